@@ -12,9 +12,11 @@
 //   b1 TransformConstants  … TestVS.hlsl
 //   b2 MaterialConstants   … Materials.hlsli
 //   b3 DisplayConstants    … Tonemap.hlsli
+//   b4 MeshConstants       … TestVS.hlsl（COMPACT_VERTEX）
 //   t0-t4 / s0  PBRテクスチャ … Materials.hlsli
 //   t0 space1 / s1  IES     … Lighting.hlsli
 //   t0 space2  ライトバッファ … Lighting.hlsli
+//   t0 space3  インスタンスのワールド変換行列 … TestVS.hlsl（INSTANCED）
 //==============================================================
 
 //==============================================
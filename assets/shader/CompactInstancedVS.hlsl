@@ -0,0 +1,6 @@
+/// @file CompactInstancedVS.hlsl
+/// @brief 圧縮した頂点（CompactVertex）のインスタンス描画用の頂点シェーダ
+
+#define COMPACT_VERTEX
+#define INSTANCED
+#include "TestVS.hlsl"
@@ -0,0 +1,6 @@
+/// @file CompactVS.hlsl
+/// @brief 圧縮した頂点（CompactVertex）用の頂点シェーダ
+/// 位置とUVはルート定数の範囲で，法線と接線は八面体写像から復元する
+
+#define COMPACT_VERTEX
+#include "TestVS.hlsl"
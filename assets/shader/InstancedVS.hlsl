@@ -0,0 +1,6 @@
+/// @file InstancedVS.hlsl
+/// @brief インスタンス描画用の頂点シェーダ
+/// ワールド変換行列をStructuredBufferからSV_InstanceIDで読む
+
+#define INSTANCED
+#include "TestVS.hlsl"
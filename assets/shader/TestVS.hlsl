@@ -1,11 +1,31 @@
 /// @file TestVS.hlsl
 /// @brief 頂点シェーダ
+/// INSTANCEDを定義するとインスタンス描画用になる（InstancedVS.hlsl）
+/// COMPACT_VERTEXを定義すると圧縮した頂点の入力になる（CompactVS.hlsl）
 
 #include "Common.hlsli"
 
 //===========================================
 // Structures
 //===========================================
+#ifdef COMPACT_VERTEX
+/// @brief 頂点シェーダの入力構造体（CompactVertex）
+struct VSInput{
+    float4 position      : POSITION;   // 範囲内の位置，wは接空間の向き（0/1）
+    float4 normalTangent : NORMAL;     // 八面体写像した法線(xy)と接線(zw)
+    float2 texCoord      : TEXCOORD;   // 範囲内のUV
+};
+
+/// @brief 圧縮した頂点の復元に使う値（VertexQuantizationと同じ並び）
+struct MeshConstants {
+    float3 positionOffset;
+    float _padding0;
+    float3 positionScale;
+    float _padding1;
+    float2 texcoordOffset;
+    float2 texcoordScale;
+};
+#else
 /// @brief 頂点シェーダの入力構造体
 struct VSInput{
     float3 position : POSITION;     // 頂点座標
@@ -14,6 +34,7 @@ struct VSInput{
     float2 texCoord : TEXCOORD;     // テクスチャ座標
     float4 color    : COLOR;        // 頂点カラー
 };
+#endif
 
 /// @brief ワールド変換行列構造体
 struct TransformConstants {
@@ -25,14 +46,54 @@ struct TransformConstants {
 //===========================================
 // constants buffer
 //===========================================
+#ifdef INSTANCED
+// [t0, space3] インスタンスごとのワールド変換行列
+StructuredBuffer<TransformConstants> g_instances : register(t0, space3);
+#else
 // [b1] ワールド変換行列
 ConstantBuffer<TransformConstants> g_transform: register(b1);
+#endif
 
-VSOutput main(VSInput input) {
+#ifdef COMPACT_VERTEX
+// [b4] 圧縮した頂点の復元に使う値（ルート定数）
+ConstantBuffer<MeshConstants> g_mesh : register(b4);
+
+/// @brief 八面体写像した2成分から単位ベクトルを復元する
+/// VertexQuantizer::DecodeOctahedralと同じ計算
+float3 DecodeOctahedral(float2 e) {
+    float3 d = float3(e, 1.0f - abs(e.x) - abs(e.y));
+    float t = saturate(-d.z);
+    d.xy += (d.xy >= 0.0f) ? -t : t;
+    return normalize(d);
+}
+#endif
+
+VSOutput main(VSInput input, uint instanceID : SV_InstanceID) {
     VSOutput output;
 
+#ifdef INSTANCED
+    TransformConstants transform = g_instances[instanceID];
+#else
+    TransformConstants transform = g_transform;
+#endif
+
+#ifdef COMPACT_VERTEX
+    // 圧縮した頂点の復元
+    float3 position = g_mesh.positionOffset + input.position.xyz * g_mesh.positionScale;
+    float3 normal   = DecodeOctahedral(input.normalTangent.xy);
+    float3 tangent  = DecodeOctahedral(input.normalTangent.zw);
+    float2 texCoord = g_mesh.texcoordOffset + input.texCoord * g_mesh.texcoordScale;
+    float handedness = input.position.w * 2.0f - 1.0f;
+#else
+    float3 position = input.position;
+    float3 normal   = input.normal;
+    float3 tangent  = input.tangent.xyz;
+    float2 texCoord = input.texCoord;
+    float handedness = input.tangent.w;
+#endif
+
     // 1. ローカル座標 -> ワールド座標変換
-    float4 worldPos = mul(float4(input.position, 1.0f), g_transform.world);
+    float4 worldPos = mul(float4(position, 1.0f), transform.world);
     output.worldPos = worldPos.xyz;
 
     // 2. ワールド座標 -> ビュー座標変換
@@ -42,18 +103,18 @@ VSOutput main(VSInput input) {
     output.position = mul(viewPos, g_scene.proj);
 
     // UV座標の受け渡し
-    output.texCoord = input.texCoord;
+    output.texCoord = texCoord;
 
     // 法線のワールド座標系への変換
-    float3 worldNormal = mul(input.normal, (float3x3)g_transform.worldInv);
+    float3 worldNormal = mul(normal, (float3x3)transform.worldInv);
     output.worldNormal = normalize(worldNormal);
 
     // 接線ベクトルのワールド座標系への変換
-    float3 worldTangent = mul(input.tangent.xyz, (float3x3)g_transform.world);
+    float3 worldTangent = mul(tangent, (float3x3)transform.world);
     output.worldTangent = normalize(worldTangent);
 
     // 接線空間の右手系/左手系の判定
-    output.handedness = input.tangent.w;
+    output.handedness = handedness;
 
     return output;
 }
\ No newline at end of file
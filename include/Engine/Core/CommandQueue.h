@@ -29,6 +29,17 @@ public:
     ////////////////////////////////////////////////////////////////
     void Wait(UINT64 fenceValue, UINT timeout);
 
+    ////////////////////////////////////////////////////////////////
+    /// @brief GPUが完了したフェンス値を取得する
+    ////////////////////////////////////////////////////////////////
+    UINT64 GetCompletedValue() const;
+
+    ////////////////////////////////////////////////////////////////
+    /// @brief 次のSignalで発行されるフェンス値を取得する
+    /// 記録中のコマンドが使うリソースは，この値で完了を判定できる
+    ////////////////////////////////////////////////////////////////
+    UINT64 GetNextValue() const { return m_nextFence; }
+
     ////////////////////////////////////////////////////////////////
     /// @brief コマンドリストを実行する
     /// @param lists コマンドリストの配列
@@ -0,0 +1,150 @@
+/// @file ConcurrentIndexPool.h
+/// @brief 複数スレッドから確保・解放できるインデックスプール
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "Engine/Core/FreeRangeAllocator.h"
+
+/// @brief スレッドごとのキャッシュを持つインデックスプール
+/// 1個ずつの確保・解放はスレッドごとのキャッシュで行い，ロックを取らない
+/// キャッシュが空・満杯になったときは，kBatchSize個をまとめて
+/// ロックフリーのスタック（デポ）とやり取りする
+/// デポも空のときだけmutexを取り，FreeRangeAllocatorからまとめて確保する
+/// 連続した範囲の確保・解放は常にmutexを取ってFreeRangeAllocatorで行う
+///
+/// キャッシュはスレッドごとに最初に使った時点で割り当てた番号で引く
+/// 番号が全て使用中のときに来たスレッドはmutexを取る経路で処理する
+/// スレッドの終了時には，全てのプールのキャッシュを戻してから番号を返す
+/// 連続した範囲が取れないときは，全てのキャッシュを戻してから探し直す
+/// ただし，その瞬間に持ち主が使っているキャッシュの分は戻らない
+/// D3D12には依存しないので，ディスクリプタヒープ以外の用途でも使える
+class ConcurrentIndexPool {
+public:
+    static constexpr uint32_t kInvalidIndex     = UINT32_MAX;
+    static constexpr uint32_t kBatchSize        = 32;  // やり取りの単位
+    static constexpr uint32_t kMaxCachedThreads = 32;  // キャッシュを持つ数
+    static constexpr uint32_t kThreadCacheSize  = kBatchSize * 2;
+
+    ConcurrentIndexPool();
+    ~ConcurrentIndexPool();
+
+    /// @brief 全てのインデックスを空きにする
+    /// 他のスレッドが使用していないときに呼ぶ
+    /// @param capacity 管理するインデックスの数
+    void Reset(uint32_t capacity);
+
+    /// @brief インデックスを1つ確保する
+    /// @return インデックス，空きがなければkInvalidIndex
+    uint32_t Allocate();
+
+    /// @brief インデックスを1つ解放する
+    void Free(uint32_t index);
+
+    /// @brief 連続した範囲の確保
+    /// @return 先頭のインデックス，確保できなければkInvalidIndex
+    uint32_t AllocateRange(uint32_t count);
+
+    /// @brief 連続した範囲の解放
+    void FreeRange(uint32_t index, uint32_t count);
+
+    /// @brief 管理するインデックスの数
+    uint32_t GetCapacity() const { return m_capacity; }
+
+private:
+    /// @brief キャッシュの中身
+    struct CacheBlock {
+        uint32_t count = 0;
+        std::array<uint32_t, kThreadCacheSize> indices;
+    };
+
+    /// @brief スレッドごとのキャッシュ
+    /// 中身はpBlockをexchangeで取り出したスレッドだけが触り，触り終えたら戻す
+    /// 所有スレッドも，空きを回収する他のスレッドも同じ手順を踏むので
+    /// 確保・解放ではロックを取らない
+    /// 所有スレッドが取り出せなかったとき（回収中）はmutexを取る経路で処理する
+    struct alignas(64) ThreadCache {
+        std::atomic<CacheBlock*> pBlock{ nullptr };
+        CacheBlock block;
+
+        /// @brief 中身を取り出す，他のスレッドが使用中ならnullptr
+        CacheBlock* Take() {
+            return pBlock.exchange(nullptr, std::memory_order_acquire);
+        }
+
+        /// @brief 取り出した中身を戻す
+        void Give(CacheBlock* pTaken) {
+            pBlock.store(pTaken, std::memory_order_release);
+        }
+    };
+
+    /// @brief スレッドのキャッシュ番号の保持
+    /// thread_localに置き，スレッドの終了時に番号を返す
+    class ThreadSlot {
+    public:
+        ThreadSlot();
+        ~ThreadSlot();
+
+        /// @brief キャッシュ番号，持てなければkInvalidIndex
+        uint32_t Get() const { return m_slot; }
+
+    private:
+        uint32_t m_slot = kInvalidIndex;
+    };
+
+    /// @brief デポのノード（kBatchSize個のインデックスを運ぶ）
+    struct Magazine {
+        std::atomic<uint32_t> next{ kInvalidIndex };  // スタックの次のノード
+        std::array<uint32_t, kBatchSize> indices;
+    };
+
+    /// @brief ロックフリーのスタック
+    /// 先頭のノード番号と，ABA問題を防ぐための更新回数を64bitにまとめて持つ
+    class MagazineStack {
+    public:
+        void Clear() { m_head.store(Pack(kInvalidIndex, 0)); }
+        void Push(Magazine* pNodes, uint32_t node);
+        uint32_t Pop(Magazine* pNodes);
+
+    private:
+        static uint64_t Pack(uint32_t node, uint32_t tag) {
+            return (static_cast<uint64_t>(tag) << 32) | node;
+        }
+
+        std::atomic<uint64_t> m_head{ Pack(kInvalidIndex, 0) };
+    };
+
+    /// @brief 呼び出しスレッドのキャッシュ，持てなければnullptr
+    ThreadCache* GetThreadCache();
+
+    /// @brief キャッシュの中身を取り出せれば，全てFreeRangeAllocatorに戻す
+    /// 取り出せなければ，使用中のスレッドに任せる（m_mutexはこの中で取る）
+    void ReturnCache(ThreadCache& cache);
+
+    /// @brief キャッシュへの補充
+    void Refill(CacheBlock& block);
+
+    /// @brief キャッシュの半分をデポに移す
+    void Flush(CacheBlock& block);
+
+    /// @brief デポのインデックスを全てFreeRangeAllocatorに戻す（要ロック）
+    void DrainDepotLocked();
+
+    std::unique_ptr<ThreadCache[]> m_pCaches;  // スレッドごとのキャッシュ
+    std::unique_ptr<Magazine[]> m_pMagazines;  // デポのノード
+    MagazineStack m_fullMagazines;             // インデックスを持つノード
+    MagazineStack m_emptyMagazines;            // 空のノード
+
+    std::mutex m_mutex;           // m_rangesの排他制御
+    FreeRangeAllocator m_ranges;  // キャッシュ・デポ以外の空き
+    uint32_t m_capacity = 0;      // 管理するインデックスの数
+
+    // コピー禁止
+    ConcurrentIndexPool(const ConcurrentIndexPool&)            = delete;
+    ConcurrentIndexPool& operator=(const ConcurrentIndexPool&) = delete;
+};
@@ -0,0 +1,19 @@
+/// @file CpuFeatures.h
+/// @brief 実行中のCPUが対応している命令セットの判定
+
+#pragma once
+
+/// @brief CPUの命令セットの判定
+/// ビルド時の/arch指定に関係なく，実行時にcpuidで判定する
+/// 結果は初回の呼び出しで求めて保持する
+class CpuFeatures {
+public:
+    CpuFeatures()  = delete;
+    ~CpuFeatures() = delete;
+
+    /// @brief AVX2を使えるか（OSがYMMレジスタを保存する場合に限る）
+    static bool HasAvx2();
+
+    /// @brief F16C（半精度との変換命令）を使えるか
+    static bool HasF16C();
+};
@@ -0,0 +1,76 @@
+/// @file DeferredReleaseQueue.h
+/// @brief フェンス値で解放するタイミングを決める遅延解放キュー
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "Engine/Core/JobSystem.h"
+
+/// @brief GPUが使い終えるまでオブジェクトの破棄を遅らせるキュー
+/// オブジェクトは最後に使われたコマンドのフェンス値を付けて預け，
+/// Collectで完了済みのフェンス値以下のものをまとめて破棄する
+/// 型は問わず，ムーブできるものならテクスチャ・モデル・
+/// ディスクリプタの範囲などを同じキューで扱える
+/// JobSystemを渡すと，破棄はワーカースレッドでまとめて行う
+/// D3D12には依存しないので，デバイスなしで動作を確認できる
+class DeferredReleaseQueue {
+public:
+    DeferredReleaseQueue();
+    ~DeferredReleaseQueue();
+
+    /// @brief オブジェクトを預ける（複数スレッドから呼べる）
+    /// @param obj 破棄するオブジェクト
+    /// @param fenceValue このフェンス値にGPUが到達したら破棄できる
+    template <typename T>
+    void Retire(T obj, uint64_t fenceValue) {
+        Push(std::make_unique<Retired<T>>(std::move(obj)), fenceValue);
+    }
+
+    /// @brief 完了済みのフェンス値以下のオブジェクトを破棄する
+    /// @param completedFenceValue GPUが完了したフェンス値
+    /// @param pJobSystem 破棄を任せるジョブシステム，nullptrならその場で破棄
+    void Collect(
+        uint64_t completedFenceValue, JobSystem* pJobSystem = nullptr);
+
+    /// @brief 実行中の破棄を待ち，残りを全てその場で破棄する
+    /// GPUの処理の完了を待ってから呼ぶ
+    void ReleaseAll();
+
+    /// @brief 破棄待ちのオブジェクトの数
+    size_t GetPendingCount() const;
+
+private:
+    /// @brief 型を消したオブジェクトの入れ物
+    struct RetiredBase {
+        virtual ~RetiredBase() = default;
+    };
+
+    template <typename T>
+    struct Retired : RetiredBase {
+        explicit Retired(T&& obj) : value(std::move(obj)) {}
+        T value;
+    };
+
+    /// @brief フェンス値を付けたオブジェクト
+    struct Entry {
+        uint64_t fenceValue;                   // 破棄できるフェンス値
+        std::unique_ptr<RetiredBase> pObject;  // 破棄するオブジェクト
+    };
+
+    /// @brief フェンス値の順になる位置に追加する
+    void Push(std::unique_ptr<RetiredBase> pObject, uint64_t fenceValue);
+
+    mutable std::mutex m_mutex;         // m_entriesの排他制御
+    std::deque<Entry> m_entries;        // 破棄待ち（フェンス値の小さい順）
+    JobSystem* m_pJobSystem = nullptr;  // 最後に破棄を任せたジョブシステム
+    JobCounter m_releaseCounter;        // ワーカーでの破棄の完了待ち
+
+    // コピー禁止
+    DeferredReleaseQueue(const DeferredReleaseQueue&)            = delete;
+    DeferredReleaseQueue& operator=(const DeferredReleaseQueue&) = delete;
+};
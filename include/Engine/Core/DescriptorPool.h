@@ -7,13 +7,12 @@
 #include <d3d12.h>
 #include <directxtk12/DescriptorHeap.h>
 
-#include <algorithm>
 #include <cassert>
 #include <memory>
-#include <mutex>
 #include <vector>
 
 #include "Engine/Core/ComPtr.h"
+#include "Engine/Core/ConcurrentIndexPool.h"
 
 // 前方宣言
 class DescriptorAllocation;
@@ -70,7 +69,9 @@ private:
     uint32_t ReserveIndex();
 
     /// @brief 割り当ての解放
-    void Free(uint32_t index);
+    /// @param index 先頭のインデックス
+    /// @param count 連続数
+    void Free(uint32_t index, uint32_t count);
 
     // ハンドルの取得
     D3D12_CPU_DESCRIPTOR_HANDLE GetCPUHandle(uint32_t index) const;
@@ -83,10 +84,7 @@ private:
     D3D12_DESCRIPTOR_HEAP_TYPE m_type{};  // ディスクリプタヒープの種類
     uint32_t m_capacity;                  // プールのサイズ
     bool m_shaderVisible;
-    std::vector<uint32_t> m_free;  // 空きスロット
-
-    // 排他制御のためのmutex
-    mutable std::mutex m_mutex;
+    ConcurrentIndexPool m_free;  // 空きスロット（スレッドごとにキャッシュする）
 
     // コピー禁止
     DescriptorPool(const DescriptorPool&)            = delete;
@@ -5,6 +5,7 @@
 
 #include <d3d12.h>
 
+#include <cstddef>
 #include <cstdint>
 
 namespace config {
@@ -19,6 +20,13 @@ inline constexpr uint32_t kFrameCount = 2;      // フレームリソースの
 inline constexpr uint32_t kMaxObjects = 10000;  // 最大オブジェクト数
 inline constexpr uint32_t kMaxLights  = 64;     // 最大ライト数
 
+// フレームごとのアップロード領域の初期サイズ（ワールド行列CBなど）
+// 超えたフレームがあれば次のフレームから自動で拡張する
+inline constexpr size_t kUploadRingSize = 4 * 1024 * 1024;
+
+// 並列処理で1ジョブが受け持つオブジェクト数
+inline constexpr uint32_t kObjectsPerJob = 256;
+
 // 1マテリアル当たりの見積もり
 inline constexpr uint32_t kMaxMaterials       = 2560;  // 最大マテリアル数
 inline constexpr uint32_t kTexturePerMaterial = 5;
@@ -26,8 +34,7 @@ inline constexpr uint32_t kMiscSrvCbvReserve  = 256;  // IES/IBLなど
 
 // CBV/SRV/UAVヒープの最大数
 inline constexpr uint32_t kCbvSrvUavCapacity =
-    kMaxObjects * kFrameCount                    // Transform CBV
-    + kMaxMaterials * (1 + kTexturePerMaterial)  // Material CBV + PBRテクスチャ
+    kMaxMaterials * (1 + kTexturePerMaterial)  // Material CBV + PBRテクスチャ
     + kFrameCount                                // Scene CBV
     + kFrameCount                                // Light StructuredBuffer
     + kMiscSrvCbvReserve;                        // IES/IBLなど
@@ -37,6 +44,11 @@ inline constexpr uint32_t kRtvCapacity     = kFrameCount + 8;  // バックバ
 inline constexpr uint32_t kDsvCapacity     = 1 + 4;  // メイン深度 + 余白
 inline constexpr uint32_t kAssetSrvCapacity = 2048;  // アセット用SRVの最大数
 
+// GLBのインポート結果のキャッシュ（実行ファイルのディレクトリからの相対パス）
+inline constexpr wchar_t kDerivedDataCacheDir[] = L"DerivedDataCache";
+inline constexpr uint64_t kDerivedDataCacheMaxBytes =
+    2ull * 1024 * 1024 * 1024;  // 合計サイズの上限，超えたら古いものから削除
+
 inline constexpr float kHDRPaperWhiteNits = 200.0f;  // HDRの紙白輝度（nits）
 inline constexpr float kSDRPaperWhiteNits = 80.0f;   // SDRの紙白輝度（nits）
 }  // namespace config
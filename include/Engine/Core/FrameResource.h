@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "Engine/Core/ComPtr.h"
+#include "Engine/Graphics/LinearUploadAllocator.h"
 #include "Engine/Shader/LightBuffer.h"
 #include "Engine/Shader/SceneConstantsGPU.h"
 
@@ -46,6 +47,9 @@ public:
     /// @brief LightBufferの取得
     LightBuffer& GetLightBuffer() { return m_lightBuffer; }
 
+    /// @brief フレーム内で使い捨てるアップロード領域の取得
+    LinearUploadAllocator& GetUploadAllocator() { return m_uploadAllocator; }
+
     /// @brief フェンス値の取得
     UINT64 GetFenceValue() const { return m_fenceValue; }
 
@@ -53,8 +57,9 @@ private:
     engine::ComPtr<ID3D12CommandAllocator>
         m_pCmdAllocator;  // コマンドアロケータ
 
-    SceneConstantsGPU m_sceneConstants;  // シーン定数
-    LightBuffer m_lightBuffer;           // ライトバッファ
+    SceneConstantsGPU m_sceneConstants;       // シーン定数
+    LightBuffer m_lightBuffer;                // ライトバッファ
+    LinearUploadAllocator m_uploadAllocator;  // ワールド行列などの一時領域
 
     UINT64 m_fenceValue = 0;  // フェンス値
     // このフレームを作成した時点のフェンス値を持つことで，
@@ -0,0 +1,70 @@
+/// @file FreeRangeAllocator.h
+/// @brief 連続したインデックスの範囲を確保・解放するアロケータ
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <utility>
+
+/// @brief 空き範囲を結合しながら管理するインデックスアロケータ
+/// 空き範囲を 先頭→長さ の順序付きマップと，長さの2の累乗ごとのバケットで持つ
+/// バケット内は (長さ, 先頭) の順に並べ，必要な長さ以上の範囲を二分探索で探す
+/// 確保・解放ともにO(log n)で，解放時は隣接する空き範囲と結合する
+/// D3D12には依存しないので，ディスクリプタヒープ以外の用途でも使える
+/// スレッドセーフではないので，排他制御は呼び出し側で行う
+class FreeRangeAllocator {
+public:
+    static constexpr uint32_t kInvalidOffset = UINT32_MAX;
+
+    FreeRangeAllocator() = default;
+
+    /// @brief 全体を1つの空き範囲にする
+    /// @param capacity 管理するインデックスの数
+    void Reset(uint32_t capacity);
+
+    /// @brief 連続した範囲の確保
+    /// @param count 個数
+    /// @return 先頭のインデックス，確保できなければkInvalidOffset
+    uint32_t Allocate(uint32_t count);
+
+    /// @brief 範囲の解放
+    /// @param offset Allocateが返した先頭のインデックス
+    /// @param count Allocateに渡した個数
+    void Free(uint32_t offset, uint32_t count);
+
+    //========================================
+    // アクセサ
+    //========================================
+    /// @brief 管理するインデックスの数
+    uint32_t GetCapacity() const { return m_capacity; }
+
+    /// @brief 空いているインデックスの数
+    uint32_t GetFreeCount() const { return m_freeCount; }
+
+    /// @brief 空き範囲の数（断片化の目安）
+    uint32_t GetFreeRangeCount() const {
+        return static_cast<uint32_t>(m_ranges.size());
+    }
+
+private:
+    static constexpr uint32_t kBucketCount = 32;
+
+    /// @brief 長さが入るバケット（[2^k, 2^(k+1))をバケットkとする）
+    static uint32_t BucketOf(uint32_t length);
+
+    /// @brief 空き範囲の登録
+    void InsertRange(uint32_t offset, uint32_t length);
+
+    /// @brief 空き範囲の登録解除
+    void EraseRange(std::map<uint32_t, uint32_t>::iterator it);
+
+    std::map<uint32_t, uint32_t> m_ranges;  // 空き範囲（先頭→長さ）
+    std::array<std::set<std::pair<uint32_t, uint32_t>>, kBucketCount>
+        m_buckets;              // 長さごとの空き範囲（長さ, 先頭）
+    uint32_t m_bucketMask = 0;  // 空でないバケットのビット
+    uint32_t m_capacity   = 0;  // 管理するインデックスの数
+    uint32_t m_freeCount  = 0;  // 空いているインデックスの数
+};
@@ -0,0 +1,33 @@
+/// @file Hash.h
+/// @brief 非暗号学的ハッシュ（FNV-1a 64bit）
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace hash {
+inline constexpr uint64_t kFnv1aOffsetBasis = 14695981039346656037ull;
+inline constexpr uint64_t kFnv1aPrime       = 1099511628211ull;
+
+/// @brief バイト列のハッシュ
+/// @param seed 続けて計算する場合は前回の結果を渡す
+inline uint64_t Fnv1a64(
+    const void* pData, size_t size, uint64_t seed = kFnv1aOffsetBasis) {
+    const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+    uint64_t hash         = seed;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= pBytes[i];
+        hash *= kFnv1aPrime;
+    }
+    return hash;
+}
+
+/// @brief 値のハッシュ，パディングを持たない型に限る
+template <typename T>
+uint64_t Fnv1a64Value(const T& value, uint64_t seed = kFnv1aOffsetBasis) {
+    static_assert(std::has_unique_object_representations_v<T>);
+    return Fnv1a64(&value, sizeof(T), seed);
+}
+}  // namespace hash
@@ -0,0 +1,150 @@
+/// @file JobSystem.h
+/// @brief ワーカースレッドでジョブを並列実行する仕組み
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief 完了待ち用のカウンタ．Submitのたびに増え，ジョブの完了で減る
+class JobCounter {
+public:
+    JobCounter() = default;
+
+    /// @brief 登録したジョブが全て完了したか
+    bool IsDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<uint32_t> m_pending{ 0 };  // 未完了のジョブ数
+
+    // コピー禁止
+    JobCounter(const JobCounter&)            = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+};
+
+/// @brief ワークスティーリング方式のジョブシステム
+/// ワーカーごとにキューを持ち，自分のキューは後ろから（LIFO），
+/// 他のキューは前から（FIFO）取り出して仕事を分け合う
+/// ワーカー以外のスレッドから投入したジョブは共有キューに入る
+/// Waitを呼んだスレッドも，待っているカウンタのジョブに限って実行に参加する
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    JobSystem();
+    ~JobSystem();
+
+    /// @brief ワーカースレッドの起動
+    /// @param workerCount ワーカー数，0ならハードウェアスレッド数 - 1
+    /// @return 成功した場合はtrue
+    bool Init(uint32_t workerCount = 0);
+
+    /// @brief ワーカースレッドの終了，残っているジョブは実行してから終わる
+    void Term();
+
+    /// @brief ジョブの投入
+    /// @param job 実行する処理
+    /// @param pCounter 完了待ち用のカウンタ（不要ならnullptr）
+    void Submit(Job job, JobCounter* pCounter = nullptr);
+
+    /// @brief カウンタのジョブが全て完了するまで，そのジョブを実行しながら待つ
+    /// 他のカウンタのジョブ（モデルの読み込みなど長いもの）は手伝わないので，
+    /// フレーム中のWaitが無関係な重いジョブで止まることはない
+    void Wait(JobCounter& counter);
+
+    /// @brief [0, count)をgrainSize個ずつに分けてfn(begin, end)を並列実行する
+    /// 呼び出し元も分担し，全て完了してから戻る
+    template <typename Fn>
+    void ParallelFor(uint32_t count, uint32_t grainSize, Fn&& fn) {
+        if (count == 0) return;
+        grainSize = std::max(grainSize, 1u);
+
+        // 1チャンクしかない場合やワーカーがいない場合はそのまま実行する
+        if (count <= grainSize || m_workers.empty()) {
+            fn(0u, count);
+            return;
+        }
+
+        JobCounter counter;
+        for (uint32_t begin = grainSize; begin < count; begin += grainSize) {
+            uint32_t end = std::min(begin + grainSize, count);
+            Submit([&fn, begin, end]() { fn(begin, end); }, &counter);
+        }
+
+        // 先頭のチャンクは呼び出し元で処理する
+        fn(0u, std::min(grainSize, count));
+        Wait(counter);
+    }
+
+    /// @brief ワーカースレッド数
+    uint32_t GetWorkerCount() const {
+        return static_cast<uint32_t>(m_workers.size());
+    }
+
+private:
+    /// @brief キューに積むジョブ
+    struct Task {
+        Job job;
+        JobCounter* pCounter = nullptr;
+    };
+
+    /// @brief ミューテックス付きの両端キュー
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    //=========================================
+    // private methods
+    //=========================================
+    /// @brief ワーカースレッドの処理
+    void WorkerMain(uint32_t queueIndex);
+
+    /// @brief queueIndexのキューから，空なら他のキューから1つ取り出す
+    /// @param pCounter 指定した場合はこのカウンタのジョブだけを取り出す
+    bool TryPop(
+        uint32_t queueIndex, Task& task, const JobCounter* pCounter = nullptr);
+
+    /// @brief ジョブを実行し，カウンタを減らす
+    void Execute(Task& task);
+
+    /// @brief 呼び出しスレッドが使うキューの番号
+    uint32_t GetQueueIndex() const;
+
+    //=========================================
+    // private variables
+    //=========================================
+    // キュー0は共有キュー，1以降はワーカー専用のキュー
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+    std::vector<std::thread> m_workers;  // ワーカースレッド
+
+    std::mutex m_sleepMutex;               // 待機用ミューテックス
+    std::condition_variable m_wakeUp;      // ジョブ投入の通知
+    std::atomic<uint32_t> m_queuedJobs{ 0 };  // キューに積まれているジョブ数
+    std::atomic<bool> m_running{ false };  // ワーカー稼働中か
+
+    // コピー禁止
+    JobSystem(const JobSystem&)            = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+};
+
+/// @brief pJobSystemがあればParallelForで並列に，なければ呼び出し元で
+/// [0, count)をまとめて実行する
+template <typename Fn>
+void ParallelFor(
+    JobSystem* pJobSystem, uint32_t count, uint32_t grainSize, Fn&& fn) {
+    if (pJobSystem != nullptr) {
+        pJobSystem->ParallelFor(count, grainSize, fn);
+    } else if (count > 0) {
+        fn(0u, count);
+    }
+}
@@ -0,0 +1,46 @@
+/// @file MappedFile.h
+/// @brief 読み取り専用のメモリマップトファイル
+
+#pragma once
+
+#define NOMINMAX
+#include <Windows.h>
+
+#include <cstddef>
+#include <filesystem>
+
+/// @brief ファイル全体を読み取り専用でマッピングする
+/// 内容はアクセスした時点でページ単位に読み込まれる
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    /// @brief ファイルを開いてマッピングする
+    /// @return 開けない場合や空のファイルはfalse
+    bool Open(const std::filesystem::path& path);
+
+    /// @brief マッピングを解除してファイルを閉じる
+    void Close();
+
+    //========================================
+    // アクセサ
+    //========================================
+    /// @brief ファイルの先頭，開いていなければnullptr
+    const void* GetData() const { return m_pView; }
+
+    /// @brief バイト数
+    size_t GetSize() const { return m_size; }
+
+    bool IsOpen() const { return m_pView != nullptr; }
+
+private:
+    HANDLE m_hFile      = INVALID_HANDLE_VALUE;  // ファイル
+    HANDLE m_hMapping   = nullptr;               // ファイルマッピング
+    const void* m_pView = nullptr;               // マッピングした先頭
+    size_t m_size       = 0;                     // バイト数
+
+    // コピー禁止
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+};
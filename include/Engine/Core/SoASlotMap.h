@@ -0,0 +1,173 @@
+/// @file SoASlotMap.h
+/// @brief 列指向（Structure of Arrays）レイアウトのSlotMapの実装
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "Engine/Core/GenHandle.h"
+
+/// @brief 要素を型ごとの密な配列（列）に分けて保持するSlotMap
+/// 全ての列は同じデータインデックスで並んでおり，
+/// 世代付きハンドルの解決方法はSlotMapと同じ
+/// 列単位で線形に走査できるので，一部のメンバだけを読む処理がキャッシュに乗りやすい
+template <typename Tag, typename... Ts>
+class SoASlotMap {
+public:
+    using HandleType = engine::GenHandle<Tag>;
+    using RowType    = std::tuple<Ts...>;
+
+    template <size_t I>
+    using ColumnType = std::tuple_element_t<I, RowType>;
+
+    /// @brief 空きスロットへ追加しハンドルを返す
+    HandleType Insert(Ts... values) {
+        uint32_t index;
+        if (!m_freeList.empty()) {
+            // フリーリストから再利用
+            index = m_freeList.back();
+            m_freeList.pop_back();
+        } else {
+            // 新しいスロットを追加
+            index = static_cast<uint32_t>(m_slots.size());
+            m_slots.push_back(Slot{ 0, 0 });
+        }
+
+        // 各列の末尾にデータを追加しスロットを更新
+        PushBack(std::index_sequence_for<Ts...>{}, std::move(values)...);
+        m_dataToSlot.push_back(index);
+        m_slots[index].dataIndex = static_cast<uint32_t>(Size() - 1);
+
+        return HandleType{ index, m_slots[index].generation };
+    }
+
+    /// @brief ハンドルに対応する要素を削除し，削除した行を返す
+    std::optional<RowType> Erase(HandleType h) {
+        uint32_t erasedDataIndex = GetDataIndex(h);
+        if (erasedDataIndex == UINT32_MAX) return std::nullopt;
+
+        // 各列とも末尾要素を削除対象の位置に移動して詰める
+        uint32_t lastDataIndex = Size() - 1;
+        RowType erasedRow      = SwapRemove(
+            std::index_sequence_for<Ts...>{}, erasedDataIndex, lastDataIndex);
+        if (erasedDataIndex != lastDataIndex) {
+            // dataToSlotと間接参照テーブルも列に合わせて調整
+            uint32_t movedSlot            = m_dataToSlot[lastDataIndex];
+            m_dataToSlot[erasedDataIndex] = movedSlot;
+            m_slots[movedSlot].dataIndex  = erasedDataIndex;
+        }
+        m_dataToSlot.pop_back();
+
+        // generationを進めて削除した要素のインデックスをフリーリストに追加
+        m_slots[h.index].generation++;
+        m_freeList.push_back(h.index);
+
+        return erasedRow;
+    }
+
+    /// @brief ハンドルが有効な要素を指しているか
+    bool Contains(HandleType h) const { return GetDataIndex(h) != UINT32_MAX; }
+
+    /// @brief generationを確認し有効ならI番目の列の実体を返す
+    template <size_t I>
+    ColumnType<I>* Get(HandleType h) {
+        uint32_t dataIndex = GetDataIndex(h);
+        if (dataIndex == UINT32_MAX) return nullptr;
+        return &std::get<I>(m_columns)[dataIndex];
+    }
+
+    /// @brief ハンドルに対応するデータインデックス，無効ならUINT32_MAX
+    uint32_t GetDataIndex(HandleType h) const {
+        // 引数のチェック
+        if (h.index >= m_slots.size()) return UINT32_MAX;
+
+        const Slot& slot = m_slots[h.index];
+        if (slot.generation != h.generation) return UINT32_MAX;
+        return slot.dataIndex;
+    }
+
+    /// @brief スロット番号に対応するデータインデックス，空きスロットならUINT32_MAX
+    uint32_t GetSlotDataIndex(uint32_t slotIndex) const {
+        if (slotIndex >= m_slots.size()) return UINT32_MAX;
+        uint32_t dataIndex = m_slots[slotIndex].dataIndex;
+        // 空きスロットのdataIndexは別の要素を指しうるので逆引きで確認する
+        if (dataIndex >= m_dataToSlot.size() ||
+            m_dataToSlot[dataIndex] != slotIndex) {
+            return UINT32_MAX;
+        }
+        return dataIndex;
+    }
+
+    /// @brief データインデックスに対応するハンドルを返す
+    HandleType GetHandle(uint32_t dataIndex) const {
+        uint32_t slot = m_dataToSlot[dataIndex];
+        return HandleType{ slot, m_slots[slot].generation };
+    }
+
+    /// @brief I番目の列を取得する．要素数はSize()と一致する
+    template <size_t I>
+    std::vector<ColumnType<I>>& GetColumn() {
+        return std::get<I>(m_columns);
+    }
+    template <size_t I>
+    const std::vector<ColumnType<I>>& GetColumn() const {
+        return std::get<I>(m_columns);
+    }
+
+    /// @brief 要素数
+    uint32_t Size() const { return static_cast<uint32_t>(m_dataToSlot.size()); }
+
+    /// @brief 各列の容量を予約する
+    void Reserve(size_t capacity) {
+        std::apply([&](auto&... column) { (column.reserve(capacity), ...); },
+            m_columns);
+        m_slots.reserve(capacity);
+        m_dataToSlot.reserve(capacity);
+    }
+
+    /// @brief 全要素を削除する
+    void Clear() {
+        std::apply([](auto&... column) { (column.clear(), ...); }, m_columns);
+        m_slots.clear();
+        m_dataToSlot.clear();
+        m_freeList.clear();
+    }
+
+private:
+    struct Slot {
+        uint32_t dataIndex;
+        uint32_t generation = 0;
+    };
+
+    /// @brief 各列の末尾に追加する
+    template <size_t... Is>
+    void PushBack(std::index_sequence<Is...>, Ts&&... values) {
+        (std::get<Is>(m_columns).push_back(std::move(values)), ...);
+    }
+
+    /// @brief 各列でerasedの位置に末尾を移動して詰め，削除した要素を返す
+    template <size_t... Is>
+    RowType SwapRemove(
+        std::index_sequence<Is...>, uint32_t erased, uint32_t last) {
+        RowType row{ std::move(std::get<Is>(m_columns)[erased])... };
+        if (erased != last) {
+            // 末尾要素の削除時は自己ムーブ代入になるので回避する
+            ((std::get<Is>(m_columns)[erased] =
+                     std::move(std::get<Is>(m_columns)[last])),
+                ...);
+        }
+        (std::get<Is>(m_columns).pop_back(), ...);
+        return row;
+    }
+
+    std::tuple<std::vector<Ts>...> m_columns;  // 実データ（列ごと）
+    std::vector<Slot> m_slots;                 // 間接参照テーブル
+    std::vector<uint32_t>
+        m_dataToSlot;  // データインデックスからスロットインデックスへの変換テーブル
+    std::vector<uint32_t> m_freeList;  // フリーリスト
+};
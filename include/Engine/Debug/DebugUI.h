@@ -16,6 +16,7 @@ class Camera;
 class ColorTarget;
 class Scene;
 class GraphicsDevice;
+struct RenderStats;
 
 class DebugUI {
 public:
@@ -34,7 +35,10 @@ public:
     /// @brief デバッグUIのフレーム開始時の処理
     /// @param input InputSystemの参照
     /// @param camera Cameraの参照
-    void BeginFrame(InputSystem& input, Camera& camera, Scene& scene);
+    /// @param scene Sceneの参照
+    /// @param stats 直近のフレームの描画統計
+    void BeginFrame(InputSystem& input, Camera& camera, Scene& scene,
+        const RenderStats& stats);
 
     /// @brief デバッグUIのレンダリング
     /// @param uiTarget UI用レンダーターゲット
@@ -60,8 +64,9 @@ private:
     // private methods
     //=========================================
 
-    /// @brief FPS表示UIの描画
-    void DrawFPSPanel();
+    /// @brief FPS・描画統計表示UIの描画
+    /// @param stats 描画統計
+    void DrawFPSPanel(const RenderStats& stats);
 
     /// @brief 露出調整UIの描画
     /// @param camera Cameraの参照
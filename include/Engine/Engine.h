@@ -13,8 +13,10 @@
 #include <d3d12.h>
 
 #include "Engine/Core/ComPtr.h"
+#include "Engine/Core/DeferredReleaseQueue.h"
 #include "Engine/Core/EngineConfig.h"
 #include "Engine/Core/GraphicsDevice.h"
+#include "Engine/Core/JobSystem.h"
 #include "Engine/Debug/DebugUI.h"
 #include "Engine/Input/IWindowEventListener.h"
 #include "Engine/Input/InputSystem.h"
@@ -65,6 +67,16 @@ public:
     /// @brief アセットロード用オブジェクトの作成
     AssetLoadScope CreateAssetLoadScope();
 
+    /// @brief モデルの非同期ロードを開始する
+    /// すぐにハンドルを返し，GPUへの転送が完了するまでは描画されない
+    /// @param callback 完了時にBeginFrame内で呼ばれる（省略可）
+    engine::ModelHandle LoadModelAsync(const std::filesystem::path& path,
+        AsyncModelLoader::Callback callback = nullptr);
+
+    /// @brief モデルをシーンから外す
+    /// GPUを待たずに戻り，描画に使い終えた時点でワーカースレッドで破棄する
+    void UnloadModel(engine::ModelHandle handle);
+
     //==================================================================
     // アクセサ
     //==================================================================
@@ -108,6 +120,10 @@ private:
 
     InputSystem m_InputSystem;  // 入力システム
 
+    JobSystem m_JobSystem;  // フレーム更新を並列に処理するワーカー群
+
+    DeferredReleaseQueue m_ReleaseQueue;  // GPUが使い終えたリソースの破棄
+
     HWND m_hWnd;  // ウィンドウハンドル
 
     WindowEventAdapter m_WindowEventAdapter{ this };
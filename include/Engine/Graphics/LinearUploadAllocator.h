@@ -0,0 +1,100 @@
+/// @file LinearUploadAllocator.h
+/// @brief フレームごとに使い捨てるアップロードヒープの線形アロケータ
+
+#pragma once
+
+#include <d3d12.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "Engine/Graphics/GPUBuffer.h"
+
+/// @brief アップロードヒープから切り出した領域
+struct UploadAllocation {
+    void* pCPU                           = nullptr;  // 書き込み先（マップ済み）
+    D3D12_GPU_VIRTUAL_ADDRESS gpuAddress = 0;        // GPU仮想アドレス
+
+    bool IsValid() const { return pCPU != nullptr; }
+};
+
+/// @brief アップロードヒープの線形アロケータ
+/// マップしたままの大きなバッファ1つから先頭順に切り出し，
+/// ルートCBV/SRVに直接渡せるGPU仮想アドレスを返す
+/// 個別の解放はせず，Resetでまとめて先頭に戻す
+/// フレームリソースごとに持ち，フェンス待機後（GPUが使い終えた後）にResetする
+///
+/// 容量を超えた場合は追加のページを作成して割り当てを続ける
+/// 追加ページは次のResetで解放し，そのフレームの使用量に余裕を持たせた大きさに
+/// メインのバッファを作り直すので，以降のフレームでは追加ページは作られない
+class LinearUploadAllocator {
+public:
+    /// @brief 定数バッファに必要なアライメント
+    static constexpr size_t kConstantBufferAlignment =
+        D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT;
+
+    LinearUploadAllocator();
+    ~LinearUploadAllocator();
+
+    /// @brief バッファの作成
+    /// @param pDevice デバイス
+    /// @param size 1フレームで使う見込みのバイト数
+    bool Init(ID3D12Device* pDevice, size_t size);
+
+    void Term();
+
+    /// @brief 全ての割り当てを破棄して先頭に戻す
+    /// 前回のResetから容量を超えていればバッファを作り直す
+    void Reset();
+
+    /// @brief 領域の割り当て
+    /// @param size バイト数
+    /// @param alignment アライメント（2の累乗）
+    /// @return 割り当てた領域，バッファを作成できなければ無効な値
+    UploadAllocation Allocate(
+        size_t size, size_t alignment = kConstantBufferAlignment);
+
+    /// @brief 定数バッファの割り当てと書き込み
+    template <typename T>
+    UploadAllocation Push(const T& data) {
+        UploadAllocation allocation = Allocate(sizeof(T));
+        if (allocation.IsValid()) {
+            *static_cast<T*>(allocation.pCPU) = data;
+        }
+        return allocation;
+    }
+
+    //========================================
+    // アクセサ
+    //========================================
+    /// @brief 前回のResetから割り当てたバイト数（アライメントの詰め物を含む）
+    size_t GetUsedBytes() const { return m_usedBytes; }
+
+    /// @brief メインのバッファのバイト数
+    size_t GetCapacity() const { return m_pages.empty() ? 0 : m_pages[0].size; }
+
+    /// @brief 前回のResetから作成した追加ページの数
+    size_t GetOverflowPageCount() const {
+        return m_pages.empty() ? 0 : m_pages.size() - 1;
+    }
+
+private:
+    /// @brief 切り出し元のバッファ
+    struct Page {
+        std::unique_ptr<GPUBuffer> pBuffer;  // アップロードヒープ
+        size_t size = 0;                     // バイト数
+    };
+
+    /// @brief ページの作成
+    bool CreatePage(size_t size, Page& outPage) const;
+
+    ID3D12Device* m_pDevice = nullptr;  // デバイス
+    std::vector<Page> m_pages;          // 先頭がメイン，以降は追加ページ
+    size_t m_offset    = 0;             // 末尾のページの使用済みバイト数
+    size_t m_usedBytes = 0;             // 全ページの使用済みバイト数
+
+    // コピー禁止
+    LinearUploadAllocator(const LinearUploadAllocator&)            = delete;
+    LinearUploadAllocator& operator=(const LinearUploadAllocator&) = delete;
+};
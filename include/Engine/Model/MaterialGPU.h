@@ -59,10 +59,14 @@ public:
     /// @brief SRVテーブルの先頭GPUハンドルを取得
     D3D12_GPU_DESCRIPTOR_HANDLE GetSrvTableBaseGPUHandle() const;
 
+    /// @brief 両面描画のマテリアルかどうか（裏面でも見える）
+    bool IsDoubleSided() const { return m_doubleSided; }
+
 private:
     ConstantBuffer m_constantBuffer;        // マテリアル定数
     shader::MaterialConstants m_constants;  // 定数バッファ用データ
     MaterialSrvTable m_srvTable;            // マテリアル用SRVテーブル
+    bool m_doubleSided;                     // 両面描画かどうか
 
     // テクスチャ
     TextureManager* m_pTextureManager;  // テクスチャマネージャ
@@ -7,6 +7,7 @@
 #include <d3d12.h>
 
 #include <memory>
+#include <vector>
 
 #include "Engine/Graphics/IndexBuffer.h"
 #include "Engine/Graphics/VertexBuffer.h"
@@ -25,6 +26,10 @@ public:
     bool Init(ID3D12Device* pDevice, DirectX::ResourceUploadBatch& batch,
         const MeshAsset& mesh);
 
+    /// @brief VB/IBの作成 batch版，データはbatchにコピーされるので参照でよい
+    bool Init(ID3D12Device* pDevice, DirectX::ResourceUploadBatch& batch,
+        const MeshView& mesh);
+
     void Term();
 
     /// @brief アップロード用バッファの破棄
@@ -53,11 +58,45 @@ public:
     /// @return マテリアルID
     uint32_t GetMaterialID() const { return m_MaterialID; }
 
+    /// @brief ローカル空間のAABBのgetter
+    /// @return インポート時に頂点座標から求めたAABB
+    const DirectX::BoundingBox& GetBounds() const { return m_Bounds; }
+
+    /// @brief 頂点フォーマットのgetter
+    /// @return 頂点バッファの形式，PSOの選択に使う
+    VertexFormat GetVertexFormat() const { return m_VertexFormat; }
+
+    /// @brief 圧縮した頂点の復元に使う値のgetter
+    /// @return Compactの場合にルート定数として渡す値
+    const VertexQuantization& GetQuantization() const { return m_Quantization; }
+
+    /// @brief メッシュレットのgetter
+    /// @return CPUでのカリングに使うメッシュレット（ないメッシュは空）
+    const std::vector<Meshlet>& GetMeshlets() const { return m_Meshlets; }
+
+    /// @brief メッシュレットのカリング用の値のgetter
+    const std::vector<MeshletBounds>& GetMeshletBounds() const {
+        return m_MeshletBounds;
+    }
+
+    /// @brief LODのgetter
+    /// @return 詳細度ごとのインデックスの範囲（LODのないメッシュも1つはある）
+    const std::vector<MeshLod>& GetLods() const { return m_Lods; }
+
 private:
+    /// @brief LODの範囲をコピーする
+    void SetLods(const MeshView& mesh);
+
     std::unique_ptr<VertexBuffer> m_pVB;
     std::unique_ptr<IndexBuffer> m_pIB;
     uint32_t m_MaterialID;
     uint32_t m_IndexCount;
+    DirectX::BoundingBox m_Bounds;
+    VertexFormat m_VertexFormat = VertexFormat::Standard;
+    VertexQuantization m_Quantization;
+    std::vector<Meshlet> m_Meshlets;
+    std::vector<MeshletBounds> m_MeshletBounds;
+    std::vector<MeshLod> m_Lods;
 
     // コピー禁止
     MeshGPU(const MeshGPU&)            = delete;
@@ -0,0 +1,38 @@
+/// @file Meshlet.h
+/// @brief メッシュを小さな三角形の集まりに分けたクラスタ
+
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <cstdint>
+
+/// @brief メッシュレット（クラスタ）
+/// インデックスバッファの連続した範囲を先頭から区切ったもので，
+/// 三角形の順番は元のインデックスバッファと同じ
+struct Meshlet {
+    /// @brief 1つのメッシュレットの頂点数の上限
+    static constexpr uint32_t kMaxVertices = 64;
+
+    /// @brief 1つのメッシュレットの三角形数の上限
+    static constexpr uint32_t kMaxTriangles = 124;
+
+    uint32_t vertexOffset;    // meshletVerticesの先頭位置
+    uint32_t triangleOffset;  // meshletTrianglesとインデックスの先頭位置
+    uint32_t vertexCount;     // 頂点数
+    uint32_t triangleCount;   // 三角形数
+};
+static_assert(sizeof(Meshlet) == 16, "Meshlet must be packed");
+
+/// @brief メッシュレットのカリングに使う値（ローカル空間）
+/// 法線錐は全ての三角形が裏を向く視点の範囲を表し，
+/// dot(normalize(coneApex - 視点), coneAxis) >= coneCutoff なら全て裏向き
+struct MeshletBounds {
+    DirectX::XMFLOAT3 center;    // 境界球の中心
+    float radius;                // 境界球の半径
+    DirectX::XMFLOAT3 coneApex;  // 法線錐の頂点
+    float coneCutoff;            // 法線錐の広がり角のsin，1以上なら判定しない
+    DirectX::XMFLOAT3 coneAxis;  // 法線錐の軸（三角形の表の向きの平均）
+    float _padding;
+};
+static_assert(sizeof(MeshletBounds) == 48, "MeshletBounds must be packed");
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include <vector>
 
 #include "Engine/Model/MaterialGPU.h"
@@ -19,6 +20,12 @@ public:
     bool Init(GraphicsDevice& graphicsDevice, TextureManager* pTextureManager,
         DirectX::ResourceUploadBatch& batch, const ModelAsset& modelAsset);
 
+    /// @brief 初期化，メッシュとマテリアルの参照からGPUリソースを作成
+    /// マテリアルのテクスチャハンドルは解決済みであること
+    bool Init(GraphicsDevice& graphicsDevice, TextureManager* pTextureManager,
+        DirectX::ResourceUploadBatch& batch, std::span<const MeshView> meshes,
+        std::span<const MaterialAsset> materials);
+
     /// @brief リソースの破棄
     void Term();
 
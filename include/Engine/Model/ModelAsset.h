@@ -2,23 +2,151 @@
 /// @brief CPUが扱うメッシュデータ
 #pragma once
 
+#include <DirectXCollision.h>
+#include <dxgiformat.h>
+
 #include <string>
 #include <vector>
 
+#include "Engine/Model/Meshlet.h"
 #include "Engine/Model/VertexTypes.h"
 
+/// @brief 詳細度（LOD）ごとのインデックスの範囲
+/// 全てのLODは同じ頂点を使い，描画するインデックスの範囲だけが異なる
+struct MeshLod {
+    uint32_t indexOffset;  // 先頭のインデックスの位置
+    uint32_t indexCount;   // インデックス数
+    float error;           // 元の形状からの誤差（ローカル空間の距離）
+};
+static_assert(sizeof(MeshLod) == 12, "MeshLod must be packed");
+
+/// @brief メッシュデータの参照（所有しない）
+/// MeshAssetや，マッピングした変換済みファイルの中を指す
+struct MeshView {
+    const void* pVertices     = nullptr;                 // 頂点データ
+    uint32_t vertexCount      = 0;                       // 頂点数
+    VertexFormat vertexFormat = VertexFormat::Standard;  // 頂点の形式
+    const void* pIndices      = nullptr;                 // インデックス
+    uint32_t indexCount       = 0;                       // インデックス数
+    DXGI_FORMAT indexFormat   = DXGI_FORMAT_R32_UINT;    // R16かR32
+    uint32_t materialID       = 0;                       // マテリアルID
+    DirectX::BoundingBox bounds;                         // ローカルAABB
+    VertexQuantization quantization;                     // Compactの復元値
+
+    const Meshlet* pMeshlets            = nullptr;  // メッシュレット
+    const MeshletBounds* pMeshletBounds = nullptr;  // カリング用の値
+    uint32_t meshletCount               = 0;        // メッシュレット数
+    const uint32_t* pMeshletVertices    = nullptr;  // メッシュの頂点番号
+    uint32_t meshletVertexCount         = 0;        // 頂点番号の数
+    const uint8_t* pMeshletTriangles    = nullptr;  // メッシュレット内の番号
+
+    const MeshLod* pLods = nullptr;  // 詳細度ごとのインデックスの範囲
+    uint32_t lodCount    = 0;        // LOD数（0なら全体が1段だけ）
+
+    /// @brief 1頂点のバイト数
+    uint32_t GetVertexStride() const { return ::GetVertexStride(vertexFormat); }
+
+    /// @brief インデックス1つのバイト数
+    uint32_t GetIndexSize() const {
+        return indexFormat == DXGI_FORMAT_R16_UINT ? 2 : 4;
+    }
+
+    /// @brief LOD0（元の形状）のインデックス数
+    uint32_t GetBaseIndexCount() const {
+        return lodCount > 0 ? pLods[0].indexCount : indexCount;
+    }
+};
+
 /// @brief CPU側メッシュデータ
+/// インポート中の処理はverticesとindicesで行い，最後に条件を満たせば
+/// compactVerticesとindices16へ移す（移した元は空になる）
+/// 簡略化したLODのインデックスはLOD0の後ろに続け，lodsで範囲を表す
+/// メッシュレットはLOD0だけに作り，meshletTrianglesはLOD0と同じ数で，
+/// meshletVertices[vertexOffset + meshletTriangles[i]]がi番目のインデックス
 struct MeshAsset {
-    std::vector<StandardVertex> vertices;  // 頂点データ
-    std::vector<uint32_t> indices;         // インデックスデータ
-    uint32_t materialID = 0;               // マテリアルID
+    std::vector<StandardVertex> vertices;        // 頂点データ
+    std::vector<CompactVertex> compactVertices;  // 圧縮した頂点データ
+    VertexQuantization quantization;             // 圧縮した頂点の復元値
+    std::vector<uint32_t> indices;               // インデックスデータ
+    std::vector<uint16_t> indices16;             // 16bitのインデックス
+    uint32_t materialID = 0;                     // マテリアルID
+    DirectX::BoundingBox bounds;                 // ローカル空間のAABB
+
+    std::vector<Meshlet> meshlets;             // メッシュレット
+    std::vector<MeshletBounds> meshletBounds;  // メッシュレットのカリング用の値
+    std::vector<uint32_t> meshletVertices;     // メッシュレットごとの頂点番号
+    std::vector<uint8_t> meshletTriangles;     // メッシュレット内の頂点番号
+
+    std::vector<MeshLod> lods;  // 詳細度ごとの範囲（空なら全体が1段だけ）
+
+    /// @brief メッシュレットを持つか
+    bool HasMeshlets() const { return !meshlets.empty(); }
+
+    /// @brief 圧縮した頂点を持つか
+    bool HasCompactVertices() const { return !compactVertices.empty(); }
+
+    /// @brief 16bitのインデックスを持つか
+    bool HasShortIndices() const { return !indices16.empty(); }
+
+    /// @brief 頂点数
+    uint32_t GetVertexCount() const {
+        return static_cast<uint32_t>(
+            HasCompactVertices() ? compactVertices.size() : vertices.size());
+    }
+
+    /// @brief インデックス数
+    uint32_t GetIndexCount() const {
+        return static_cast<uint32_t>(
+            HasShortIndices() ? indices16.size() : indices.size());
+    }
+
+    /// @brief LOD0（元の形状）のインデックス数
+    uint32_t GetBaseIndexCount() const {
+        return lods.empty() ? GetIndexCount() : lods[0].indexCount;
+    }
+
+    /// @brief このメッシュを指す参照
+    MeshView GetView() const {
+        MeshView view;
+        if (HasCompactVertices()) {
+            view.pVertices    = compactVertices.data();
+            view.vertexFormat = VertexFormat::Compact;
+        } else {
+            view.pVertices    = vertices.data();
+            view.vertexFormat = VertexFormat::Standard;
+        }
+        view.vertexCount = GetVertexCount();
+        if (HasShortIndices()) {
+            view.pIndices    = indices16.data();
+            view.indexFormat = DXGI_FORMAT_R16_UINT;
+        } else {
+            view.pIndices    = indices.data();
+            view.indexFormat = DXGI_FORMAT_R32_UINT;
+        }
+        view.indexCount   = GetIndexCount();
+        view.materialID   = materialID;
+        view.bounds       = bounds;
+        view.quantization = quantization;
+
+        view.pMeshlets          = meshlets.data();
+        view.pMeshletBounds     = meshletBounds.data();
+        view.meshletCount       = static_cast<uint32_t>(meshlets.size());
+        view.pMeshletVertices   = meshletVertices.data();
+        view.meshletVertexCount = static_cast<uint32_t>(meshletVertices.size());
+        view.pMeshletTriangles  = meshletTriangles.data();
+
+        view.pLods    = lods.data();
+        view.lodCount = static_cast<uint32_t>(lods.size());
+        return view;
+    }
 };
 
 /// @brief CPU側画像データ
 struct ImageAsset {
     std::vector<uint8_t> imageData;  // GLBの埋め込み画像データ
     std::string format;              // tex->achFormatの文字列，"jpg"や"png"など
-    bool isSRGB = false;             // sRGBとして扱うかどうか
+    bool isSRGB      = false;        // sRGBとして扱うかどうか
+    bool isNormalMap = false;        // 法線マップとして扱うかどうか
 
     bool IsValid() const { return !imageData.empty(); }
 };
@@ -43,6 +171,9 @@ struct MaterialAsset {
     DirectX::XMFLOAT3 emissiveFactor  = { 0.0f, 0.0f, 0.0f };
     float occlusionFactor             = 1.0f;
 
+    // 両面描画（glTFのdoubleSided），裏面のカリングをしない
+    bool doubleSided = false;
+
     // テクスチャへの参照（TextureManager内配列のインデックス）
     TextureHandle baseColorTexture;          // base color
     TextureHandle metallicRoughnessTexture;  // metallic-roughness
@@ -3,8 +3,16 @@
 #include <DirectXMath.h>
 #include <d3d12.h>
 
+#include <cstdint>
 #include <vector>
 
+/// @brief 頂点フォーマットの種類
+enum class VertexFormat : uint32_t {
+    Standard = 0,  // StandardVertex
+    Compact  = 1,  // CompactVertex
+    Count    = 2
+};
+
 /// @brief 基本の頂点フォーマット
 struct StandardVertex {
     DirectX::XMFLOAT3 position;  // 座標
@@ -31,4 +39,55 @@ struct StandardVertex {
                 D3D12_APPEND_ALIGNED_ELEMENT,
                 D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 } };
     }
-};
\ No newline at end of file
+};
+
+/// @brief 圧縮した頂点フォーマット
+/// 位置とUVはメッシュごとの範囲で正規化した16bit整数，
+/// 法線と接線は八面体写像で2成分にした16bit整数で持つ
+/// 頂点カラーは持たない（白以外の頂点カラーを持つメッシュはStandardのまま）
+struct CompactVertex {
+    uint16_t position[4];      // 範囲内の位置（UNORM），wは接空間の向き
+    int16_t normalTangent[4];  // 八面体写像した法線(xy)と接線(zw)（SNORM）
+    uint16_t texcoord[2];      // 範囲内のUV（UNORM）
+
+    /// @brief 頂点レイアウトの取得
+    static std::vector<D3D12_INPUT_ELEMENT_DESC> GetInputLayout() {
+        return { { "POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0,
+                     D3D12_APPEND_ALIGNED_ELEMENT,
+                     D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+            { "NORMAL", 0, DXGI_FORMAT_R16G16B16A16_SNORM, 0,
+                D3D12_APPEND_ALIGNED_ELEMENT,
+                D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+            { "TEXCOORD", 0, DXGI_FORMAT_R16G16_UNORM, 0,
+                D3D12_APPEND_ALIGNED_ELEMENT,
+                D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 } };
+    }
+};
+static_assert(sizeof(CompactVertex) == 20, "CompactVertex must be packed");
+
+/// @brief CompactVertexの復元に使うメッシュごとの値
+/// 復元した値 = offset + 正規化した値 * scale
+/// ルート定数としてそのまま渡すので，TestVS.hlslのMeshConstantsと並びを合わせる
+struct VertexQuantization {
+    DirectX::XMFLOAT3 positionOffset = { 0.0f, 0.0f, 0.0f };  // 位置の最小値
+    float _padding0                  = 0.0f;
+    DirectX::XMFLOAT3 positionScale  = { 1.0f, 1.0f, 1.0f };  // 位置の範囲
+    float _padding1                  = 0.0f;
+    DirectX::XMFLOAT2 texcoordOffset = { 0.0f, 0.0f };        // UVの最小値
+    DirectX::XMFLOAT2 texcoordScale  = { 1.0f, 1.0f };        // UVの範囲
+};
+static_assert(sizeof(VertexQuantization) == 48,
+    "Must be matched with shader struct size");
+
+/// @brief 頂点フォーマットごとの1頂点のバイト数
+inline uint32_t GetVertexStride(VertexFormat format) {
+    return format == VertexFormat::Compact ? sizeof(CompactVertex)
+                                           : sizeof(StandardVertex);
+}
+
+/// @brief 頂点フォーマットごとの頂点レイアウト
+inline std::vector<D3D12_INPUT_ELEMENT_DESC> GetInputLayout(
+    VertexFormat format) {
+    return format == VertexFormat::Compact ? CompactVertex::GetInputLayout()
+                                           : StandardVertex::GetInputLayout();
+}
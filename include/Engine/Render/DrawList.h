@@ -0,0 +1,179 @@
+/// @file DrawList.h
+/// @brief ソートキーで並べ替えてから記録する描画リスト
+
+#pragma once
+
+#include <d3d12.h>
+
+#include <cstdint>
+#include <vector>
+
+/// @brief 1回の描画に必要なバインド情報
+struct DrawPacket {
+    uint64_t sortKey;                          // DrawList::MakeSortKeyで作成
+    ID3D12PipelineState* pPSO;                 // パイプラインステート
+    D3D12_GPU_VIRTUAL_ADDRESS transformCB;     // ワールド行列CB（単体描画）
+    D3D12_GPU_VIRTUAL_ADDRESS instanceData;    // ワールド行列の列（インスタンス描画）
+    D3D12_GPU_VIRTUAL_ADDRESS materialCB;      // マテリアルCB
+    D3D12_GPU_DESCRIPTOR_HANDLE textureTable;  // PBRテクスチャのSRVテーブル
+    D3D12_VERTEX_BUFFER_VIEW vbv;              // 頂点バッファビュー
+    D3D12_INDEX_BUFFER_VIEW ibv;               // インデックスバッファビュー
+    uint32_t startIndex;                       // 先頭のインデックスの位置
+    uint32_t indexCount;                       // インデックス数
+    uint32_t instanceCount;                    // インスタンス数
+    const void* pMeshConstants;                // メッシュのルート定数（省略可）
+    uint32_t meshConstantCount;                // ルート定数の32bit値の数
+};
+
+/// @brief 記録時のバインド数の統計
+struct DrawListStats {
+    uint32_t bindsIssued = 0;  // 実際に発行したバインド数
+    uint32_t bindsElided = 0;  // 直前と同じため省略したバインド数
+    uint32_t drawCalls   = 0;  // 発行した描画コマンド数
+};
+
+/// @brief 描画リスト
+/// パケットをソートキーで並べ替え，直前と同じバインドを省略しながら記録する
+/// キーの上位から パイプライン(4) | マテリアル(24) | メッシュ(20) | 深度(16) bit
+/// キーは並び順を決めるだけで，省略の判定は実際のバインド値の比較で行う
+/// instanceDataが0でなければtransformCBの代わりにインスタンスの列をバインドする
+/// pMeshConstantsがnullでなければメッシュのルート定数を設定する
+class DrawList {
+public:
+    /// @brief ルートパラメータ番号（ルートシグネチャの並びに合わせる）
+    struct RootSlots {
+        uint32_t transformCB;    // ワールド行列CB
+        uint32_t instanceData;   // インスタンスごとのワールド行列のSRV
+        uint32_t materialCB;     // マテリアルCB
+        uint32_t textureTable;   // PBRテクスチャのSRVテーブル
+        uint32_t meshConstants;  // メッシュのルート定数
+    };
+
+    static constexpr uint32_t kPipelineBits = 4;
+    static constexpr uint32_t kMaterialBits = 24;
+    static constexpr uint32_t kMeshBits     = 20;
+    static constexpr uint32_t kDepthBits    = 16;
+
+    /// @brief ソートキーの作成，各値は上位ビットを切り捨てる
+    /// @param pipeline パイプラインの番号
+    /// @param material マテリアルの番号
+    /// @param mesh メッシュの番号
+    /// @param depth01 カメラからの距離を0～1に正規化した値（手前から描く）
+    static uint64_t MakeSortKey(
+        uint32_t pipeline, uint32_t material, uint32_t mesh, float depth01);
+
+    /// @brief パケットを全て破棄する
+    void Clear() {
+        m_packets.clear();
+        m_entries.clear();
+    }
+
+    /// @brief パケットの追加
+    void Add(const DrawPacket& packet) { m_packets.push_back(packet); }
+
+    /// @brief ソートキーの昇順に基数ソートする
+    void Sort();
+
+    /// @brief Sortした順に描画コマンドを記録する
+    /// ID3D12GraphicsCommandListと同じ名前のメンバ関数を持つ型なら記録できる
+    /// @param pCmdList 記録先
+    /// @param slots ルートパラメータ番号
+    /// @param stats バインド数の加算先
+    template <typename CommandList>
+    void Record(CommandList* pCmdList, const RootSlots& slots,
+        DrawListStats& stats) const;
+
+    /// @brief パケット数
+    uint32_t Size() const { return static_cast<uint32_t>(m_packets.size()); }
+
+private:
+    /// @brief ソート用のキーとパケット番号の組
+    struct SortEntry {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    std::vector<DrawPacket> m_packets;  // 追加順のパケット
+    std::vector<SortEntry> m_entries;   // ソート結果
+    std::vector<SortEntry> m_scratch;   // 基数ソートの作業領域
+};
+
+//==============================================================
+// テンプレートの実装
+//==============================================================
+template <typename CommandList>
+void DrawList::Record(CommandList* pCmdList, const RootSlots& slots,
+    DrawListStats& stats) const {
+    // 値が変わったときだけバインドする
+    auto bind = [&stats](bool changed, auto&& setter) {
+        if (changed) {
+            setter();
+            stats.bindsIssued++;
+        } else {
+            stats.bindsElided++;
+        }
+    };
+
+    // 最後にバインドした値，ルート引数は描画をまたいで保持される
+    // 最初の描画は必ずバインドするように，先頭は直前の値がないものとして扱う
+    const DrawPacket* pPrev                  = nullptr;
+    D3D12_GPU_VIRTUAL_ADDRESS boundTransform = 0;
+    D3D12_GPU_VIRTUAL_ADDRESS boundInstances = 0;
+    const void* pBoundMeshConstants          = nullptr;
+
+    for (const SortEntry& entry : m_entries) {
+        const DrawPacket& packet = m_packets[entry.index];
+
+        bind(!pPrev || packet.pPSO != pPrev->pPSO,
+            [&] { pCmdList->SetPipelineState(packet.pPSO); });
+
+        if (packet.instanceData != 0) {
+            bind(packet.instanceData != boundInstances, [&] {
+                pCmdList->SetGraphicsRootShaderResourceView(
+                    slots.instanceData, packet.instanceData);
+            });
+            boundInstances = packet.instanceData;
+        } else {
+            bind(packet.transformCB != boundTransform, [&] {
+                pCmdList->SetGraphicsRootConstantBufferView(
+                    slots.transformCB, packet.transformCB);
+            });
+            boundTransform = packet.transformCB;
+        }
+
+        bind(!pPrev || packet.materialCB != pPrev->materialCB, [&] {
+            pCmdList->SetGraphicsRootConstantBufferView(
+                slots.materialCB, packet.materialCB);
+        });
+
+        bind(!pPrev || packet.textureTable.ptr != pPrev->textureTable.ptr,
+            [&] {
+                pCmdList->SetGraphicsRootDescriptorTable(
+                    slots.textureTable, packet.textureTable);
+            });
+
+        bind(!pPrev || packet.vbv.BufferLocation != pPrev->vbv.BufferLocation ||
+                 packet.vbv.SizeInBytes != pPrev->vbv.SizeInBytes ||
+                 packet.vbv.StrideInBytes != pPrev->vbv.StrideInBytes,
+            [&] { pCmdList->IASetVertexBuffers(0, 1, &packet.vbv); });
+
+        bind(!pPrev || packet.ibv.BufferLocation != pPrev->ibv.BufferLocation ||
+                 packet.ibv.SizeInBytes != pPrev->ibv.SizeInBytes ||
+                 packet.ibv.Format != pPrev->ibv.Format,
+            [&] { pCmdList->IASetIndexBuffer(&packet.ibv); });
+
+        // 使わないパケットでは前の値を残したままにする
+        if (packet.pMeshConstants != nullptr) {
+            bind(packet.pMeshConstants != pBoundMeshConstants, [&] {
+                pCmdList->SetGraphicsRoot32BitConstants(slots.meshConstants,
+                    packet.meshConstantCount, packet.pMeshConstants, 0);
+            });
+            pBoundMeshConstants = packet.pMeshConstants;
+        }
+
+        pCmdList->DrawIndexedInstanced(
+            packet.indexCount, packet.instanceCount, packet.startIndex, 0, 0);
+        stats.drawCalls++;
+        pPrev = &packet;
+    }
+}
@@ -0,0 +1,60 @@
+/// @file FrustumCuller.h
+/// @brief 視錐台とAABBの交差判定による描画対象の選別
+
+#pragma once
+
+#include <DirectXCollision.h>
+#include <DirectXMath.h>
+
+#include <cstdint>
+#include <vector>
+
+/// @brief 視錐台カリング
+/// 登録したバウンディングボックスをワールド空間のAABBに変換して
+/// 中心・半径の成分ごとの配列に詰め，4個ずつSIMDで6平面と判定する
+class FrustumCuller {
+public:
+    static constexpr uint32_t kPlaneCount = 6;
+
+    FrustumCuller() = default;
+
+    /// @brief 登録したバウンディングボックスを全て破棄する
+    void Clear();
+
+    /// @brief ビュー射影行列から視錐台の6平面を求める
+    /// @param viewProj ビュー行列 * 射影行列（行ベクトル規約，深度0～1）
+    void SetViewProjection(const DirectX::XMMATRIX& viewProj);
+
+    /// @brief ローカル空間のバウンディングボックスを登録する
+    /// @param localBounds ローカル空間のAABB
+    /// @param world ワールド行列
+    /// @return 登録番号（Cullの結果に使われる番号）
+    uint32_t Add(const DirectX::BoundingBox& localBounds,
+        const DirectX::XMMATRIX& world);
+
+    /// @brief 視錐台と交差する登録番号を昇順に列挙する
+    /// @return 見えている登録番号の列，次のClearまで有効
+    const std::vector<uint32_t>& Cull();
+
+    /// @brief 登録数
+    uint32_t Size() const { return m_count; }
+
+    /// @brief 視錐台の平面（内向き法線，正規化済み）
+    const DirectX::XMFLOAT4& GetPlane(uint32_t index) const {
+        return m_planes[index];
+    }
+
+private:
+    DirectX::XMFLOAT4 m_planes[kPlaneCount] = {};  // 内向き法線の平面
+
+    // ワールド空間のAABB（成分ごとの配列，4の倍数まで詰め物をする）
+    std::vector<float> m_centerX;
+    std::vector<float> m_centerY;
+    std::vector<float> m_centerZ;
+    std::vector<float> m_extentX;
+    std::vector<float> m_extentY;
+    std::vector<float> m_extentZ;
+    uint32_t m_count = 0;  // 登録数
+
+    std::vector<uint32_t> m_visible;  // 判定結果
+};
@@ -0,0 +1,78 @@
+/// @file InstanceBatcher.h
+/// @brief 同じメッシュを使う描画をまとめてインスタンス描画にする
+
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Engine/Shader/ShaderConstants.h"
+
+// 前方宣言
+class JobSystem;
+
+/// @brief インスタンス描画のグループ分けとワールド行列の詰め込み
+/// 描画要素をメッシュのキーでまとめ，一定数以上集まったグループは
+/// ワールド行列をインスタンスバッファに連続して書き込む
+/// GPUリソースには触らないので，描画とは独立に動作を確認できる
+class InstanceBatcher {
+public:
+    /// @brief 描画要素
+    struct Entry {
+        uint64_t key;        // まとめる単位（モデルとメッシュの組）
+        uint32_t itemIndex;  // 呼び出し側の描画要素の番号
+        uint32_t dataIndex;  // ワールド行列の列のインデックス
+    };
+
+    /// @brief 1回の描画にまとめたグループ
+    struct Group {
+        uint32_t firstEntry;     // GetEntriesでの先頭位置
+        uint32_t entryCount;     // 要素数
+        uint32_t firstInstance;  // インスタンスバッファの先頭位置，
+                                 // インスタンス描画しない場合はkNotInstanced
+    };
+
+    static constexpr uint32_t kNotInstanced = UINT32_MAX;
+
+    /// @brief 描画要素を全て破棄する
+    void Clear();
+
+    /// @brief 描画要素の追加
+    void Add(uint64_t key, uint32_t itemIndex, uint32_t dataIndex);
+
+    /// @brief キーでまとめてグループを作り，ワールド行列を詰め込む
+    /// minInstances未満のグループや容量に収まらないグループは
+    /// 要素ごとに1グループとして扱う
+    /// @param minInstances インスタンス描画にする最小の要素数
+    /// @param worlds ワールド行列の列
+    /// @param worldInverses ワールド逆行列の列
+    /// @param pOut インスタンスバッファの書き込み先
+    /// @param capacity 書き込み先の最大要素数
+    /// @param pJobSystem 行列の書き込みを分割して並列に行う（nullptrなら逐次）
+    void Build(uint32_t minInstances,
+        std::span<const DirectX::XMFLOAT4X4> worlds,
+        std::span<const DirectX::XMFLOAT4X4> worldInverses,
+        shader::TransformConstants* pOut, uint32_t capacity,
+        JobSystem* pJobSystem = nullptr);
+
+    //========================================
+    // アクセサ
+    //========================================
+    /// @brief キー順に並べた描画要素
+    const std::vector<Entry>& GetEntries() const { return m_entries; }
+
+    /// @brief 作成したグループ（1グループが1回の描画になる）
+    const std::vector<Group>& GetGroups() const { return m_groups; }
+
+    /// @brief インスタンスバッファに書き込んだ要素数
+    uint32_t GetInstanceCount() const { return m_instanceCount; }
+
+private:
+    std::vector<Entry> m_entries;             // 描画要素
+    std::vector<Group> m_groups;              // グループ
+    std::vector<uint32_t> m_instanceEntries;  // インスタンスごとの要素の位置
+    uint32_t m_instanceCount = 0;             // 書き込んだインスタンス数
+};
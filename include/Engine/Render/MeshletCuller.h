@@ -0,0 +1,74 @@
+/// @file MeshletCuller.h
+/// @brief メッシュレット単位の視錐台・法線錐カリング
+
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Model/Meshlet.h"
+#include "Engine/Render/FrustumCuller.h"
+
+/// @brief メッシュレットのカリング
+/// 視錐台の平面と視点をメッシュのローカル空間に移し，
+/// 境界球と視錐台，法線錐と視点をメッシュレットごとに判定する
+/// メッシュレットはインデックスの連続した範囲なので，
+/// 見えるメッシュレットの並びをそのまま描画するインデックスの範囲にする
+class MeshletCuller {
+public:
+    /// @brief 1メッシュあたりの描画範囲の上限
+    /// 超えた場合は最初から最後の見える範囲までをまとめて描く
+    static constexpr uint32_t kMaxRangesPerMesh = 8;
+
+    /// @brief 描画するインデックスの範囲
+    struct IndexRange {
+        uint32_t startIndex;  // 先頭のインデックスの位置
+        uint32_t indexCount;  // インデックス数
+    };
+
+    /// @brief 判定結果の統計（ResetStatsまでの合計）
+    struct Stats {
+        uint32_t meshletsTested  = 0;  // 判定したメッシュレット数
+        uint32_t meshletsCulled  = 0;  // 見えないと判定したメッシュレット数
+        uint32_t trianglesTested = 0;  // 判定したメッシュの三角形数
+        uint32_t trianglesCulled = 0;  // 描画を省略した三角形数
+    };
+
+    MeshletCuller() = default;
+
+    /// @brief 判定に使う視錐台と視点を設定する
+    /// @param frustum SetViewProjection済みの視錐台
+    /// @param cameraPos ワールド空間の視点
+    void SetView(
+        const FrustumCuller& frustum, const DirectX::XMFLOAT3& cameraPos);
+
+    /// @brief 1つのメッシュのメッシュレットを判定する
+    /// @param pMeshlets メッシュレットの配列
+    /// @param pBounds メッシュレットのカリング用の値の配列
+    /// @param count メッシュレット数
+    /// @param world ワールド行列
+    /// @param worldInv ワールド行列の逆行列
+    /// @param cullBackFaces 法線錐で裏向きのメッシュレットを省くかどうか
+    /// 両面描画のマテリアルでは裏面も見えるのでfalseにする
+    /// @return 描画する範囲の昇順の列（空なら描画しない），次のCullまで有効
+    const std::vector<IndexRange>& Cull(const Meshlet* pMeshlets,
+        const MeshletBounds* pBounds, uint32_t count,
+        const DirectX::XMMATRIX& world, const DirectX::XMMATRIX& worldInv,
+        bool cullBackFaces);
+
+    /// @brief 統計の取得
+    const Stats& GetStats() const { return m_stats; }
+
+    /// @brief 統計を0に戻す
+    void ResetStats() { m_stats = Stats{}; }
+
+private:
+    // ワールド空間の視錐台の平面
+    DirectX::XMFLOAT4 m_planes[FrustumCuller::kPlaneCount] = {};
+    DirectX::XMFLOAT3 m_cameraPos = { 0.0f, 0.0f, 0.0f };  // ワールド空間の視点
+
+    std::vector<IndexRange> m_ranges;  // 判定結果
+    Stats m_stats;                     // 判定結果の統計
+};
@@ -7,20 +7,25 @@
 
 #include <cstdint>
 
+class LinearUploadAllocator;
+
 struct ScenePassBindings {
-    ID3D12GraphicsCommandList* pCmdList;   // コマンドリスト
-    uint32_t frameIndex;                   // フレーム番号
-    ID3D12DescriptorHeap* pCbvSrvUavHeap;  // CBV/SRV/UAV用ディスクリプタヒープ
-    D3D12_GPU_VIRTUAL_ADDRESS sceneCB;     // b0 シーンCBのGPUアドレス
-    D3D12_GPU_VIRTUAL_ADDRESS displayCB;   // b3  ディスプレイCBのGPUアドレス
-    D3D12_GPU_DESCRIPTOR_HANDLE iesSRV;    // t0, space1 iesSRV
-    D3D12_GPU_DESCRIPTOR_HANDLE lightSRV;  // t0, space2 ライトバッファのSRV
+    ID3D12GraphicsCommandList* pCmdList;      // コマンドリスト
+    uint32_t frameIndex;                      // フレーム番号
+    ID3D12DescriptorHeap* pCbvSrvUavHeap;     // CBV/SRV/UAV用ディスクリプタヒープ
+    D3D12_GPU_VIRTUAL_ADDRESS sceneCB;        // b0 シーンCBのGPUアドレス
+    D3D12_GPU_VIRTUAL_ADDRESS displayCB;      // b3  ディスプレイCBのGPUアドレス
+    D3D12_GPU_DESCRIPTOR_HANDLE iesSRV;       // t0, space1 iesSRV
+    D3D12_GPU_DESCRIPTOR_HANDLE lightSRV;     // t0, space2 ライトバッファのSRV
+    LinearUploadAllocator* pUploadAllocator;  // b1, t0 space3 行列の書き込み先
+    uint32_t viewportHeight;                  // 描画先の高さ（LODの選択に使う）
 
     /// @brief 初期化漏れを検出するためのチェック
     bool IsValid() const {
         return pCmdList != nullptr && pCbvSrvUavHeap != nullptr &&
                sceneCB != 0 && displayCB != 0 && iesSRV.ptr != 0 &&
-               lightSRV.ptr != 0;
+               lightSRV.ptr != 0 && pUploadAllocator != nullptr &&
+               viewportHeight > 0;
     }
 };
 
@@ -0,0 +1,33 @@
+/// @file RenderStats.h
+/// @brief フレームごとの描画統計
+
+#pragma once
+
+#include <cstdint>
+
+/// @brief 1フレーム分の描画統計，DebugUIのStatsパネルに表示する
+struct RenderStats {
+    uint32_t transformsUpdated = 0;  // ワールド行列を再計算したオブジェクト数
+    uint32_t transformsSkipped = 0;  // 変更がなく再計算を省略したオブジェクト数
+
+    uint32_t transformsUploaded = 0;  // アップロード領域に書き込んだワールド行列数
+    uint32_t uploadBytes        = 0;  // アップロード領域から割り当てたバイト数
+    uint32_t uploadCapacity     = 0;  // アップロード領域のバイト数
+
+    uint32_t meshesSubmitted = 0;  // 視錐台カリングを通過し描画したメッシュ数
+    uint32_t meshesCulled    = 0;  // 視錐台の外にあり描画を省略したメッシュ数
+    float cullTimeMs         = 0.0f;  // カリングに掛かった時間（ミリ秒）
+
+    uint32_t meshletsCulled  = 0;  // 描画を省略したメッシュレット数
+    uint32_t trianglesTested = 0;  // メッシュレット単位で判定した三角形数
+    uint32_t trianglesCulled = 0;  // メッシュレット単位で省略した三角形数
+
+    uint32_t lodMeshes         = 0;  // 簡略化したLODで描画したメッシュ数
+    uint32_t lodTrianglesSaved = 0;  // LODの選択で減らした三角形数
+
+    uint32_t bindsIssued = 0;  // シーン描画で発行したPSO・ルート引数・IAのバインド数
+    uint32_t bindsElided = 0;  // 直前と同じため省略したバインド数
+
+    uint32_t drawCalls = 0;  // シーン描画で発行した描画コマンド数
+    uint32_t instances = 0;  // インスタンス描画にまとめたメッシュ数
+};
@@ -10,6 +10,7 @@
 #include "Engine/Graphics/ColorTarget.h"
 #include "Engine/Graphics/DepthTarget.h"
 #include "Engine/Render/PassBindings.h"
+#include "Engine/Render/RenderStats.h"
 #include "Engine/Render/SwapChain.h"
 #include "Engine/Shader/DisplayConstantsGPU.h"
 
@@ -100,6 +101,10 @@ public:
     /// @brief コマンドリスト
     ID3D12GraphicsCommandList* GetCommandList() { return m_pCmdList.Get(); }
 
+    /// @brief 直近のフレームの描画統計
+    const RenderStats& GetStats() const { return m_stats; }
+    RenderStats& GetStats() { return m_stats; }
+
 private:
     engine::ComPtr<ID3D12GraphicsCommandList> m_pCmdList;  // コマンドリスト
 
@@ -114,6 +119,8 @@ private:
     DisplayConstantsGPU m_displayConstantsGPU;  // ディスプレイCB
     HWND m_hWnd = nullptr;                      // ウィンドウハンドル
 
+    RenderStats m_stats;  // 描画統計
+
     // コピー禁止
     Renderer(const Renderer&)            = delete;
     Renderer& operator=(const Renderer&) = delete;
@@ -5,12 +5,22 @@
 
 #include <d3d12.h>
 
+#include <cstdint>
+#include <vector>
+
 #include "Engine/Core/ComPtr.h"
+#include "Engine/Model/VertexTypes.h"
+#include "Engine/Render/DrawList.h"
+#include "Engine/Render/FrustumCuller.h"
+#include "Engine/Render/InstanceBatcher.h"
+#include "Engine/Render/MeshletCuller.h"
 
 // 前方宣言
 struct ScenePassBindings;
 class GraphicsDevice;
 class Scene;
+struct RenderStats;
+class JobSystem;
 
 class ScenePass {
 public:
@@ -26,7 +36,14 @@ public:
     void Term();
 
     /// @brief 描画コマンドの記録
-    void Draw(const ScenePassBindings& passBindings, Scene& scene);
+    /// 視錐台の外にあるメッシュは描画せず，画面上の誤差からLODを選び，
+    /// 同じメッシュとLODはインスタンス描画にまとめ，
+    /// 単体描画は見えるメッシュレットの範囲だけにして，
+    /// バインドが減る順に並べて記録する
+    /// @param stats カリング結果の書き込み先
+    /// @param jobSystem インスタンスの行列の書き込みを分割して並列に行う
+    void Draw(const ScenePassBindings& passBindings, Scene& scene,
+        RenderStats& stats, JobSystem& jobSystem);
 
 private:
     // ルートシグネチャ内でのルートパラメータ番号
@@ -39,10 +56,32 @@ private:
         SRV_Texture    = 4,  // t0-t4
         SRV_IESProfile = 5,  // t0, space1
         SRV_Lights     = 6,  // t0, space2
+        SRV_Instances  = 7,  // t0, space3
+        CONST_Mesh     = 8,  // b4
+    };
+
+    /// @brief 頂点フォーマットの数（PSOの数）
+    static constexpr size_t kVertexFormatCount =
+        static_cast<size_t>(VertexFormat::Count);
+
+    /// @brief カリング対象の1メッシュ
+    struct DrawItem {
+        uint32_t dataIndex;     // オブジェクトのデータインデックス
+        uint32_t meshIndex;     // モデル内のメッシュ番号
+        uint32_t lodIndex = 0;  // 選んだLOD（見えるものだけ毎フレーム選ぶ）
     };
 
     GraphicsDevice* m_pDevice = nullptr;
 
+    FrustumCuller m_culler;             // 視錐台カリング
+    MeshletCuller m_meshletCuller;      // メッシュレット単位のカリング
+    std::vector<DrawItem> m_drawItems;  // カリングの登録番号と対応するメッシュ
+    InstanceBatcher m_batcher;          // インスタンス描画のグループ分け
+    DrawList m_drawList;                // ソートして記録する描画リスト
+
     engine::ComPtr<ID3D12RootSignature> m_pRootSignature;  // ルートシグネチャ
-    engine::ComPtr<ID3D12PipelineState> m_pPSO;  // パイプラインステート
+    // 頂点フォーマットごとのパイプラインステート
+    engine::ComPtr<ID3D12PipelineState> m_pPSO[kVertexFormatCount];
+    // 頂点フォーマットごとのインスタンス描画用のパイプラインステート
+    engine::ComPtr<ID3D12PipelineState> m_pInstancedPSO[kVertexFormatCount];
 };
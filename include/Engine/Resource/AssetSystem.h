@@ -3,6 +3,11 @@
 
 #pragma once
 
+#include <filesystem>
+
+#include "Engine/Core/GenHandle.h"
+#include "Engine/Resource/AsyncModelLoader.h"
+#include "Engine/Resource/DerivedDataCache.h"
 #include "Engine/Resource/IESProfile.h"
 #include "Engine/Resource/ModelLoader.h"
 #include "Engine/Resource/TextureManager.h"
@@ -10,6 +15,7 @@
 // 前方宣言
 class GraphicsDevice;
 class AssetLoadScope;
+class JobSystem;
 class Scene;
 
 class AssetSystem {
@@ -18,7 +24,8 @@ public:
     ~AssetSystem() = default;
 
     /// @brief 初期化
-    bool Init(GraphicsDevice& graphicsDevice);
+    /// @param jobSystem 非同期ロードとインポート中の並列処理の実行先
+    bool Init(GraphicsDevice& graphicsDevice, JobSystem& jobSystem);
 
     /// @brief 終了処理
     void Term();
@@ -29,15 +36,25 @@ public:
     /// @return AssetLoadScope
     AssetLoadScope CreateAssetLoadScope(Scene& scene);
 
+    /// @brief モデルの非同期ロードを開始する
+    /// @return 空のモデルのハンドル，転送が完了した時点でモデルが設定される
+    engine::ModelHandle LoadModelAsync(const std::filesystem::path& path,
+        Scene& scene, AsyncModelLoader::Callback callback = nullptr);
+
+    /// @brief フレームごとの処理，非同期ロードの進行
+    void Update(Scene& scene) { m_asyncModelLoader.Update(scene); }
+
     /// @brief IESプロファイルのSRVハンドル
     D3D12_GPU_DESCRIPTOR_HANDLE GetIesSrvGpuHandle() const {
         return m_iesProfile.GetSrvGpuHandle();
     }
 
 private:
+    DerivedDataCache m_derivedDataCache;
     TextureManager m_textureManager;
     ModelLoader m_modelLoader;
     IESProfile m_iesProfile;
+    AsyncModelLoader m_asyncModelLoader;
 
     GraphicsDevice* m_pGraphicsDevice = nullptr;
 };
@@ -0,0 +1,112 @@
+/// @file AsyncModelLoader.h
+/// @brief ワーカースレッドとコピーキューを使ったモデルの非同期ロード
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "Engine/Core/CommandQueue.h"
+#include "Engine/Core/GenHandle.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Resource/ModelLoader.h"
+
+// 前方宣言
+class GraphicsDevice;
+class Model;
+class Scene;
+
+/// @brief モデルの非同期ロード
+/// Loadはシーンに空のモデルのスロットを確保し，すぐにハンドルを返す
+/// 1. GLBの解析と画像のデコード・ミップ生成をワーカースレッドで行う
+///    変換済みモデル（.mdlかキャッシュ）はマッピングと検証だけを行う
+/// 2. CPU側が終わったものはUpdateでGPUリソースを作成し，
+///    フレームごとに1つのbatchにまとめてコピーキューで転送する
+/// 3. コピーキューのフェンスが完了したものをシーンに設定し，
+///    メインスレッドで完了コールバックを呼ぶ
+/// 設定されるまでGetModelはnullptrを返すので，そのモデルは描画されない
+class AsyncModelLoader {
+public:
+    /// @brief 完了コールバック，メインスレッドのUpdate内で呼ばれる
+    /// @param handle Loadが返したハンドル
+    /// @param succeeded 失敗した場合，ハンドルはシーンから外されている
+    using Callback =
+        std::function<void(engine::ModelHandle handle, bool succeeded)>;
+
+    AsyncModelLoader();
+    ~AsyncModelLoader();
+
+    /// @brief 初期化，コピーキューの作成
+    bool Init(GraphicsDevice& graphicsDevice, ModelLoader& modelLoader,
+        JobSystem& jobSystem);
+
+    /// @brief 終了処理，ロード中のものは完了を待って破棄する
+    void Term();
+
+    /// @brief モデルの非同期ロードを開始する
+    /// @param path GLBまたは変換済みモデルのファイルパス
+    /// @param scene 登録先のシーン
+    /// @param callback 完了コールバック（省略可）
+    /// @return 空のモデルのハンドル
+    engine::ModelHandle Load(const std::filesystem::path& path, Scene& scene,
+        Callback callback = nullptr);
+
+    /// @brief フレームごとの処理，転送の開始と完了したモデルの登録
+    void Update(Scene& scene);
+
+    /// @brief ロード中のモデルの数
+    size_t GetPendingCount() const { return m_requests.size(); }
+
+private:
+    /// @brief ロード中のモデル1つ分
+    struct Request {
+        engine::ModelHandle handle;  // シーン内のハンドル
+        std::filesystem::path path;  // ファイルパス
+        Callback callback;           // 完了コールバック
+
+        // ワーカースレッドが書き込み，decodedで公開する
+        ModelSource source;                  // CPU側の読み込み結果
+        bool succeeded = false;              // CPU側の読み込みの結果
+        std::atomic<bool> decoded{ false };  // CPU側の処理の完了
+
+        // メインスレッドだけが触る
+        std::unique_ptr<Model> pModel;  // 転送中のモデル
+        uint64_t fenceValue = 0;        // 転送の完了で到達するフェンス値
+    };
+
+    /// @brief コピーキューに送った転送
+    struct PendingUpload {
+        uint64_t fenceValue;       // 完了で到達するフェンス値
+        std::future<void> future;  // batchの後始末（完了前に破棄すると待つ）
+    };
+
+    /// @brief CPU側が終わったものの転送を開始する
+    /// @param[out] finished 失敗して終えたものの追加先
+    void SubmitUploads(
+        Scene& scene, std::vector<std::unique_ptr<Request>>& finished);
+
+    /// @brief 転送が完了したものをシーンに設定する
+    /// @param[out] finished 終えたものの追加先
+    void ResolveUploads(
+        Scene& scene, std::vector<std::unique_ptr<Request>>& finished);
+
+    GraphicsDevice* m_pGraphicsDevice = nullptr;  // デバイス
+    ModelLoader* m_pModelLoader       = nullptr;  // GPUリソースの作成
+    JobSystem* m_pJobSystem           = nullptr;  // CPU側の処理の実行先
+
+    CommandQueue m_copyQueue;    // 転送専用のコピーキュー
+    JobCounter m_decodeCounter;  // 実行中のCPU側の処理
+
+    std::vector<std::unique_ptr<Request>> m_requests;  // ロード中（古い順）
+    std::deque<PendingUpload> m_uploads;               // 転送中のbatch
+
+    // コピー禁止
+    AsyncModelLoader(const AsyncModelLoader&)            = delete;
+    AsyncModelLoader& operator=(const AsyncModelLoader&) = delete;
+};
@@ -0,0 +1,193 @@
+/// @file CookedModel.h
+/// @brief 変換済みモデル（.mdl）のファイル形式と読み書き
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include "Engine/Model/ModelAsset.h"
+
+/// @brief 変換済みモデルのファイル形式
+/// ヘッダ，各テーブル，頂点・インデックス・テクスチャのデータを
+/// kDataAlignmentに揃えた位置に並べる
+/// ファイルをマッピングしたまま，データをGPUへの転送元として直接使える
+/// オフセットは全てファイル先頭からのバイト数
+namespace cooked {
+constexpr uint32_t kMagic         = 0x314C444D;  // "MDL1"
+constexpr uint32_t kVersion       = 6;           // 形式を変えたら増やす
+constexpr uint64_t kDataAlignment = 256;         // データの先頭位置の揃え
+constexpr int32_t kNoTexture      = -1;          // テクスチャなし
+
+/// @brief ファイルヘッダ
+struct FileHeader {
+    uint32_t magic;                // kMagic
+    uint32_t version;              // kVersion
+    uint32_t meshCount;            // メッシュ数
+    uint32_t materialCount;        // マテリアル数
+    uint32_t textureCount;         // テクスチャ数
+    uint32_t vertexStride;         // StandardVertexのバイト数
+    uint64_t meshTableOffset;      // MeshRecordの配列
+    uint64_t materialTableOffset;  // MaterialRecordの配列
+    uint64_t textureTableOffset;   // TextureRecordの配列
+    uint64_t fileSize;             // ファイル全体のバイト数
+};
+
+/// @brief メッシュ
+struct MeshRecord {
+    uint64_t vertexOffset;    // vertexFormatの頂点の配列
+    uint64_t indexOffset;     // uint16_tかuint32_tの配列
+    uint32_t vertexCount;     // 頂点数
+    uint32_t indexCount;      // インデックス数
+    uint32_t materialID;      // マテリアルID
+    float boundsCenter[3];    // ローカル空間のAABBの中心
+    float boundsExtents[3];   // ローカル空間のAABBの半径
+    uint32_t indexSize;       // インデックス1つのバイト数（2か4）
+    uint32_t vertexFormat;    // VertexFormatの値
+    float positionOffset[3];  // Compactの位置の最小値
+    float positionScale[3];   // Compactの位置の範囲
+    float texcoordOffset[2];  // CompactのUVの最小値
+    float texcoordScale[2];   // CompactのUVの範囲
+
+    // メッシュレットとLOD（ないメッシュは数が0）
+    uint32_t meshletCount;           // メッシュレット数
+    uint32_t meshletVertexCount;     // メッシュレットの頂点番号の数
+    uint32_t lodCount;               // LOD数（0ならインデックス全体が1段）
+    uint64_t meshletOffset;          // Meshletの配列
+    uint64_t meshletBoundsOffset;    // MeshletBoundsの配列
+    uint64_t meshletVertexOffset;    // uint32_tの頂点番号の配列
+    uint64_t meshletTriangleOffset;  // uint8_tの番号の配列（LOD0の分）
+    uint64_t lodOffset;              // MeshLodの配列
+};
+
+/// @brief マテリアル（名前は保存しない）
+struct MaterialRecord {
+    float baseColorFactor[4];
+    float metallicFactor;
+    float roughnessFactor;
+    float emissiveFactor[3];
+    float occlusionFactor;
+
+    // テクスチャ番号（TextureRecordの配列のインデックス）
+    int32_t baseColorTexture;
+    int32_t metallicRoughnessTexture;
+    int32_t occlusionTexture;
+    int32_t normalTexture;
+    int32_t emissiveTexture;
+
+    uint32_t doubleSided;  // 0以外なら両面描画
+};
+
+/// @brief テクスチャ（ミップ生成済み）
+struct TextureRecord {
+    uint32_t width;                   // 幅
+    uint32_t height;                  // 高さ
+    uint32_t format;                  // DXGI_FORMAT
+    uint32_t mipLevels;               // ミップレベル数
+    uint32_t isSRGB;                  // sRGBとしてSRVを作るかどうか
+    uint32_t subresourceCount;        // 0ならデコードに失敗した画像
+    uint64_t subresourceTableOffset;  // SubresourceRecordの配列
+};
+
+/// @brief テクスチャのサブリソース（ミップ順）
+struct SubresourceRecord {
+    uint64_t dataOffset;  // ピクセルデータ
+    uint64_t rowPitch;    // 1行のバイト数
+    uint64_t slicePitch;  // 1枚のバイト数
+};
+
+// 読み書きで構造体の配置が変わらないことの確認
+static_assert(sizeof(FileHeader) == 56);
+static_assert(sizeof(MeshRecord) == 152);
+static_assert(sizeof(MaterialRecord) == 64);
+static_assert(sizeof(TextureRecord) == 32);
+static_assert(sizeof(SubresourceRecord) == 24);
+}  // namespace cooked
+
+/// @brief 書き出すテクスチャのサブリソース
+struct CookedSubresourceSource {
+    const void* pData   = nullptr;  // ピクセルデータ
+    uint64_t rowPitch   = 0;        // 1行のバイト数
+    uint64_t slicePitch = 0;        // 1枚のバイト数
+};
+
+/// @brief 書き出すテクスチャ，subresourcesが空ならデコードに失敗した画像
+struct CookedTextureSource {
+    uint32_t width     = 0;
+    uint32_t height    = 0;
+    uint32_t format    = 0;  // DXGI_FORMAT
+    uint32_t mipLevels = 0;
+    bool isSRGB        = false;
+    std::vector<CookedSubresourceSource> subresources;  // ミップ順
+};
+
+/// @brief 変換済みモデルの書き出し
+class CookedModelWriter {
+public:
+    CookedModelWriter()  = delete;
+    ~CookedModelWriter() = delete;
+
+    /// @brief ModelAssetとデコード済みのテクスチャを書き出す
+    /// @param path 出力先
+    /// @param modelAsset メッシュとマテリアル
+    /// @param textures modelAsset.imagesと同じ並びのテクスチャ
+    static bool Write(const std::filesystem::path& path,
+        const ModelAsset& modelAsset,
+        const std::vector<CookedTextureSource>& textures);
+};
+
+/// @brief メモリ上の変換済みモデルの参照（所有しない）
+/// Parseで範囲を検証し，以降はデータを指すポインタを返す
+class CookedModelView {
+public:
+    /// @brief 先頭から検証する
+    /// @param pData ファイルの内容（8バイト境界に揃っていること）
+    /// @param size バイト数
+    /// @return 形式が正しくなければfalse
+    bool Parse(const void* pData, size_t size);
+
+    /// @brief メッシュの参照
+    MeshView GetMesh(uint32_t index) const;
+
+    /// @brief 書き出し時と同じ並びのマテリアル
+    /// テクスチャはローカルインデックスに設定され，ハンドルは無効のまま
+    std::vector<MaterialAsset> GetMaterials() const;
+
+    /// @brief テクスチャの情報
+    const cooked::TextureRecord& GetTexture(uint32_t index) const {
+        return m_textures[index];
+    }
+
+    /// @brief テクスチャのサブリソース
+    std::span<const cooked::SubresourceRecord> GetSubresources(
+        uint32_t index) const;
+
+    /// @brief オフセットの位置を指すポインタ
+    const uint8_t* GetData(uint64_t offset) const { return m_pData + offset; }
+
+    uint32_t GetMeshCount() const {
+        return static_cast<uint32_t>(m_meshes.size());
+    }
+    uint32_t GetMaterialCount() const {
+        return static_cast<uint32_t>(m_materials.size());
+    }
+    uint32_t GetTextureCount() const {
+        return static_cast<uint32_t>(m_textures.size());
+    }
+
+private:
+    /// @brief 範囲がファイル内に収まるかどうか
+    bool Contains(uint64_t offset, uint64_t size) const {
+        return offset <= m_size && size <= m_size - offset;
+    }
+
+    const uint8_t* m_pData = nullptr;  // ファイルの先頭
+    uint64_t m_size        = 0;        // バイト数
+
+    std::span<const cooked::MeshRecord> m_meshes;
+    std::span<const cooked::MaterialRecord> m_materials;
+    std::span<const cooked::TextureRecord> m_textures;
+};
@@ -0,0 +1,38 @@
+/// @file CookedModelFile.h
+/// @brief マッピングした変換済みモデルのファイル
+
+#pragma once
+
+#include <filesystem>
+
+#include "Engine/Core/MappedFile.h"
+#include "Engine/Resource/CookedModel.h"
+
+/// @brief 変換済みモデルのファイルをマッピングして検証する
+/// GetViewが返すポインタはこのオブジェクトが生きている間だけ有効
+class CookedModelFile {
+public:
+    /// @brief ファイルを開き，形式を検証する
+    bool Open(const std::filesystem::path& path) {
+        if (!m_file.Open(path)) {
+            return false;
+        }
+        if (!m_view.Parse(m_file.GetData(), m_file.GetSize())) {
+            m_file.Close();
+            return false;
+        }
+        return true;
+    }
+
+    /// @brief ファイルを閉じる
+    void Close() {
+        m_view = CookedModelView{};
+        m_file.Close();
+    }
+
+    const CookedModelView& GetView() const { return m_view; }
+
+private:
+    MappedFile m_file;       // マッピングしたファイル
+    CookedModelView m_view;  // ファイルの内容の参照
+};
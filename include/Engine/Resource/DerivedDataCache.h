@@ -0,0 +1,88 @@
+/// @file DerivedDataCache.h
+/// @brief インポート結果のディスクキャッシュ
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+/// @brief 入力の内容から作ったキーで，変換済みファイルを保存・検索する
+/// エントリは<キーの16進数>.mdlとしてディレクトリ直下に置く
+/// 最終使用時刻はファイルの更新時刻に記録し，実行をまたいでLRUで削除する
+/// ワーカースレッドから同時に呼べる
+class DerivedDataCache {
+public:
+    /// @brief 統計
+    struct Stats {
+        uint64_t hits          = 0;  // 検索でエントリが見つかった回数
+        uint64_t misses        = 0;  // 検索でエントリがなかった回数
+        uint64_t writes        = 0;  // 書き込んだエントリ数
+        uint64_t writeFailures = 0;  // 書き込みに失敗した回数
+        uint64_t evictions     = 0;  // 容量超過で削除したエントリ数
+        uint64_t totalBytes    = 0;  // 現在のエントリの合計バイト数
+        uint64_t entryCount    = 0;  // 現在のエントリ数
+    };
+
+    /// @brief 書き込み処理，渡されたパスにファイルを作る
+    using WriteFunc = std::function<bool(const std::filesystem::path& path)>;
+
+    DerivedDataCache();
+    ~DerivedDataCache();
+
+    /// @brief 初期化，ディレクトリを作成して既存のエントリを読み込む
+    /// @param directory キャッシュのディレクトリ
+    /// @param maxBytes 合計サイズの上限，超えた分は古いものから削除する
+    bool Init(const std::filesystem::path& directory, uint64_t maxBytes);
+
+    /// @brief 終了処理，統計を出力する
+    void Term();
+
+    /// @brief エントリの検索，見つかれば最終使用時刻を更新する
+    /// @param[out] outPath エントリのファイルパス
+    bool Find(uint64_t key, std::filesystem::path& outPath);
+
+    /// @brief エントリの書き込み
+    /// write(path)が完全なファイルを作った場合だけ登録される
+    bool Store(uint64_t key, const WriteFunc& write);
+
+    /// @brief エントリの削除（壊れていた場合など）
+    void Remove(uint64_t key);
+
+    /// @brief 統計の取得
+    Stats GetStats() const;
+
+    /// @brief 統計をデバッグ出力する
+    void ReportStats() const;
+
+    bool IsEnabled() const { return !m_directory.empty(); }
+
+private:
+    using FileTime = std::filesystem::file_time_type;
+
+    /// @brief エントリ1つ分
+    struct Entry {
+        uint64_t size;     // バイト数
+        FileTime lastUse;  // 最終使用時刻
+    };
+
+    /// @brief エントリのファイルパス
+    std::filesystem::path GetEntryPath(uint64_t key) const;
+
+    /// @brief 上限を超えた分を古いものから削除する，m_mutexを取った状態で呼ぶ
+    void Trim();
+
+    std::filesystem::path m_directory;  // キャッシュのディレクトリ
+    uint64_t m_maxBytes = 0;            // 合計サイズの上限
+
+    mutable std::mutex m_mutex;                     // 以下を保護する
+    std::unordered_map<uint64_t, Entry> m_entries;  // キーごとのエントリ
+    Stats m_stats;                                  // 統計
+    uint32_t m_tempCounter = 0;                     // 一時ファイル名の連番
+
+    // コピー禁止
+    DerivedDataCache(const DerivedDataCache&)            = delete;
+    DerivedDataCache& operator=(const DerivedDataCache&) = delete;
+};
@@ -13,21 +13,52 @@
 #include <vector>
 
 #include "Engine/Model/ModelAsset.h"
+#include "Engine/Resource/MeshOptimizer.h"
+#include "Engine/Resource/MeshSimplifier.h"
+#include "Engine/Resource/MeshletBuilder.h"
+#include "Engine/Resource/TangentGenerator.h"
+#include "Engine/Resource/VertexQuantizer.h"
+
+// 前方宣言
+class JobSystem;
 
 class GLBImporter {
 public:
     GLBImporter()  = delete;
     ~GLBImporter() = delete;
 
+    /// @brief assimpの後処理フラグ
+    /// 法線と接線の生成はassimpでは1スレッドで行われるので，
+    /// TangentGeneratorで並列に行う
+    static constexpr unsigned int kImportFlags =
+        aiProcess_Triangulate |               // 三角形化
+        aiProcess_RemoveRedundantMaterials |  // 冗長なマテリアルの削除
+        aiProcess_ConvertToLeftHanded;  // 左手座標系への変換 (MakeLeftHanded +
+                                        // FlipUVs + FlipWindingOrder)
+
+    /// @brief インポート処理の版
+    /// 出力が変わる変更（解析や画像の処理）をしたら増やし，キャッシュを無効にする
+    static constexpr uint32_t kVersion = 10;
+
     /// @brief glbファイルを読み込み，ModelAssetを出力
+    /// ファイルにない法線と接線は全メッシュを読んでから並列に生成する
+    /// メッシュはMeshOptimizerで並べ替えてから出力する
+    /// 最後にできるものは16bitのインデックスと圧縮した頂点に変換する
+    /// LODとメッシュレットは頂点を圧縮する前に全てのメッシュで生成する
     /// @param path ファイルパス
     /// @param[out] outModel 出力先
+    /// @param[out] pOutStats 最適化・16bit化・頂点の圧縮の前後の評価（省略可）
+    /// @param pJobSystem 法線と接線の生成に使う（nullptrなら逐次）
     /// @return 成功時true
-    static bool LoadFromFile(
-        const std::filesystem::path& path, ModelAsset& outModel);
+    static bool LoadFromFile(const std::filesystem::path& path,
+        ModelAsset& outModel, MeshImportStats* pOutStats = nullptr,
+        JobSystem* pJobSystem = nullptr);
 
 private:
-    static bool ParseMesh(const aiMesh* mesh, MeshAsset& outMesh);
+    /// @brief aiMeshの頂点とインデックスの読み込み
+    /// @param[out] outTarget ファイルになく，生成が必要なもの
+    static bool ParseMesh(const aiMesh* mesh, MeshAsset& outMesh,
+        TangentGenerator::Target& outTarget);
     static bool ParseMaterial(
         const aiMaterial* material, int imageCount, MaterialAsset& outMaterial);
 };
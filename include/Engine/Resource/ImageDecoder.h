@@ -0,0 +1,36 @@
+/// @file ImageDecoder.h
+/// @brief 埋め込み画像（PNG・JPEG）のデコード
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Engine/Resource/MipGenerator.h"
+
+// 前方宣言
+class JobSystem;
+
+/// @brief GLBの埋め込み画像をRGBA8にデコードし，ミップチェーンを作る
+/// デコードはstb_imageで行い，WICやCOMに依存しないので，
+/// どのスレッドからでも呼べ，Windows以外でも動く
+class ImageDecoder {
+public:
+    ImageDecoder()  = delete;
+    ~ImageDecoder() = delete;
+
+    /// @brief 対応する形式か（assimpのachFormatHintを小文字にしたもの）
+    static bool IsSupportedFormat(const std::string& format);
+
+    /// @brief 画像をデコードし，1x1までのミップチェーンを作る
+    /// @param pData ファイルの中身
+    /// @param size pDataのバイト数
+    /// @param options ミップの作り方（フィルタ・sRGB・法線マップ）
+    /// @param[out] outChain 出力先，失敗した場合は空
+    /// @param pJobSystem ミップの生成を行ごとに並列に処理する（省略可）
+    /// @return 壊れた画像・対応しない形式の場合はfalse
+    static bool Decode(const uint8_t* pData, size_t size,
+        const MipOptions& options, MipChain& outChain,
+        JobSystem* pJobSystem = nullptr);
+};
@@ -0,0 +1,127 @@
+/// @file MeshOptimizer.h
+/// @brief インポート時のメッシュの最適化
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Model/ModelAsset.h"
+#include "Engine/Resource/MeshSimplifier.h"
+#include "Engine/Resource/MeshletBuilder.h"
+#include "Engine/Resource/TangentGenerator.h"
+#include "Engine/Resource/VertexQuantizer.h"
+
+/// @brief MeshAssetの頂点とインデックスを描画向けに並べ替える
+/// 1. 完全に一致する頂点の統合
+/// 2. 頂点キャッシュ向けの三角形の並べ替え（Tipsify）
+/// 3. オーバードローを減らすクラスタの並べ替え
+/// 4. 頂点フェッチ向けの頂点の並べ替え（初出順）
+/// 形状と見た目は変わらず，頂点とインデックスの並びだけが変わる
+/// モデル全体の最後にConvertToShortIndicesで16bitのインデックスにする
+class MeshOptimizer {
+public:
+    MeshOptimizer()  = delete;
+    ~MeshOptimizer() = delete;
+
+    /// @brief 最適化と評価で想定する頂点キャッシュ（FIFO）のサイズ
+    static constexpr uint32_t kCacheSize = 16;
+
+    /// @brief クラスタを分割してよいACMRの悪化の割合
+    static constexpr float kOverdrawThreshold = 1.05f;
+
+    /// @brief 頂点キャッシュの評価
+    struct CacheStats {
+        float acmr = 0.0f;  // 三角形あたりの頂点シェーダ実行数（0.5〜3）
+        float atvr = 0.0f;  // 頂点あたりの頂点シェーダ実行数（1以上）
+    };
+
+    /// @brief 16bitのインデックスで扱える頂点数の上限
+    /// 0xFFFFはストリップの区切りと紛らわしいので使わない
+    static constexpr uint32_t kMaxShortIndexVertices = 0xFFFF;
+
+    /// @brief 最適化の前後の比較
+    struct Stats {
+        uint32_t vertexCountBefore = 0;
+        uint32_t vertexCountAfter  = 0;
+        CacheStats before;
+        CacheStats after;
+    };
+
+    /// @brief 16bit化の前後の比較（モデル全体）
+    struct IndexStats {
+        uint32_t meshCountBefore   = 0;  // 変換前のメッシュ数
+        uint32_t meshCountAfter    = 0;  // 分割後のメッシュ数
+        uint32_t shortMeshCount    = 0;  // 16bitになったメッシュ数
+        uint32_t splitMeshCount    = 0;  // 分割した元のメッシュ数
+        uint64_t indexBytesBefore  = 0;  // インデックスの合計バイト数
+        uint64_t indexBytesAfter   = 0;
+        uint64_t vertexBytesBefore = 0;  // 頂点の合計バイト数（分割で増える）
+        uint64_t vertexBytesAfter  = 0;
+
+        /// @brief 頂点とインデックスを合わせて減ったバイト数（増えたら負）
+        int64_t GetSavedBytes() const {
+            return static_cast<int64_t>(indexBytesBefore + vertexBytesBefore) -
+                   static_cast<int64_t>(indexBytesAfter + vertexBytesAfter);
+        }
+    };
+
+    /// @brief 全ての段階を順に行う
+    /// @param[out] pOutStats 前後の評価の出力先（省略可）
+    static void Optimize(MeshAsset& mesh, Stats* pOutStats = nullptr);
+
+    /// @brief バイト単位で一致する頂点を1つにまとめる
+    static void DeduplicateVertices(MeshAsset& mesh);
+
+    /// @brief 頂点キャッシュ向けに三角形を並べ替える（Tipsify）
+    /// @param[out] pOutClusters 行き止まりで区切ったクラスタの先頭の三角形番号
+    static void OptimizeVertexCache(std::vector<uint32_t>& indices,
+        size_t vertexCount, std::vector<uint32_t>* pOutClusters = nullptr);
+
+    /// @brief 外側を向くクラスタから描くように並べ替える
+    /// キャッシュの効率がthreshold倍以上悪化しない位置でクラスタを細かく分ける
+    /// @param clusters OptimizeVertexCacheが出力したクラスタ
+    static void OptimizeOverdraw(MeshAsset& mesh,
+        const std::vector<uint32_t>& clusters,
+        float threshold = kOverdrawThreshold);
+
+    /// @brief インデックスの初出順に頂点を並べ替え，未使用の頂点を除く
+    static void OptimizeVertexFetch(MeshAsset& mesh);
+
+    /// @brief FIFOの頂点キャッシュを模擬して評価する
+    static CacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices,
+        size_t vertexCount, uint32_t cacheSize = kCacheSize);
+
+    /// @brief 全てのインデックスが頂点数未満か
+    static bool ValidateIndexRange(
+        const std::vector<uint32_t>& indices, size_t vertexCount);
+
+    /// @brief モデルの全メッシュを可能な限り16bitのインデックスにする
+    /// 頂点数がkMaxShortIndexVertices以下のメッシュはそのまま変換し，
+    /// 超えるメッシュは分割で増える頂点より減るインデックスの方が
+    /// 大きい場合だけ分割する．メッシュの数と順番は変わりうる
+    /// @param[out] pOutStats 前後の比較の出力先（省略可）
+    static void ConvertToShortIndices(
+        std::vector<MeshAsset>& meshes, IndexStats* pOutStats = nullptr);
+
+    /// @brief インデックスを16bitに変換する
+    /// @return 頂点数が多い・範囲外のインデックスがある場合はfalse（変更なし）
+    static bool CompactIndices(MeshAsset& mesh);
+
+    /// @brief 三角形の順番を保ったまま，頂点数がmaxVertices以下のメッシュに
+    /// 分割する．境界の頂点は複製される
+    /// @param[out] outMeshes 分割したメッシュ（AABBは各メッシュで計算し直す）
+    static void SplitMesh(const MeshAsset& mesh, uint32_t maxVertices,
+        std::vector<MeshAsset>& outMeshes);
+};
+
+/// @brief インポート時の最適化の評価
+struct MeshImportStats {
+    TangentGenerator::Stats tangents;          // 法線と接線の生成結果
+    std::vector<MeshOptimizer::Stats> meshes;  // 元のメッシュごとの評価
+    MeshOptimizer::IndexStats indices;         // 16bit化の評価
+    MeshSimplifier::Stats lods;                // LODの生成結果
+    MeshletBuilder::Stats meshlets;            // メッシュレットの生成結果
+    VertexQuantizer::Stats vertices;           // 頂点の圧縮の評価
+};
@@ -0,0 +1,73 @@
+/// @file MeshSimplifier.h
+/// @brief インポート時の詳細度（LOD）の生成
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Model/ModelAsset.h"
+
+/// @brief 二次誤差（QEM）による辺の縮約でメッシュを簡略化し，LODを作る
+/// 頂点を隣の頂点の位置へ寄せる縮約（half-edge collapse）だけを行うので，
+/// 新しい頂点は作らず，全てのLODが同じ頂点バッファを共有する
+/// 同じ位置に複数の頂点がある（UVや法線が不連続な）シームと，
+/// 開いた縁の頂点は動かさないので，シームと輪郭は崩れない
+/// 各LODのインデックスはLOD0の後ろに追加し，MeshAsset::lodsで範囲を表す
+class MeshSimplifier {
+public:
+    MeshSimplifier()  = delete;
+    ~MeshSimplifier() = delete;
+
+    /// @brief LOD0を含むLODの数の上限
+    static constexpr uint32_t kMaxLods = 4;
+
+    /// @brief 1段ごとに目標とする三角形数の割合
+    static constexpr float kLodReduction = 0.5f;
+
+    /// @brief 1段で最低限減らす三角形数の割合（届かなければ打ち切る）
+    static constexpr float kMinLodReduction = 0.15f;
+
+    /// @brief これより三角形が少なくなるLODは作らない
+    static constexpr uint32_t kMinLodTriangles = 64;
+
+    /// @brief 縮約で許す三角形の向きの変化（cos，約75°まで）
+    static constexpr float kMinNormalDot = 0.25f;
+
+    /// @brief 生成結果（モデル全体）
+    struct Stats {
+        uint32_t meshCount               = 0;   // LODを作ったメッシュ数
+        uint32_t lodMeshCount[kMaxLods]  = {};  // そのLODを持つメッシュ数
+        uint64_t triangleCount[kMaxLods] = {};  // LODごとの三角形の合計数
+        uint64_t inputTriangleCount      = 0;   // 簡略化した元の三角形数
+        double simplifyTimeMs            = 0.0;  // 簡略化に掛かった時間
+
+        /// @brief 1秒あたりに簡略化した元の三角形数
+        double GetTrianglesPerSecond() const {
+            if (simplifyTimeMs <= 0.0) {
+                return 0.0;
+            }
+            return inputTriangleCount * 1000.0 / simplifyTimeMs;
+        }
+    };
+
+    /// @brief モデルの全メッシュのLODを生成する
+    /// @param[out] pOutStats 生成結果の出力先（省略可）
+    static void GenerateLods(
+        std::vector<MeshAsset>& meshes, Stats* pOutStats = nullptr);
+
+    /// @brief メッシュのLODを生成する（既存のLODは置き換える）
+    /// @return LODを1つ以上作った場合はtrue，頂点が圧縮済み・三角形が少ない・
+    /// 縮約できる頂点がない場合はfalse（LOD0だけになる）
+    static bool GenerateLods(MeshAsset& mesh);
+
+    /// @brief インデックスを目標の数まで簡略化する
+    /// @param targetIndexCount 目標のインデックス数（縮約できる頂点が
+    /// なくなれば届かない）
+    /// @param[out] outIndices 簡略化したインデックス
+    /// @return 元の形状からの誤差（ローカル空間の距離）
+    static float Simplify(const std::vector<StandardVertex>& vertices,
+        const std::vector<uint32_t>& indices, size_t targetIndexCount,
+        std::vector<uint32_t>& outIndices);
+};
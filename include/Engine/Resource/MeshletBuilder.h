@@ -0,0 +1,59 @@
+/// @file MeshletBuilder.h
+/// @brief インポート時のメッシュレットの生成
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Model/Meshlet.h"
+#include "Engine/Model/ModelAsset.h"
+
+/// @brief MeshAssetのLOD0のインデックスを先頭から区切ってメッシュレットにする
+/// 三角形を並べ替えないので，MeshOptimizerで頂点キャッシュ向けに並べた
+/// 局所性がそのままメッシュレットのまとまりになる
+/// 境界球と法線錐は圧縮前の頂点の位置から求めるので，
+/// VertexQuantizerより前に行う
+class MeshletBuilder {
+public:
+    MeshletBuilder()  = delete;
+    ~MeshletBuilder() = delete;
+
+    /// @brief 生成結果（モデル全体）
+    struct Stats {
+        uint32_t meshletCount     = 0;  // メッシュレット数
+        uint64_t triangleCount    = 0;  // 三角形の合計数
+        uint64_t vertexCount      = 0;  // メッシュレットの頂点の合計数
+        uint32_t coneMeshletCount = 0;  // 法線錐で判定できるメッシュレット数
+
+        /// @brief 1メッシュレットあたりの三角形数
+        float GetTrianglesPerMeshlet() const {
+            if (meshletCount == 0) {
+                return 0.0f;
+            }
+            return static_cast<float>(triangleCount) / meshletCount;
+        }
+
+        /// @brief 1メッシュレットあたりの頂点数
+        float GetVerticesPerMeshlet() const {
+            if (meshletCount == 0) {
+                return 0.0f;
+            }
+            return static_cast<float>(vertexCount) / meshletCount;
+        }
+    };
+
+    /// @brief モデルの全メッシュのメッシュレットを生成する
+    /// @param[out] pOutStats 生成結果の出力先（省略可）
+    static void BuildMeshlets(
+        std::vector<MeshAsset>& meshes, Stats* pOutStats = nullptr);
+
+    /// @brief メッシュのメッシュレットを生成する（既存のものは置き換える）
+    /// @return 頂点がStandardでない・範囲外のインデックスがある場合はfalse
+    static bool Build(MeshAsset& mesh);
+
+    /// @brief 1つのメッシュレットの境界球と法線錐を求める
+    /// @param mesh meshletVerticesとmeshletTrianglesを作成済みのメッシュ
+    static MeshletBounds ComputeBounds(
+        const MeshAsset& mesh, const Meshlet& meshlet);
+};
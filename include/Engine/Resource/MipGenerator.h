@@ -0,0 +1,117 @@
+/// @file MipGenerator.h
+/// @brief CPUでのミップチェーンの生成
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 前方宣言
+class JobSystem;
+
+/// @brief ミップチェーンのピクセル形式
+enum class MipFormat : uint8_t {
+    RGBA8,    // R8G8B8A8_UNORM
+    RGBA16F,  // R16G16B16A16_FLOAT
+    R32F,     // R32_FLOAT
+};
+
+/// @brief 縮小に使うフィルタ
+enum class MipFilter : uint8_t {
+    Box,     // 面積で重み付けした平均
+    Kaiser,  // Kaiser窓を掛けたsinc，ぼけにくいが少し遅い
+};
+
+/// @brief ミップの作り方
+struct MipOptions {
+    MipFilter filter = MipFilter::Box;
+    bool isSRGB      = false;  // RGBA8のRGBをsRGBとして線形にしてから縮小
+    bool isNormalMap = false;  // RGBA8のXYZを段ごとに長さ1に戻す
+    bool useAvx2     = true;   // falseなら常にスカラーで処理する
+};
+
+/// @brief ミップチェーンの1段
+struct MipLevel {
+    uint32_t width  = 0;  // 幅（ピクセル）
+    uint32_t height = 0;  // 高さ（ピクセル）
+    size_t offset   = 0;  // pixelsの中の先頭の位置
+    size_t rowPitch = 0;  // 1行のバイト数
+};
+
+/// @brief CPU側のミップチェーン
+/// 全ての段を1つの配列に詰め，段ごとの位置をlevelsで表す
+struct MipChain {
+    std::vector<uint8_t> pixels;   // 全ての段のピクセル
+    std::vector<MipLevel> levels;  // 段ごとの大きさと位置
+    MipFormat format = MipFormat::RGBA8;
+
+    /// @brief 中身があるか
+    bool IsValid() const { return !levels.empty(); }
+
+    /// @brief 段数
+    uint32_t GetMipCount() const {
+        return static_cast<uint32_t>(levels.size());
+    }
+
+    /// @brief 段の先頭
+    uint8_t* GetData(uint32_t level) {
+        return pixels.data() + levels[level].offset;
+    }
+    const uint8_t* GetData(uint32_t level) const {
+        return pixels.data() + levels[level].offset;
+    }
+
+    /// @brief 段のバイト数
+    size_t GetSlicePitch(uint32_t level) const {
+        return levels[level].rowPitch * levels[level].height;
+    }
+};
+
+/// @brief 分離可能なフィルタでミップチェーンを作る
+/// ボックスは縮小先の1ピクセルが覆う範囲を重なった面積で平均するので，
+/// 奇数の辺でも端の行や列を捨てずに全てのピクセルが寄与する
+/// Kaiserは縮小先の3ピクセル分の半径を見て，範囲外は反対側から繰り返す
+/// 縮小はfloatの線形な値で行い，sRGBは変換してから平均する
+/// 縮小先の行ごとに独立しているので，行のまとまりごとに並列に処理する
+/// CPUがAVX2とF16Cに対応していれば8レーンずつ処理する
+/// スカラーの場合と同じ順番で演算するので，結果はビット単位で一致する
+/// WICやDirectXTexに依存しないので，どのスレッドからでも呼べる
+class MipGenerator {
+public:
+    MipGenerator()  = delete;
+    ~MipGenerator() = delete;
+
+    /// @brief 1つのジョブで処理する縮小先の行数
+    static constexpr uint32_t kGrainRows = 32;
+
+    /// @brief Kaiserフィルタの半径（縮小先のピクセル単位）
+    static constexpr float kKaiserWidth = 3.0f;
+
+    /// @brief Kaiser窓の形，大きいほど裾が小さく，ぼける
+    static constexpr float kKaiserAlpha = 4.0f;
+
+    /// @brief 1ピクセルのバイト数
+    static uint32_t GetBytesPerPixel(MipFormat format);
+
+    /// @brief 1ピクセルのチャンネル数
+    static uint32_t GetChannelCount(MipFormat format);
+
+    /// @brief AVX2の経路を使えるか（CPUがAVX2とF16Cに対応しているか）
+    static bool IsAvx2Supported();
+
+    /// @brief 1x1までの段数
+    static uint32_t ComputeMipCount(uint32_t width, uint32_t height);
+
+    /// @brief 全ての段の領域を確保する（中身は0）
+    /// @param mipCount 段数，0なら1x1まで
+    /// @return 大きさが0の場合はfalse
+    static bool Allocate(uint32_t width, uint32_t height, uint32_t mipCount,
+        MipFormat format, MipChain& outChain);
+
+    /// @brief 先頭の段から残りの段を作る
+    /// @param options フィルタ・sRGB・法線マップの指定
+    /// @param pJobSystem 行を分けて並列に処理する（nullptrなら逐次）
+    static void Generate(MipChain& chain, const MipOptions& options = {},
+        JobSystem* pJobSystem = nullptr);
+};
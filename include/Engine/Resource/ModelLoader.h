@@ -3,29 +3,104 @@
 
 #pragma once
 
+#include <directxtex.h>
+
+#include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <vector>
 
 #include "Engine/Model/Model.h"
+#include "Engine/Resource/CookedModelFile.h"
+#include "Engine/Resource/MeshOptimizer.h"
 #include "directxtk12/ResourceUploadBatch.h"
 
 // 前方宣言
+class DerivedDataCache;
 class TextureManager;
 class GraphicsDevice;
+class JobSystem;
+
+/// @brief モデルのCPU側の読み込み結果
+/// 変換済みのファイルを読んだ場合はpCooked，GLBを読んだ場合はassetとimages
+struct ModelSource {
+    ModelAsset asset;                           // GLBの内容
+    std::vector<DirectX::ScratchImage> images;  // デコード済みの画像
+    std::unique_ptr<CookedModelFile> pCooked;   // マッピングした変換済みファイル
+};
 
 class ModelLoader {
 public:
     /// @brief 初期化，必要なポインタの受け取り
-    bool Init(GraphicsDevice& graphicsDevice, TextureManager& textureManager);
+    /// @param pCache GLBのインポート結果のキャッシュ（nullptrなら使わない）
+    /// @param pJobSystem インポート中の並列処理の実行先（nullptrなら逐次）
+    bool Init(GraphicsDevice& graphicsDevice, TextureManager& textureManager,
+        DerivedDataCache* pCache = nullptr, JobSystem* pJobSystem = nullptr);
 
     /// @brief 終了処理，ポインタの破棄
     void Term();
 
-    /// @brief モデルのロード
+    /// @brief モデルのロード，拡張子が.mdlなら変換済みモデルとして読む
     std::unique_ptr<Model> LoadModel(
         const std::filesystem::path& path, DirectX::ResourceUploadBatch& batch);
 
+    /// @brief モデルのCPU側の読み込み
+    /// GLBはキャッシュにあればそれをマッピングし，なければインポートして書き込む
+    /// GPUを使わないので，ワーカースレッドから呼べる
+    /// @param[out] outSource 出力先
+    bool LoadSource(const std::filesystem::path& path, ModelSource& outSource);
+
+    /// @brief 読み込み結果からモデルのGPUリソースを作成
+    std::unique_ptr<Model> CreateModel(
+        ModelSource& source, DirectX::ResourceUploadBatch& batch);
+
+    /// @brief モデルのCPU側の読み込み（GLBの解析と画像のデコード）
+    /// GPUを使わないので，ワーカースレッドから呼べる
+    /// @param[out] outAsset 出力先
+    /// @param[out] outImages 画像ごとのミップチェーン
+    /// @param[out] pOutStats 最適化と16bit化の前後の評価（省略可）
+    /// @param pJobSystem 法線と接線の生成・画像のデコードに使う（省略可）
+    static bool LoadAsset(const std::filesystem::path& path,
+        ModelAsset& outAsset, std::vector<DirectX::ScratchImage>& outImages,
+        MeshImportStats* pOutStats = nullptr, JobSystem* pJobSystem = nullptr);
+
+    /// @brief 読み込み済みのデータからモデルのGPUリソースを作成
+    std::unique_ptr<Model> CreateModel(ModelAsset& modelAsset,
+        const std::vector<DirectX::ScratchImage>& images,
+        DirectX::ResourceUploadBatch& batch);
+
+    /// @brief 変換済みモデルからモデルのGPUリソースを作成
+    /// 頂点・インデックス・テクスチャはviewの参照先から直接batchに積む
+    /// batchは記録時にアップロードヒープへコピーするので，
+    /// viewの参照先はこの呼び出しの間だけ有効であればよい
+    std::unique_ptr<Model> CreateModel(
+        const CookedModelView& view, DirectX::ResourceUploadBatch& batch);
+
+    /// @brief 変換済みモデルのパスかどうか
+    static bool IsCookedPath(const std::filesystem::path& path);
+
+    /// @brief GLBを読み込み，変換済みモデルとして書き出す
+    /// @param srcPath GLBファイルのパス
+    /// @param dstPath 出力先（.mdl）
+    /// @param[out] pOutStats 最適化と16bit化の前後の評価（省略可）
+    /// @param pJobSystem 法線と接線の生成・画像のデコードに使う（省略可）
+    static bool CookModel(const std::filesystem::path& srcPath,
+        const std::filesystem::path& dstPath,
+        MeshImportStats* pOutStats = nullptr, JobSystem* pJobSystem = nullptr);
+
+    /// @brief キャッシュのキー
+    /// GLBの内容，インポートのフラグと版，変換済みモデルの形式の版から作る
+    static bool ComputeCacheKey(
+        const std::filesystem::path& path, uint64_t& outKey);
+
 private:
+    /// @brief 読み込み済みのデータを変換済みモデルとして書き出す
+    static bool WriteCookedModel(const std::filesystem::path& path,
+        const ModelAsset& modelAsset,
+        const std::vector<DirectX::ScratchImage>& images);
+
     GraphicsDevice* m_pGraphicsDevice = nullptr;
     TextureManager* m_pTextureManager = nullptr;
+    DerivedDataCache* m_pCache        = nullptr;
+    JobSystem* m_pJobSystem           = nullptr;
 };
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include "Engine/Resource/TextureResource.h"
 
 class DescriptorPool;
+class JobSystem;
 
 /// @brief 個別のテクスチャリソースとそのSRVの管理
 class ShaderResourceTexture {
@@ -28,6 +29,30 @@ public:
     bool InitFromImage(ID3D12Device* pDevice, DescriptorPool* pPoolSRV,
         const ImageAsset& image, DirectX::ResourceUploadBatch& batch);
 
+    /// @brief デコード済みの画像からテクスチャリソースとデフォルトSRVを作成
+    /// @param mipChain DecodeImageで作成したミップチェーン
+    /// @param isSRGB sRGBとしてSRVを作るかどうか
+    bool InitFromDecodedImage(ID3D12Device* pDevice, DescriptorPool* pPoolSRV,
+        const DirectX::ScratchImage& mipChain, bool isSRGB,
+        DirectX::ResourceUploadBatch& batch);
+
+    /// @brief サブリソースのデータからテクスチャリソースとデフォルトSRVを作成
+    /// データはbatchのアップロードヒープにコピーされるので，呼び出し後は不要
+    /// @param metadata 2Dテクスチャの大きさ・フォーマット・ミップ数
+    /// @param pSubresources ミップ順のサブリソース
+    bool InitFromSubresources(ID3D12Device* pDevice, DescriptorPool* pPoolSRV,
+        const DirectX::TexMetadata& metadata,
+        const D3D12_SUBRESOURCE_DATA* pSubresources, UINT subresourceCount,
+        bool isSRGB, DirectX::ResourceUploadBatch& batch);
+
+    /// @brief 画像をデコードし，ミップチェーンを生成する
+    /// ImageDecoderでデコードし，RGBA8のScratchImageに移す
+    /// GPUもWICも使わないので，どのワーカースレッドからでも呼べる
+    /// @param[out] outMipChain 出力先
+    /// @param pJobSystem ミップの生成を並列に処理する（nullptrなら逐次）
+    static bool DecodeImage(const ImageAsset& image,
+        DirectX::ScratchImage& outMipChain, JobSystem* pJobSystem = nullptr);
+
     bool InitSolidColorRGBA8(ID3D12Device* pDevice, DescriptorPool* pPoolSRV,
         uint8_t r, uint8_t g, uint8_t b, uint8_t a,
         DirectX::ResourceUploadBatch& batch);
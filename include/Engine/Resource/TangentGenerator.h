@@ -0,0 +1,68 @@
+/// @file TangentGenerator.h
+/// @brief インポート時の法線と接線の生成
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Model/ModelAsset.h"
+
+// 前方宣言
+class JobSystem;
+
+/// @brief ファイルに法線や接線がないメッシュに，法線と接線を生成する
+/// 法線は同じ位置の頂点で，角度で重み付けした面法線を平均する
+/// 接線はMikkTSpaceと同じく，UVの勾配を頂点の法線に垂直な面へ射影し，
+/// 角の角度で重み付けして位置・法線・UVが同じ頂点ごとに平均する
+/// w成分は従来と同じく(N×T)·Bの符号で，符号の異なる三角形が共有する
+/// 頂点（ミラーしたUVの境目）は複製して分ける
+/// メッシュごと，メッシュ内は三角形のまとまりごとにJobSystemで並列に処理する
+class TangentGenerator {
+public:
+    TangentGenerator()  = delete;
+    ~TangentGenerator() = delete;
+
+    /// @brief 1つのジョブで処理する三角形数（頂点の処理も同じ数ずつ）
+    static constexpr uint32_t kGrainSize = 4096;
+
+    /// @brief メッシュごとに生成するもの
+    struct Target {
+        bool normals  = false;  // 法線を生成する
+        bool tangents = false;  // 接線を生成する（UVがあるメッシュに限る）
+    };
+
+    /// @brief 生成結果（モデル全体）
+    struct Stats {
+        uint32_t normalMeshCount  = 0;    // 法線を生成したメッシュ数
+        uint32_t tangentMeshCount = 0;    // 接線を生成したメッシュ数
+        uint32_t splitVertexCount = 0;    // 符号の違いで複製した頂点数
+        uint64_t triangleCount    = 0;    // 処理した三角形数
+        double generateTimeMs     = 0.0;  // 生成に掛かった時間
+
+        /// @brief 1秒あたりに処理した三角形数
+        double GetTrianglesPerSecond() const {
+            if (generateTimeMs <= 0.0) {
+                return 0.0;
+            }
+            return triangleCount * 1000.0 / generateTimeMs;
+        }
+    };
+
+    /// @brief モデルの全メッシュの法線と接線を生成する
+    /// @param targets meshesと同じ数の，メッシュごとに生成するもの
+    /// @param pJobSystem 並列に処理するジョブシステム（nullptrなら逐次）
+    /// @param[out] pOutStats 生成結果の出力先（省略可）
+    static void Generate(std::vector<MeshAsset>& meshes,
+        const std::vector<Target>& targets, JobSystem* pJobSystem,
+        Stats* pOutStats = nullptr);
+
+    /// @brief 滑らかな法線を生成する（既存の法線は置き換える）
+    /// 面積が0の三角形しか使わない頂点の法線は(0, 1, 0)にする
+    static void GenerateNormals(MeshAsset& mesh, JobSystem* pJobSystem);
+
+    /// @brief 接線を生成する（既存の接線は置き換える）
+    /// 法線が正規化されていることを前提とする
+    /// @return 符号の違いで複製した頂点数
+    static uint32_t GenerateTangents(MeshAsset& mesh, JobSystem* pJobSystem);
+};
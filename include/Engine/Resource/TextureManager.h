@@ -14,6 +14,9 @@
 #include "Engine/Resource/ShaderResourceTexture.h"
 #include "Engine/Resource/TextureResource.h"
 
+// 前方宣言
+class JobSystem;
+
 /// @brief テクスチャの所有とハンドル管理
 class TextureManager {
 public:
@@ -29,6 +32,26 @@ public:
     void BuildTexturesFromModelAsset(
         ModelAsset& modelAsset, DirectX::ResourceUploadBatch& batch);
 
+    /// @brief ModelAssetの画像のデコードとミップチェーン生成
+    /// GPUを使わないので，ワーカースレッドから呼べる
+    /// 画像ごとに並列にデコードし，結果は画像と同じ順番に並べる
+    /// @param[out] outImages 画像ごとのミップチェーン，失敗した画像は空
+    /// @param pJobSystem 並列に処理するジョブシステム（nullptrなら逐次）
+    static void DecodeModelImages(ModelAsset& modelAsset,
+        std::vector<DirectX::ScratchImage>& outImages,
+        JobSystem* pJobSystem = nullptr);
+
+    /// @brief デコード済みの画像からのテクスチャ構築と
+    /// マテリアル内テクスチャハンドルの解決
+    void BuildTexturesFromDecodedImages(ModelAsset& modelAsset,
+        const std::vector<DirectX::ScratchImage>& images,
+        DirectX::ResourceUploadBatch& batch);
+
+    /// @brief マテリアルのローカルインデックスからテクスチャハンドルを解決
+    /// @param textureHandles 画像の並びと同じテクスチャハンドル
+    static void ResolveMaterialTextures(std::vector<MaterialAsset>& materials,
+        const std::vector<TextureHandle>& textureHandles);
+
     //=========================================
     // デフォルトテクスチャの取得
     //==========================================
@@ -43,6 +66,17 @@ public:
     uint32_t CreateFromImageAsset(
         const ImageAsset& image, DirectX::ResourceUploadBatch& batch);
 
+    /// @brief デコード済みの画像からテクスチャを生成
+    /// @return 生成したテクスチャのインデックス
+    uint32_t CreateFromDecodedImage(const DirectX::ScratchImage& mipChain,
+        bool isSRGB, DirectX::ResourceUploadBatch& batch);
+
+    /// @brief サブリソースのデータからテクスチャを生成
+    /// @return 生成したテクスチャのインデックス
+    uint32_t CreateFromSubresources(const DirectX::TexMetadata& metadata,
+        const D3D12_SUBRESOURCE_DATA* pSubresources, UINT subresourceCount,
+        bool isSRGB, DirectX::ResourceUploadBatch& batch);
+
     /// @brief 単色テクスチャの生成
     bool CreateSolidColorTexture(DirectX::ResourceUploadBatch& batch, uint8_t r,
         uint8_t g, uint8_t b, uint8_t a, DescriptorPool* poolSRV,
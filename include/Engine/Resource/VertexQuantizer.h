@@ -0,0 +1,85 @@
+/// @file VertexQuantizer.h
+/// @brief インポート時の頂点の圧縮
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Model/ModelAsset.h"
+
+/// @brief StandardVertex（64バイト）をCompactVertex（20バイト）に変換する
+/// 位置とUVはメッシュごとの最小値と範囲で正規化して16bitにし，
+/// 法線と接線は八面体写像で2成分にして16bitにする
+/// 白以外の頂点カラーを持つメッシュと，UVの範囲が広く誤差が許容値を
+/// 超えるメッシュはStandardのまま残す
+class VertexQuantizer {
+public:
+    VertexQuantizer()  = delete;
+    ~VertexQuantizer() = delete;
+
+    /// @brief UVの誤差の許容値（4096テクセルのテクスチャで1/4テクセル）
+    static constexpr float kMaxTexcoordError = 1.0f / 16384.0f;
+
+    /// @brief 復元した値の誤差の最大値
+    struct ErrorStats {
+        float position = 0.0f;  // 位置の誤差（モデルの単位）
+        float normal   = 0.0f;  // 法線の角度の誤差（度）
+        float tangent  = 0.0f;  // 接線の角度の誤差（度）
+        float texcoord = 0.0f;  // UVの誤差
+    };
+
+    /// @brief 圧縮の前後の比較（モデル全体）
+    struct Stats {
+        uint32_t compactMeshCount  = 0;  // Compactにしたメッシュ数
+        uint32_t standardMeshCount = 0;  // Standardのまま残したメッシュ数
+        uint64_t vertexCount       = 0;  // 頂点の合計数
+        uint64_t bytesBefore       = 0;  // 頂点の合計バイト数
+        uint64_t bytesAfter        = 0;
+        ErrorStats maxError;             // Compactにしたメッシュの誤差の最大値
+
+        /// @brief 1頂点あたりのバイト数
+        float GetBytesPerVertexBefore() const {
+            if (vertexCount == 0) {
+                return 0.0f;
+            }
+            return static_cast<float>(bytesBefore) / vertexCount;
+        }
+        float GetBytesPerVertexAfter() const {
+            if (vertexCount == 0) {
+                return 0.0f;
+            }
+            return static_cast<float>(bytesAfter) / vertexCount;
+        }
+    };
+
+    /// @brief モデルの全メッシュについて，圧縮できるものを圧縮する
+    /// @param[out] pOutStats 前後の比較の出力先（省略可）
+    static void CompressVertices(
+        std::vector<MeshAsset>& meshes, Stats* pOutStats = nullptr);
+
+    /// @brief メッシュの頂点を圧縮し，verticesをcompactVerticesに移す
+    /// @param[out] pOutError 復元した値の誤差（省略可）
+    /// @return 圧縮できない場合はfalse（変更なし）
+    static bool Compress(MeshAsset& mesh, ErrorStats* pOutError = nullptr);
+
+    /// @brief 頂点を囲む範囲から復元に使う値を求める
+    static VertexQuantization ComputeQuantization(
+        const std::vector<StandardVertex>& vertices);
+
+    /// @brief 1頂点の圧縮
+    static CompactVertex Encode(
+        const StandardVertex& vertex, const VertexQuantization& quantization);
+
+    /// @brief 1頂点の復元（TestVS.hlslの復元と同じ計算，頂点カラーは白）
+    static StandardVertex Decode(
+        const CompactVertex& vertex, const VertexQuantization& quantization);
+
+    /// @brief 単位ベクトルを八面体写像で2成分のSNORM16にする
+    /// 丸め方向の4通りから，復元したときに最も近いものを選ぶ
+    static void EncodeOctahedral(
+        const DirectX::XMFLOAT3& direction, int16_t outEncoded[2]);
+
+    /// @brief 八面体写像した2成分から単位ベクトルを復元する
+    static DirectX::XMFLOAT3 DecodeOctahedral(const int16_t encoded[2]);
+};
@@ -61,6 +61,10 @@ public:
     Transform& GetTransform() { return m_transform; }
     const Transform& GetTransform() const { return m_transform; }
 
+    float GetFovYRad() const { return m_fovYRad; }
+    float GetNearZ() const { return m_nearZ; }
+    float GetFarZ() const { return m_farZ; }
+
     float GetAperture() const { return m_aperture; }
     float GetShutterSpeed() const { return m_shutterSpeed; }
 
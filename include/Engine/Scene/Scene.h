@@ -1,45 +1,88 @@
 #pragma once
 
-#include <d3d12.h>
+#include <DirectXMath.h>
 
 #include <memory>
-#include <stack>
 #include <vector>
 
 #include "Engine/Core/EngineConfig.h"
 #include "Engine/Core/GenHandle.h"
-#include "Engine/Core/RetireQueue.h"
 #include "Engine/Core/SlotMap.h"
+#include "Engine/Core/SoASlotMap.h"
 #include "Engine/Model/Model.h"
 #include "Engine/Scene/Camera.h"
-#include "Engine/Scene/GameObject.h"
 #include "Engine/Scene/Light.h"
-#include "Engine/Shader/TransformGPU.h"
+#include "Engine/Scene/SceneGraph.h"
 
 // 前方宣言
-class GraphicsDevice;
+class JobSystem;
+struct RenderStats;
 
 class Scene {
 public:
+    /// @brief ゲームオブジェクトの列番号（ObjectStorageの列の並びと一致させる）
+    enum ObjectColumn : size_t {
+        Column_Transform = 0,  // ローカル姿勢
+        Column_Model     = 1,  // モデルハンドル
+        Column_Version   = 2,  // 最後に確認したTransformの変更カウンタ
+        Column_World     = 3,  // 親子関係を反映したワールド行列
+        Column_WorldInv  = 4,  // ワールド行列の逆行列
+    };
+
+    /// @brief ゲームオブジェクトの格納先
+    /// GPU側のリソースは持たず，ワールド行列は描画時に毎フレーム書き込む
+    using ObjectStorage = SoASlotMap<engine::GameObjectTag, Transform,
+        engine::ModelHandle, uint32_t, DirectX::XMFLOAT4X4,
+        DirectX::XMFLOAT4X4>;
+
     Scene();
     ~Scene();
 
-    void Init(GraphicsDevice& graphicsDevice);
+    void Init();
 
     void Term();
 
     /// @brief シーンにモデルを追加する
     engine::ModelHandle RegisterModel(std::unique_ptr<Model> pModel);
 
+    /// @brief 中身が空のモデルのスロットを確保する（非同期ロード用）
+    /// ResolveModelで中身を設定するまで，GetModelはnullptrを返す
+    engine::ModelHandle ReserveModel();
+
+    /// @brief ReserveModelで確保したスロットにモデルを設定する
+    /// @return スロットが既に外されていればfalse
+    bool ResolveModel(
+        engine::ModelHandle handle, std::unique_ptr<Model> pModel);
+
+    /// @brief モデルをシーンから外し，所有権を返す
+    /// このモデルを参照するオブジェクトは描画されなくなる
+    /// GPUが使い終えるまでは破棄せず，遅延解放キューに預ける
+    std::unique_ptr<Model> UnregisterModel(engine::ModelHandle handle);
+
     /// @brief モデルのアップロードヒープ破棄
     void DiscardModelUploads();
 
     /// @brief シーン内にゲームオブジェクトを作成する
     engine::ObjectHandle SpawnObject(engine::ModelHandle model);
 
-    /// @brief ゲームオブジェクトを削除する
+    /// @brief ゲームオブジェクトを削除する．子孫のオブジェクトも削除する
     void DespawnObject(engine::ObjectHandle handle);
 
+    /// @brief 親オブジェクトを設定する．Transformは親に対するローカル姿勢になる
+    /// @param child 子オブジェクト
+    /// @param parent 親オブジェクト，無効なハンドルなら親子関係を解除する
+    /// @return 循環する場合や無効なハンドルを指定した場合はfalse
+    bool SetParent(engine::ObjectHandle child, engine::ObjectHandle parent);
+
+    /// @brief 親オブジェクトの取得，親がなければ無効なハンドル
+    engine::ObjectHandle GetParent(engine::ObjectHandle handle);
+
+    /// @brief 変更のあったオブジェクトとその子孫のワールド行列を計算する
+    /// 親が子より前に並んだ順序で1回走査する
+    /// 親子関係に依存しない行列計算はjobSystemで分割して並列に行う
+    /// @param stats 再計算した数と省略した数の書き込み先
+    void UpdateWorldMatrices(JobSystem& jobSystem, RenderStats& stats);
+
     /// @brief ライトの作成
     engine::LightHandle SpawnDirectionalLight(const DirectionalLightDesc& desc);
     engine::LightHandle SpawnPointLight(const PointLightDesc& desc);
@@ -49,16 +92,14 @@ public:
     /// @brief ライトの削除
     void DespawnLight(engine::LightHandle handle);
 
-    /// @brief
-    /// フレーム開始時の処理，frameIndexの設定と遅延解放キューのクリア，必ずフェンス待機後に呼び出す
-    void BeginFrame(uint32_t frameIndex);
-
-    /// @brief 全ゲームオブジェクトに対してfnを呼び出す
+    /// @brief 全ゲームオブジェクトに対してfn(transform, model)を呼び出す
     template <typename Fn>
     void ForEachObject(Fn&& fn) {
-        m_gameObjectMap.ForEach(
-            // 全てのGameObjectをfnに渡すラムダ式
-            [&](std::unique_ptr<GameObject>& pObj) { fn(*pObj); });
+        auto& transforms = m_gameObjectMap.GetColumn<Column_Transform>();
+        auto& models     = m_gameObjectMap.GetColumn<Column_Model>();
+        for (uint32_t i = 0; i < m_gameObjectMap.Size(); i++) {
+            fn(transforms[i], models[i]);
+        }
     }
 
     /// @brief 全ライトに対してfnを呼び出す
@@ -69,8 +110,18 @@ public:
             [&](std::unique_ptr<Light>& pLight) { fn(*pLight); });
     }
 
-    /// @brief ハンドルに対応するゲームオブジェクトの取得
-    GameObject* GetObject(engine::ObjectHandle handle);
+    /// @brief ハンドルに対応するゲームオブジェクトの姿勢の取得
+    Transform* GetTransform(engine::ObjectHandle handle);
+
+    /// @brief ハンドルに対応するゲームオブジェクトのワールド行列の取得
+    /// UpdateWorldMatrices()の時点の値を返す
+    const DirectX::XMFLOAT4X4* GetWorldMatrix(engine::ObjectHandle handle);
+
+    /// @brief ハンドルに対応するゲームオブジェクトのモデルハンドルの取得
+    engine::ModelHandle GetModelHandle(engine::ObjectHandle handle);
+
+    /// @brief ゲームオブジェクトの格納先を取得する（列単位の一括処理用）
+    ObjectStorage& GetObjectStorage() { return m_gameObjectMap; }
 
     /// @brief ハンドルに対応するモデルの取得
     Model* GetModel(engine::ModelHandle handle);
@@ -85,13 +136,15 @@ private:
     //==============================================================
     // メンバ変数
     //==============================================================
-    // D3D12
-    ID3D12Device* m_pDevice    = nullptr;  // デバイス
-    DescriptorPool* m_pPoolCBV = nullptr;  // CBV用ディスクリプタプール
-
     // スロットマップ
-    SlotMap<std::unique_ptr<GameObject>, engine::GameObjectTag>
-        m_gameObjectMap;  // ゲームオブジェクトのスロットマップ
+    ObjectStorage m_gameObjectMap;  // ゲームオブジェクトのスロットマップ
+
+    // 親子関係（ノードIDはゲームオブジェクトのスロット番号）
+    SceneGraph m_sceneGraph;
+    std::vector<uint32_t> m_orderDataIndex;  // 並び位置ごとのデータインデックス
+    std::vector<uint8_t> m_orderChanged;  // 並び位置ごとのワールド行列変更フラグ
+    std::vector<uint32_t> m_changedIndices;  // 再計算するデータインデックス
+    std::vector<uint32_t> m_composePositions;  // 親の行列を掛ける並び位置
     SlotMap<std::unique_ptr<Model>, engine::ModelTag>
         m_modelMap;  // モデルのスロットマップ
     SlotMap<std::unique_ptr<Light>, engine::LightTag>
@@ -99,8 +152,4 @@ private:
 
     // カメラ
     Camera m_camera;  // シーンのカメラ
-
-    // 遅延解放キュー
-    RetireQueue<std::unique_ptr<GameObject>> m_retireQueue;
-    uint32_t m_currentFrameIndex = 0;  // 現在のフレームインデックス
 };
\ No newline at end of file
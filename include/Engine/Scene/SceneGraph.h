@@ -0,0 +1,103 @@
+/// @file SceneGraph.h
+/// @brief 親子関係の管理とトポロジカル順序の保持
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/// @brief ノードの親子関係を管理するクラス
+/// ノードIDは呼び出し側が決める安定した番号（SceneではSlotMapのスロット番号）
+/// 親が必ず子より前に並ぶ順序（幅優先順）を保持するので，
+/// ワールド行列は先頭から1回走査するだけで再帰なしに求まる
+class SceneGraph {
+public:
+    static constexpr uint32_t kNone = UINT32_MAX;  // 親なし・未登録
+
+    SceneGraph()  = default;
+    ~SceneGraph() = default;
+
+    /// @brief ノードをルートとして追加する
+    void AddNode(uint32_t id);
+
+    /// @brief ノードを削除する．子が残っている場合はルートになる
+    void RemoveNode(uint32_t id);
+
+    /// @brief 親を付け替える
+    /// @param child 子ノード
+    /// @param parent 新しい親ノード，kNoneならルートにする
+    /// @return 循環する場合や未登録のノードを指定した場合はfalse
+    bool SetParent(uint32_t child, uint32_t parent);
+
+    /// @brief 全ノードを削除する
+    void Clear();
+
+    /// @brief ソート済みの順序を確定する．付け替えで順序が崩れていれば並べ直す
+    void Sort();
+
+    //=========================================
+    // アクセサ
+    //=========================================
+    /// @brief 親ノードの取得
+    uint32_t GetParent(uint32_t id) const {
+        return id < m_nodes.size() ? m_nodes[id].parent : kNone;
+    }
+
+    /// @brief 最初の子ノードの取得
+    uint32_t GetFirstChild(uint32_t id) const {
+        return id < m_nodes.size() ? m_nodes[id].firstChild : kNone;
+    }
+
+    /// @brief 次の兄弟ノードの取得
+    uint32_t GetNextSibling(uint32_t id) const {
+        return id < m_nodes.size() ? m_nodes[id].nextSibling : kNone;
+    }
+
+    /// @brief ノードが登録されているか
+    bool Contains(uint32_t id) const {
+        return id < m_nodes.size() && m_nodes[id].alive;
+    }
+
+    /// @brief 親が子より前に並んだノードIDの列．Sort()の後に参照する
+    const std::vector<uint32_t>& GetOrder() const { return m_order; }
+
+    /// @brief GetOrder()の各要素について，親の並び位置（ルートはkNone）
+    const std::vector<uint32_t>& GetOrderParent() const {
+        return m_orderParent;
+    }
+
+    /// @brief 前回の参照以降に親が変わったノードか．参照するとフラグを下ろす
+    bool ConsumeReparented(uint32_t id) {
+        bool reparented         = m_nodes[id].reparented;
+        m_nodes[id].reparented = false;
+        return reparented;
+    }
+
+private:
+    /// @brief ノードの親子リンク
+    struct Node {
+        uint32_t parent      = kNone;  // 親ノード
+        uint32_t firstChild  = kNone;  // 最初の子ノード
+        uint32_t nextSibling = kNone;  // 次の兄弟ノード
+        uint32_t prevSibling = kNone;  // 前の兄弟ノード
+        uint32_t position    = kNone;  // m_order内の位置
+        bool alive           = false;  // 登録済みか
+        bool reparented      = false;  // 親が変わったか
+    };
+
+    //=========================================
+    // private methods
+    //=========================================
+    /// @brief 親の子リストから外す
+    void Unlink(uint32_t id);
+
+    /// @brief 親の子リストの先頭に加える
+    void Link(uint32_t id, uint32_t parent);
+
+    //=========================================
+    // private variables
+    //=========================================
+    std::vector<Node> m_nodes;            // ノードIDで引く親子リンク
+    std::vector<uint32_t> m_order;        // 親が子より前に並んだノードID
+    std::vector<uint32_t> m_orderParent;  // 各要素の親の並び位置
+    bool m_needsSort = false;  // 削除や付け替えで順序が崩れているか
+};
@@ -2,6 +2,8 @@
 
 #include <DirectXMath.h>
 
+#include <cstdint>
+
 // 座標系・回転について
 // DirectXの慣習に従い，左手系・回転軸の正方向から原点を見て時計回り
 // DirectXMathは行ベクトル規約のためワールド行列はS * R * Tの順で計算する
@@ -18,12 +20,32 @@ inline constexpr DirectX::XMFLOAT3 kRight   = { 1.0f, 0.0f, 0.0f };
 
 class Transform {
 public:
+    /// @brief 逆行列を計算できないとみなすスケールの大きさ
+    static constexpr float kMinInvertibleScale = 1e-6f;
+
     Transform();
     ~Transform();
 
+    Transform(const Transform&) = default;
+
+    /// @brief 代入では中身だけを写し，変更カウンタは自分のものを進める
+    /// カウンタまで写すと，記録済みの値と一致して変更を見落とすことがある
+    Transform& operator=(const Transform& other);
+
     /// @brief ワールド行列の計算
     DirectX::XMMATRIX CalcWorldMatrix() const;
 
+    /// @brief ワールド行列の逆行列の計算
+    /// 汎用の逆行列計算は使わず，T^-1 * R^T * S^-1 を成分から直接組み立てる
+    DirectX::XMMATRIX CalcInverseWorldMatrix() const;
+
+    /// @brief ワールド行列とその逆行列をまとめて計算する
+    /// 回転行列を共有するので，個別に計算するより速い
+    /// @param world ワールド行列の出力先
+    /// @param inverse 逆行列の出力先
+    void CalcWorldAndInverse(
+        DirectX::XMMATRIX& world, DirectX::XMMATRIX& inverse) const;
+
     /// @brief
     /// オイラー角（度）で姿勢を設定する．これは初期姿勢の設定などに使い，それ以外は基本的にRotateを使う
     /// @param rotation
@@ -61,14 +83,22 @@ public:
     //=========================================
     void SetPosition(const DirectX::XMFLOAT3& position) {
         m_position = position;
+        m_version++;
+    }
+    void SetScale(const DirectX::XMFLOAT3& scale) {
+        m_scale = scale;
+        m_version++;
     }
-    void SetScale(const DirectX::XMFLOAT3& scale) { m_scale = scale; }
     DirectX::XMFLOAT3 GetPosition() const { return m_position; }
     DirectX::XMFLOAT3 GetScale() const { return m_scale; }
     DirectX::XMFLOAT4 GetOrientation() const { return m_orientation; }
 
+    /// @brief 変更のたびに進むカウンタ．値が同じならワールド行列も同じ
+    uint32_t GetVersion() const { return m_version; }
+
 private:
     DirectX::XMFLOAT3 m_position;
     DirectX::XMFLOAT4 m_orientation;
     DirectX::XMFLOAT3 m_scale;
+    uint32_t m_version = 0;  // 変更カウンタ
 };
\ No newline at end of file
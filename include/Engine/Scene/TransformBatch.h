@@ -0,0 +1,59 @@
+/// @file TransformBatch.h
+/// @brief 多数のTRSからワールド行列と逆行列をまとめて計算する
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <cstdint>
+#include <span>
+
+class Transform;
+
+/// @brief ワールド行列・逆行列の一括計算
+/// 複数オブジェクトを1つのSIMDレジスタの各レーンに割り当てて計算する
+/// CPUがAVX2に対応していれば8個，それ以外はSSEで4個ずつ処理し，端数と
+/// SIMDが使えない環境ではスカラーで処理する
+/// AVX2の版はビルドの/arch指定に関係なく作り，実行時にcpuidで選ぶ
+/// どの幅でも同じ順番で演算するので，結果はビット単位で一致する
+/// Transform::CalcWorldAndInverseとは演算順序が異なるため，数ULPの誤差がある
+class TransformBatch {
+public:
+    /// @brief 使う命令セットの上限（テストや計測で経路を固定する用）
+    enum class SimdLevel {
+        Avx2,    // CPUが対応していればAVX2，していなければSSE
+        Sse,     // SSEまで
+        Scalar,  // SIMDを使わない
+    };
+
+    /// @brief AVX2の経路を使えるか（CPUがAVX2に対応しているか）
+    static bool IsAvx2Supported();
+
+    /// @brief 位置・回転・スケールの列からワールド行列と逆行列を計算する
+    /// @param positions 位置
+    /// @param orientations 回転（正規化済みクォータニオン）
+    /// @param scales スケール
+    /// @param outWorlds ワールド行列の出力先（行ベクトル規約，S * R * T）
+    /// @param outInverses 逆行列の出力先
+    /// @param simdLevel 使う命令セットの上限
+    static void CalcWorldAndInverse(
+        std::span<const DirectX::XMFLOAT3> positions,
+        std::span<const DirectX::XMFLOAT4> orientations,
+        std::span<const DirectX::XMFLOAT3> scales,
+        std::span<DirectX::XMFLOAT4X4> outWorlds,
+        std::span<DirectX::XMFLOAT4X4> outInverses,
+        SimdLevel simdLevel = SimdLevel::Avx2);
+
+    /// @brief indicesで指定したTransformについてワールド行列と逆行列を計算する
+    /// 出力先もindicesの位置に書き込む（変更のあった要素だけを処理する用途）
+    /// @param transforms Transformの列
+    /// @param indices 処理する要素の番号
+    /// @param outWorlds ワールド行列の出力先，transformsと同じ要素数
+    /// @param outInverses 逆行列の出力先，transformsと同じ要素数
+    static void CalcWorldAndInverse(std::span<const Transform> transforms,
+        std::span<const uint32_t> indices,
+        std::span<DirectX::XMFLOAT4X4> outWorlds,
+        std::span<DirectX::XMFLOAT4X4> outInverses);
+
+private:
+    TransformBatch() = delete;
+};
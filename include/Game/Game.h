@@ -8,7 +8,6 @@
 // 前方宣言
 class Engine;
 class CameraController;
-class GameObject;
 
 class Game {
 public:
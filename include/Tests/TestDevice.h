@@ -0,0 +1,11 @@
+/// @file   TestDevice.h
+/// @brief  テスト用のD3D12デバイス
+#pragma once
+
+#include <d3d12.h>
+
+/// @brief WARP（ソフトウェア実装）のデバイスを取得する
+/// GPUのない環境でもリソースの作成とマップを確認できる
+/// 最初の呼び出しで作成し，テスト全体で共有する（終了まで解放しない）
+/// @return 作成できなければnullptr
+ID3D12Device* GetWarpDevice();
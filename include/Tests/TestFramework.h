@@ -0,0 +1,83 @@
+/// @file   TestFramework.h
+/// @brief  テスト・計測用の最小限の登録と判定の仕組み
+/// GPUもウィンドウも使わないコンソールアプリとして動かす
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+/// @brief テスト（またはベンチマーク）の1件
+struct TestCase {
+    using Func = void (*)();
+
+    const char* name;
+    Func func;
+    bool isBenchmark;  // --benchを指定したときだけ実行する
+};
+
+/// @brief テストの登録先と失敗数の集計
+class TestRegistry {
+public:
+    TestRegistry()  = delete;
+    ~TestRegistry() = delete;
+
+    /// @brief テストを登録する（TEST_CASE・BENCHMARK_CASEから使う）
+    /// @return 静的変数の初期化に使うための値（常にtrue）
+    static bool Add(const char* name, TestCase::Func func, bool isBenchmark);
+
+    /// @brief 登録済みのテストの一覧
+    static const std::vector<TestCase>& GetCases();
+
+    /// @brief 判定の失敗を記録して表示する（複数スレッドから呼んでよい）
+    static void ReportFailure(const char* expression, const char* file,
+        int line);
+
+    /// @brief これまでに記録した失敗の数
+    static int GetFailureCount();
+
+private:
+    static std::vector<TestCase>& GetMutableCases();
+    static std::atomic<int> s_failureCount;
+};
+
+/// @brief 経過時間の計測（ベンチマーク用）
+class Stopwatch {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Stopwatch() : m_start(Clock::now()) {}
+
+    /// @brief 計測開始からの経過時間（ミリ秒）
+    double GetElapsedMs() const {
+        return std::chrono::duration<double, std::milli>(
+            Clock::now() - m_start)
+            .count();
+    }
+
+private:
+    Clock::time_point m_start;
+};
+
+// テストの定義
+#define TEST_CASE(name)                                                 \
+    static void name();                                                 \
+    static const bool name##Registered = TestRegistry::Add(#name, name, \
+        false);                                                         \
+    static void name()
+
+// ベンチマークの定義（--benchのときだけ実行する）
+#define BENCHMARK_CASE(name)                                            \
+    static void name();                                                 \
+    static const bool name##Registered = TestRegistry::Add(#name, name, \
+        true);                                                          \
+    static void name()
+
+// 条件が成り立たなければ失敗として記録し，テストは続ける
+#define CHECK(expression)                                      \
+    do {                                                       \
+        if (!(expression)) {                                   \
+            TestRegistry::ReportFailure(#expression, __FILE__, \
+                __LINE__);                                     \
+        }                                                      \
+    } while (0)
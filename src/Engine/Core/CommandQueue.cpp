@@ -56,6 +56,14 @@ void CommandQueue::Wait(UINT64 fenceValue, UINT timeout = INFINITE) {
     WaitForSingleObject(m_fenceEvent, timeout);
 }
 
+// 完了したフェンス値の取得
+UINT64 CommandQueue::GetCompletedValue() const {
+    if (m_pFence == nullptr) {
+        return 0;
+    }
+    return m_pFence->GetCompletedValue();
+}
+
 // 現時点のコマンドをすべて実行させる
 void CommandQueue::Flush() {
     if (m_pQueue == nullptr || m_pFence == nullptr) {
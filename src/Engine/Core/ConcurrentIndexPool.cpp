@@ -0,0 +1,298 @@
+#include "Engine/Core/ConcurrentIndexPool.h"
+
+#include <bit>
+#include <cassert>
+#include <vector>
+
+namespace /* anonymous */ {
+/// @brief 生きているプールと，使用中のキャッシュ番号
+/// ロックの順序は Registry → プールのm_mutex
+struct Registry {
+    std::mutex mutex;
+    std::vector<ConcurrentIndexPool*> pools;  // 生きているプール
+    uint32_t usedSlots = 0;                   // 使用中の番号のビット
+};
+
+Registry& GetRegistry() {
+    static Registry registry;
+    return registry;
+}
+}  // namespace
+
+static_assert(ConcurrentIndexPool::kMaxCachedThreads <= 32,
+    "usedSlots holds one bit per thread slot");
+
+ConcurrentIndexPool::ConcurrentIndexPool() {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.pools.push_back(this);
+}
+
+ConcurrentIndexPool::~ConcurrentIndexPool() {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::erase(registry.pools, this);
+}
+
+// 全てのインデックスを空きにする
+void ConcurrentIndexPool::Reset(uint32_t capacity) {
+    // 終了するスレッドがキャッシュを戻している途中で作り直さないようにする
+    std::lock_guard<std::mutex> registryLock(GetRegistry().mutex);
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_capacity = capacity;
+    m_ranges.Reset(capacity);
+    m_pCaches = std::make_unique<ThreadCache[]>(kMaxCachedThreads);
+    for (uint32_t slot = 0; slot < kMaxCachedThreads; slot++) {
+        m_pCaches[slot].Give(&m_pCaches[slot].block);
+    }
+
+    // デポに入るのは全体をkBatchSizeで割った数まで
+    // キャッシュへ移している途中のノードの分を足しておく
+    uint32_t magazineCount = capacity / kBatchSize + kMaxCachedThreads + 1;
+    m_pMagazines           = std::make_unique<Magazine[]>(magazineCount);
+    m_fullMagazines.Clear();
+    m_emptyMagazines.Clear();
+    for (uint32_t i = 0; i < magazineCount; i++) {
+        m_emptyMagazines.Push(m_pMagazines.get(), i);
+    }
+}
+
+// インデックスの確保
+uint32_t ConcurrentIndexPool::Allocate() {
+    ThreadCache* pCache = GetThreadCache();
+    CacheBlock* pBlock  = pCache != nullptr ? pCache->Take() : nullptr;
+    if (pBlock == nullptr) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_ranges.Allocate(1);
+    }
+
+    if (pBlock->count == 0) {
+        Refill(*pBlock);
+    }
+    uint32_t index = kInvalidIndex;
+    if (pBlock->count > 0) {
+        index = pBlock->indices[--pBlock->count];
+    }
+    pCache->Give(pBlock);
+    return index;
+}
+
+// インデックスの解放
+void ConcurrentIndexPool::Free(uint32_t index) {
+    if (index >= m_capacity) return;
+
+    ThreadCache* pCache = GetThreadCache();
+    CacheBlock* pBlock  = pCache != nullptr ? pCache->Take() : nullptr;
+    if (pBlock == nullptr) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_ranges.Free(index, 1);
+        return;
+    }
+
+    if (pBlock->count == kThreadCacheSize) {
+        Flush(*pBlock);
+    }
+    pBlock->indices[pBlock->count++] = index;
+    pCache->Give(pBlock);
+}
+
+// 連続した範囲の確保
+uint32_t ConcurrentIndexPool::AllocateRange(uint32_t count) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        uint32_t first = m_ranges.Allocate(count);
+        if (first == FreeRangeAllocator::kInvalidOffset) {
+            // デポに溜まった1個ずつの空きを戻して，結合してから探し直す
+            DrainDepotLocked();
+            first = m_ranges.Allocate(count);
+        }
+        if (first != FreeRangeAllocator::kInvalidOffset || !m_pCaches) {
+            return first == FreeRangeAllocator::kInvalidOffset ? kInvalidIndex
+                                                               : first;
+        }
+    }
+
+    // それでも取れなければ，各スレッドのキャッシュに残った空きも戻す
+    // 持ち主が確保・解放している最中のキャッシュは待たずに飛ばす
+    for (uint32_t slot = 0; slot < kMaxCachedThreads; slot++) {
+        ReturnCache(m_pCaches[slot]);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    DrainDepotLocked();
+    uint32_t first = m_ranges.Allocate(count);
+    return first == FreeRangeAllocator::kInvalidOffset ? kInvalidIndex : first;
+}
+
+// 連続した範囲の解放
+void ConcurrentIndexPool::FreeRange(uint32_t index, uint32_t count) {
+    if (index >= m_capacity || count > m_capacity - index) return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_ranges.Free(index, count);
+}
+
+//========================================================================
+// private methods
+//========================================================================
+// 呼び出しスレッドのキャッシュ
+ConcurrentIndexPool::ThreadCache* ConcurrentIndexPool::GetThreadCache() {
+    // このスレッドのキャッシュ番号（全プールで共通）
+    thread_local const ThreadSlot t_threadSlot;
+
+    uint32_t slot = t_threadSlot.Get();
+    if (slot >= kMaxCachedThreads || !m_pCaches) {
+        return nullptr;
+    }
+    return &m_pCaches[slot];
+}
+
+// キャッシュの空きを全て戻す
+void ConcurrentIndexPool::ReturnCache(ThreadCache& cache) {
+    // 持ち主が使用中なら，その空きは持ち主のキャッシュに残したままにする
+    CacheBlock* pBlock = cache.Take();
+    if (pBlock == nullptr) return;
+
+    if (pBlock->count > 0) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (uint32_t i = 0; i < pBlock->count; i++) {
+            m_ranges.Free(pBlock->indices[i], 1);
+        }
+        pBlock->count = 0;
+    }
+    cache.Give(pBlock);
+}
+
+// キャッシュへの補充
+void ConcurrentIndexPool::Refill(CacheBlock& block) {
+    // デポにあればロックを取らずに受け取る
+    uint32_t node = m_fullMagazines.Pop(m_pMagazines.get());
+    if (node != kInvalidIndex) {
+        const Magazine& magazine = m_pMagazines[node];
+        for (uint32_t index : magazine.indices) {
+            block.indices[block.count++] = index;
+        }
+        m_emptyMagazines.Push(m_pMagazines.get(), node);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // 連続で取れれば1回の検索で済む，小さい番号から使うように逆順に積む
+    uint32_t first = m_ranges.Allocate(kBatchSize);
+    if (first != FreeRangeAllocator::kInvalidOffset) {
+        for (uint32_t i = kBatchSize; i > 0; i--) {
+            block.indices[block.count++] = first + i - 1;
+        }
+        return;
+    }
+
+    // 断片化していれば1個ずつ取れるだけ取る
+    while (block.count < kBatchSize) {
+        uint32_t index = m_ranges.Allocate(1);
+        if (index == FreeRangeAllocator::kInvalidOffset) break;
+        block.indices[block.count++] = index;
+    }
+}
+
+// キャッシュの半分をデポに移す
+void ConcurrentIndexPool::Flush(CacheBlock& block) {
+    assert(block.count >= kBatchSize);
+    block.count -= kBatchSize;
+
+    uint32_t node = m_emptyMagazines.Pop(m_pMagazines.get());
+    if (node != kInvalidIndex) {
+        Magazine& magazine = m_pMagazines[node];
+        for (uint32_t i = 0; i < kBatchSize; i++) {
+            magazine.indices[i] = block.indices[block.count + i];
+        }
+        m_fullMagazines.Push(m_pMagazines.get(), node);
+        return;
+    }
+
+    // ノードが足りなければ直接戻す
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (uint32_t i = 0; i < kBatchSize; i++) {
+        m_ranges.Free(block.indices[block.count + i], 1);
+    }
+}
+
+// デポの空きを全て戻す
+void ConcurrentIndexPool::DrainDepotLocked() {
+    uint32_t node;
+    while ((node = m_fullMagazines.Pop(m_pMagazines.get())) != kInvalidIndex) {
+        for (uint32_t index : m_pMagazines[node].indices) {
+            m_ranges.Free(index, 1);
+        }
+        m_emptyMagazines.Push(m_pMagazines.get(), node);
+    }
+}
+
+//========================================================================
+// ThreadSlot
+//========================================================================
+// 空いている番号を受け取る
+ConcurrentIndexPool::ThreadSlot::ThreadSlot() {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    uint32_t freeSlots = ~registry.usedSlots;
+    if constexpr (kMaxCachedThreads < 32) {
+        freeSlots &= (1u << kMaxCachedThreads) - 1;
+    }
+    if (freeSlots != 0) {
+        m_slot = static_cast<uint32_t>(std::countr_zero(freeSlots));
+        registry.usedSlots |= 1u << m_slot;
+    }
+}
+
+// 全てのプールのキャッシュを戻してから番号を返す
+ConcurrentIndexPool::ThreadSlot::~ThreadSlot() {
+    if (m_slot == kInvalidIndex) return;
+
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (ConcurrentIndexPool* pPool : registry.pools) {
+        if (!pPool->m_pCaches) continue;
+        // 回収中で取り出せなければ，回収する側が全て戻す
+        pPool->ReturnCache(pPool->m_pCaches[m_slot]);
+    }
+    registry.usedSlots &= ~(1u << m_slot);
+}
+
+//========================================================================
+// MagazineStack
+//========================================================================
+// ノードを積む
+void ConcurrentIndexPool::MagazineStack::Push(
+    Magazine* pNodes, uint32_t node) {
+    uint64_t head = m_head.load(std::memory_order_relaxed);
+    do {
+        pNodes[node].next.store(
+            static_cast<uint32_t>(head), std::memory_order_relaxed);
+    } while (!m_head.compare_exchange_weak(head,
+        Pack(node, static_cast<uint32_t>(head >> 32) + 1),
+        std::memory_order_release, std::memory_order_relaxed));
+}
+
+// ノードを取り出す
+uint32_t ConcurrentIndexPool::MagazineStack::Pop(Magazine* pNodes) {
+    uint64_t head = m_head.load(std::memory_order_acquire);
+    while (true) {
+        uint32_t node = static_cast<uint32_t>(head);
+        if (node == kInvalidIndex) {
+            return kInvalidIndex;
+        }
+
+        // 他のスレッドが先に取り出して積み直していても，
+        // 更新回数が変わっているので比較交換は失敗する
+        uint32_t next = pNodes[node].next.load(std::memory_order_relaxed);
+        if (m_head.compare_exchange_weak(head,
+                Pack(next, static_cast<uint32_t>(head >> 32) + 1),
+                std::memory_order_acquire, std::memory_order_acquire)) {
+            return node;
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#include "Engine/Core/CpuFeatures.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+namespace /* anonymous */ {
+/// @brief cpuidで調べた対応状況
+struct Features {
+    bool avx2 = false;
+    bool f16c = false;
+};
+
+/// @brief cpuidとXCR0から対応状況を求める
+Features Detect() {
+    Features features;
+
+    uint32_t regs[4] = {};  // eax, ebx, ecx, edx
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    std::memcpy(regs, info, sizeof(regs));
+#else
+    const unsigned maxLeaf = __get_cpuid_max(0, nullptr);
+    __get_cpuid(1, &regs[0], &regs[1], &regs[2], &regs[3]);
+#endif
+
+    // OSがYMMレジスタを保存するか（OSXSAVEとXCR0）
+    const bool osxsave = (regs[2] & (1u << 27)) != 0;
+    const bool avx     = (regs[2] & (1u << 28)) != 0;
+    if (!osxsave || !avx) {
+        return features;
+    }
+#if defined(_MSC_VER)
+    const uint64_t xcr0 = _xgetbv(0);
+#else
+    uint32_t xcrLow, xcrHigh;
+    __asm__("xgetbv" : "=a"(xcrLow), "=d"(xcrHigh) : "c"(0));
+    const uint64_t xcr0 = (uint64_t{ xcrHigh } << 32) | xcrLow;
+#endif
+    if ((xcr0 & 0x6) != 0x6) {
+        return features;
+    }
+    features.f16c = (regs[2] & (1u << 29)) != 0;
+
+    if (maxLeaf < 7) {
+        return features;
+    }
+#if defined(_MSC_VER)
+    __cpuidex(info, 7, 0);
+    std::memcpy(regs, info, sizeof(regs));
+#else
+    __cpuid_count(7, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+    features.avx2 = (regs[1] & (1u << 5)) != 0;
+    return features;
+}
+
+/// @brief 初回の呼び出しで判定した結果
+const Features& GetFeatures() {
+    static const Features features = Detect();
+    return features;
+}
+}  // namespace
+
+// AVX2を使えるか
+bool CpuFeatures::HasAvx2() { return GetFeatures().avx2; }
+
+// F16Cを使えるか
+bool CpuFeatures::HasF16C() { return GetFeatures().f16c; }
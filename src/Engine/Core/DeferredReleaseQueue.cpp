@@ -0,0 +1,81 @@
+#include "Engine/Core/DeferredReleaseQueue.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <vector>
+
+DeferredReleaseQueue::DeferredReleaseQueue() = default;
+
+DeferredReleaseQueue::~DeferredReleaseQueue() { ReleaseAll(); }
+
+// フェンス値の順になる位置に追加する
+void DeferredReleaseQueue::Push(
+    std::unique_ptr<RetiredBase> pObject, uint64_t fenceValue) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // フェンス値は通常増える一方なので，ほとんどは末尾への追加になる
+    auto it = m_entries.end();
+    if (!m_entries.empty() && m_entries.back().fenceValue > fenceValue) {
+        it = std::upper_bound(m_entries.begin(), m_entries.end(), fenceValue,
+            [](uint64_t value, const Entry& entry) {
+                return value < entry.fenceValue;
+            });
+    }
+    m_entries.insert(it, Entry{ fenceValue, std::move(pObject) });
+}
+
+// 完了済みのオブジェクトの破棄
+void DeferredReleaseQueue::Collect(
+    uint64_t completedFenceValue, JobSystem* pJobSystem) {
+    // 完了済みの範囲は先頭から連続しているので，まとめて取り出す
+    std::vector<Entry> batch;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto end = m_entries.begin();
+        while (end != m_entries.end() &&
+               end->fenceValue <= completedFenceValue) {
+            ++end;
+        }
+        if (end == m_entries.begin()) {
+            return;
+        }
+
+        batch.reserve(static_cast<size_t>(end - m_entries.begin()));
+        std::move(m_entries.begin(), end, std::back_inserter(batch));
+        m_entries.erase(m_entries.begin(), end);
+    }
+
+    // ジョブシステムがなければその場で破棄する
+    if (pJobSystem == nullptr) {
+        return;
+    }
+
+    // Jobはコピーできる必要があるので，shared_ptrに包んで渡す
+    assert((m_pJobSystem == nullptr || m_pJobSystem == pJobSystem) &&
+           "DeferredReleaseQueue must use a single JobSystem");
+    m_pJobSystem = pJobSystem;
+    auto pBatch  = std::make_shared<std::vector<Entry>>(std::move(batch));
+    pJobSystem->Submit([pBatch]() { pBatch->clear(); }, &m_releaseCounter);
+}
+
+// 全て破棄する
+void DeferredReleaseQueue::ReleaseAll() {
+    // ワーカーで実行中の破棄を待つ
+    if (m_pJobSystem != nullptr) {
+        m_pJobSystem->Wait(m_releaseCounter);
+        m_pJobSystem = nullptr;
+    }
+
+    std::deque<Entry> entries;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        entries.swap(m_entries);
+    }
+}
+
+// 破棄待ちの数
+size_t DeferredReleaseQueue::GetPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
@@ -70,9 +70,7 @@ D3D12_GPU_DESCRIPTOR_HANDLE DescriptorAllocation::GetGPUHandle(
 // 解放
 void DescriptorAllocation::Release() {
     if (m_pPool) {
-        for (uint32_t i = 0; i < m_count; ++i) {
-            m_pPool->Free(m_index + i);
-        }
+        m_pPool->Free(m_index, m_count);
         m_pPool = nullptr;
         m_index = 0;
         m_count = 1;
@@ -30,11 +30,8 @@ std::unique_ptr<DescriptorPool> DescriptorPool::Create(ID3D12Device* pDevice,
     pool->m_shaderVisible =
         (flags & D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE) != 0;
 
-    // フリーリスト作成
-    pool->m_free.reserve(capacity);
-    for (uint32_t i = 0; i < capacity; i++) {
-        pool->m_free.push_back(i);
-    }
+    // 全体を1つの空き範囲にする
+    pool->m_free.Reset(capacity);
 
     // 正常終了
     return pool;
@@ -54,39 +51,13 @@ DescriptorAllocation DescriptorPool::AllocateRange(uint32_t count) {
     }
     if (count == 1) return Allocate();
 
-    // m_freeのデータ競合を防ぐため，mutexで保護する
-    // lockがスコープを抜ける時に自動でunlockされる
-    std::lock_guard<std::mutex> lock(m_mutex);
-
-    if (m_free.size() < count) {
-        assert(false && "Not enough free descriptors");
+    // 連続した領域を検索（排他制御はm_freeの内部で行う）
+    uint32_t startIndex = m_free.AllocateRange(count);
+    if (startIndex == ConcurrentIndexPool::kInvalidIndex) {
+        assert(false && "No continuous range found");
         return DescriptorAllocation(nullptr, UINT32_MAX, 0);
     }
-
-    // ソート
-    std::sort(m_free.begin(), m_free.end());
-
-    // 連続した領域を検索
-    for (size_t i = 0; i + count <= m_free.size(); i++) {
-        bool continuous = true;
-        for (uint32_t j = 1; j < count; j++) {
-            // i番目からcount個の要素が連続しているか確認
-            if (m_free[i + j] != m_free[i] + j) {
-                continuous = false;
-                break;
-            }
-        }
-
-        if (continuous) {
-            uint32_t startIndex = m_free[i];
-            // 割り当てた領域をフリーリストから削除
-            m_free.erase(m_free.begin() + i, m_free.begin() + i + count);
-            return DescriptorAllocation(this, startIndex, count);
-        }
-    }
-
-    assert(false && "No continuous range found");
-    return DescriptorAllocation(nullptr, UINT32_MAX, 0);
+    return DescriptorAllocation(this, startIndex, count);
 }
 
 //========================================================================
@@ -94,23 +65,22 @@ DescriptorAllocation DescriptorPool::AllocateRange(uint32_t count) {
 //========================================================================
 // インデックスの確保
 uint32_t DescriptorPool::ReserveIndex() {
-    // m_freeのデータ競合を防ぐため，mutexで保護する
-    // lockがスコープを抜ける時に自動でunlockされる
-    std::lock_guard<std::mutex> lock(m_mutex);
-
-    assert(!m_free.empty() && "DescriptorPool: No free descriptors available");
-
-    uint32_t index = m_free.back();
-    m_free.pop_back();
+    // スレッドごとのキャッシュから取り出すので，通常はロックを取らない
+    uint32_t index = m_free.Allocate();
+    assert(index != ConcurrentIndexPool::kInvalidIndex &&
+           "DescriptorPool: No free descriptors available");
     return index;
 }
 
 // 割り当ての解放
-void DescriptorPool::Free(uint32_t index) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+void DescriptorPool::Free(uint32_t index, uint32_t count) {
+    if (index >= m_capacity || count > m_capacity - index) return;
 
-    if (index >= m_capacity) return;
-    m_free.push_back(index);
+    if (count == 1) {
+        m_free.Free(index);
+    } else {
+        m_free.FreeRange(index, count);
+    }
 }
 
 // CPUハンドル取得
@@ -133,6 +103,5 @@ DescriptorPool::DescriptorPool() : m_capacity(0), m_shaderVisible(false) {}
 
 DescriptorPool::~DescriptorPool() {
     m_pHeap.reset();
-    m_free.clear();
     m_capacity = 0;
 }
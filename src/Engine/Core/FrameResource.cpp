@@ -1,6 +1,7 @@
 #include "Engine/Core/FrameResource.h"
 
 #include "Engine/Core/DxDebug.h"
+#include "Engine/Core/EngineConfig.h"
 #include "Engine/Core/GraphicsDevice.h"
 
 FrameResource::FrameResource()
@@ -27,6 +28,11 @@ bool FrameResource::Init(GraphicsDevice& graphicsDevice) {
         return false;
     }
 
+    // アップロード領域初期化
+    if (!m_uploadAllocator.Init(pDevice, config::kUploadRingSize)) {
+        return false;
+    }
+
     return true;
 }
 
@@ -39,6 +45,7 @@ void FrameResource::Term() {
     // リソースの解放
     m_sceneConstants.Term();
     m_lightBuffer.Term();
+    m_uploadAllocator.Term();
     m_pCmdAllocator.Reset();
 }
 
@@ -48,6 +55,9 @@ void FrameResource::BeginFrame(ID3D12GraphicsCommandList* pCmdList) {
 
     // コマンドリストのリセット
     pCmdList->Reset(m_pCmdAllocator.Get(), nullptr);
+
+    // 前回このフレームリソースで割り当てた領域はGPUが使い終えている
+    m_uploadAllocator.Reset();
     m_isActive = true;
 }
 
@@ -0,0 +1,124 @@
+#include "Engine/Core/FreeRangeAllocator.h"
+
+#include <bit>
+#include <cassert>
+#include <iterator>
+
+// 全体を空き範囲にする
+void FreeRangeAllocator::Reset(uint32_t capacity) {
+    m_ranges.clear();
+    for (auto& bucket : m_buckets) {
+        bucket.clear();
+    }
+    m_bucketMask = 0;
+    m_capacity   = capacity;
+    m_freeCount  = 0;
+
+    if (capacity > 0) {
+        InsertRange(0, capacity);
+    }
+}
+
+// 範囲の確保
+uint32_t FreeRangeAllocator::Allocate(uint32_t count) {
+    if (count == 0 || count > m_freeCount) {
+        return kInvalidOffset;
+    }
+
+    // 長さがcount以上であることが確実な，countを切り上げた2の累乗のバケットから探す
+    // 空でないバケットはビットマスクから1命令で見つかる
+    uint32_t minBucket = count == 1 ? 0 : std::bit_width(count - 1);
+    uint32_t mask =
+        minBucket < kBucketCount ? m_bucketMask & (~0u << minBucket) : 0;
+
+    auto it = m_ranges.end();
+    if (mask != 0) {
+        // 同じバケット内では最も短い範囲を使い，長い範囲を残しておく
+        uint32_t bucket = static_cast<uint32_t>(std::countr_zero(mask));
+        it              = m_ranges.find(m_buckets[bucket].begin()->second);
+    } else {
+        // 切り上げたバケットが全て空なら，countを含むバケットの中から
+        // 長さがcount以上で最も短い範囲を二分探索で探す
+        const auto& bucket = m_buckets[BucketOf(count)];
+        auto candidate     = bucket.lower_bound({ count, 0u });
+        if (candidate != bucket.end()) {
+            it = m_ranges.find(candidate->second);
+        }
+    }
+    if (it == m_ranges.end()) {
+        return kInvalidOffset;
+    }
+
+    // 先頭から切り出し，残りを空き範囲に戻す
+    uint32_t offset = it->first;
+    uint32_t length = it->second;
+    EraseRange(it);
+    if (length > count) {
+        InsertRange(offset + count, length - count);
+    }
+    return offset;
+}
+
+// 範囲の解放
+void FreeRangeAllocator::Free(uint32_t offset, uint32_t count) {
+    if (count == 0) return;
+    assert(offset < m_capacity && count <= m_capacity - offset &&
+           "FreeRangeAllocator: range is out of bounds");
+
+    uint32_t begin = offset;
+    uint32_t end   = offset + count;
+
+    // 後ろの空き範囲と隣接していれば結合する
+    auto next = m_ranges.lower_bound(offset);
+    if (next != m_ranges.end()) {
+        assert(next->first >= end && "FreeRangeAllocator: double free");
+        if (next->first == end) {
+            end += next->second;
+            EraseRange(next++);
+        }
+    }
+
+    // 前の空き範囲と隣接していれば結合する
+    if (next != m_ranges.begin()) {
+        auto prev = std::prev(next);
+        assert(prev->first + prev->second <= begin &&
+               "FreeRangeAllocator: double free");
+        if (prev->first + prev->second == begin) {
+            begin = prev->first;
+            EraseRange(prev);
+        }
+    }
+
+    InsertRange(begin, end - begin);
+}
+
+//========================================================================
+// private methods
+//========================================================================
+// バケット番号
+uint32_t FreeRangeAllocator::BucketOf(uint32_t length) {
+    assert(length > 0);
+    return static_cast<uint32_t>(std::bit_width(length)) - 1;
+}
+
+// 空き範囲の登録
+void FreeRangeAllocator::InsertRange(uint32_t offset, uint32_t length) {
+    m_ranges.emplace(offset, length);
+
+    uint32_t bucket = BucketOf(length);
+    m_buckets[bucket].emplace(length, offset);
+    m_bucketMask |= 1u << bucket;
+    m_freeCount += length;
+}
+
+// 空き範囲の登録解除
+void FreeRangeAllocator::EraseRange(
+    std::map<uint32_t, uint32_t>::iterator it) {
+    uint32_t bucket = BucketOf(it->second);
+    m_buckets[bucket].erase({ it->second, it->first });
+    if (m_buckets[bucket].empty()) {
+        m_bucketMask &= ~(1u << bucket);
+    }
+    m_freeCount -= it->second;
+    m_ranges.erase(it);
+}
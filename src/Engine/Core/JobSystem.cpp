@@ -0,0 +1,182 @@
+#include "Engine/Core/JobSystem.h"
+
+#include <cassert>
+#include <iterator>
+
+namespace /* anonymous */ {
+/// @brief このスレッドが使うキューの番号（ワーカー以外は0）
+thread_local const JobSystem* t_pOwner = nullptr;
+thread_local uint32_t t_queueIndex     = 0;
+}  // namespace
+
+JobSystem::JobSystem() = default;
+
+JobSystem::~JobSystem() { Term(); }
+
+// ワーカースレッドの起動
+bool JobSystem::Init(uint32_t workerCount) {
+    assert(!m_running && "JobSystem is already initialized.");
+
+    if (workerCount == 0) {
+        // メインスレッドも待機中にジョブを実行するので1つ減らす
+        uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    // 共有キュー + ワーカーごとのキュー
+    m_queues.clear();
+    for (uint32_t i = 0; i < workerCount + 1; i++) {
+        m_queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    m_running = true;
+    m_workers.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; i++) {
+        m_workers.emplace_back([this, i]() { WorkerMain(i + 1); });
+    }
+
+    return true;
+}
+
+// ワーカースレッドの終了
+void JobSystem::Term() {
+    if (!m_running) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_running = false;
+    }
+    m_wakeUp.notify_all();
+
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+
+    // ワーカーが拾わなかったジョブを実行して，待っているカウンタを解放する
+    Task task;
+    while (TryPop(0, task)) {
+        Execute(task);
+    }
+    m_queues.clear();
+}
+
+// ジョブの投入
+void JobSystem::Submit(Job job, JobCounter* pCounter) {
+    if (pCounter) {
+        pCounter->m_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // ワーカーが起動していなければその場で実行する
+    if (!m_running) {
+        Task task{ std::move(job), pCounter };
+        Execute(task);
+        return;
+    }
+
+    // 取り出した側が先に減らして0を下回らないように，積む前に数を増やす
+    {
+        // 待機に入ろうとしているワーカーが通知を取りこぼさないようにロックを取る
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_queuedJobs.fetch_add(1, std::memory_order_release);
+    }
+
+    WorkQueue& queue = *m_queues[GetQueueIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(Task{ std::move(job), pCounter });
+    }
+    m_wakeUp.notify_one();
+}
+
+// カウンタの完了待ち
+void JobSystem::Wait(JobCounter& counter) {
+    uint32_t queueIndex = GetQueueIndex();
+    while (!counter.IsDone()) {
+        // 待っている間はこのカウンタのジョブだけを実行する
+        Task task;
+        if (!m_queues.empty() && TryPop(queueIndex, task, &counter)) {
+            Execute(task);
+        } else {
+            // 実行中のジョブの完了待ち
+            std::this_thread::yield();
+        }
+    }
+}
+
+// ワーカースレッドの処理
+void JobSystem::WorkerMain(uint32_t queueIndex) {
+    t_pOwner     = this;
+    t_queueIndex = queueIndex;
+
+    while (true) {
+        Task task;
+        if (TryPop(queueIndex, task)) {
+            Execute(task);
+            continue;
+        }
+
+        // キューが空になったら投入されるまで眠る
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wakeUp.wait(lock, [this]() {
+            return !m_running ||
+                   m_queuedJobs.load(std::memory_order_acquire) > 0;
+        });
+        if (!m_running && m_queuedJobs.load() == 0) {
+            break;
+        }
+    }
+
+    t_pOwner     = nullptr;
+    t_queueIndex = 0;
+}
+
+// ジョブの取り出し
+bool JobSystem::TryPop(
+    uint32_t queueIndex, Task& task, const JobCounter* pCounter) {
+    auto matches = [pCounter](const Task& candidate) {
+        return pCounter == nullptr || candidate.pCounter == pCounter;
+    };
+
+    // 自分のキューは後ろから取り出す（直前に積んだものほどキャッシュに残っている）
+    {
+        WorkQueue& own = *m_queues[queueIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        auto it = std::find_if(own.tasks.rbegin(), own.tasks.rend(), matches);
+        if (it != own.tasks.rend()) {
+            task = std::move(*it);
+            own.tasks.erase(std::next(it).base());
+            m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // 他のキューからは前から盗む
+    const uint32_t queueCount = static_cast<uint32_t>(m_queues.size());
+    for (uint32_t offset = 1; offset < queueCount; offset++) {
+        WorkQueue& victim = *m_queues[(queueIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        auto it =
+            std::find_if(victim.tasks.begin(), victim.tasks.end(), matches);
+        if (it != victim.tasks.end()) {
+            task = std::move(*it);
+            victim.tasks.erase(it);
+            m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+// ジョブの実行
+void JobSystem::Execute(Task& task) {
+    task.job();
+    if (task.pCounter) {
+        task.pCounter->m_pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+// 呼び出しスレッドのキュー番号
+uint32_t JobSystem::GetQueueIndex() const {
+    return t_pOwner == this ? t_queueIndex : 0;
+}
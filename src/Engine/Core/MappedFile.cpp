@@ -0,0 +1,59 @@
+#include "Engine/Core/MappedFile.h"
+
+MappedFile::MappedFile() = default;
+
+MappedFile::~MappedFile() { Close(); }
+
+// ファイルを開いてマッピングする
+bool MappedFile::Open(const std::filesystem::path& path) {
+    Close();
+
+    // 先頭から順に読むことが多いので，先読みを有効にする
+    m_hFile = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr);
+    if (m_hFile == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    // サイズの取得，空のファイルはマッピングできない
+    LARGE_INTEGER size = {};
+    if (!GetFileSizeEx(m_hFile, &size) || size.QuadPart == 0) {
+        Close();
+        return false;
+    }
+
+    // ファイル全体をマッピング
+    m_hMapping =
+        CreateFileMappingW(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_hMapping == nullptr) {
+        Close();
+        return false;
+    }
+
+    m_pView = MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0);
+    if (m_pView == nullptr) {
+        Close();
+        return false;
+    }
+
+    m_size = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+// マッピングの解除
+void MappedFile::Close() {
+    if (m_pView != nullptr) {
+        UnmapViewOfFile(m_pView);
+        m_pView = nullptr;
+    }
+    if (m_hMapping != nullptr) {
+        CloseHandle(m_hMapping);
+        m_hMapping = nullptr;
+    }
+    if (m_hFile != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_hFile);
+        m_hFile = INVALID_HANDLE_VALUE;
+    }
+    m_size = 0;
+}
@@ -8,6 +8,7 @@
 #include "Engine/Graphics/ColorTarget.h"
 #include "Engine/Graphics/RenderTargetLayout.h"
 #include "Engine/Input/InputSystem.h"
+#include "Engine/Render/RenderStats.h"
 #include "Engine/Scene/Camera.h"
 #include "Engine/Scene/Scene.h"
 #include "Engine/Shader/ShaderConstants.h"
@@ -205,7 +206,8 @@ void DebugUI::Term() {
 }
 
 // デバッグUIのフレーム開始時の処理
-void DebugUI::BeginFrame(InputSystem& input, Camera& camera, Scene& scene) {
+void DebugUI::BeginFrame(InputSystem& input, Camera& camera, Scene& scene,
+    const RenderStats& stats) {
     // ImGui描画開始
     ImGui_ImplDX12_NewFrame();
     ImGui_ImplWin32_NewFrame();
@@ -217,7 +219,7 @@ void DebugUI::BeginFrame(InputSystem& input, Camera& camera, Scene& scene) {
 
     // デバッグGUIの作成
     // FPS表示UI
-    DrawFPSPanel();
+    DrawFPSPanel(stats);
 
     // 露出調整UI
     DrawExposurePanel(camera);
@@ -262,12 +264,42 @@ void DebugUI::Render(
     pCmdList->ResourceBarrier(1, &barrier);
 }
 
-// FPS表示UIの描画
-void DebugUI::DrawFPSPanel() {
+// FPS・描画統計表示UIの描画
+void DebugUI::DrawFPSPanel(const RenderStats& stats) {
     ImGuiIO& io = ImGui::GetIO();
     if (ImGui::Begin("Stats", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
         ImGui::Text(
             "%.1f FPS (%.3f ms/frame)", io.Framerate, 1000.0f / io.Framerate);
+
+        // ワールド行列の再計算数
+        ImGui::Text("Transforms: %u updated / %u skipped",
+            stats.transformsUpdated, stats.transformsSkipped);
+
+        // フレームごとのアップロード領域の使用量
+        ImGui::Text("Uploads: %u transforms (%.1f / %.1f KB)",
+            stats.transformsUploaded, stats.uploadBytes / 1024.0f,
+            stats.uploadCapacity / 1024.0f);
+
+        // 視錐台カリングの結果
+        ImGui::Text("Meshes: %u drawn / %u culled (%.3f ms)",
+            stats.meshesSubmitted, stats.meshesCulled, stats.cullTimeMs);
+
+        // メッシュレット単位のカリングで省略した三角形数
+        ImGui::Text("Triangles: %u / %u culled (%u meshlets)",
+            stats.trianglesCulled, stats.trianglesTested,
+            stats.meshletsCulled);
+
+        // 画面上の誤差から簡略化したLODを選んだメッシュ数
+        ImGui::Text("LODs: %u meshes simplified (%u triangles saved)",
+            stats.lodMeshes, stats.lodTrianglesSaved);
+
+        // 描画リストで省略できたバインド数
+        ImGui::Text("Binds: %u issued / %u elided", stats.bindsIssued,
+            stats.bindsElided);
+
+        // インスタンス描画による描画コマンド数の削減
+        ImGui::Text("Draws: %u for %u meshes (%u instanced)", stats.drawCalls,
+            stats.meshesSubmitted, stats.instances);
     }
     ImGui::End();
 }
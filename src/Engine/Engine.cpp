@@ -55,6 +55,9 @@ void Engine::Shutdown() {
     // GPUの処理が完了するまで待機
     m_Device.WaitForGPU();
 
+    // 遅延解放待ちのリソースを全て破棄
+    m_ReleaseQueue.ReleaseAll();
+
     // アプリケーション固有の終了処理
     TermApp();
 
@@ -64,15 +67,26 @@ void Engine::Shutdown() {
 
 // フェンス待機・コマンドリスト/アロケータのリセット
 void Engine::BeginFrame() {
-    m_Scene.BeginFrame(m_Renderer.GetFrameIndex());
-
     m_Renderer.BeginFrame();
 
-    m_DebugUI.BeginFrame(m_InputSystem, m_Scene.GetCamera(), m_Scene);
+    // GPUが使い終えたリソースをワーカースレッドで破棄
+    m_ReleaseQueue.Collect(
+        m_Device.GetCommandQueue().GetCompletedValue(), &m_JobSystem);
+
+    // 転送が完了したモデルをシーンに登録
+    m_AssetSystem.Update(m_Scene);
+
+    m_DebugUI.BeginFrame(
+        m_InputSystem, m_Scene.GetCamera(), m_Scene, m_Renderer.GetStats());
 }
 
 // 定数バッファの更新
 void Engine::Update() {
+    // 親子関係を反映したワールド行列の計算
+    m_Scene.UpdateWorldMatrices(m_JobSystem, m_Renderer.GetStats());
+
+    // シーン・ライトの定数バッファの更新
+    // ワールド行列は描画時に見えているものだけをアップロード領域に書き込む
     m_Renderer.UpdateConstants(m_Scene, m_DebugUI.GetDebugView());
 }
 
@@ -80,7 +94,8 @@ void Engine::Update() {
 void Engine::Render() {
     // シーンの描画
     m_Renderer.BeginScenePass();
-    m_ScenePass.Draw(m_Renderer.MakeScenePassBindings(m_AssetSystem), m_Scene);
+    m_ScenePass.Draw(m_Renderer.MakeScenePassBindings(m_AssetSystem), m_Scene,
+        m_Renderer.GetStats(), m_JobSystem);
 
     // デバッグUIの描画
     m_DebugUI.Render(m_Renderer.GetUITarget(), m_Renderer.GetCommandList());
@@ -135,11 +150,17 @@ void Engine::TermD3D() {
 
 // アプリケーション固有の初期化
 bool Engine::InitApp() {
+    // ジョブシステムの初期化
+    if (!m_JobSystem.Init()) {
+        OutputDebugStringW(L"Failed to initialize JobSystem.\n");
+        return false;
+    }
+
     // シーンの初期化
-    m_Scene.Init(m_Device);
+    m_Scene.Init();
 
     // アセット管理クラスの初期化
-    if (!m_AssetSystem.Init(m_Device)) {
+    if (!m_AssetSystem.Init(m_Device, m_JobSystem)) {
         return false;
     }
 
@@ -177,6 +198,9 @@ void Engine::TermApp() {
     // 描画パスの終了処理
     m_ScenePass.Term();
     m_CompositePass.Term();
+
+    // ワーカースレッドの終了
+    m_JobSystem.Term();
 }
 
 void Engine::ApplyRenderSize(uint32_t width, uint32_t height) {
@@ -195,6 +219,24 @@ AssetLoadScope Engine::CreateAssetLoadScope() {
     return m_AssetSystem.CreateAssetLoadScope(m_Scene);
 }
 
+// モデルの非同期ロード
+engine::ModelHandle Engine::LoadModelAsync(
+    const std::filesystem::path& path, AsyncModelLoader::Callback callback) {
+    return m_AssetSystem.LoadModelAsync(path, m_Scene, std::move(callback));
+}
+
+// モデルをシーンから外す
+void Engine::UnloadModel(engine::ModelHandle handle) {
+    std::unique_ptr<Model> pModel = m_Scene.UnregisterModel(handle);
+    if (pModel == nullptr) {
+        return;
+    }
+
+    // 記録中のフレームでも使うので，次に発行するフェンス値まで破棄を遅らせる
+    m_ReleaseQueue.Retire(
+        std::move(pModel), m_Device.GetCommandQueue().GetNextValue());
+}
+
 //=============================================
 // イベント関数
 //=============================================
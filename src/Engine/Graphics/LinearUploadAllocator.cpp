@@ -0,0 +1,122 @@
+#include "Engine/Graphics/LinearUploadAllocator.h"
+
+#include <Windows.h>
+
+#include <algorithm>
+#include <cassert>
+#include <string>
+
+namespace /* anonymous */ {
+/// @brief alignmentの倍数に切り上げる（alignmentは2の累乗）
+size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+}  // namespace
+
+LinearUploadAllocator::LinearUploadAllocator() = default;
+
+LinearUploadAllocator::~LinearUploadAllocator() { Term(); }
+
+bool LinearUploadAllocator::Init(ID3D12Device* pDevice, size_t size) {
+    // 引数チェック
+    if (pDevice == nullptr || size == 0) {
+        return false;
+    }
+
+    m_pDevice = pDevice;
+
+    // メインのバッファの作成
+    Page page;
+    if (!CreatePage(size, page)) {
+        Term();
+        return false;
+    }
+    m_pages.push_back(std::move(page));
+
+    m_offset    = 0;
+    m_usedBytes = 0;
+    return true;
+}
+
+void LinearUploadAllocator::Term() {
+    m_pages.clear();
+    m_pDevice   = nullptr;
+    m_offset    = 0;
+    m_usedBytes = 0;
+}
+
+// 割り当ての破棄
+void LinearUploadAllocator::Reset() {
+    // 追加ページを使ったフレームがあれば，その使用量が収まる大きさで作り直す
+    // 同程度の負荷が続いても追加ページが要らないように半分の余裕を持たせる
+    if (m_pages.size() > 1) {
+        size_t grownSize = m_usedBytes + m_usedBytes / 2;
+
+        Page page;
+        if (CreatePage(grownSize, page)) {
+            std::wstring message =
+                L"LinearUploadAllocator: grown to " +
+                std::to_wstring(page.size) + L" bytes.\n";
+            OutputDebugStringW(message.c_str());
+            m_pages[0] = std::move(page);
+        }
+        m_pages.resize(1);
+    }
+
+    m_offset    = 0;
+    m_usedBytes = 0;
+}
+
+// 領域の割り当て
+UploadAllocation LinearUploadAllocator::Allocate(
+    size_t size, size_t alignment) {
+    assert(!m_pages.empty() && "LinearUploadAllocator is not initialized.");
+    assert(alignment != 0 && (alignment & (alignment - 1)) == 0 &&
+           "Alignment must be a power of two.");
+    if (m_pages.empty() || size == 0) {
+        return {};
+    }
+
+    // 末尾のページに収まらなければ追加ページを作る
+    // ページの先頭は64KBに揃っているので，オフセットの切り上げだけで整列できる
+    size_t offset = AlignUp(m_offset, alignment);
+    if (offset + size > m_pages.back().size) {
+        Page page;
+        if (!CreatePage(std::max(m_pages[0].size, size), page)) {
+            assert(false && "Failed to create an upload overflow page.");
+            return {};
+        }
+        m_usedBytes += m_pages.back().size - m_offset;
+        m_pages.push_back(std::move(page));
+        m_offset = 0;
+        offset   = 0;
+    }
+
+    const Page& page = m_pages.back();
+
+    UploadAllocation allocation;
+    allocation.pCPU =
+        static_cast<uint8_t*>(page.pBuffer->GetMappedPtr()) + offset;
+    allocation.gpuAddress = page.pBuffer->GetGPUVirtualAddress() + offset;
+
+    m_usedBytes += offset + size - m_offset;
+    m_offset = offset + size;
+    return allocation;
+}
+
+// ページの作成
+bool LinearUploadAllocator::CreatePage(size_t size, Page& outPage) const {
+    // リソースの配置単位に切り上げて，端数の領域も割り当てに使う
+    size_t pageSize =
+        AlignUp(size, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+
+    auto pBuffer = std::make_unique<GPUBuffer>();
+    if (!pBuffer->CreateDynamic(m_pDevice, pageSize) ||
+        pBuffer->GetMappedPtr() == nullptr) {
+        return false;
+    }
+
+    outPage.pBuffer = std::move(pBuffer);
+    outPage.size    = pageSize;
+    return true;
+}
@@ -10,7 +10,8 @@ MaterialGPU::MaterialGPU()
       m_metallicRoughnessIndex(std::nullopt),
       m_normalIndex(std::nullopt),
       m_emissiveIndex(std::nullopt),
-      m_occlusionIndex(std::nullopt) {
+      m_occlusionIndex(std::nullopt),
+      m_doubleSided(false) {
     m_constants.baseColor = { 1.0f, 1.0f, 1.0f, 1.0f };
     m_constants.metallic  = 0.0f;
     m_constants.roughness = 0.5f;
@@ -42,6 +43,7 @@ bool MaterialGPU::Init(GraphicsDevice& graphicsDevice,
     m_constants.roughness = materialAsset.roughnessFactor;
     m_constants.emissive  = materialAsset.emissiveFactor;
     m_constants.occlusion = materialAsset.occlusionFactor;
+    m_doubleSided         = materialAsset.doubleSided;
 
     // 定数バッファの更新
     m_constantBuffer.Update(&m_constants, sizeof(shader::MaterialConstants));
@@ -82,6 +84,7 @@ void MaterialGPU::Term() {
     m_normalIndex            = std::nullopt;
     m_emissiveIndex          = std::nullopt;
     m_occlusionIndex         = std::nullopt;
+    m_doubleSided            = false;
 }
 
 // 描画で使うためのテクスチャを取得する
@@ -19,23 +19,38 @@ bool MeshGPU::Init(ID3D12Device* pDevice, ID3D12GraphicsCommandList* pCmdList,
     }
 
     // 頂点バッファの作成
-    auto pVB = std::make_unique<VertexBuffer>();
+    // 圧縮済みならそちらを使う
+    const MeshView view = mesh.GetView();
+    auto pVB            = std::make_unique<VertexBuffer>();
     if (!pVB->Init(pDevice, pCmdList,
-            sizeof(StandardVertex) * mesh.vertices.size(),
-            mesh.vertices.data())) {
+            static_cast<size_t>(view.vertexCount) * view.GetVertexStride(),
+            view.GetVertexStride(), view.pVertices)) {
         return false;
     }
     m_pVB = std::move(pVB);
 
     // インデックスバッファの作成
-    auto pIB = std::make_unique<IndexBuffer>();
-    if (!pIB->Init(pDevice, pCmdList, mesh.indices)) {
+    // 16bitに変換済みならそちらを使う
+    auto pIB  = std::make_unique<IndexBuffer>();
+    bool ibOK = false;
+    if (mesh.HasShortIndices()) {
+        ibOK = pIB->Init(pDevice, pCmdList, mesh.indices16);
+    } else {
+        ibOK = pIB->Init(pDevice, pCmdList, mesh.indices);
+    }
+    if (!ibOK) {
         return false;
     }
     m_pIB = std::move(pIB);
 
-    m_MaterialID = mesh.materialID;
-    m_IndexCount = static_cast<uint32_t>(mesh.indices.size());
+    m_MaterialID    = mesh.materialID;
+    m_IndexCount    = mesh.GetIndexCount();
+    m_Bounds        = mesh.bounds;
+    m_VertexFormat  = view.vertexFormat;
+    m_Quantization  = view.quantization;
+    m_Meshlets      = mesh.meshlets;
+    m_MeshletBounds = mesh.meshletBounds;
+    SetLods(view);
 
     return true;
 }
@@ -43,6 +58,12 @@ bool MeshGPU::Init(ID3D12Device* pDevice, ID3D12GraphicsCommandList* pCmdList,
 // VB/IBの作成 batch版
 bool MeshGPU::Init(ID3D12Device* pDevice, DirectX::ResourceUploadBatch& batch,
     const MeshAsset& mesh) {
+    return Init(pDevice, batch, mesh.GetView());
+}
+
+// VB/IBの作成 batch版（参照から）
+bool MeshGPU::Init(ID3D12Device* pDevice, DirectX::ResourceUploadBatch& batch,
+    const MeshView& mesh) {
     // 引数チェック
     if (!pDevice) {
         return false;
@@ -51,21 +72,32 @@ bool MeshGPU::Init(ID3D12Device* pDevice, DirectX::ResourceUploadBatch& batch,
     // 頂点バッファの作成
     auto pVB = std::make_unique<VertexBuffer>();
     if (!pVB->Init(pDevice, batch,
-            mesh.vertices.size() * sizeof(StandardVertex),
-            mesh.vertices.data())) {
+            static_cast<size_t>(mesh.vertexCount) * mesh.GetVertexStride(),
+            mesh.GetVertexStride(), mesh.pVertices)) {
         return false;
     }
     m_pVB = std::move(pVB);
 
     // インデックスバッファの作成
     auto pIB = std::make_unique<IndexBuffer>();
-    if (!pIB->Init(pDevice, batch, mesh.indices)) {
+    if (!pIB->Init(pDevice, batch,
+            static_cast<size_t>(mesh.indexCount) * mesh.GetIndexSize(),
+            mesh.indexFormat, mesh.pIndices)) {
         return false;
     }
     m_pIB = std::move(pIB);
 
-    m_MaterialID = mesh.materialID;
-    m_IndexCount = static_cast<uint32_t>(mesh.indices.size());
+    m_MaterialID   = mesh.materialID;
+    m_IndexCount   = mesh.indexCount;
+    m_Bounds       = mesh.bounds;
+    m_VertexFormat = mesh.vertexFormat;
+    m_Quantization = mesh.quantization;
+
+    // カリングはCPUで行うので，メッシュレットはCPU側に残す
+    m_Meshlets.assign(mesh.pMeshlets, mesh.pMeshlets + mesh.meshletCount);
+    m_MeshletBounds.assign(
+        mesh.pMeshletBounds, mesh.pMeshletBounds + mesh.meshletCount);
+    SetLods(mesh);
 
     return true;
 }
@@ -80,8 +112,23 @@ void MeshGPU::Term() {
         m_pIB->Term();
         m_pIB.reset();
     }
-    m_MaterialID = 0;
-    m_IndexCount = 0;
+    m_MaterialID   = 0;
+    m_IndexCount   = 0;
+    m_VertexFormat = VertexFormat::Standard;
+    m_Quantization = VertexQuantization{};
+    m_Meshlets.clear();
+    m_MeshletBounds.clear();
+    m_Lods.clear();
+}
+
+// LODの設定
+void MeshGPU::SetLods(const MeshView& mesh) {
+    // LODのないメッシュはインデックス全体をLOD0とする
+    if (mesh.lodCount == 0) {
+        m_Lods.assign(1, MeshLod{ 0, mesh.indexCount, 0.0f });
+        return;
+    }
+    m_Lods.assign(mesh.pLods, mesh.pLods + mesh.lodCount);
 }
 
 void MeshGPU::DiscardUpload() {
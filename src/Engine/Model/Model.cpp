@@ -6,17 +6,36 @@ bool Model::Init(GraphicsDevice& graphicsDevice,
     TextureManager* pTextureManager, DirectX::ResourceUploadBatch& batch,
     const ModelAsset& modelAsset) {
     // 引数チェック
-    if (!pTextureManager || !modelAsset.IsValid()) {
+    if (!modelAsset.IsValid()) {
+        return false;
+    }
+
+    // メッシュの参照を作って転送する
+    std::vector<MeshView> meshes;
+    meshes.reserve(modelAsset.meshes.size());
+    for (const auto& mesh : modelAsset.meshes) {
+        meshes.push_back(mesh.GetView());
+    }
+    return Init(
+        graphicsDevice, pTextureManager, batch, meshes, modelAsset.materials);
+}
+
+bool Model::Init(GraphicsDevice& graphicsDevice,
+    TextureManager* pTextureManager, DirectX::ResourceUploadBatch& batch,
+    std::span<const MeshView> meshes,
+    std::span<const MaterialAsset> materials) {
+    // 引数チェック
+    if (!pTextureManager || meshes.empty()) {
         return false;
     }
 
     ID3D12Device* pDevice = graphicsDevice.GetDevice();
 
     // メッシュをGPUに転送
-    m_meshes.reserve(modelAsset.meshes.size());
-    for (size_t i = 0; i < modelAsset.meshes.size(); i++) {
+    m_meshes.reserve(meshes.size());
+    for (size_t i = 0; i < meshes.size(); i++) {
         auto mesh = std::make_unique<MeshGPU>();
-        if (!mesh->Init(pDevice, batch, modelAsset.meshes[i])) {
+        if (!mesh->Init(pDevice, batch, meshes[i])) {
             Term();
             return false;
         }
@@ -24,11 +43,10 @@ bool Model::Init(GraphicsDevice& graphicsDevice,
     }
 
     // マテリアルをGPUに転送
-    m_materials.reserve(modelAsset.materials.size());
-    for (size_t i = 0; i < modelAsset.materials.size(); i++) {
+    m_materials.reserve(materials.size());
+    for (size_t i = 0; i < materials.size(); i++) {
         auto material = std::make_unique<MaterialGPU>();
-        if (!material->Init(
-                graphicsDevice, pTextureManager, modelAsset.materials[i])) {
+        if (!material->Init(graphicsDevice, pTextureManager, materials[i])) {
             Term();
             return false;
         }
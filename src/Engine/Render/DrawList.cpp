@@ -0,0 +1,59 @@
+#include "Engine/Render/DrawList.h"
+
+#include <algorithm>
+#include <array>
+
+// ソートキーの作成
+uint64_t DrawList::MakeSortKey(
+    uint32_t pipeline, uint32_t material, uint32_t mesh, float depth01) {
+    // 深度は0～1を量子化する
+    float clamped  = std::clamp(depth01, 0.0f, 1.0f);
+    uint64_t depth = static_cast<uint64_t>(
+        clamped * static_cast<float>((1u << kDepthBits) - 1));
+
+    // 各フィールドを幅に切り詰めて上位から詰める
+    auto field = [](uint32_t value, uint32_t bits) {
+        return static_cast<uint64_t>(value) & ((1ull << bits) - 1);
+    };
+    uint64_t key = field(pipeline, kPipelineBits);
+    key          = (key << kMaterialBits) | field(material, kMaterialBits);
+    key          = (key << kMeshBits) | field(mesh, kMeshBits);
+    key          = (key << kDepthBits) | depth;
+    return key;
+}
+
+// 基数ソート
+void DrawList::Sort() {
+    const uint32_t count = Size();
+    m_entries.resize(count);
+    m_scratch.resize(count);
+    for (uint32_t i = 0; i < count; i++) {
+        m_entries[i] = SortEntry{ m_packets[i].sortKey, i };
+    }
+
+    // 下位から8bitずつ安定な計数ソートを行う
+    // 全要素が同じ値になる桁は並びが変わらないので飛ばす
+    for (uint32_t shift = 0; shift < 64; shift += 8) {
+        std::array<uint32_t, 256> histogram = {};
+        for (const SortEntry& entry : m_entries) {
+            histogram[(entry.key >> shift) & 0xFF]++;
+        }
+        if (count == 0 ||
+            histogram[(m_entries[0].key >> shift) & 0xFF] == count) {
+            continue;
+        }
+
+        // 各値の書き込み開始位置
+        uint32_t offset = 0;
+        for (uint32_t& bucket : histogram) {
+            uint32_t n = bucket;
+            bucket     = offset;
+            offset += n;
+        }
+
+        for (const SortEntry& entry : m_entries) {
+            m_scratch[histogram[(entry.key >> shift) & 0xFF]++] = entry;
+        }
+        m_entries.swap(m_scratch);
+    }
+}
@@ -0,0 +1,129 @@
+#include "Engine/Render/FrustumCuller.h"
+
+using namespace DirectX;
+
+namespace /* anonymous */ {
+/// @brief 連続する4要素を1つのベクトルに読み込む
+XMVECTOR LoadLanes(const float* p) {
+    return XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(p));
+}
+}  // namespace
+
+// 登録の破棄
+void FrustumCuller::Clear() {
+    m_centerX.clear();
+    m_centerY.clear();
+    m_centerZ.clear();
+    m_extentX.clear();
+    m_extentY.clear();
+    m_extentZ.clear();
+    m_count = 0;
+    m_visible.clear();
+}
+
+// 視錐台の平面の計算
+void FrustumCuller::SetViewProjection(const XMMATRIX& viewProj) {
+    // 行ベクトル規約ではクリップ座標の各成分が行列の列との内積になる
+    // 転置して列を行として取り出す
+    XMMATRIX m = XMMatrixTranspose(viewProj);
+    XMVECTOR planes[kPlaneCount] = {
+        XMVectorAdd(m.r[3], m.r[0]),       // 左   -w <= x
+        XMVectorSubtract(m.r[3], m.r[0]),  // 右    x <= w
+        XMVectorAdd(m.r[3], m.r[1]),       // 下   -w <= y
+        XMVectorSubtract(m.r[3], m.r[1]),  // 上    y <= w
+        m.r[2],                            // 手前  0 <= z
+        XMVectorSubtract(m.r[3], m.r[2]),  // 奥    z <= w
+    };
+
+    for (uint32_t i = 0; i < kPlaneCount; i++) {
+        XMStoreFloat4(&m_planes[i], XMPlaneNormalize(planes[i]));
+    }
+}
+
+// バウンディングボックスの登録
+uint32_t FrustumCuller::Add(
+    const BoundingBox& localBounds, const XMMATRIX& world) {
+    // 中心は行列で変換し，半径は回転・スケール部分の絶対値で広げる
+    XMVECTOR center =
+        XMVector3Transform(XMLoadFloat3(&localBounds.Center), world);
+    XMVECTOR extents = XMLoadFloat3(&localBounds.Extents);
+    XMVECTOR worldExtents =
+        XMVectorMultiply(XMVectorSplatX(extents), XMVectorAbs(world.r[0]));
+    worldExtents = XMVectorMultiplyAdd(
+        XMVectorSplatY(extents), XMVectorAbs(world.r[1]), worldExtents);
+    worldExtents = XMVectorMultiplyAdd(
+        XMVectorSplatZ(extents), XMVectorAbs(world.r[2]), worldExtents);
+
+    m_centerX.push_back(XMVectorGetX(center));
+    m_centerY.push_back(XMVectorGetY(center));
+    m_centerZ.push_back(XMVectorGetZ(center));
+    m_extentX.push_back(XMVectorGetX(worldExtents));
+    m_extentY.push_back(XMVectorGetY(worldExtents));
+    m_extentZ.push_back(XMVectorGetZ(worldExtents));
+
+    return m_count++;
+}
+
+// 視錐台との判定
+const std::vector<uint32_t>& FrustumCuller::Cull() {
+    m_visible.clear();
+    if (m_count == 0) return m_visible;
+
+    // 4個ずつ読み込めるように詰め物をする（結果には含めない）
+    uint32_t paddedCount = (m_count + 3) & ~3u;
+    m_centerX.resize(paddedCount, 0.0f);
+    m_centerY.resize(paddedCount, 0.0f);
+    m_centerZ.resize(paddedCount, 0.0f);
+    m_extentX.resize(paddedCount, 0.0f);
+    m_extentY.resize(paddedCount, 0.0f);
+    m_extentZ.resize(paddedCount, 0.0f);
+
+    // 平面の成分を各レーンに複製しておく
+    XMVECTOR planeX[kPlaneCount], planeY[kPlaneCount], planeZ[kPlaneCount];
+    XMVECTOR planeW[kPlaneCount];
+    XMVECTOR absX[kPlaneCount], absY[kPlaneCount], absZ[kPlaneCount];
+    for (uint32_t p = 0; p < kPlaneCount; p++) {
+        XMVECTOR plane = XMLoadFloat4(&m_planes[p]);
+        planeX[p]      = XMVectorSplatX(plane);
+        planeY[p]      = XMVectorSplatY(plane);
+        planeZ[p]      = XMVectorSplatZ(plane);
+        planeW[p]      = XMVectorSplatW(plane);
+        absX[p]        = XMVectorAbs(planeX[p]);
+        absY[p]        = XMVectorAbs(planeY[p]);
+        absZ[p]        = XMVectorAbs(planeZ[p]);
+    }
+
+    const XMVECTOR zero = XMVectorZero();
+    for (uint32_t i = 0; i < paddedCount; i += 4) {
+        XMVECTOR cx = LoadLanes(&m_centerX[i]);
+        XMVECTOR cy = LoadLanes(&m_centerY[i]);
+        XMVECTOR cz = LoadLanes(&m_centerZ[i]);
+        XMVECTOR ex = LoadLanes(&m_extentX[i]);
+        XMVECTOR ey = LoadLanes(&m_extentY[i]);
+        XMVECTOR ez = LoadLanes(&m_extentZ[i]);
+
+        // 中心の符号付き距離に，法線方向へのAABBの半径を足したものが
+        // 負になる平面が1つでもあれば視錐台の外
+        XMVECTOR inside = XMVectorTrueInt();
+        for (uint32_t p = 0; p < kPlaneCount; p++) {
+            XMVECTOR dist = XMVectorMultiplyAdd(cx, planeX[p], planeW[p]);
+            dist          = XMVectorMultiplyAdd(cy, planeY[p], dist);
+            dist          = XMVectorMultiplyAdd(cz, planeZ[p], dist);
+            dist          = XMVectorMultiplyAdd(ex, absX[p], dist);
+            dist          = XMVectorMultiplyAdd(ey, absY[p], dist);
+            dist          = XMVectorMultiplyAdd(ez, absZ[p], dist);
+            inside = XMVectorAndInt(inside, XMVectorGreaterOrEqual(dist, zero));
+        }
+
+        XMUINT4 mask;
+        XMStoreUInt4(&mask, inside);
+        const uint32_t lanes[4] = { mask.x, mask.y, mask.z, mask.w };
+        for (uint32_t lane = 0; lane < 4 && i + lane < m_count; lane++) {
+            if (lanes[lane] != 0) {
+                m_visible.push_back(i + lane);
+            }
+        }
+    }
+
+    return m_visible;
+}
@@ -0,0 +1,78 @@
+#include "Engine/Render/InstanceBatcher.h"
+
+#include <algorithm>
+
+#include "Engine/Core/EngineConfig.h"
+#include "Engine/Core/JobSystem.h"
+
+using namespace DirectX;
+
+// 描画要素の破棄
+void InstanceBatcher::Clear() {
+    m_entries.clear();
+    m_groups.clear();
+    m_instanceEntries.clear();
+    m_instanceCount = 0;
+}
+
+// 描画要素の追加
+void InstanceBatcher::Add(
+    uint64_t key, uint32_t itemIndex, uint32_t dataIndex) {
+    m_entries.push_back(Entry{ key, itemIndex, dataIndex });
+}
+
+// グループ分けと詰め込み
+void InstanceBatcher::Build(uint32_t minInstances,
+    std::span<const XMFLOAT4X4> worlds,
+    std::span<const XMFLOAT4X4> worldInverses, shader::TransformConstants* pOut,
+    uint32_t capacity, JobSystem* pJobSystem) {
+    m_groups.clear();
+    m_instanceEntries.clear();
+    m_instanceCount = 0;
+
+    // 同じキーが連続するように並べる（同じキー内は追加順を保つ）
+    std::stable_sort(m_entries.begin(), m_entries.end(),
+        [](const Entry& a, const Entry& b) { return a.key < b.key; });
+
+    const uint32_t count = static_cast<uint32_t>(m_entries.size());
+    uint32_t begin       = 0;
+    while (begin < count) {
+        uint32_t end = begin + 1;
+        while (end < count && m_entries[end].key == m_entries[begin].key) {
+            end++;
+        }
+        uint32_t n = end - begin;
+
+        // 数が少ないか容量に収まらなければ，要素ごとに描画する
+        if (n < minInstances || pOut == nullptr ||
+            m_instanceCount + n > capacity) {
+            for (uint32_t i = begin; i < end; i++) {
+                m_groups.push_back(Group{ i, 1, kNotInstanced });
+            }
+            begin = end;
+            continue;
+        }
+
+        // 書き込む位置だけを決め，行列は全てのグループが決まってから書く
+        for (uint32_t i = begin; i < end; i++) {
+            m_instanceEntries.push_back(i);
+        }
+        m_groups.push_back(Group{ begin, n, m_instanceCount });
+        m_instanceCount += n;
+        begin = end;
+    }
+
+    // ワールド行列は転置，逆行列はそのまま書き込む（単体描画のCBと同じ）
+    // 書き込み先はインスタンスごとに別なので，範囲を分割して並列に書き込む
+    ParallelFor(pJobSystem, m_instanceCount, config::kObjectsPerJob,
+        [&](uint32_t first, uint32_t last) {
+            for (uint32_t slot = first; slot < last; slot++) {
+                uint32_t entry     = m_instanceEntries[slot];
+                uint32_t dataIndex = m_entries[entry].dataIndex;
+                shader::TransformConstants& tc = pOut[slot];
+                XMStoreFloat4x4(&tc.world,
+                    XMMatrixTranspose(XMLoadFloat4x4(&worlds[dataIndex])));
+                tc.worldInverse = worldInverses[dataIndex];
+            }
+        });
+}
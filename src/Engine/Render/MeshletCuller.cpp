@@ -0,0 +1,97 @@
+#include "Engine/Render/MeshletCuller.h"
+
+using namespace DirectX;
+
+// 視錐台と視点の設定
+void MeshletCuller::SetView(
+    const FrustumCuller& frustum, const XMFLOAT3& cameraPos) {
+    for (uint32_t i = 0; i < FrustumCuller::kPlaneCount; i++) {
+        m_planes[i] = frustum.GetPlane(i);
+    }
+    m_cameraPos = cameraPos;
+}
+
+// メッシュレットの判定
+const std::vector<MeshletCuller::IndexRange>& MeshletCuller::Cull(
+    const Meshlet* pMeshlets, const MeshletBounds* pBounds, uint32_t count,
+    const XMMATRIX& world, const XMMATRIX& worldInv, bool cullBackFaces) {
+    m_ranges.clear();
+
+    // 平面をローカル空間に移す（行ベクトル規約なので転置した行列で変換する）
+    // 正規化しないので，内積はワールド空間の距離のままで，
+    // 法線の長さが境界球の半径の拡大率になる（非一様スケールでも成り立つ）
+    constexpr uint32_t kPlaneCount = FrustumCuller::kPlaneCount;
+
+    XMMATRIX worldT = XMMatrixTranspose(world);
+    XMVECTOR planes[kPlaneCount];
+    XMVECTOR radiusScale[kPlaneCount];
+    for (uint32_t p = 0; p < kPlaneCount; p++) {
+        XMVECTOR plane = XMLoadFloat4(&m_planes[p]);
+        planes[p]      = XMVector4Transform(plane, worldT);
+        radiusScale[p] = XMVector3Length(planes[p]);
+    }
+
+    // 平面の表裏はアフィン変換で変わらないので，法線錐もローカル空間で判定する
+    XMVECTOR camera =
+        XMVector3Transform(XMLoadFloat3(&m_cameraPos), worldInv);
+
+    uint32_t triangleCount = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const Meshlet& meshlet      = pMeshlets[i];
+        const MeshletBounds& bounds = pBounds[i];
+        triangleCount += meshlet.triangleCount;
+        m_stats.meshletsTested++;
+
+        // 境界球が1つの平面の外側にあれば見えない
+        XMVECTOR center = XMVectorSetW(XMLoadFloat3(&bounds.center), 1.0f);
+        XMVECTOR radius = XMVectorReplicate(bounds.radius);
+        bool visible    = true;
+        for (uint32_t p = 0; p < kPlaneCount && visible; p++) {
+            XMVECTOR distance = XMVectorMultiplyAdd(
+                radius, radiusScale[p], XMVector4Dot(planes[p], center));
+            visible = XMVectorGetX(distance) >= 0.0f;
+        }
+
+        // 視点が法線錐の中にあれば全ての三角形が裏を向いている
+        if (visible && cullBackFaces && bounds.coneCutoff < 1.0f) {
+            XMVECTOR toApex =
+                XMVectorSubtract(XMLoadFloat3(&bounds.coneApex), camera);
+            XMVECTOR axis   = XMLoadFloat3(&bounds.coneAxis);
+            float alongAxis = XMVectorGetX(XMVector3Dot(toApex, axis));
+            float distance  = XMVectorGetX(XMVector3Length(toApex));
+            visible         = alongAxis < bounds.coneCutoff * distance;
+        }
+
+        if (!visible) {
+            m_stats.meshletsCulled++;
+            continue;
+        }
+
+        // 直前の範囲と続いていればつなげる
+        const uint32_t startIndex = meshlet.triangleOffset;
+        const uint32_t indexCount = meshlet.triangleCount * 3;
+        if (!m_ranges.empty() &&
+            m_ranges.back().startIndex + m_ranges.back().indexCount ==
+                startIndex) {
+            m_ranges.back().indexCount += indexCount;
+        } else {
+            m_ranges.push_back(IndexRange{ startIndex, indexCount });
+        }
+    }
+
+    // 範囲が多すぎると描画コマンドが増えるので，まとめて描く
+    if (m_ranges.size() > kMaxRangesPerMesh) {
+        const uint32_t first = m_ranges.front().startIndex;
+        const uint32_t end =
+            m_ranges.back().startIndex + m_ranges.back().indexCount;
+        m_ranges.assign(1, IndexRange{ first, end - first });
+    }
+
+    uint32_t drawnIndexCount = 0;
+    for (const IndexRange& range : m_ranges) {
+        drawnIndexCount += range.indexCount;
+    }
+    m_stats.trianglesTested += triangleCount;
+    m_stats.trianglesCulled += triangleCount - drawnIndexCount / 3;
+    return m_ranges;
+}
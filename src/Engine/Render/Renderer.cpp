@@ -179,11 +179,6 @@ void Renderer::UpdateConstants(Scene& scene, uint32_t debugView) {
     uint32_t frameIndex          = GetFrameIndex();
     FrameResource& frameResource = m_frameResources[frameIndex];
 
-    // 定数バッファの中身(行列やマテリアル情報)の更新
-    // シーン内の全ゲームオブジェクトのtransformを更新
-    scene.ForEachObject(
-        [&](GameObject& obj) { obj.UpdateTransformGPU(frameIndex); });
-
     // シーン内ライトの更新
     std::array<shader::LightConstants, config::kMaxLights> lights = {};
     uint32_t count = 0;  // 実際にコピーされたライトの数
@@ -347,6 +342,8 @@ ScenePassBindings Renderer::MakeScenePassBindings(AssetSystem& assetSystem) {
     context.displayCB = m_displayConstantsGPU.GetGPUAddress();
     context.lightSRV  = frameResource.GetLightBuffer().GetGPUHandle();
     context.iesSRV    = assetSystem.GetIesSrvGpuHandle();
+    context.pUploadAllocator = &frameResource.GetUploadAllocator();
+    context.viewportHeight   = m_swapChain.GetBackBuffer().GetHeight();
 
     assert(context.IsValid() && "ScenePassBindings is not valid.");
 
@@ -1,17 +1,73 @@
 #include "Engine/Render/ScenePass.h"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cmath>
 
 #include "Engine/Core/ComPtr.h"
 #include "Engine/Core/DxDebug.h"
 #include "Engine/Core/GraphicsDevice.h"
 #include "Engine/Graphics/GraphicsPipelineBuilder.h"
+#include "Engine/Graphics/LinearUploadAllocator.h"
 #include "Engine/Graphics/RootSignatureBuilder.h"
 #include "Engine/Model/VertexTypes.h"
+#include "Engine/Render/DrawList.h"
+#include "Engine/Render/InstanceBatcher.h"
 #include "Engine/Render/PassBindings.h"
+#include "Engine/Render/RenderStats.h"
 #include "Engine/Resource/AssetPath.h"
 #include "Engine/Resource/ShaderLoader.h"
 #include "Engine/Scene/Scene.h"
+#include "Engine/Shader/ShaderConstants.h"
+
+namespace /* anonymous */ {
+/// @brief インスタンス描画にまとめる最小のオブジェクト数
+constexpr uint32_t kMinInstancesPerDraw = 2;
+
+/// @brief メッシュのルート定数（VertexQuantization）の32bit値の数
+constexpr uint32_t kMeshConstantCount =
+    sizeof(VertexQuantization) / sizeof(uint32_t);
+
+/// @brief LODの選択で許す画面上の誤差（ピクセル）
+constexpr float kLodErrorPixels = 1.0f;
+
+/// @brief 画面上の誤差がkLodErrorPixels以下になる最も粗いLODを選ぶ
+/// @param pixelsPerUnit 視点から距離1の位置での長さ1のピクセル数
+uint32_t SelectLod(const std::vector<MeshLod>& lods,
+    const DirectX::BoundingBox& bounds, const DirectX::XMMATRIX& world,
+    const DirectX::XMFLOAT3& cameraPos, float pixelsPerUnit) {
+    using namespace DirectX;
+
+    if (lods.size() <= 1) {
+        return 0;
+    }
+
+    // 誤差はローカル空間の距離なので，最も大きい軸の拡大率を掛ける
+    float scale = std::max({ XMVectorGetX(XMVector3Length(world.r[0])),
+        XMVectorGetX(XMVector3Length(world.r[1])),
+        XMVectorGetX(XMVector3Length(world.r[2])) });
+
+    // AABBを囲む球の最も近い点までの距離（球の中にいれば元の形状）
+    XMVECTOR center   = XMVector3Transform(XMLoadFloat3(&bounds.Center), world);
+    XMVECTOR extents  = XMLoadFloat3(&bounds.Extents);
+    XMVECTOR toCenter = XMVectorSubtract(center, XMLoadFloat3(&cameraPos));
+
+    float radius   = XMVectorGetX(XMVector3Length(extents)) * scale;
+    float distance = XMVectorGetX(XMVector3Length(toCenter)) - radius;
+    if (distance <= 0.0f) {
+        return 0;
+    }
+
+    float pixelsPerError = pixelsPerUnit * scale / distance;
+    for (uint32_t i = static_cast<uint32_t>(lods.size()) - 1; i > 0; i--) {
+        if (lods[i].error * pixelsPerError <= kLodErrorPixels) {
+            return i;
+        }
+    }
+    return 0;
+}
+}  // namespace
 
 bool ScenePass::Init(GraphicsDevice& device) {
     m_pDevice = &device;
@@ -48,6 +104,8 @@ bool ScenePass::Init(GraphicsDevice& device) {
         // baseColor, metallic-roughness, normal, emissive, occlusion
         // [t0, space1] IES Profile Texture(Descriptor Table SRV)
         // [t0, space2] Light StructuredBuffer (Descriptor Table SRV)
+        // [t0, space3] Instance Transforms (Root SRV)
+        // [b4] MeshConstants (Root Constants, CompactVertexの復元)
         // [s0] Default Sampler (Static Sampler)
         // [s1] IES Profile Sampler (Static Sampler)
         builder
@@ -62,6 +120,10 @@ bool ScenePass::Init(GraphicsDevice& device) {
             .AddDescriptorTable(range, D3D12_SHADER_VISIBILITY_PIXEL)
             .AddDescriptorTable(iesRange, D3D12_SHADER_VISIBILITY_PIXEL)
             .AddDescriptorTable(lightRange, D3D12_SHADER_VISIBILITY_PIXEL)
+            .AddSRV(0, 3, D3D12_SHADER_VISIBILITY_VERTEX,
+                D3D12_ROOT_DESCRIPTOR_FLAG_DATA_VOLATILE)
+            .AddConstants(
+                kMeshConstantCount, 4, 0, D3D12_SHADER_VISIBILITY_VERTEX)
             .AddStaticSampler(0)
             .AddStaticSampler(1, D3D12_FILTER_MIN_MAG_MIP_LINEAR,
                 D3D12_TEXTURE_ADDRESS_MODE_CLAMP,  // 垂直角は端で止める
@@ -79,29 +141,48 @@ bool ScenePass::Init(GraphicsDevice& device) {
     // パイプラインステートの生成
     {
         // シェーダーの読み込み
-        engine::ComPtr<ID3DBlob> vsBlob;
+        // 頂点シェーダーは頂点フォーマットの順（VertexFormat）に並べる
+        engine::ComPtr<ID3DBlob> vsBlob[kVertexFormatCount];
+        engine::ComPtr<ID3DBlob> instancedVsBlob[kVertexFormatCount];
         engine::ComPtr<ID3DBlob> psBlob;
-        if (!LoadShader(L"shader/TestVS.cso", vsBlob) ||
+        if (!LoadShader(L"shader/TestVS.cso", vsBlob[0]) ||
+            !LoadShader(L"shader/InstancedVS.cso", instancedVsBlob[0]) ||
+            !LoadShader(L"shader/CompactVS.cso", vsBlob[1]) ||
+            !LoadShader(L"shader/CompactInstancedVS.cso", instancedVsBlob[1]) ||
             !LoadShader(L"shader/GGX_PS.cso", psBlob)) {
             OutputDebugStringW(L"Failed to load shaders.\n");
             return false;
         }
 
-        // グラフィックスパイプラインステートの設定
-        GraphicsPipelineBuilder pipelineBuilder;
-        pipelineBuilder.SetRootSignature(m_pRootSignature.Get())
-            .SetVertexShader(vsBlob.Get())
-            .SetPixelShader(psBlob.Get())
-            .SetInputLayout(StandardVertex::GetInputLayout())
-            .SetBlendState(BlendMode::Opaque)
-            .SetRenderTargetLayout(kSceneLayout);
-
-        if (!pipelineBuilder.Build(m_pDevice->GetDevice())) {
-            OutputDebugStringW(L"Failed to build graphics pipeline state.\n");
-            return false;
+        // 頂点シェーダーと入力レイアウト以外は全てのPSOで共通
+        auto buildPSO = [&](ID3DBlob* pVSBlob, VertexFormat format,
+                            engine::ComPtr<ID3D12PipelineState>& pPSO) {
+            // グラフィックスパイプラインステートの設定
+            GraphicsPipelineBuilder pipelineBuilder;
+            pipelineBuilder.SetRootSignature(m_pRootSignature.Get())
+                .SetVertexShader(pVSBlob)
+                .SetPixelShader(psBlob.Get())
+                .SetInputLayout(GetInputLayout(format))
+                .SetBlendState(BlendMode::Opaque)
+                .SetRenderTargetLayout(kSceneLayout);
+
+            if (!pipelineBuilder.Build(m_pDevice->GetDevice())) {
+                return false;
+            }
+            pPSO = pipelineBuilder.Get();
+            return true;
+        };
+
+        for (size_t i = 0; i < kVertexFormatCount; i++) {
+            VertexFormat format = static_cast<VertexFormat>(i);
+            if (!buildPSO(vsBlob[i].Get(), format, m_pPSO[i]) ||
+                !buildPSO(instancedVsBlob[i].Get(), format,
+                    m_pInstancedPSO[i])) {
+                OutputDebugStringW(
+                    L"Failed to build graphics pipeline state.\n");
+                return false;
+            }
         }
-
-        m_pPSO = pipelineBuilder.Get();
     }
 
     return true;
@@ -110,16 +191,20 @@ bool ScenePass::Init(GraphicsDevice& device) {
 void ScenePass::Term() {
     m_pDevice = nullptr;
 
-    m_pPSO.Reset();
+    for (size_t i = 0; i < kVertexFormatCount; i++) {
+        m_pPSO[i].Reset();
+        m_pInstancedPSO[i].Reset();
+    }
     m_pRootSignature.Reset();
 }
 
-void ScenePass::Draw(const ScenePassBindings& passBindings, Scene& scene) {
+void ScenePass::Draw(const ScenePassBindings& passBindings, Scene& scene,
+    RenderStats& stats, JobSystem& jobSystem) {
     auto pCmdList = passBindings.pCmdList;
 
     // パイプライン設定
+    // PSOは描画リストの記録時に設定する
     pCmdList->SetGraphicsRootSignature(m_pRootSignature.Get());
-    pCmdList->SetPipelineState(m_pPSO.Get());
 
     ID3D12DescriptorHeap* ppHeaps[] = { passBindings.pCbvSrvUavHeap };
     pCmdList->SetDescriptorHeaps(1, ppHeaps);
@@ -143,45 +228,246 @@ void ScenePass::Draw(const ScenePassBindings& passBindings, Scene& scene) {
     // PrimitiveTopologyの指定
     pCmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
-    // 全オブジェクトを描画
-    scene.ForEachObject([&](GameObject& obj) {
-        // [b1] TransformConstants (モデル単位)
-        pCmdList->SetGraphicsRootConstantBufferView(RootParam::CBV_Transform,
-            obj.GetTransformGPU(passBindings.frameIndex).GetGPUAddress());
-
-        // 各メッシュを描画
-        const auto model = scene.GetModel(obj.GetModelHandle());
-        if (model == nullptr) return;
-        const auto& meshes    = model->GetMeshes();
-        const auto& materials = model->GetMaterials();
-        for (auto& mesh : meshes) {
-            // このメッシュが使うマテリアルを取得
-            uint32_t materialID = mesh->GetMaterialID();
-
-            // マテリアルが存在しない場合は描画しない
-            if (materialID >= materials.size() ||
-                materials[materialID] == nullptr) {
-                assert(false && "Mesh has no valid material.");
-                continue;
-            }
+    // 視錐台カリング
+    // 全オブジェクトの全メッシュのAABBをワールド空間に変換して判定する
+    auto cullStart = std::chrono::high_resolution_clock::now();
+
+    Camera& camera                 = scene.GetCamera();
+    DirectX::XMFLOAT4X4 view       = camera.GetViewMatrix();
+    DirectX::XMFLOAT4X4 projection = camera.GetProjectionMatrix();
+    m_culler.Clear();
+    m_culler.SetViewProjection(DirectX::XMMatrixMultiply(
+        DirectX::XMLoadFloat4x4(&view), DirectX::XMLoadFloat4x4(&projection)));
+
+    Scene::ObjectStorage& objects = scene.GetObjectStorage();
+
+    const auto& modelHandles = objects.GetColumn<Scene::Column_Model>();
+    const auto& worlds       = objects.GetColumn<Scene::Column_World>();
+    const auto& worldInvs    = objects.GetColumn<Scene::Column_WorldInv>();
+
+    m_drawItems.clear();
+    for (uint32_t i = 0; i < objects.Size(); i++) {
+        const Model* pModel = scene.GetModel(modelHandles[i]);
+        if (pModel == nullptr) continue;
+
+        DirectX::XMMATRIX world = DirectX::XMLoadFloat4x4(&worlds[i]);
+        const auto& meshes      = pModel->GetMeshes();
+        for (uint32_t m = 0; m < meshes.size(); m++) {
+            m_culler.Add(meshes[m]->GetBounds(), world);
+            m_drawItems.push_back(DrawItem{ i, m });
+        }
+    }
+    const std::vector<uint32_t>& visible = m_culler.Cull();
+
+    auto cullEnd = std::chrono::high_resolution_clock::now();
+    stats.cullTimeMs =
+        std::chrono::duration<float, std::milli>(cullEnd - cullStart).count();
+    stats.meshesSubmitted = static_cast<uint32_t>(visible.size());
+    stats.meshesCulled    = m_culler.Size() - stats.meshesSubmitted;
+
+    // 同じモデル・メッシュの描画をまとめ，アップロード領域に行列を詰める
+    // 見えている数だけ確保すれば全てインスタンス描画になっても足りる
+    LinearUploadAllocator& uploadAllocator = *passBindings.pUploadAllocator;
+    const uint32_t visibleCount = static_cast<uint32_t>(visible.size());
+    UploadAllocation instanceAlloc;
+    if (visibleCount > 0) {
+        instanceAlloc = uploadAllocator.Allocate(
+            sizeof(shader::TransformConstants) * visibleCount);
+    }
 
-            // マテリアルをバインド
-            // [b2] MaterialConstants (マテリアル単位)
-            pCmdList->SetGraphicsRootConstantBufferView(RootParam::CBV_Material,
-                materials[materialID]->GetConstantBufferGPUAddress());
+    // 見えるメッシュごとに画面上の誤差からLODを選ぶ
+    // 同じLODのものだけをインスタンス描画にまとめる
+    const DirectX::XMFLOAT3 cameraPos = camera.GetTransform().GetPosition();
+    const float pixelsPerUnit =
+        passBindings.viewportHeight /
+        (2.0f * std::tan(camera.GetFovYRad() * 0.5f));
+
+    m_batcher.Clear();
+    for (uint32_t itemIndex : visible) {
+        DrawItem& item      = m_drawItems[itemIndex];
+        const Model* pModel = scene.GetModel(modelHandles[item.dataIndex]);
+        const auto& mesh    = pModel->GetMeshes()[item.meshIndex];
+
+        item.lodIndex = SelectLod(mesh->GetLods(), mesh->GetBounds(),
+            DirectX::XMLoadFloat4x4(&worlds[item.dataIndex]), cameraPos,
+            pixelsPerUnit);
+
+        uint64_t modelIndex = modelHandles[item.dataIndex].index;
+        uint64_t lodIndex   = item.lodIndex;
+        uint64_t key =
+            (modelIndex << 32) | (lodIndex << 16) | item.meshIndex;
+        m_batcher.Add(key, itemIndex, item.dataIndex);
+    }
+    m_batcher.Build(kMinInstancesPerDraw, worlds, worldInvs,
+        static_cast<shader::TransformConstants*>(instanceAlloc.pCPU),
+        instanceAlloc.IsValid() ? visibleCount : 0, &jobSystem);
+    uint32_t transformsUploaded = m_batcher.GetInstanceCount();
+
+    // グループごとに描画リストに積む
+    // ソートキーはパイプライン・マテリアル・メッシュ・深度の順で，
+    // 同じマテリアルやメッシュが連続するように並べる
+    DirectX::XMMATRIX viewMat = DirectX::XMLoadFloat4x4(&view);
+    const float invFarZ       = 1.0f / camera.GetFarZ();
+
+    // 単体描画はメッシュレット単位でも視錐台と法線錐で判定する
+    m_meshletCuller.SetView(m_culler, cameraPos);
+    m_meshletCuller.ResetStats();
+    float meshletCullTimeMs = 0.0f;
+
+    uint32_t lodMeshes         = 0;
+    uint32_t lodTrianglesSaved = 0;
+
+    const auto& entries = m_batcher.GetEntries();
+    m_drawList.Clear();
+    for (const InstanceBatcher::Group& group : m_batcher.GetGroups()) {
+        // 代表（先頭）の要素でメッシュ・マテリアル・深度を決める
+        const InstanceBatcher::Entry& head = entries[group.firstEntry];
+        const DrawItem& item               = m_drawItems[head.itemIndex];
+
+        engine::ModelHandle modelHandle = modelHandles[item.dataIndex];
+        const Model* pModel             = scene.GetModel(modelHandle);
+        const auto& mesh                = pModel->GetMeshes()[item.meshIndex];
+        const auto& materials           = pModel->GetMaterials();
+
+        // このメッシュが使うマテリアルを取得
+        uint32_t materialID = mesh->GetMaterialID();
+
+        // マテリアルが存在しない場合は描画しない
+        if (materialID >= materials.size() ||
+            materials[materialID] == nullptr) {
+            assert(false && "Mesh has no valid material.");
+            continue;
+        }
 
-            // [t0-t4] PBR Textures
-            pCmdList->SetGraphicsRootDescriptorTable(RootParam::SRV_Texture,
-                materials[materialID]->GetSrvTableBaseGPUHandle());
+        // オブジェクトの原点のビュー空間での深度（手前から描く）
+        DirectX::XMVECTOR origin = DirectX::XMVector3Transform(
+            DirectX::XMLoadFloat4x4(&worlds[item.dataIndex]).r[3], viewMat);
+        float depth01 = DirectX::XMVectorGetZ(origin) * invFarZ;
+
+        // マテリアル・メッシュの番号はモデルのスロット番号と組み合わせて作る
+        // キーは並び順にしか使わないので，切り捨てで重複しても描画は正しい
+        // パイプラインの番号は頂点フォーマットと単体/インスタンス描画の組
+        bool instanced =
+            group.firstInstance != InstanceBatcher::kNotInstanced;
+        size_t format        = static_cast<size_t>(mesh->GetVertexFormat());
+        uint32_t pipelineKey = static_cast<uint32_t>(format * 2) +
+                               (instanced ? 1 : 0);
+        uint32_t materialKey = (modelHandle.index << 8) | materialID;
+        uint32_t meshKey     = (modelHandle.index << 8) | item.meshIndex;
+        const MaterialGPU& material = *materials[materialID];
+
+        // 選んだLODのインデックスの範囲を描く
+        const std::vector<MeshLod>& lods = mesh->GetLods();
+        const MeshLod& lod               = lods[item.lodIndex];
+        if (item.lodIndex > 0) {
+            lodMeshes += group.entryCount;
+            lodTrianglesSaved +=
+                (lods[0].indexCount - lod.indexCount) / 3 * group.entryCount;
+        }
+
+        // インスタンス描画は見え方が1つずつ違うのでメッシュ全体を描く
+        // メッシュレットはLOD0にしかないので，LOD1以降も全体を描く
+        // 片面のマテリアルは裏面が見えないものとして裏向きのメッシュレットも
+        // 省き，両面描画のマテリアルは視錐台の判定だけにする
+        const std::vector<MeshletCuller::IndexRange>* pRanges = nullptr;
+        if (!instanced && item.lodIndex == 0 &&
+            !mesh->GetMeshlets().empty()) {
+            auto meshletStart = std::chrono::high_resolution_clock::now();
+            pRanges           = &m_meshletCuller.Cull(
+                mesh->GetMeshlets().data(), mesh->GetMeshletBounds().data(),
+                static_cast<uint32_t>(mesh->GetMeshlets().size()),
+                DirectX::XMLoadFloat4x4(&worlds[item.dataIndex]),
+                DirectX::XMLoadFloat4x4(&worldInvs[item.dataIndex]),
+                !material.IsDoubleSided());
+            auto meshletEnd = std::chrono::high_resolution_clock::now();
+
+            meshletCullTimeMs += std::chrono::duration<float, std::milli>(
+                meshletEnd - meshletStart).count();
+
+            // 全てのメッシュレットが見えない
+            if (pRanges->empty()) continue;
+        }
 
-            // 頂点バッファ・インデックスバッファの設定
-            auto vbv = mesh->GetVertexBufferView();
-            auto ibv = mesh->GetIndexBufferView();
-            pCmdList->IASetVertexBuffers(0, 1, &vbv);
-            pCmdList->IASetIndexBuffer(&ibv);
+        DrawPacket packet = {};
+        packet.sortKey    = DrawList::MakeSortKey(
+            pipelineKey, materialKey, meshKey, depth01);
+        if (instanced) {
+            packet.pPSO         = m_pInstancedPSO[format].Get();
+            packet.instanceData = instanceAlloc.gpuAddress +
+                                  sizeof(shader::TransformConstants) *
+                                      group.firstInstance;
+            packet.instanceCount = group.entryCount;
+        } else {
+            // ワールド行列は転置，逆行列はそのまま書き込む
+            shader::TransformConstants tc;
+            DirectX::XMStoreFloat4x4(&tc.world,
+                DirectX::XMMatrixTranspose(
+                    DirectX::XMLoadFloat4x4(&worlds[item.dataIndex])));
+            tc.worldInverse = worldInvs[item.dataIndex];
+
+            UploadAllocation transformAlloc = uploadAllocator.Push(tc);
+            if (!transformAlloc.IsValid()) continue;
+            transformsUploaded++;
+
+            packet.pPSO          = m_pPSO[format].Get();
+            packet.transformCB   = transformAlloc.gpuAddress;
+            packet.instanceCount = 1;
+        }
+        packet.materialCB   = material.GetConstantBufferGPUAddress();
+        packet.textureTable = material.GetSrvTableBaseGPUHandle();
+        packet.vbv          = mesh->GetVertexBufferView();
+        packet.ibv          = mesh->GetIndexBufferView();
+        packet.startIndex   = lod.indexOffset;
+        packet.indexCount   = lod.indexCount;
+        if (mesh->GetVertexFormat() == VertexFormat::Compact) {
+            packet.pMeshConstants    = &mesh->GetQuantization();
+            packet.meshConstantCount = kMeshConstantCount;
+        }
 
-            // 描画コマンドの発行
-            pCmdList->DrawIndexedInstanced(mesh->GetIndexCount(), 1, 0, 0, 0);
+        if (pRanges == nullptr) {
+            m_drawList.Add(packet);
+        } else {
+            // 見えるメッシュレットの範囲ごとに描く（バインドは同じ）
+            for (const MeshletCuller::IndexRange& range : *pRanges) {
+                packet.startIndex = range.startIndex;
+                packet.indexCount = range.indexCount;
+                m_drawList.Add(packet);
+            }
         }
-    });
+    }
+
+    stats.cullTimeMs += meshletCullTimeMs;
+
+    const MeshletCuller::Stats& meshletStats = m_meshletCuller.GetStats();
+
+    stats.meshletsCulled  = meshletStats.meshletsCulled;
+    stats.trianglesTested = meshletStats.trianglesTested;
+    stats.trianglesCulled = meshletStats.trianglesCulled;
+
+    stats.lodMeshes         = lodMeshes;
+    stats.lodTrianglesSaved = lodTrianglesSaved;
+
+    // 並べ替えて，直前と同じバインドを省略しながら記録する
+    // [b1] TransformConstants (単体描画)
+    // [t0, space3] Instance Transforms (インスタンス描画)
+    // [b2] MaterialConstants (マテリアル単位)
+    // [t0-t4] PBR Textures (マテリアル単位)
+    // [b4] MeshConstants (CompactVertexのメッシュ単位)
+    DrawListStats drawStats;
+    m_drawList.Sort();
+    m_drawList.Record(pCmdList,
+        DrawList::RootSlots{ RootParam::CBV_Transform,
+            RootParam::SRV_Instances, RootParam::CBV_Material,
+            RootParam::SRV_Texture, RootParam::CONST_Mesh },
+        drawStats);
+    stats.bindsIssued = drawStats.bindsIssued;
+    stats.bindsElided = drawStats.bindsElided;
+    stats.drawCalls   = drawStats.drawCalls;
+    stats.instances   = m_batcher.GetInstanceCount();
+
+    stats.transformsUploaded = transformsUploaded;
+    stats.uploadBytes =
+        static_cast<uint32_t>(uploadAllocator.GetUsedBytes());
+    stats.uploadCapacity =
+        static_cast<uint32_t>(uploadAllocator.GetCapacity());
 }
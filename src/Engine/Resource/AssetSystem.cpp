@@ -3,11 +3,13 @@
 #include <directxtk12/ResourceUploadBatch.h>
 
 #include <memory>
+#include <utility>
 
+#include "Engine/Core/EngineConfig.h"
 #include "Engine/Core/GraphicsDevice.h"
 #include "Engine/Resource/AssetLoadScope.h"
 
-bool AssetSystem::Init(GraphicsDevice& graphicsDevice) {
+bool AssetSystem::Init(GraphicsDevice& graphicsDevice, JobSystem& jobSystem) {
     m_pGraphicsDevice = &graphicsDevice;
 
     // TextureManagerの初期化
@@ -16,8 +18,18 @@ bool AssetSystem::Init(GraphicsDevice& graphicsDevice) {
         return false;
     }
 
+    // インポート結果のキャッシュの初期化，失敗しても毎回インポートするだけ
+    wchar_t exePath[MAX_PATH] = {};
+    GetModuleFileNameW(nullptr, exePath, MAX_PATH);
+    auto cacheDir = std::filesystem::path(exePath).parent_path() /
+                    config::kDerivedDataCacheDir;
+    if (!m_derivedDataCache.Init(cacheDir, config::kDerivedDataCacheMaxBytes)) {
+        OutputDebugStringW(L"Failed to initialize DerivedDataCache.\n");
+    }
+
     // ModelLoaderの初期化
-    if (!m_modelLoader.Init(graphicsDevice, m_textureManager)) {
+    if (!m_modelLoader.Init(graphicsDevice, m_textureManager,
+            &m_derivedDataCache, &jobSystem)) {
         OutputDebugStringW(L"Failed to initialize ModelLoader.\n");
         return false;
     }
@@ -28,6 +40,12 @@ bool AssetSystem::Init(GraphicsDevice& graphicsDevice) {
         return false;
     }
 
+    // 非同期ロードの初期化
+    if (!m_asyncModelLoader.Init(graphicsDevice, m_modelLoader, jobSystem)) {
+        OutputDebugStringW(L"Failed to initialize AsyncModelLoader.\n");
+        return false;
+    }
+
     // ResourceUploadBatchの生成
     DirectX::ResourceUploadBatch batch(graphicsDevice.GetDevice());
     batch.Begin();
@@ -46,6 +64,9 @@ bool AssetSystem::Init(GraphicsDevice& graphicsDevice) {
 }
 
 void AssetSystem::Term() {
+    // ロード中のモデルの破棄
+    m_asyncModelLoader.Term();
+
     // TextureManagerの終了処理
     m_textureManager.Term();
 
@@ -54,6 +75,9 @@ void AssetSystem::Term() {
 
     // ModelLoaderの終了処理
     m_modelLoader.Term();
+
+    // キャッシュの終了処理，統計を出力する
+    m_derivedDataCache.Term();
 }
 
 // AssetLoadScopeの作成
@@ -66,4 +90,11 @@ AssetLoadScope AssetSystem::CreateAssetLoadScope(Scene& scene) {
     return AssetLoadScope(std::move(batch),
         m_pGraphicsDevice->GetCommandQueue(), m_modelLoader, scene,
         m_iesProfile);
-}
\ No newline at end of file
+}
+
+// モデルの非同期ロード
+engine::ModelHandle AssetSystem::LoadModelAsync(
+    const std::filesystem::path& path, Scene& scene,
+    AsyncModelLoader::Callback callback) {
+    return m_asyncModelLoader.Load(path, scene, std::move(callback));
+}
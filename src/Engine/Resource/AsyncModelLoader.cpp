@@ -0,0 +1,187 @@
+#include "Engine/Resource/AsyncModelLoader.h"
+
+#include <directxtk12/ResourceUploadBatch.h>
+
+#include <cassert>
+#include <utility>
+
+#include "Engine/Core/GraphicsDevice.h"
+#include "Engine/Model/Model.h"
+#include "Engine/Resource/ModelLoader.h"
+#include "Engine/Scene/Scene.h"
+
+namespace /* anonymous */ {
+/// @brief 条件を満たす要素を順序を保ったまま取り出す
+template <typename T, typename Pred>
+void ExtractIf(std::vector<T>& items, std::vector<T>& out, Pred&& pred) {
+    size_t kept = 0;
+    for (size_t i = 0; i < items.size(); i++) {
+        if (pred(items[i])) {
+            out.push_back(std::move(items[i]));
+        } else {
+            items[kept++] = std::move(items[i]);
+        }
+    }
+    items.resize(kept);
+}
+}  // namespace
+
+AsyncModelLoader::AsyncModelLoader() = default;
+
+AsyncModelLoader::~AsyncModelLoader() { Term(); }
+
+// 初期化
+bool AsyncModelLoader::Init(GraphicsDevice& graphicsDevice,
+    ModelLoader& modelLoader, JobSystem& jobSystem) {
+    // 転送専用のコピーキューの作成
+    if (!m_copyQueue.Init(
+            graphicsDevice.GetDevice(), D3D12_COMMAND_LIST_TYPE_COPY)) {
+        return false;
+    }
+
+    m_pGraphicsDevice = &graphicsDevice;
+    m_pModelLoader    = &modelLoader;
+    m_pJobSystem      = &jobSystem;
+    return true;
+}
+
+// 終了処理
+void AsyncModelLoader::Term() {
+    // 実行中のCPU側の処理と転送の完了を待つ
+    if (m_pJobSystem != nullptr) {
+        m_pJobSystem->Wait(m_decodeCounter);
+    }
+    m_copyQueue.Flush();
+
+    // ロード中のモデルはシーンに登録せずに破棄する
+    m_uploads.clear();
+    m_requests.clear();
+    m_copyQueue.Term();
+
+    m_pGraphicsDevice = nullptr;
+    m_pModelLoader    = nullptr;
+    m_pJobSystem      = nullptr;
+}
+
+// 非同期ロードの開始
+engine::ModelHandle AsyncModelLoader::Load(
+    const std::filesystem::path& path, Scene& scene, Callback callback) {
+    assert(m_pJobSystem != nullptr && "AsyncModelLoader is not initialized.");
+
+    // 先にスロットだけ確保し，ゲームオブジェクトを作れるようにする
+    auto pRequest      = std::make_unique<Request>();
+    pRequest->handle   = scene.ReserveModel();
+    pRequest->path     = path;
+    pRequest->callback = std::move(callback);
+
+    // GLBの解析と画像のデコードはワーカースレッドで行う
+    // Requestはunique_ptrで持つので，m_requestsが伸びてもアドレスは変わらない
+    Request* pTarget     = pRequest.get();
+    ModelLoader* pLoader = m_pModelLoader;
+    m_pJobSystem->Submit(
+        [pTarget, pLoader]() {
+            pTarget->succeeded =
+                pLoader->LoadSource(pTarget->path, pTarget->source);
+            pTarget->decoded.store(true, std::memory_order_release);
+        },
+        &m_decodeCounter);
+
+    engine::ModelHandle handle = pRequest->handle;
+    m_requests.push_back(std::move(pRequest));
+    return handle;
+}
+
+// フレームごとの処理
+void AsyncModelLoader::Update(Scene& scene) {
+    if (m_requests.empty()) {
+        return;
+    }
+
+    // 先に完了した転送を回収し，その後で新しい転送を開始する
+    std::vector<std::unique_ptr<Request>> finished;
+    ResolveUploads(scene, finished);
+    SubmitUploads(scene, finished);
+
+    // コールバックは最後にまとめて呼び，コールバック内からLoadできるようにする
+    for (auto& pRequest : finished) {
+        if (pRequest->callback) {
+            pRequest->callback(pRequest->handle, pRequest->succeeded);
+        }
+    }
+}
+
+// 転送の開始
+void AsyncModelLoader::SubmitUploads(
+    Scene& scene, std::vector<std::unique_ptr<Request>>& finished) {
+    // このフレームでCPU側が終わったものを1つのbatchにまとめる
+    DirectX::ResourceUploadBatch batch(m_pGraphicsDevice->GetDevice());
+    bool hasUploads = false;
+
+    ExtractIf(m_requests, finished, [&](std::unique_ptr<Request>& pRequest) {
+        Request& request = *pRequest;
+        if (request.fenceValue != 0 ||
+            !request.decoded.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        // GPUリソースの作成と転送の記録
+        if (request.succeeded) {
+            if (!hasUploads) {
+                batch.Begin(D3D12_COMMAND_LIST_TYPE_COPY);
+                hasUploads = true;
+            }
+            request.pModel = m_pModelLoader->CreateModel(request.source, batch);
+        }
+
+        // CPU側のデータは記録した時点でアップロードヒープにコピー済み
+        request.source = ModelSource{};
+
+        // 失敗したものはスロットを外して終える
+        if (request.pModel == nullptr) {
+            OutputDebugStringW(L"Failed to load model asynchronously.\n");
+            scene.UnregisterModel(request.handle);
+            request.succeeded = false;
+            return true;
+        }
+        return false;
+    });
+
+    if (!hasUploads) {
+        return;
+    }
+
+    // コピーキューで実行し，完了を判定するフェンス値を発行する
+    PendingUpload upload;
+    upload.future     = batch.End(m_copyQueue.GetD3DQueue());
+    upload.fenceValue = m_copyQueue.Signal();
+    for (auto& pRequest : m_requests) {
+        if (pRequest->pModel != nullptr && pRequest->fenceValue == 0) {
+            pRequest->fenceValue = upload.fenceValue;
+        }
+    }
+    m_uploads.push_back(std::move(upload));
+}
+
+// 転送が完了したものの登録
+void AsyncModelLoader::ResolveUploads(
+    Scene& scene, std::vector<std::unique_ptr<Request>>& finished) {
+    uint64_t completed = m_copyQueue.GetCompletedValue();
+
+    // batchの後始末は完了済みなので，破棄しても待たない
+    while (!m_uploads.empty() && m_uploads.front().fenceValue <= completed) {
+        m_uploads.pop_front();
+    }
+
+    ExtractIf(m_requests, finished, [&](std::unique_ptr<Request>& pRequest) {
+        Request& request = *pRequest;
+        if (request.fenceValue == 0 || request.fenceValue > completed) {
+            return false;
+        }
+
+        // 転送中にスロットが外されていれば，まだ描画に使っていないので破棄する
+        request.pModel->DiscardUpload();
+        request.succeeded =
+            scene.ResolveModel(request.handle, std::move(request.pModel));
+        return true;
+    });
+}
@@ -0,0 +1,482 @@
+#include "Engine/Resource/CookedModel.h"
+
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+namespace /* anonymous */ {
+/// @brief alignmentの倍数に切り上げる
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+/// @brief 書き出すファイルの内容
+/// 追加した位置はオフセットで返し，配列の再確保の影響を受けないようにする
+class FileImage {
+public:
+    /// @brief 0で埋めた領域を末尾に確保する
+    /// @return 確保した領域のオフセット
+    uint64_t Reserve(uint64_t size, uint64_t alignment) {
+        uint64_t offset = AlignUp(m_bytes.size(), alignment);
+        m_bytes.resize(static_cast<size_t>(offset + size), 0);
+        return offset;
+    }
+
+    /// @brief データを末尾に追加する
+    /// @return 追加したデータのオフセット
+    uint64_t Append(const void* pData, uint64_t size, uint64_t alignment) {
+        uint64_t offset = Reserve(size, alignment);
+        if (size > 0) {
+            std::memcpy(m_bytes.data() + offset, pData, size);
+        }
+        return offset;
+    }
+
+    /// @brief 確保済みの領域に書き込む
+    template <typename T>
+    void Store(uint64_t offset, const T& value) {
+        std::memcpy(m_bytes.data() + offset, &value, sizeof(T));
+    }
+
+    uint64_t GetSize() const { return m_bytes.size(); }
+    const std::vector<uint8_t>& GetBytes() const { return m_bytes; }
+
+private:
+    std::vector<uint8_t> m_bytes;
+};
+
+/// @brief ローカルインデックスをテクスチャ番号に変換する（範囲外は無効）
+int32_t ToTextureIndex(int localIndex, size_t textureCount) {
+    if (localIndex < 0 || static_cast<size_t>(localIndex) >= textureCount) {
+        return cooked::kNoTexture;
+    }
+    return localIndex;
+}
+}  // namespace
+
+//==============================================================
+// CookedModelWriter
+//==============================================================
+
+// 変換済みモデルの書き出し
+bool CookedModelWriter::Write(const std::filesystem::path& path,
+    const ModelAsset& modelAsset,
+    const std::vector<CookedTextureSource>& textures) {
+    // 引数チェック
+    if (!modelAsset.IsValid() || textures.size() != modelAsset.images.size()) {
+        return false;
+    }
+
+    FileImage image;
+
+    // ヘッダと各テーブルの領域を先に確保する
+    const uint64_t meshCount     = modelAsset.meshes.size();
+    const uint64_t materialCount = modelAsset.materials.size();
+    const uint64_t textureCount  = textures.size();
+
+    cooked::FileHeader header = {};
+    image.Reserve(sizeof(cooked::FileHeader), 8);
+    header.meshTableOffset =
+        image.Reserve(sizeof(cooked::MeshRecord) * meshCount, 8);
+    header.materialTableOffset =
+        image.Reserve(sizeof(cooked::MaterialRecord) * materialCount, 8);
+    header.textureTableOffset =
+        image.Reserve(sizeof(cooked::TextureRecord) * textureCount, 8);
+
+    std::vector<uint64_t> subresourceTables(textures.size());
+    for (size_t i = 0; i < textures.size(); i++) {
+        subresourceTables[i] = image.Reserve(
+            sizeof(cooked::SubresourceRecord) * textures[i].subresources.size(),
+            8);
+    }
+
+    // メッシュ
+    for (size_t i = 0; i < modelAsset.meshes.size(); i++) {
+        const MeshView mesh = modelAsset.meshes[i].GetView();
+
+        cooked::MeshRecord record = {};
+        record.vertexOffset = image.Append(mesh.pVertices,
+            size_t{ mesh.GetVertexStride() } * mesh.vertexCount,
+            cooked::kDataAlignment);
+        record.indexOffset = image.Append(mesh.pIndices,
+            size_t{ mesh.GetIndexSize() } * mesh.indexCount,
+            cooked::kDataAlignment);
+        record.vertexCount      = mesh.vertexCount;
+        record.indexCount       = mesh.indexCount;
+        record.indexSize        = mesh.GetIndexSize();
+        record.materialID       = mesh.materialID;
+        record.boundsCenter[0]  = mesh.bounds.Center.x;
+        record.boundsCenter[1]  = mesh.bounds.Center.y;
+        record.boundsCenter[2]  = mesh.bounds.Center.z;
+        record.boundsExtents[0] = mesh.bounds.Extents.x;
+        record.boundsExtents[1] = mesh.bounds.Extents.y;
+        record.boundsExtents[2] = mesh.bounds.Extents.z;
+
+        // 圧縮した頂点の復元に使う値
+        const VertexQuantization& q = mesh.quantization;
+        record.vertexFormat      = static_cast<uint32_t>(mesh.vertexFormat);
+        record.positionOffset[0] = q.positionOffset.x;
+        record.positionOffset[1] = q.positionOffset.y;
+        record.positionOffset[2] = q.positionOffset.z;
+        record.positionScale[0]  = q.positionScale.x;
+        record.positionScale[1]  = q.positionScale.y;
+        record.positionScale[2]  = q.positionScale.z;
+        record.texcoordOffset[0] = q.texcoordOffset.x;
+        record.texcoordOffset[1] = q.texcoordOffset.y;
+        record.texcoordScale[0]  = q.texcoordScale.x;
+        record.texcoordScale[1]  = q.texcoordScale.y;
+
+        // メッシュレット（CPUでのカリング用）
+        record.meshletCount       = mesh.meshletCount;
+        record.meshletVertexCount = mesh.meshletVertexCount;
+
+        record.meshletOffset = image.Append(
+            mesh.pMeshlets, sizeof(Meshlet) * mesh.meshletCount, 8);
+        record.meshletBoundsOffset = image.Append(mesh.pMeshletBounds,
+            sizeof(MeshletBounds) * mesh.meshletCount, 8);
+        record.meshletVertexOffset = image.Append(mesh.pMeshletVertices,
+            sizeof(uint32_t) * mesh.meshletVertexCount, 8);
+        record.meshletTriangleOffset = image.Append(mesh.pMeshletTriangles,
+            mesh.meshletCount > 0 ? mesh.GetBaseIndexCount() : 0, 8);
+
+        // LOD（インデックスの範囲）
+        record.lodCount  = mesh.lodCount;
+        record.lodOffset = image.Append(
+            mesh.pLods, sizeof(MeshLod) * mesh.lodCount, 8);
+        image.Store(header.meshTableOffset + sizeof(record) * i, record);
+    }
+
+    // マテリアル
+    for (size_t i = 0; i < modelAsset.materials.size(); i++) {
+        const MaterialAsset& material = modelAsset.materials[i];
+
+        cooked::MaterialRecord record = {};
+        record.baseColorFactor[0]     = material.baseColorFactor.x;
+        record.baseColorFactor[1]     = material.baseColorFactor.y;
+        record.baseColorFactor[2]     = material.baseColorFactor.z;
+        record.baseColorFactor[3]     = material.baseColorFactor.w;
+        record.metallicFactor         = material.metallicFactor;
+        record.roughnessFactor        = material.roughnessFactor;
+        record.emissiveFactor[0]      = material.emissiveFactor.x;
+        record.emissiveFactor[1]      = material.emissiveFactor.y;
+        record.emissiveFactor[2]      = material.emissiveFactor.z;
+        record.occlusionFactor        = material.occlusionFactor;
+
+        // テクスチャ番号は画像の並びと同じ
+        auto Resolve = [&](int localIndex) {
+            return ToTextureIndex(localIndex, textureCount);
+        };
+        record.baseColorTexture = Resolve(material.baseColorLocalTextureIndex);
+        record.metallicRoughnessTexture =
+            Resolve(material.metallicRoughnessLocalTextureIndex);
+        record.occlusionTexture = Resolve(material.occlusionLocalTextureIndex);
+        record.normalTexture    = Resolve(material.normalLocalTextureIndex);
+        record.emissiveTexture  = Resolve(material.emissiveLocalTextureIndex);
+        record.doubleSided      = material.doubleSided ? 1 : 0;
+        image.Store(header.materialTableOffset + sizeof(record) * i, record);
+    }
+
+    // テクスチャ
+    for (size_t i = 0; i < textures.size(); i++) {
+        const CookedTextureSource& texture = textures[i];
+
+        cooked::TextureRecord record = {};
+        record.width                 = texture.width;
+        record.height                = texture.height;
+        record.format                = texture.format;
+        record.mipLevels             = texture.mipLevels;
+        record.isSRGB                = texture.isSRGB ? 1 : 0;
+        record.subresourceCount =
+            static_cast<uint32_t>(texture.subresources.size());
+        record.subresourceTableOffset = subresourceTables[i];
+        image.Store(header.textureTableOffset + sizeof(record) * i, record);
+
+        for (size_t s = 0; s < texture.subresources.size(); s++) {
+            const CookedSubresourceSource& source = texture.subresources[s];
+
+            cooked::SubresourceRecord subresource = {};
+            subresource.dataOffset = image.Append(
+                source.pData, source.slicePitch, cooked::kDataAlignment);
+            subresource.rowPitch   = source.rowPitch;
+            subresource.slicePitch = source.slicePitch;
+            image.Store(
+                subresourceTables[i] + sizeof(subresource) * s, subresource);
+        }
+    }
+
+    // ヘッダ
+    header.magic         = cooked::kMagic;
+    header.version       = cooked::kVersion;
+    header.meshCount     = static_cast<uint32_t>(meshCount);
+    header.materialCount = static_cast<uint32_t>(materialCount);
+    header.textureCount  = static_cast<uint32_t>(textureCount);
+    header.vertexStride  = sizeof(StandardVertex);
+    header.fileSize      = image.GetSize();
+    image.Store(0, header);
+
+    // 一時ファイルに書き込んでから置き換え，書きかけのファイルを残さない
+    std::filesystem::path tempPath = path;
+    tempPath += L".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        const auto& bytes = image.GetBytes();
+        file.write(reinterpret_cast<const char*>(bytes.data()),
+            static_cast<std::streamsize>(bytes.size()));
+        if (!file) {
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+//==============================================================
+// CookedModelView
+//==============================================================
+
+// 形式の検証
+bool CookedModelView::Parse(const void* pData, size_t size) {
+    m_pData     = static_cast<const uint8_t*>(pData);
+    m_size      = size;
+    m_meshes    = {};
+    m_materials = {};
+    m_textures  = {};
+
+    // ヘッダ
+    if (pData == nullptr || !Contains(0, sizeof(cooked::FileHeader))) {
+        return false;
+    }
+    const auto& header = *reinterpret_cast<const cooked::FileHeader*>(m_pData);
+    if (header.magic != cooked::kMagic || header.version != cooked::kVersion ||
+        header.vertexStride != sizeof(StandardVertex) ||
+        header.fileSize != size) {
+        return false;
+    }
+
+    // テーブル
+    auto tableFits = [&](uint64_t offset, uint64_t count, uint64_t stride) {
+        return offset % 8 == 0 && Contains(offset, count * stride);
+    };
+    if (!tableFits(header.meshTableOffset, header.meshCount,
+            sizeof(cooked::MeshRecord)) ||
+        !tableFits(header.materialTableOffset, header.materialCount,
+            sizeof(cooked::MaterialRecord)) ||
+        !tableFits(header.textureTableOffset, header.textureCount,
+            sizeof(cooked::TextureRecord))) {
+        return false;
+    }
+    std::span<const cooked::MeshRecord> meshes(
+        reinterpret_cast<const cooked::MeshRecord*>(
+            m_pData + header.meshTableOffset),
+        header.meshCount);
+    std::span<const cooked::MaterialRecord> materials(
+        reinterpret_cast<const cooked::MaterialRecord*>(
+            m_pData + header.materialTableOffset),
+        header.materialCount);
+    std::span<const cooked::TextureRecord> textures(
+        reinterpret_cast<const cooked::TextureRecord*>(
+            m_pData + header.textureTableOffset),
+        header.textureCount);
+
+    // メッシュのデータ
+    for (const auto& mesh : meshes) {
+        if (mesh.indexSize != sizeof(uint16_t) &&
+            mesh.indexSize != sizeof(uint32_t)) {
+            return false;
+        }
+        if (mesh.vertexFormat >= static_cast<uint32_t>(VertexFormat::Count)) {
+            return false;
+        }
+        uint32_t vertexStride =
+            GetVertexStride(static_cast<VertexFormat>(mesh.vertexFormat));
+        if (mesh.vertexOffset % alignof(StandardVertex) != 0 ||
+            mesh.indexOffset % mesh.indexSize != 0 ||
+            !Contains(mesh.vertexOffset,
+                uint64_t{ mesh.vertexCount } * vertexStride) ||
+            !Contains(mesh.indexOffset,
+                uint64_t{ mesh.indexCount } * mesh.indexSize)) {
+            return false;
+        }
+
+        // LODは描画するインデックスの範囲になるので中身も確かめる
+        // LOD0は先頭から始まり，メッシュレットはLOD0の中を指す
+        uint32_t baseIndexCount = mesh.indexCount;
+        if (mesh.lodCount > 0) {
+            if (!tableFits(mesh.lodOffset, mesh.lodCount, sizeof(MeshLod))) {
+                return false;
+            }
+            const auto* pLods =
+                reinterpret_cast<const MeshLod*>(m_pData + mesh.lodOffset);
+            for (uint32_t i = 0; i < mesh.lodCount; i++) {
+                if (pLods[i].indexCount % 3 != 0 ||
+                    uint64_t{ pLods[i].indexOffset } + pLods[i].indexCount >
+                        mesh.indexCount) {
+                    return false;
+                }
+            }
+            if (pLods[0].indexOffset != 0) {
+                return false;
+            }
+            baseIndexCount = pLods[0].indexCount;
+        }
+
+        // メッシュレットも描画するインデックスの範囲になる
+        if (mesh.meshletCount == 0) {
+            continue;
+        }
+        if (!tableFits(mesh.meshletOffset, mesh.meshletCount,
+                sizeof(Meshlet)) ||
+            !tableFits(mesh.meshletBoundsOffset, mesh.meshletCount,
+                sizeof(MeshletBounds)) ||
+            !tableFits(mesh.meshletVertexOffset, mesh.meshletVertexCount,
+                sizeof(uint32_t)) ||
+            !Contains(mesh.meshletTriangleOffset, baseIndexCount)) {
+            return false;
+        }
+        const auto* pMeshlets = reinterpret_cast<const Meshlet*>(
+            m_pData + mesh.meshletOffset);
+        for (uint32_t i = 0; i < mesh.meshletCount; i++) {
+            const Meshlet& meshlet = pMeshlets[i];
+            if (meshlet.vertexCount > Meshlet::kMaxVertices ||
+                meshlet.triangleCount > Meshlet::kMaxTriangles ||
+                uint64_t{ meshlet.vertexOffset } + meshlet.vertexCount >
+                    mesh.meshletVertexCount ||
+                uint64_t{ meshlet.triangleOffset } +
+                        uint64_t{ meshlet.triangleCount } * 3 >
+                    baseIndexCount) {
+                return false;
+            }
+        }
+    }
+
+    // マテリアルのテクスチャ番号
+    auto textureFits = [&](int32_t index) {
+        return index == cooked::kNoTexture ||
+               (index >= 0 && static_cast<uint32_t>(index) < textures.size());
+    };
+    for (const auto& material : materials) {
+        if (!textureFits(material.baseColorTexture) ||
+            !textureFits(material.metallicRoughnessTexture) ||
+            !textureFits(material.occlusionTexture) ||
+            !textureFits(material.normalTexture) ||
+            !textureFits(material.emissiveTexture)) {
+            return false;
+        }
+    }
+
+    // テクスチャのデータ
+    for (const auto& texture : textures) {
+        if (texture.subresourceCount == 0) {
+            continue;
+        }
+        if (texture.subresourceCount != texture.mipLevels ||
+            !tableFits(texture.subresourceTableOffset,
+                texture.subresourceCount, sizeof(cooked::SubresourceRecord))) {
+            return false;
+        }
+        const auto* pSubresources =
+            reinterpret_cast<const cooked::SubresourceRecord*>(
+                m_pData + texture.subresourceTableOffset);
+        for (uint32_t s = 0; s < texture.subresourceCount; s++) {
+            const auto& subresource = pSubresources[s];
+            if (subresource.rowPitch > subresource.slicePitch ||
+                !Contains(subresource.dataOffset, subresource.slicePitch)) {
+                return false;
+            }
+        }
+    }
+
+    m_meshes    = meshes;
+    m_materials = materials;
+    m_textures  = textures;
+    return true;
+}
+
+// メッシュの参照
+MeshView CookedModelView::GetMesh(uint32_t index) const {
+    const cooked::MeshRecord& record = m_meshes[index];
+
+    MeshView view;
+    view.pVertices    = GetData(record.vertexOffset);
+    view.vertexCount  = record.vertexCount;
+    view.vertexFormat = static_cast<VertexFormat>(record.vertexFormat);
+    view.pIndices     = GetData(record.indexOffset);
+    view.indexCount   = record.indexCount;
+    view.indexFormat  = DXGI_FORMAT_R32_UINT;
+    if (record.indexSize == sizeof(uint16_t)) {
+        view.indexFormat = DXGI_FORMAT_R16_UINT;
+    }
+    view.materialID     = record.materialID;
+    view.bounds.Center  = DirectX::XMFLOAT3(record.boundsCenter);
+    view.bounds.Extents = DirectX::XMFLOAT3(record.boundsExtents);
+
+    VertexQuantization& q = view.quantization;
+    q.positionOffset      = DirectX::XMFLOAT3(record.positionOffset);
+    q.positionScale       = DirectX::XMFLOAT3(record.positionScale);
+    q.texcoordOffset      = DirectX::XMFLOAT2(record.texcoordOffset);
+    q.texcoordScale       = DirectX::XMFLOAT2(record.texcoordScale);
+
+    if (record.meshletCount > 0) {
+        view.meshletCount       = record.meshletCount;
+        view.meshletVertexCount = record.meshletVertexCount;
+        view.pMeshletTriangles  = GetData(record.meshletTriangleOffset);
+
+        view.pMeshlets = reinterpret_cast<const Meshlet*>(
+            GetData(record.meshletOffset));
+        view.pMeshletBounds = reinterpret_cast<const MeshletBounds*>(
+            GetData(record.meshletBoundsOffset));
+        view.pMeshletVertices = reinterpret_cast<const uint32_t*>(
+            GetData(record.meshletVertexOffset));
+    }
+    if (record.lodCount > 0) {
+        view.lodCount = record.lodCount;
+        view.pLods =
+            reinterpret_cast<const MeshLod*>(GetData(record.lodOffset));
+    }
+    return view;
+}
+
+// マテリアルの取得
+std::vector<MaterialAsset> CookedModelView::GetMaterials() const {
+    std::vector<MaterialAsset> materials(m_materials.size());
+    for (size_t i = 0; i < m_materials.size(); i++) {
+        const cooked::MaterialRecord& record = m_materials[i];
+        MaterialAsset& material              = materials[i];
+
+        material.baseColorFactor = DirectX::XMFLOAT4(record.baseColorFactor);
+        material.metallicFactor  = record.metallicFactor;
+        material.roughnessFactor = record.roughnessFactor;
+        material.emissiveFactor  = DirectX::XMFLOAT3(record.emissiveFactor);
+        material.occlusionFactor = record.occlusionFactor;
+        material.doubleSided     = record.doubleSided != 0;
+
+        material.baseColorLocalTextureIndex = record.baseColorTexture;
+        material.metallicRoughnessLocalTextureIndex =
+            record.metallicRoughnessTexture;
+        material.occlusionLocalTextureIndex = record.occlusionTexture;
+        material.normalLocalTextureIndex    = record.normalTexture;
+        material.emissiveLocalTextureIndex  = record.emissiveTexture;
+    }
+    return materials;
+}
+
+// テクスチャのサブリソース
+std::span<const cooked::SubresourceRecord> CookedModelView::GetSubresources(
+    uint32_t index) const {
+    const cooked::TextureRecord& texture = m_textures[index];
+    if (texture.subresourceCount == 0) {
+        return {};
+    }
+    return { reinterpret_cast<const cooked::SubresourceRecord*>(
+                 GetData(texture.subresourceTableOffset)),
+        texture.subresourceCount };
+}
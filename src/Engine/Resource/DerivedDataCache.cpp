@@ -0,0 +1,270 @@
+#include "Engine/Resource/DerivedDataCache.h"
+
+#include <Windows.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace /* anonymous */ {
+constexpr wchar_t kEntryExtension[] = L".mdl";  // エントリの拡張子
+constexpr wchar_t kTempExtension[]  = L".tmp";  // 書き込み中の拡張子
+
+/// @brief ファイル名（拡張子なし）からキーを得る
+bool ParseKey(const std::wstring& stem, uint64_t& outKey) {
+    if (stem.size() != 16) {
+        return false;
+    }
+    uint64_t key = 0;
+    for (wchar_t c : stem) {
+        uint64_t digit = 0;
+        if (c >= L'0' && c <= L'9') {
+            digit = c - L'0';
+        } else if (c >= L'a' && c <= L'f') {
+            digit = c - L'a' + 10;
+        } else {
+            return false;
+        }
+        key = (key << 4) | digit;
+    }
+    outKey = key;
+    return true;
+}
+}  // namespace
+
+DerivedDataCache::DerivedDataCache() = default;
+
+DerivedDataCache::~DerivedDataCache() { Term(); }
+
+// 初期化
+bool DerivedDataCache::Init(
+    const std::filesystem::path& directory, uint64_t maxBytes) {
+    // 引数チェック
+    if (directory.empty() || maxBytes == 0) {
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_directory = directory;
+    m_maxBytes  = maxBytes;
+    m_entries.clear();
+    m_stats = Stats{};
+
+    // 既存のエントリを読み込み，中断された書き込みの残りは消す
+    std::filesystem::directory_iterator it(directory, ec);
+    for (const auto& item : it) {
+        if (!item.is_regular_file(ec)) {
+            continue;
+        }
+        const std::filesystem::path& path = item.path();
+        if (path.extension() == kTempExtension) {
+            std::filesystem::remove(path, ec);
+            continue;
+        }
+
+        uint64_t key = 0;
+        if (path.extension() != kEntryExtension ||
+            !ParseKey(path.stem().wstring(), key)) {
+            continue;
+        }
+
+        uint64_t size = item.file_size(ec);
+        if (ec) {
+            continue;
+        }
+        FileTime lastUse = item.last_write_time(ec);
+        if (ec) {
+            continue;
+        }
+        m_entries.emplace(key, Entry{ size, lastUse });
+        m_stats.totalBytes += size;
+    }
+    m_stats.entryCount = m_entries.size();
+
+    // 上限を下げた場合に備えて，起動時にも削る
+    Trim();
+    return true;
+}
+
+// 終了処理
+void DerivedDataCache::Term() {
+    if (!IsEnabled()) {
+        return;
+    }
+    ReportStats();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_directory.clear();
+    m_maxBytes = 0;
+}
+
+// エントリの検索
+bool DerivedDataCache::Find(uint64_t key, std::filesystem::path& outPath) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!IsEnabled()) {
+        return false;
+    }
+
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        m_stats.misses++;
+        return false;
+    }
+
+    // 最終使用時刻をファイルにも残し，次回の起動でも古い順に削れるようにする
+    std::filesystem::path path = GetEntryPath(key);
+    FileTime now               = FileTime::clock::now();
+    std::error_code ec;
+    std::filesystem::last_write_time(path, now, ec);
+    if (ec && !std::filesystem::exists(path)) {
+        // 外部から消された
+        m_stats.totalBytes -= it->second.size;
+        m_entries.erase(it);
+        m_stats.entryCount = m_entries.size();
+        m_stats.misses++;
+        return false;
+    }
+
+    it->second.lastUse = now;
+    m_stats.hits++;
+    outPath = std::move(path);
+    return true;
+}
+
+// エントリの書き込み
+bool DerivedDataCache::Store(uint64_t key, const WriteFunc& write) {
+    // 同じキーを同時に書き込んでも衝突しない一時ファイル名を作る
+    std::filesystem::path tempPath;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!IsEnabled()) {
+            return false;
+        }
+        tempPath = GetEntryPath(key);
+        tempPath.replace_extension(
+            L"." + std::to_wstring(GetCurrentProcessId()) + L"_" +
+            std::to_wstring(m_tempCounter++) + kTempExtension);
+    }
+
+    // 書き込みは時間がかかるのでロックの外で行う
+    std::error_code ec;
+    bool written  = write(tempPath);
+    uint64_t size = written ? std::filesystem::file_size(tempPath, ec) : 0;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!written || ec || !IsEnabled()) {
+        std::filesystem::remove(tempPath, ec);
+        m_stats.writeFailures++;
+        return false;
+    }
+
+    // 完成したファイルを置き換えで公開し，書きかけのエントリを見せない
+    std::filesystem::rename(tempPath, GetEntryPath(key), ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        m_stats.writeFailures++;
+        return false;
+    }
+
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        m_stats.totalBytes -= it->second.size;
+    }
+    m_entries[key] = Entry{ size, FileTime::clock::now() };
+    m_stats.totalBytes += size;
+    m_stats.entryCount = m_entries.size();
+    m_stats.writes++;
+
+    Trim();
+    return true;
+}
+
+// エントリの削除
+void DerivedDataCache::Remove(uint64_t key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(GetEntryPath(key), ec);
+    m_stats.totalBytes -= it->second.size;
+    m_entries.erase(it);
+    m_stats.entryCount = m_entries.size();
+}
+
+// 統計の取得
+DerivedDataCache::Stats DerivedDataCache::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+// 統計のデバッグ出力
+void DerivedDataCache::ReportStats() const {
+    Stats stats    = GetStats();
+    uint64_t total = stats.hits + stats.misses;
+    double hitRate = total > 0 ? 100.0 * stats.hits / total : 0.0;
+
+    wchar_t buffer[256] = {};
+    swprintf_s(buffer,
+        L"DerivedDataCache: %llu hits, %llu misses (%.1f%% hit), "
+        L"%llu writes, %llu write failures, %llu evictions, "
+        L"%.1f MB in %llu entries\n",
+        stats.hits, stats.misses, hitRate, stats.writes, stats.writeFailures,
+        stats.evictions, stats.totalBytes / (1024.0 * 1024.0),
+        stats.entryCount);
+    OutputDebugStringW(buffer);
+}
+
+// エントリのファイルパス
+std::filesystem::path DerivedDataCache::GetEntryPath(uint64_t key) const {
+    wchar_t name[32] = {};
+    swprintf_s(name, L"%016llx%ls", static_cast<unsigned long long>(key),
+        kEntryExtension);
+    return m_directory / name;
+}
+
+// 上限を超えた分を古いものから削除
+void DerivedDataCache::Trim() {
+    if (m_stats.totalBytes <= m_maxBytes) {
+        return;
+    }
+
+    // 最終使用時刻の古い順に並べる
+    std::vector<std::pair<FileTime, uint64_t>> order;
+    order.reserve(m_entries.size());
+    for (const auto& [key, entry] : m_entries) {
+        order.emplace_back(entry.lastUse, key);
+    }
+    std::sort(order.begin(), order.end());
+
+    for (const auto& [lastUse, key] : order) {
+        if (m_stats.totalBytes <= m_maxBytes) {
+            break;
+        }
+
+        // マッピング中のエントリは消せないので，次の機会に回す
+        std::error_code ec;
+        std::filesystem::remove(GetEntryPath(key), ec);
+        if (ec) {
+            continue;
+        }
+
+        auto it = m_entries.find(key);
+        m_stats.totalBytes -= it->second.size;
+        m_entries.erase(it);
+        m_stats.evictions++;
+    }
+    m_stats.entryCount = m_entries.size();
+}
@@ -3,8 +3,8 @@
 
 #include "Engine/Resource/GLBImporter.h"
 
-bool GLBImporter::LoadFromFile(
-    const std::filesystem::path& path, ModelAsset& outModel) {
+bool GLBImporter::LoadFromFile(const std::filesystem::path& path,
+    ModelAsset& outModel, MeshImportStats* pOutStats, JobSystem* pJobSystem) {
     // ファイルパスの確認
     if (!std::filesystem::exists(path)) {
         OutputDebugStringW(L"Error: File not found.\n");
@@ -15,18 +15,12 @@ bool GLBImporter::LoadFromFile(
     outModel.meshes.clear();
     outModel.materials.clear();
     outModel.images.clear();
+    if (pOutStats != nullptr) {
+        *pOutStats = MeshImportStats{};
+    }
 
     Assimp::Importer importer;
-    unsigned int flags = 0;
-    flags |=
-        aiProcess_Triangulate |               // 三角形化
-        aiProcess_GenSmoothNormals |          // スムース法線ベクトル生成
-        aiProcess_CalcTangentSpace |          // 接線ベクトル計算
-        aiProcess_RemoveRedundantMaterials |  // 冗長なマテリアルの削除
-        aiProcess_ConvertToLeftHanded;  // 左手座標系への変換 (MakeLeftHanded +
-                                        // FlipUVs + FlipWindingOrder)
-
-    const aiScene* scene = importer.ReadFile(path.string(), flags);
+    const aiScene* scene = importer.ReadFile(path.string(), kImportFlags);
 
     if (!scene) {
         OutputDebugStringW(L"Error: Scene is null.\n");
@@ -70,16 +64,111 @@ bool GLBImporter::LoadFromFile(
 
     // メッシュの読み込み
     outModel.meshes.reserve(scene->mNumMeshes);  // メモリ確保
+    std::vector<TangentGenerator::Target> tangentTargets;
+    tangentTargets.reserve(scene->mNumMeshes);
 
     for (unsigned int i = 0; i < scene->mNumMeshes; i++) {
         const aiMesh* mesh = scene->mMeshes[i];
         MeshAsset meshAsset;
+        TangentGenerator::Target target;
 
         // 頂点データの読み込み
-        if (!ParseMesh(mesh, meshAsset)) {
+        if (!ParseMesh(mesh, meshAsset, target)) {
             continue;
         }
         outModel.meshes.push_back(std::move(meshAsset));
+        tangentTargets.push_back(target);
+    }
+
+    // ファイルにない法線と接線を，全メッシュまとめて並列に生成する
+    TangentGenerator::Stats tangentStats;
+    TangentGenerator::Generate(
+        outModel.meshes, tangentTargets, pJobSystem, &tangentStats);
+
+    wchar_t message[256] = {};
+    swprintf_s(message,
+        L"Tangents: normals %u, tangents %u meshes (%u split vertices), "
+        L"%.1f ms (%.2f M triangles/s)\n",
+        tangentStats.normalMeshCount, tangentStats.tangentMeshCount,
+        tangentStats.splitVertexCount, tangentStats.generateTimeMs,
+        tangentStats.GetTrianglesPerSecond() / 1e6);
+    OutputDebugStringW(message);
+
+    for (size_t i = 0; i < outModel.meshes.size(); i++) {
+        // 頂点の統合と描画向けの並べ替え
+        MeshOptimizer::Stats stats;
+        MeshOptimizer::Optimize(outModel.meshes[i], &stats);
+
+        swprintf_s(message,
+            L"Mesh %zu: vertices %u -> %u, ACMR %.3f -> %.3f, "
+            L"ATVR %.3f -> %.3f\n",
+            i, stats.vertexCountBefore, stats.vertexCountAfter,
+            stats.before.acmr, stats.after.acmr, stats.before.atvr,
+            stats.after.atvr);
+        OutputDebugStringW(message);
+        if (pOutStats != nullptr) {
+            pOutStats->meshes.push_back(stats);
+        }
+    }
+
+    // 頂点数が少ないメッシュのインデックスを16bitにする
+    MeshOptimizer::IndexStats indexStats;
+    MeshOptimizer::ConvertToShortIndices(outModel.meshes, &indexStats);
+
+    swprintf_s(message,
+        L"Indices: %u/%u meshes 16-bit (%u split), index %.1f KB -> %.1f KB, "
+        L"vertex %.1f KB -> %.1f KB\n",
+        indexStats.shortMeshCount, indexStats.meshCountAfter,
+        indexStats.splitMeshCount, indexStats.indexBytesBefore / 1024.0,
+        indexStats.indexBytesAfter / 1024.0,
+        indexStats.vertexBytesBefore / 1024.0,
+        indexStats.vertexBytesAfter / 1024.0);
+    OutputDebugStringW(message);
+
+    // 分割後のメッシュごとにLODを作り，インデックスの後ろに足す
+    MeshSimplifier::Stats lodStats;
+    MeshSimplifier::GenerateLods(outModel.meshes, &lodStats);
+
+    swprintf_s(message,
+        L"LODs: %u meshes, triangles %llu / %llu / %llu / %llu, "
+        L"%.1f ms (%.2f M triangles/s)\n",
+        lodStats.meshCount, lodStats.triangleCount[0],
+        lodStats.triangleCount[1], lodStats.triangleCount[2],
+        lodStats.triangleCount[3], lodStats.simplifyTimeMs,
+        lodStats.GetTrianglesPerSecond() / 1e6);
+    OutputDebugStringW(message);
+
+    // 最終的なインデックスのLOD0からメッシュレットを作る
+    // 境界球と法線錐に圧縮前の位置を使うので，頂点の圧縮より前に行う
+    MeshletBuilder::Stats meshletStats;
+    MeshletBuilder::BuildMeshlets(outModel.meshes, &meshletStats);
+
+    swprintf_s(message,
+        L"Meshlets: %u (%.1f triangles, %.1f vertices each, "
+        L"%u with normal cone)\n",
+        meshletStats.meshletCount, meshletStats.GetTrianglesPerMeshlet(),
+        meshletStats.GetVerticesPerMeshlet(), meshletStats.coneMeshletCount);
+    OutputDebugStringW(message);
+
+    // 頂点カラーを持たないメッシュの頂点を圧縮する
+    VertexQuantizer::Stats vertexStats;
+    VertexQuantizer::CompressVertices(outModel.meshes, &vertexStats);
+
+    swprintf_s(message,
+        L"Vertices: %u/%u meshes compact, %.1f -> %.1f bytes/vertex, "
+        L"max error position %g, normal %.4f deg, uv %g\n",
+        vertexStats.compactMeshCount,
+        vertexStats.compactMeshCount + vertexStats.standardMeshCount,
+        vertexStats.GetBytesPerVertexBefore(),
+        vertexStats.GetBytesPerVertexAfter(), vertexStats.maxError.position,
+        vertexStats.maxError.normal, vertexStats.maxError.texcoord);
+    OutputDebugStringW(message);
+    if (pOutStats != nullptr) {
+        pOutStats->tangents = tangentStats;
+        pOutStats->indices  = indexStats;
+        pOutStats->lods     = lodStats;
+        pOutStats->meshlets = meshletStats;
+        pOutStats->vertices = vertexStats;
     }
 
     // マテリアルの読み込み
@@ -100,11 +189,19 @@ bool GLBImporter::LoadFromFile(
     return true;
 }
 
-bool GLBImporter::ParseMesh(const aiMesh* srcMesh, MeshAsset& outMesh) {
+bool GLBImporter::ParseMesh(const aiMesh* srcMesh, MeshAsset& outMesh,
+    TangentGenerator::Target& outTarget) {
     if (!srcMesh) {
         return false;
     }
 
+    // ファイルにない法線は生成する，接線はUVから決まるのでUVがある場合だけ
+    // 接線の符号は法線から求めるので，法線がなければ接線も作り直す
+    const bool hasTangents =
+        srcMesh->HasNormals() && srcMesh->HasTangentsAndBitangents();
+    outTarget.normals  = !srcMesh->HasNormals();
+    outTarget.tangents = !hasTangents && srcMesh->HasTextureCoords(0);
+
     // 頂点データの読み込み
     outMesh.vertices.resize(srcMesh->mNumVertices);  // 頂点数分のメモリ確保
 
@@ -116,7 +213,7 @@ bool GLBImporter::ParseMesh(const aiMesh* srcMesh, MeshAsset& outMesh) {
         vertex.position.y = srcMesh->mVertices[i].y;
         vertex.position.z = srcMesh->mVertices[i].z;
 
-        // 法線
+        // 法線，ない場合は後でTangentGeneratorが生成する
         if (srcMesh->HasNormals()) {
             vertex.normal.x = srcMesh->mNormals[i].x;
             vertex.normal.y = srcMesh->mNormals[i].y;
@@ -125,8 +222,8 @@ bool GLBImporter::ParseMesh(const aiMesh* srcMesh, MeshAsset& outMesh) {
             vertex.normal = { 0.0f, 1.0f, 0.0f };
         }
 
-        // 接線ベクトル
-        if (srcMesh->HasTangentsAndBitangents()) {
+        // 接線ベクトル，ファイルにある場合（glTFのTANGENT）だけassimpが返す
+        if (hasTangents) {
             vertex.tangent.x = srcMesh->mTangents[i].x;
             vertex.tangent.y = srcMesh->mTangents[i].y;
             vertex.tangent.z = srcMesh->mTangents[i].z;
@@ -175,6 +272,13 @@ bool GLBImporter::ParseMesh(const aiMesh* srcMesh, MeshAsset& outMesh) {
     // マテリアルIDの設定
     outMesh.materialID = srcMesh->mMaterialIndex;
 
+    // 視錐台カリング用のAABBを頂点座標から求める
+    if (!outMesh.vertices.empty()) {
+        DirectX::BoundingBox::CreateFromPoints(outMesh.bounds,
+            outMesh.vertices.size(), &outMesh.vertices[0].position,
+            sizeof(StandardVertex));
+    }
+
     return true;
 }
 
@@ -220,6 +324,12 @@ bool GLBImporter::ParseMaterial(
 
     // occlusion factorはassimpでは取得できない
 
+    // doubleSided
+    int twoSided = 0;
+    if (srcMaterial->Get(AI_MATKEY_TWOSIDED, twoSided) == AI_SUCCESS) {
+        outMaterial.doubleSided = twoSided != 0;
+    }
+
     // テクスチャ参照の設定
     // base color
     aiString baseColorPath;
@@ -0,0 +1,52 @@
+#include "Engine/Resource/ImageDecoder.h"
+
+#include <climits>
+#include <cstring>
+
+// GLBの埋め込み画像はPNGとJPEGだけなので，他の形式のデコーダは含めない
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_PNG
+#define STBI_ONLY_JPEG
+#define STBI_NO_STDIO
+#include <stb_image.h>
+
+// 対応する形式か
+bool ImageDecoder::IsSupportedFormat(const std::string& format) {
+    return format == "png" || format == "jpg" || format == "jpeg";
+}
+
+// デコードとミップチェーン生成
+bool ImageDecoder::Decode(const uint8_t* pData, size_t size,
+    const MipOptions& options, MipChain& outChain, JobSystem* pJobSystem) {
+    outChain = MipChain{};
+
+    // 引数チェック，stb_imageはintでサイズを受け取る
+    if (!pData || size == 0 || size > INT_MAX) {
+        return false;
+    }
+
+    // チャンネル数に関わらずRGBA8に揃える
+    int width    = 0;
+    int height   = 0;
+    int channels = 0;
+
+    stbi_uc* pPixels = stbi_load_from_memory(pData, static_cast<int>(size),
+        &width, &height, &channels, STBI_rgb_alpha);
+    if (!pPixels) {
+        return false;
+    }
+
+    // 先頭の段にコピーしてから残りの段を作る
+    bool result = MipGenerator::Allocate(static_cast<uint32_t>(width),
+        static_cast<uint32_t>(height), 0, MipFormat::RGBA8, outChain);
+    if (result) {
+        std::memcpy(outChain.GetData(0), pPixels, outChain.GetSlicePitch(0));
+    }
+    stbi_image_free(pPixels);
+    if (!result) {
+        return false;
+    }
+
+    MipGenerator::Generate(outChain, options, pJobSystem);
+    return true;
+}
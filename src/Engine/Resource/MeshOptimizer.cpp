@@ -0,0 +1,587 @@
+#include "Engine/Resource/MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+#include "Engine/Core/Hash.h"
+
+namespace /* anonymous */ {
+constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+// 頂点をバイト列として比較するので，パディングがないことを確認する
+static_assert(sizeof(StandardVertex) == sizeof(float) * 16);
+
+/// @brief FIFOの頂点キャッシュの模擬
+/// 頂点ごとに入った時刻を持ち，時刻の差でキャッシュ内かどうかを判定する
+class FifoCache {
+public:
+    FifoCache(size_t vertexCount, uint32_t size)
+        : m_stamps(vertexCount, 0), m_time(size + 1), m_size(size) {}
+
+    /// @brief 入ってからの経過（キャッシュ内なら1〜size）
+    uint32_t GetAge(uint32_t vertex) const {
+        return m_time - m_stamps[vertex];
+    }
+
+    bool Contains(uint32_t vertex) const { return GetAge(vertex) <= m_size; }
+
+    /// @brief 頂点の参照
+    /// @return キャッシュになく，頂点シェーダが実行される場合true
+    bool Access(uint32_t vertex) {
+        if (Contains(vertex)) {
+            return false;
+        }
+        m_stamps[vertex] = m_time++;
+        return true;
+    }
+
+    /// @brief 三角形の参照
+    /// @return 頂点シェーダの実行数
+    uint32_t AccessTriangle(const uint32_t* pTriangle) {
+        return Access(pTriangle[0]) + Access(pTriangle[1]) +
+               Access(pTriangle[2]);
+    }
+
+    /// @brief 全ての頂点を追い出す
+    void Flush() { m_time += m_size + 1; }
+
+private:
+    std::vector<uint32_t> m_stamps;  // 頂点ごとのキャッシュに入った時刻
+    uint32_t m_time;                 // 次に入る頂点の時刻
+    uint32_t m_size;                 // キャッシュのサイズ
+};
+
+/// @brief 頂点ごとの隣接三角形
+struct VertexAdjacency {
+    std::vector<uint32_t> offsets;    // 頂点ごとの先頭（頂点数+1）
+    std::vector<uint32_t> triangles;  // 三角形番号
+
+    VertexAdjacency(const std::vector<uint32_t>& indices, size_t vertexCount)
+        : offsets(vertexCount + 1, 0), triangles(indices.size()) {
+        for (uint32_t index : indices) {
+            offsets[index + 1]++;
+        }
+        for (size_t v = 0; v < vertexCount; v++) {
+            offsets[v + 1] += offsets[v];
+        }
+
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < indices.size(); i++) {
+            triangles[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+
+    uint32_t GetCount(uint32_t vertex) const {
+        return offsets[vertex + 1] - offsets[vertex];
+    }
+};
+
+//==============================================================
+// ベクトルの計算（インポート時のみなので単純に書く）
+//==============================================================
+struct Vec3 {
+    float x, y, z;
+};
+
+Vec3 ToVec3(const DirectX::XMFLOAT3& v) { return { v.x, v.y, v.z }; }
+Vec3 operator+(Vec3 a, Vec3 b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+Vec3 operator-(Vec3 a, Vec3 b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+Vec3 operator*(Vec3 a, float s) { return { a.x * s, a.y * s, a.z * s }; }
+float Dot(Vec3 a, Vec3 b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+Vec3 Cross(Vec3 a, Vec3 b) {
+    return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z,
+        a.x * b.y - a.y * b.x };
+}
+float Length(Vec3 v) { return std::sqrt(Dot(v, v)); }
+
+/// @brief 三角形の面積で重み付けした重心と法線の和
+struct SurfaceSum {
+    Vec3 centroid = { 0.0f, 0.0f, 0.0f };  // 重心×面積の和
+    Vec3 normal   = { 0.0f, 0.0f, 0.0f };  // 法線×面積×2の和
+    float area    = 0.0f;                  // 面積の和
+
+    void Add(const MeshAsset& mesh, uint32_t triangle) {
+        const uint32_t* pTriangle = &mesh.indices[triangle * 3];
+
+        Vec3 p0 = ToVec3(mesh.vertices[pTriangle[0]].position);
+        Vec3 p1 = ToVec3(mesh.vertices[pTriangle[1]].position);
+        Vec3 p2 = ToVec3(mesh.vertices[pTriangle[2]].position);
+        Vec3 n  = Cross(p1 - p0, p2 - p0);
+        float a = Length(n) * 0.5f;
+
+        centroid = centroid + (p0 + p1 + p2) * (a / 3.0f);
+        normal   = normal + n;
+        area     = area + a;
+    }
+
+    /// @brief 面積で重み付けした重心，面積が0なら原点
+    Vec3 GetCentroid() const {
+        if (area <= 0.0f) {
+            return { 0.0f, 0.0f, 0.0f };
+        }
+        return centroid * (1.0f / area);
+    }
+};
+
+/// @brief 頂点とインデックスのバイト数
+uint64_t GetVertexBytes(const MeshAsset& mesh) {
+    return uint64_t{ mesh.vertices.size() } * sizeof(StandardVertex);
+}
+uint64_t GetIndexBytes(const MeshAsset& mesh) {
+    return uint64_t{ mesh.indices.size() } * sizeof(uint32_t) +
+           uint64_t{ mesh.indices16.size() } * sizeof(uint16_t);
+}
+}  // namespace
+
+// 全ての段階を順に行う
+void MeshOptimizer::Optimize(MeshAsset& mesh, Stats* pOutStats) {
+    const size_t vertexCount = mesh.vertices.size();
+    Stats stats;
+    stats.vertexCountBefore = static_cast<uint32_t>(vertexCount);
+    stats.before            = AnalyzeVertexCache(mesh.indices, vertexCount);
+
+    // 三角形リストとして正しいものだけを対象にする
+    bool valid = vertexCount > 0 && !mesh.indices.empty() &&
+                 mesh.indices.size() % 3 == 0 &&
+                 ValidateIndexRange(mesh.indices, vertexCount);
+    if (valid) {
+        std::vector<uint32_t> clusters;
+        DeduplicateVertices(mesh);
+        OptimizeVertexCache(mesh.indices, mesh.vertices.size(), &clusters);
+        OptimizeOverdraw(mesh, clusters);
+        OptimizeVertexFetch(mesh);
+    }
+
+    stats.vertexCountAfter = static_cast<uint32_t>(mesh.vertices.size());
+
+    stats.after = AnalyzeVertexCache(mesh.indices, mesh.vertices.size());
+    if (pOutStats != nullptr) {
+        *pOutStats = stats;
+    }
+}
+
+// 一致する頂点の統合
+void MeshOptimizer::DeduplicateVertices(MeshAsset& mesh) {
+    const std::vector<StandardVertex>& vertices = mesh.vertices;
+
+    // 頂点番号をキーにし，内容で比較する
+    auto hashVertex = [&](uint32_t v) {
+        return static_cast<size_t>(
+            hash::Fnv1a64(&vertices[v], sizeof(StandardVertex)));
+    };
+    auto equalVertex = [&](uint32_t a, uint32_t b) {
+        return std::memcmp(&vertices[a], &vertices[b],
+                   sizeof(StandardVertex)) == 0;
+    };
+    std::unordered_map<uint32_t, uint32_t, decltype(hashVertex),
+        decltype(equalVertex)>
+        firstIndex(vertices.size(), hashVertex, equalVertex);
+
+    std::vector<uint32_t> remap(vertices.size());
+    std::vector<StandardVertex> unique;
+    unique.reserve(vertices.size());
+    for (uint32_t v = 0; v < static_cast<uint32_t>(vertices.size()); v++) {
+        auto [it, inserted] =
+            firstIndex.try_emplace(v, static_cast<uint32_t>(unique.size()));
+        if (inserted) {
+            unique.push_back(vertices[v]);
+        }
+        remap[v] = it->second;
+    }
+
+    // 比較にverticesを使うので，置き換えはマップを使い終えてから
+    firstIndex.clear();
+    for (uint32_t& index : mesh.indices) {
+        index = remap[index];
+    }
+    mesh.vertices = std::move(unique);
+}
+
+// 頂点キャッシュ向けの並べ替え
+// Sander et al., "Fast Triangle Reordering for Vertex Locality and Reduced
+// Overdraw" (2007) のTipsify
+void MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t>& indices,
+    size_t vertexCount, std::vector<uint32_t>* pOutClusters) {
+    const size_t triangleCount = indices.size() / 3;
+    if (pOutClusters != nullptr) {
+        pOutClusters->clear();
+    }
+    if (triangleCount == 0) {
+        return;
+    }
+
+    VertexAdjacency adjacency(indices, vertexCount);
+
+    // 頂点ごとの未出力の三角形の数
+    std::vector<uint32_t> live(vertexCount);
+    for (uint32_t v = 0; v < static_cast<uint32_t>(vertexCount); v++) {
+        live[v] = adjacency.GetCount(v);
+    }
+
+    FifoCache cache(vertexCount, kCacheSize);
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> deadEnd;     // 最近出力した頂点（行き止まりの候補）
+    std::vector<uint32_t> candidates;  // 直前の扇で出力した頂点
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    deadEnd.reserve(indices.size());
+
+    // 行き止まりの場合の次の頂点
+    // 最近出力した頂点を優先し，なければ頂点番号順に探す
+    uint32_t scanCursor = 0;
+
+    auto SkipDeadEnd = [&]() {
+        while (!deadEnd.empty()) {
+            uint32_t v = deadEnd.back();
+            deadEnd.pop_back();
+            if (live[v] > 0) {
+                return v;
+            }
+        }
+        while (scanCursor < vertexCount) {
+            if (live[scanCursor] > 0) {
+                return scanCursor;
+            }
+            scanCursor++;
+        }
+        return kInvalidIndex;
+    };
+
+    uint32_t fanning = SkipDeadEnd();
+    if (pOutClusters != nullptr) {
+        pOutClusters->push_back(0);
+    }
+    while (fanning != kInvalidIndex) {
+        // 扇の中心の頂点を使う三角形を全て出力する
+        candidates.clear();
+        for (uint32_t i = adjacency.offsets[fanning];
+            i < adjacency.offsets[fanning + 1]; i++) {
+            uint32_t triangle = adjacency.triangles[i];
+            if (emitted[triangle]) {
+                continue;
+            }
+            emitted[triangle] = true;
+
+            for (uint32_t c = 0; c < 3; c++) {
+                uint32_t v = indices[triangle * 3 + c];
+                output.push_back(v);
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                live[v]--;
+                cache.Access(v);
+            }
+        }
+
+        // 扇にしてもキャッシュに残る頂点のうち，最も古いものを次の中心にする
+        uint32_t next     = kInvalidIndex;
+        int64_t bestScore = -1;
+        for (uint32_t v : candidates) {
+            if (live[v] == 0) {
+                continue;
+            }
+            int64_t score = 0;
+            if (cache.GetAge(v) + 2 * live[v] <= kCacheSize) {
+                score = cache.GetAge(v);
+            }
+            if (score > bestScore) {
+                bestScore = score;
+                next      = v;
+            }
+        }
+
+        // 候補がなければ行き止まり，ここでクラスタを区切る
+        if (next == kInvalidIndex) {
+            next = SkipDeadEnd();
+            if (next != kInvalidIndex && pOutClusters != nullptr) {
+                pOutClusters->push_back(
+                    static_cast<uint32_t>(output.size() / 3));
+            }
+        }
+        fanning = next;
+    }
+
+    indices = std::move(output);
+}
+
+// オーバードローを減らす並べ替え
+void MeshOptimizer::OptimizeOverdraw(MeshAsset& mesh,
+    const std::vector<uint32_t>& clusters, float threshold) {
+    const uint32_t triangleCount =
+        static_cast<uint32_t>(mesh.indices.size() / 3);
+    if (triangleCount == 0 || clusters.empty()) {
+        return;
+    }
+
+    // キャッシュの効率がthreshold倍以内に収まる位置でクラスタを分ける
+    // 分けた位置ではキャッシュが空になる前提で評価する
+    std::vector<uint32_t> boundaries;
+    FifoCache cache(mesh.vertices.size(), kCacheSize);
+    for (size_t c = 0; c < clusters.size(); c++) {
+        uint32_t start = clusters[c];
+        uint32_t end =
+            (c + 1 < clusters.size()) ? clusters[c + 1] : triangleCount;
+
+        // クラスタ全体のACMR
+        cache.Flush();
+        uint32_t clusterMisses = 0;
+        for (uint32_t t = start; t < end; t++) {
+            clusterMisses += cache.AccessTriangle(&mesh.indices[t * 3]);
+        }
+        float clusterAcmr = static_cast<float>(clusterMisses) / (end - start);
+
+        cache.Flush();
+        boundaries.push_back(start);
+        uint32_t subStart = start;
+        uint32_t misses   = 0;
+        for (uint32_t t = start; t < end; t++) {
+            misses += cache.AccessTriangle(&mesh.indices[t * 3]);
+            if (t + 1 < end &&
+                misses <= threshold * clusterAcmr * (t + 1 - subStart)) {
+                boundaries.push_back(t + 1);
+                subStart = t + 1;
+                misses   = 0;
+                cache.Flush();
+            }
+        }
+    }
+
+    // メッシュ全体の重心
+    SurfaceSum meshSum;
+    for (uint32_t t = 0; t < triangleCount; t++) {
+        meshSum.Add(mesh, t);
+    }
+    Vec3 meshCentroid = meshSum.GetCentroid();
+
+    // クラスタの重心がメッシュの重心から法線方向に遠いものほど外側にあり，
+    // 先に描くと後ろのクラスタが深度テストで落ちやすい
+    struct ClusterOrder {
+        float score;
+        uint32_t start;
+        uint32_t end;
+    };
+    std::vector<ClusterOrder> order(boundaries.size());
+    for (size_t c = 0; c < boundaries.size(); c++) {
+        uint32_t start = boundaries[c];
+        uint32_t end =
+            (c + 1 < boundaries.size()) ? boundaries[c + 1] : triangleCount;
+
+        SurfaceSum sum;
+        for (uint32_t t = start; t < end; t++) {
+            sum.Add(mesh, t);
+        }
+        float length = Length(sum.normal);
+        float score  = 0.0f;
+        if (length > 0.0f) {
+            score = Dot(sum.GetCentroid() - meshCentroid, sum.normal) / length;
+        }
+        order[c] = { score, start, end };
+    }
+    std::stable_sort(order.begin(), order.end(),
+        [](const ClusterOrder& a, const ClusterOrder& b) {
+            return a.score > b.score;
+        });
+
+    std::vector<uint32_t> output;
+    output.reserve(mesh.indices.size());
+    for (const auto& cluster : order) {
+        output.insert(output.end(), mesh.indices.begin() + cluster.start * 3,
+            mesh.indices.begin() + cluster.end * 3);
+    }
+    mesh.indices = std::move(output);
+}
+
+// 頂点フェッチ向けの並べ替え
+void MeshOptimizer::OptimizeVertexFetch(MeshAsset& mesh) {
+    std::vector<uint32_t> remap(mesh.vertices.size(), kInvalidIndex);
+    uint32_t next = 0;
+    for (uint32_t& index : mesh.indices) {
+        if (remap[index] == kInvalidIndex) {
+            remap[index] = next++;
+        }
+        index = remap[index];
+    }
+
+    std::vector<StandardVertex> vertices(next);
+    for (size_t v = 0; v < mesh.vertices.size(); v++) {
+        if (remap[v] != kInvalidIndex) {
+            vertices[remap[v]] = mesh.vertices[v];
+        }
+    }
+    mesh.vertices = std::move(vertices);
+}
+
+// 頂点キャッシュの評価
+MeshOptimizer::CacheStats MeshOptimizer::AnalyzeVertexCache(
+    const std::vector<uint32_t>& indices, size_t vertexCount,
+    uint32_t cacheSize) {
+    CacheStats stats;
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || vertexCount == 0) {
+        return stats;
+    }
+
+    FifoCache cache(vertexCount, cacheSize);
+    std::vector<bool> used(vertexCount, false);
+    uint32_t misses    = 0;
+    uint32_t usedCount = 0;
+    for (size_t i = 0; i < triangleCount * 3; i++) {
+        uint32_t index = indices[i];
+        if (index >= vertexCount) {
+            return CacheStats{};
+        }
+        misses += cache.Access(index);
+        if (!used[index]) {
+            used[index] = true;
+            usedCount++;
+        }
+    }
+
+    stats.acmr = static_cast<float>(misses) / triangleCount;
+    stats.atvr = static_cast<float>(misses) / usedCount;
+    return stats;
+}
+
+// インデックスの範囲の確認
+bool MeshOptimizer::ValidateIndexRange(
+    const std::vector<uint32_t>& indices, size_t vertexCount) {
+    return std::all_of(indices.begin(), indices.end(),
+        [&](uint32_t index) { return index < vertexCount; });
+}
+
+// モデル全体の16bit化
+void MeshOptimizer::ConvertToShortIndices(
+    std::vector<MeshAsset>& meshes, IndexStats* pOutStats) {
+    IndexStats stats;
+    stats.meshCountBefore = static_cast<uint32_t>(meshes.size());
+
+    std::vector<MeshAsset> result;
+    result.reserve(meshes.size());
+    for (MeshAsset& mesh : meshes) {
+        stats.indexBytesBefore += GetIndexBytes(mesh);
+        stats.vertexBytesBefore += GetVertexBytes(mesh);
+
+        // 頂点数が多いメッシュは，分割して得になるなら分割する
+        if (!mesh.HasShortIndices() &&
+            mesh.vertices.size() > kMaxShortIndexVertices) {
+            std::vector<MeshAsset> pieces;
+            SplitMesh(mesh, kMaxShortIndexVertices, pieces);
+
+            // 境界の頂点の複製で増える分と，インデックスで減る分を比べる
+            uint64_t splitBytes = 0;
+            for (const MeshAsset& piece : pieces) {
+                splitBytes += GetVertexBytes(piece) +
+                              piece.indices.size() * sizeof(uint16_t);
+            }
+            uint64_t wholeBytes = GetVertexBytes(mesh) + GetIndexBytes(mesh);
+            if (!pieces.empty() && splitBytes < wholeBytes) {
+                for (MeshAsset& piece : pieces) {
+                    CompactIndices(piece);
+                    result.push_back(std::move(piece));
+                }
+                stats.splitMeshCount++;
+                continue;
+            }
+        }
+
+        CompactIndices(mesh);
+        result.push_back(std::move(mesh));
+    }
+
+    for (const MeshAsset& mesh : result) {
+        stats.indexBytesAfter += GetIndexBytes(mesh);
+        stats.vertexBytesAfter += GetVertexBytes(mesh);
+        if (mesh.HasShortIndices()) {
+            stats.shortMeshCount++;
+        }
+    }
+    stats.meshCountAfter = static_cast<uint32_t>(result.size());
+
+    meshes = std::move(result);
+    if (pOutStats != nullptr) {
+        *pOutStats = stats;
+    }
+}
+
+// 16bitのインデックスへの変換
+bool MeshOptimizer::CompactIndices(MeshAsset& mesh) {
+    if (mesh.HasShortIndices()) {
+        return true;
+    }
+    if (mesh.indices.empty() || mesh.vertices.size() > kMaxShortIndexVertices ||
+        !ValidateIndexRange(mesh.indices, mesh.vertices.size())) {
+        return false;
+    }
+
+    mesh.indices16.resize(mesh.indices.size());
+    for (size_t i = 0; i < mesh.indices.size(); i++) {
+        mesh.indices16[i] = static_cast<uint16_t>(mesh.indices[i]);
+    }
+    mesh.indices.clear();
+    mesh.indices.shrink_to_fit();
+    return true;
+}
+
+// 頂点数の上限での分割
+void MeshOptimizer::SplitMesh(const MeshAsset& mesh, uint32_t maxVertices,
+    std::vector<MeshAsset>& outMeshes) {
+    outMeshes.clear();
+    if (maxVertices < 3 || mesh.indices.size() % 3 != 0 ||
+        !ValidateIndexRange(mesh.indices, mesh.vertices.size())) {
+        return;
+    }
+
+    // 元の頂点番号から分割先の頂点番号への対応
+    std::vector<uint32_t> remap(mesh.vertices.size(), kInvalidIndex);
+    std::vector<uint32_t> sources;  // 分割先の頂点ごとの元の頂点番号
+    MeshAsset piece;
+
+    auto flush = [&]() {
+        if (piece.indices.empty()) {
+            return;
+        }
+        for (uint32_t source : sources) {
+            remap[source] = kInvalidIndex;
+        }
+        sources.clear();
+
+        piece.materialID = mesh.materialID;
+        DirectX::BoundingBox::CreateFromPoints(piece.bounds,
+            piece.vertices.size(), &piece.vertices[0].position,
+            sizeof(StandardVertex));
+        outMeshes.push_back(std::move(piece));
+        piece = MeshAsset{};
+    };
+
+    // 最適化済みの三角形の順番のまま，入りきらなくなったら区切る
+    const size_t triangleCount = mesh.indices.size() / 3;
+    for (size_t t = 0; t < triangleCount; t++) {
+        const uint32_t* pTriangle = &mesh.indices[t * 3];
+
+        uint32_t newCount = 0;
+        for (int k = 0; k < 3; k++) {
+            uint32_t v = pTriangle[k];
+            bool seen  = remap[v] != kInvalidIndex ||
+                         (k > 0 && v == pTriangle[0]) ||
+                         (k > 1 && v == pTriangle[1]);
+            if (!seen) {
+                newCount++;
+            }
+        }
+        if (sources.size() + newCount > maxVertices) {
+            flush();
+        }
+
+        for (int k = 0; k < 3; k++) {
+            uint32_t v = pTriangle[k];
+            if (remap[v] == kInvalidIndex) {
+                remap[v] = static_cast<uint32_t>(sources.size());
+                sources.push_back(v);
+                piece.vertices.push_back(mesh.vertices[v]);
+            }
+            piece.indices.push_back(remap[v]);
+        }
+    }
+    flush();
+}
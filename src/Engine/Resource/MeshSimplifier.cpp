@@ -0,0 +1,494 @@
+#include "Engine/Resource/MeshSimplifier.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+#include "Engine/Core/Hash.h"
+#include "Engine/Resource/MeshOptimizer.h"
+
+namespace /* anonymous */ {
+using DirectX::XMFLOAT3;
+
+/// @brief 二次誤差の行列（対称な4x4の上三角）と面積の合計
+/// 平面 n・p + d = 0 を面積で重み付けして足し合わせたもの
+struct Quadric {
+    double a00 = 0.0, a01 = 0.0, a02 = 0.0;  // n nᵀ
+    double a11 = 0.0, a12 = 0.0, a22 = 0.0;
+    double b0 = 0.0, b1 = 0.0, b2 = 0.0;  // d n
+    double c      = 0.0;                   // d²
+    double weight = 0.0;                   // 面積の合計
+
+    /// @brief 平面を足す
+    void AddPlane(double nx, double ny, double nz, double d, double w) {
+        a00 += w * nx * nx;
+        a01 += w * nx * ny;
+        a02 += w * nx * nz;
+        a11 += w * ny * ny;
+        a12 += w * ny * nz;
+        a22 += w * nz * nz;
+        b0 += w * nx * d;
+        b1 += w * ny * d;
+        b2 += w * nz * d;
+        c += w * d * d;
+        weight += w;
+    }
+
+    /// @brief 別の二次誤差を足す
+    void Add(const Quadric& q) {
+        a00 += q.a00;
+        a01 += q.a01;
+        a02 += q.a02;
+        a11 += q.a11;
+        a12 += q.a12;
+        a22 += q.a22;
+        b0 += q.b0;
+        b1 += q.b1;
+        b2 += q.b2;
+        c += q.c;
+        weight += q.weight;
+    }
+};
+
+/// @brief 2つの二次誤差の和を点で評価する（平面までの距離の2乗の加重平均）
+double Evaluate(const Quadric& q0, const Quadric& q1, const XMFLOAT3& p) {
+    Quadric q = q0;
+    q.Add(q1);
+    if (!(q.weight > 0.0)) {
+        return 0.0;
+    }
+
+    const double x = p.x, y = p.y, z = p.z;
+    double error = q.a00 * x * x + q.a11 * y * y + q.a22 * z * z +
+                   2.0 * (q.a01 * x * y + q.a02 * x * z + q.a12 * y * z) +
+                   2.0 * (q.b0 * x + q.b1 * y + q.b2 * z) + q.c;
+    return std::max(error, 0.0) / q.weight;
+}
+
+XMFLOAT3 Subtract(const XMFLOAT3& a, const XMFLOAT3& b) {
+    return XMFLOAT3(a.x - b.x, a.y - b.y, a.z - b.z);
+}
+
+XMFLOAT3 Cross(const XMFLOAT3& a, const XMFLOAT3& b) {
+    return XMFLOAT3(
+        a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+}
+
+float Dot(const XMFLOAT3& a, const XMFLOAT3& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+/// @brief 辺の縮約の状態
+/// 目標の数を下げながらReduceを繰り返すと，前のLODの続きから縮約する
+class Simplifier {
+public:
+    Simplifier(const std::vector<StandardVertex>& vertices,
+        const std::vector<uint32_t>& indices)
+        : m_vertices(vertices), m_indices(indices) {
+        ClassifyVertices();
+        ComputeQuadrics();
+    }
+
+    /// @brief インデックスが目標の数以下になるか，縮約できなくなるまで進める
+    /// @return ここまでの縮約の最大の誤差
+    float Reduce(size_t targetIndexCount) {
+        while (m_indices.size() > targetIndexCount) {
+            if (!CollapsePass(targetIndexCount)) {
+                break;
+            }
+        }
+        return m_error;
+    }
+
+    /// @brief 現在のインデックス
+    const std::vector<uint32_t>& GetIndices() const { return m_indices; }
+
+private:
+    /// @brief 1回の縮約の候補
+    struct Collapse {
+        uint32_t from;  // 動かす頂点
+        uint32_t to;    // 寄せる先の頂点
+        double cost;    // 誤差
+    };
+
+    /// @brief 同じ位置の頂点をまとめ，動かしてよい頂点を決める
+    void ClassifyVertices() {
+        const uint32_t vertexCount = static_cast<uint32_t>(m_vertices.size());
+
+        // 位置をキーにし，最初に出てきた頂点を代表にする
+        auto hashPosition = [&](uint32_t v) {
+            return static_cast<size_t>(
+                hash::Fnv1a64(&m_vertices[v].position, sizeof(XMFLOAT3)));
+        };
+        auto equalPosition = [&](uint32_t a, uint32_t b) {
+            return std::memcmp(&m_vertices[a].position,
+                       &m_vertices[b].position, sizeof(XMFLOAT3)) == 0;
+        };
+        std::unordered_map<uint32_t, uint32_t, decltype(hashPosition),
+            decltype(equalPosition)>
+            firstVertex(vertexCount, hashPosition, equalPosition);
+
+        m_position.resize(vertexCount);
+        for (uint32_t v = 0; v < vertexCount; v++) {
+            m_position[v] = firstVertex.try_emplace(v, v).first->second;
+        }
+
+        // 使われている頂点が2つ以上ある位置はシーム
+        std::vector<uint8_t> used(vertexCount, 0);
+        std::vector<uint32_t> wedgeCount(vertexCount, 0);
+        for (uint32_t index : m_indices) {
+            if (!used[index]) {
+                used[index] = 1;
+                wedgeCount[m_position[index]]++;
+            }
+        }
+
+        // 位置で見た有向辺を数え，逆向きの辺がない（縁）か
+        // 同じ向きの辺が2つ以上ある（非多様体）位置は動かさない
+        auto edgeKey = [](uint32_t a, uint32_t b) {
+            return (uint64_t{ a } << 32) | b;
+        };
+        std::unordered_map<uint64_t, uint32_t> edgeCount(m_indices.size());
+        for (size_t t = 0; t < m_indices.size(); t += 3) {
+            for (int k = 0; k < 3; k++) {
+                uint32_t a = m_position[m_indices[t + k]];
+                uint32_t b = m_position[m_indices[t + (k + 1) % 3]];
+                edgeCount[edgeKey(a, b)]++;
+            }
+        }
+
+        std::vector<uint8_t> locked(vertexCount, 0);
+        for (const auto& [key, count] : edgeCount) {
+            uint32_t a = static_cast<uint32_t>(key >> 32);
+            uint32_t b = static_cast<uint32_t>(key & 0xFFFFFFFFu);
+            if (count > 1 || edgeCount.find(edgeKey(b, a)) == edgeCount.end()) {
+                locked[a] = 1;
+                locked[b] = 1;
+            }
+        }
+
+        m_movable.resize(vertexCount);
+        for (uint32_t v = 0; v < vertexCount; v++) {
+            uint32_t p   = m_position[v];
+            m_movable[v] = wedgeCount[p] == 1 && !locked[p];
+        }
+    }
+
+    /// @brief 三角形の平面を3つの頂点の位置の二次誤差に足す
+    void ComputeQuadrics() {
+        m_quadrics.assign(m_vertices.size(), Quadric{});
+        for (size_t t = 0; t < m_indices.size(); t += 3) {
+            const XMFLOAT3& p0 = m_vertices[m_indices[t + 0]].position;
+            const XMFLOAT3& p1 = m_vertices[m_indices[t + 1]].position;
+            const XMFLOAT3& p2 = m_vertices[m_indices[t + 2]].position;
+
+            XMFLOAT3 normal = Cross(Subtract(p1, p0), Subtract(p2, p0));
+            double length   = std::sqrt(double{ Dot(normal, normal) });
+            if (!(length > 0.0)) {
+                continue;  // 縮退した三角形は平面を持たない
+            }
+            double nx = normal.x / length;
+            double ny = normal.y / length;
+            double nz = normal.z / length;
+            double d  = -(nx * p0.x + ny * p0.y + nz * p0.z);
+
+            // 外積の長さは面積の2倍
+            double area = length * 0.5;
+            for (int k = 0; k < 3; k++) {
+                m_quadrics[m_position[m_indices[t + k]]].AddPlane(
+                    nx, ny, nz, d, area);
+            }
+        }
+    }
+
+    /// @brief 頂点ごとに含まれる三角形の一覧を作り直す
+    void BuildAdjacency() {
+        const size_t vertexCount = m_vertices.size();
+        m_triangleOffsets.assign(vertexCount + 1, 0);
+        for (uint32_t index : m_indices) {
+            m_triangleOffsets[index + 1]++;
+        }
+        for (size_t v = 0; v < vertexCount; v++) {
+            m_triangleOffsets[v + 1] += m_triangleOffsets[v];
+        }
+
+        std::vector<uint32_t> cursor(
+            m_triangleOffsets.begin(), m_triangleOffsets.end() - 1);
+        m_vertexTriangles.resize(m_indices.size());
+        for (size_t i = 0; i < m_indices.size(); i++) {
+            m_vertexTriangles[cursor[m_indices[i]]++] =
+                static_cast<uint32_t>(i / 3);
+        }
+    }
+
+    /// @brief fromをtoへ寄せると，残る三角形の向きが大きく変わるか
+    bool Flips(uint32_t from, uint32_t to) const {
+        for (uint32_t i = m_triangleOffsets[from];
+            i < m_triangleOffsets[from + 1]; i++) {
+            const uint32_t* triangle = &m_indices[m_vertexTriangles[i] * 3];
+            if (triangle[0] == to || triangle[1] == to || triangle[2] == to) {
+                continue;  // 縮約で消える三角形
+            }
+
+            // 縮約後の三角形の頂点法線の和
+            XMFLOAT3 before[3];
+            XMFLOAT3 after[3];
+            XMFLOAT3 shading(0.0f, 0.0f, 0.0f);
+            for (int k = 0; k < 3; k++) {
+                uint32_t vertex = triangle[k] == from ? to : triangle[k];
+                before[k]       = m_vertices[triangle[k]].position;
+                after[k]        = m_vertices[vertex].position;
+
+                const XMFLOAT3& normal = m_vertices[vertex].normal;
+                shading.x += normal.x;
+                shading.y += normal.y;
+                shading.z += normal.z;
+            }
+            XMFLOAT3 n0 = Cross(
+                Subtract(before[1], before[0]), Subtract(before[2], before[0]));
+            XMFLOAT3 n1 = Cross(
+                Subtract(after[1], after[0]), Subtract(after[2], after[0]));
+
+            // 面の向きが大きく変わるか，頂点法線に対して裏返る
+            float limit = MeshSimplifier::kMinNormalDot *
+                          std::sqrt(Dot(n0, n0) * Dot(n1, n1));
+            if (Dot(n0, n1) < limit ||
+                Dot(n0, shading) * Dot(n1, shading) < 0.0f) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief 互いに影響しない縮約を誤差の小さい順にまとめて行う
+    /// @return 1つも縮約できなかった場合はfalse
+    bool CollapsePass(size_t targetIndexCount) {
+        BuildAdjacency();
+
+        // 動かせる頂点ごとに，辺でつながる頂点のうち最も誤差の小さい寄せ先
+        const size_t vertexCount = m_vertices.size();
+        std::vector<Collapse> best(vertexCount,
+            Collapse{ 0, 0, std::numeric_limits<double>::infinity() });
+        for (size_t t = 0; t < m_indices.size(); t += 3) {
+            for (int k = 0; k < 3; k++) {
+                uint32_t from = m_indices[t + k];
+                if (!m_movable[from]) {
+                    continue;
+                }
+                for (int e = 1; e < 3; e++) {
+                    uint32_t to = m_indices[t + (k + e) % 3];
+                    if (m_position[to] == m_position[from]) {
+                        continue;
+                    }
+                    double cost = Evaluate(m_quadrics[m_position[from]],
+                        m_quadrics[m_position[to]], m_vertices[to].position);
+                    if (cost < best[from].cost) {
+                        best[from] = Collapse{ from, to, cost };
+                    }
+                }
+            }
+        }
+
+        std::vector<Collapse> collapses;
+        for (const Collapse& collapse : best) {
+            if (collapse.cost < std::numeric_limits<double>::infinity()) {
+                collapses.push_back(collapse);
+            }
+        }
+        std::sort(collapses.begin(), collapses.end(),
+            [](const Collapse& a, const Collapse& b) {
+                return a.cost < b.cost;
+            });
+
+        // 縮約した頂点とその周りの頂点は，このパスでは動かさない
+        // 周りの三角形が変わらないので，向きの判定が他の縮約に影響されない
+        std::vector<uint32_t> remap(vertexCount);
+        for (uint32_t v = 0; v < static_cast<uint32_t>(vertexCount); v++) {
+            remap[v] = v;
+        }
+        std::vector<uint8_t> locked(vertexCount, 0);
+
+        const size_t removeTarget = (m_indices.size() - targetIndexCount) / 3;
+        size_t removed            = 0;
+        size_t collapseCount      = 0;
+        for (const Collapse& collapse : collapses) {
+            if (removed >= removeTarget) {
+                break;
+            }
+            if (locked[collapse.from] || remap[collapse.to] != collapse.to ||
+                Flips(collapse.from, collapse.to)) {
+                continue;
+            }
+
+            for (uint32_t i = m_triangleOffsets[collapse.from];
+                i < m_triangleOffsets[collapse.from + 1]; i++) {
+                const uint32_t* triangle =
+                    &m_indices[m_vertexTriangles[i] * 3];
+                bool removes = false;
+                for (int k = 0; k < 3; k++) {
+                    locked[triangle[k]] = 1;
+                    removes |= m_position[triangle[k]] ==
+                               m_position[collapse.to];
+                }
+                removed += removes ? 1 : 0;
+            }
+
+            remap[collapse.from] = collapse.to;
+            m_quadrics[m_position[collapse.to]].Add(
+                m_quadrics[m_position[collapse.from]]);
+            m_error = std::max(
+                m_error, static_cast<float>(std::sqrt(collapse.cost)));
+            collapseCount++;
+        }
+        if (collapseCount == 0) {
+            return false;
+        }
+
+        // 置き換えて，位置が重なった三角形を除く
+        size_t write = 0;
+        for (size_t t = 0; t < m_indices.size(); t += 3) {
+            uint32_t a = remap[m_indices[t + 0]];
+            uint32_t b = remap[m_indices[t + 1]];
+            uint32_t c = remap[m_indices[t + 2]];
+            if (m_position[a] == m_position[b] ||
+                m_position[b] == m_position[c] ||
+                m_position[c] == m_position[a]) {
+                continue;
+            }
+            m_indices[write + 0] = a;
+            m_indices[write + 1] = b;
+            m_indices[write + 2] = c;
+            write += 3;
+        }
+        m_indices.resize(write);
+        return true;
+    }
+
+    const std::vector<StandardVertex>& m_vertices;  // 元の頂点
+    std::vector<uint32_t> m_indices;                // 現在のインデックス
+    std::vector<uint32_t> m_position;  // 同じ位置の代表の頂点番号
+    std::vector<uint8_t> m_movable;    // 他の頂点へ寄せてよいか
+    std::vector<Quadric> m_quadrics;   // 代表の頂点ごとの二次誤差
+
+    std::vector<uint32_t> m_triangleOffsets;  // 頂点ごとの三角形の一覧の先頭
+    std::vector<uint32_t> m_vertexTriangles;  // 頂点ごとの三角形の一覧
+
+    float m_error = 0.0f;  // ここまでの縮約の最大の誤差
+};
+}  // namespace
+
+// モデル全体のLODの生成
+void MeshSimplifier::GenerateLods(
+    std::vector<MeshAsset>& meshes, Stats* pOutStats) {
+    Stats stats;
+    for (MeshAsset& mesh : meshes) {
+        auto start = std::chrono::high_resolution_clock::now();
+        bool built = GenerateLods(mesh);
+        auto end   = std::chrono::high_resolution_clock::now();
+        stats.simplifyTimeMs +=
+            std::chrono::duration<double, std::milli>(end - start).count();
+        if (!built) {
+            continue;
+        }
+
+        stats.meshCount++;
+        stats.inputTriangleCount += mesh.lods[0].indexCount / 3;
+        for (size_t i = 0; i < mesh.lods.size(); i++) {
+            stats.lodMeshCount[i]++;
+            stats.triangleCount[i] += mesh.lods[i].indexCount / 3;
+        }
+    }
+
+    if (pOutStats != nullptr) {
+        *pOutStats = stats;
+    }
+}
+
+// LODの生成
+bool MeshSimplifier::GenerateLods(MeshAsset& mesh) {
+    // 誤差の計算に圧縮前の位置が必要
+    if (mesh.HasCompactVertices()) {
+        return false;
+    }
+
+    // 既存のLODを除き，LOD0だけに戻す
+    const size_t baseCount = mesh.GetBaseIndexCount();
+    mesh.indices.resize(std::min(mesh.indices.size(), baseCount));
+    mesh.indices16.resize(std::min(mesh.indices16.size(), baseCount));
+    mesh.lods.clear();
+
+    // 16bitに変換済みでも同じように扱えるように，32bitで読み出す
+    std::vector<uint32_t> base = mesh.indices;
+    if (mesh.HasShortIndices()) {
+        base.assign(mesh.indices16.begin(), mesh.indices16.end());
+    }
+    const size_t vertexCount = mesh.vertices.size();
+    if (base.size() % 3 != 0 ||
+        !MeshOptimizer::ValidateIndexRange(base, vertexCount)) {
+        return false;
+    }
+
+    std::vector<MeshLod> lods = {
+        MeshLod{ 0, static_cast<uint32_t>(base.size()), 0.0f }
+    };
+    std::vector<uint32_t> lodIndices;
+
+    Simplifier simplifier(mesh.vertices, base);
+    size_t previousCount = base.size();
+    while (lods.size() < kMaxLods) {
+        size_t target =
+            static_cast<size_t>(previousCount / 3 * kLodReduction) * 3;
+        if (target < size_t{ kMinLodTriangles } * 3) {
+            break;
+        }
+
+        float error       = simplifier.Reduce(target);
+        size_t indexCount = simplifier.GetIndices().size();
+
+        // シームや縁ばかりで，ほとんど減らせなかった
+        if (indexCount > previousCount * (1.0f - kMinLodReduction)) {
+            break;
+        }
+
+        // LODごとに頂点キャッシュ向けに並べ直してから後ろに足す
+        std::vector<uint32_t> indices = simplifier.GetIndices();
+        MeshOptimizer::OptimizeVertexCache(indices, vertexCount);
+
+        const size_t indexOffset = base.size() + lodIndices.size();
+
+        MeshLod lod     = {};
+        lod.indexOffset = static_cast<uint32_t>(indexOffset);
+        lod.indexCount  = static_cast<uint32_t>(indexCount);
+        lod.error       = error;
+        lods.push_back(lod);
+        lodIndices.insert(lodIndices.end(), indices.begin(), indices.end());
+        previousCount = indexCount;
+    }
+    if (lods.size() == 1) {
+        return false;
+    }
+
+    if (mesh.HasShortIndices()) {
+        for (uint32_t index : lodIndices) {
+            mesh.indices16.push_back(static_cast<uint16_t>(index));
+        }
+    } else {
+        mesh.indices.insert(
+            mesh.indices.end(), lodIndices.begin(), lodIndices.end());
+    }
+    mesh.lods = std::move(lods);
+    return true;
+}
+
+// 目標の数までの簡略化
+float MeshSimplifier::Simplify(const std::vector<StandardVertex>& vertices,
+    const std::vector<uint32_t>& indices, size_t targetIndexCount,
+    std::vector<uint32_t>& outIndices) {
+    Simplifier simplifier(vertices, indices);
+    float error = simplifier.Reduce(targetIndexCount);
+    outIndices  = simplifier.GetIndices();
+    return error;
+}
@@ -0,0 +1,277 @@
+#include "Engine/Resource/MeshletBuilder.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Engine/Resource/MeshOptimizer.h"
+
+namespace /* anonymous */ {
+/// @brief メッシュレットにまだ含まれていない頂点
+constexpr uint8_t kUnusedVertex = 0xFF;
+
+/// @brief 法線錐で判定する最小の内積（広がりが約84°を超えたら判定しない）
+constexpr float kMinConeDot = 0.1f;
+
+static_assert(Meshlet::kMaxVertices < kUnusedVertex,
+    "Local vertex index must fit in uint8_t");
+
+using DirectX::XMFLOAT3;
+
+XMFLOAT3 Subtract(const XMFLOAT3& a, const XMFLOAT3& b) {
+    return XMFLOAT3(a.x - b.x, a.y - b.y, a.z - b.z);
+}
+
+XMFLOAT3 Scale(const XMFLOAT3& v, float s) {
+    return XMFLOAT3(v.x * s, v.y * s, v.z * s);
+}
+
+float Dot(const XMFLOAT3& a, const XMFLOAT3& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+XMFLOAT3 Cross(const XMFLOAT3& a, const XMFLOAT3& b) {
+    return XMFLOAT3(
+        a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+}
+
+float Length(const XMFLOAT3& v) { return std::sqrt(Dot(v, v)); }
+
+/// @brief 軸の番号（0～2）で成分を取り出す
+float Component(const XMFLOAT3& v, int axis) {
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+/// @brief 点の集まりを囲む球（Ritterの方法，最小ではないが近い）
+void ComputeBoundingSphere(const std::vector<XMFLOAT3>& points,
+    XMFLOAT3& outCenter, float& outRadius) {
+    // 各軸で最小・最大の点を探し，最も離れた組を最初の直径にする
+    size_t minIndex[3] = {};
+    size_t maxIndex[3] = {};
+    for (size_t i = 0; i < points.size(); i++) {
+        for (int axis = 0; axis < 3; axis++) {
+            float value = Component(points[i], axis);
+            if (value < Component(points[minIndex[axis]], axis)) {
+                minIndex[axis] = i;
+            }
+            if (value > Component(points[maxIndex[axis]], axis)) {
+                maxIndex[axis] = i;
+            }
+        }
+    }
+
+    int bestAxis     = 0;
+    float bestLength = -1.0f;
+    for (int axis = 0; axis < 3; axis++) {
+        float length = Length(
+            Subtract(points[maxIndex[axis]], points[minIndex[axis]]));
+        if (length > bestLength) {
+            bestLength = length;
+            bestAxis   = axis;
+        }
+    }
+
+    const XMFLOAT3& a = points[minIndex[bestAxis]];
+    const XMFLOAT3& b = points[maxIndex[bestAxis]];
+    XMFLOAT3 center((a.x + b.x) * 0.5f, (a.y + b.y) * 0.5f, (a.z + b.z) * 0.5f);
+    float radius = bestLength * 0.5f;
+
+    // 外にある点を含むように，球をその点の方向へ広げる
+    for (const XMFLOAT3& point : points) {
+        XMFLOAT3 offset = Subtract(point, center);
+        float distance  = Length(offset);
+        if (distance > radius) {
+            float newRadius = (radius + distance) * 0.5f;
+            float shift     = (distance - newRadius) / distance;
+            center.x += offset.x * shift;
+            center.y += offset.y * shift;
+            center.z += offset.z * shift;
+            radius = newRadius;
+        }
+    }
+
+    outCenter = center;
+    outRadius = radius;
+}
+}  // namespace
+
+// モデル全体のメッシュレットの生成
+void MeshletBuilder::BuildMeshlets(
+    std::vector<MeshAsset>& meshes, Stats* pOutStats) {
+    Stats stats;
+    for (MeshAsset& mesh : meshes) {
+        if (!Build(mesh)) {
+            continue;
+        }
+
+        stats.meshletCount += static_cast<uint32_t>(mesh.meshlets.size());
+        stats.vertexCount += mesh.meshletVertices.size();
+        stats.triangleCount += mesh.meshletTriangles.size() / 3;
+        for (const MeshletBounds& bounds : mesh.meshletBounds) {
+            if (bounds.coneCutoff < 1.0f) {
+                stats.coneMeshletCount++;
+            }
+        }
+    }
+
+    if (pOutStats != nullptr) {
+        *pOutStats = stats;
+    }
+}
+
+// メッシュレットの生成
+bool MeshletBuilder::Build(MeshAsset& mesh) {
+    // 境界の計算に圧縮前の位置が必要
+    if (mesh.HasCompactVertices()) {
+        return false;
+    }
+
+    // 16bitに変換済みでも同じように扱えるように，32bitで読み出す
+    // LODはカリングしないので，LOD0の範囲だけを使う
+    std::vector<uint32_t> indices = mesh.indices;
+    if (mesh.HasShortIndices()) {
+        indices.assign(mesh.indices16.begin(), mesh.indices16.end());
+    }
+    indices.resize(std::min<size_t>(indices.size(), mesh.GetBaseIndexCount()));
+    const size_t vertexCount = mesh.vertices.size();
+    if (indices.size() % 3 != 0 ||
+        !MeshOptimizer::ValidateIndexRange(indices, vertexCount)) {
+        return false;
+    }
+
+    std::vector<Meshlet> meshlets;
+    std::vector<uint32_t> meshletVertices;
+    std::vector<uint8_t> meshletTriangles(indices.size());
+
+    // メッシュの頂点番号からメッシュレット内の番号への対応
+    std::vector<uint8_t> localIndex(vertexCount, kUnusedVertex);
+
+    // 作成中のメッシュレット
+    Meshlet current = {};
+
+    // 作成中のメッシュレットを確定し，続きから次のメッシュレットを始める
+    auto finish = [&]() {
+        for (uint32_t i = 0; i < current.vertexCount; i++) {
+            localIndex[meshletVertices[current.vertexOffset + i]] =
+                kUnusedVertex;
+        }
+        meshlets.push_back(current);
+
+        current                = Meshlet{};
+        current.vertexOffset   = static_cast<uint32_t>(meshletVertices.size());
+        current.triangleOffset = meshlets.back().triangleOffset +
+                                 meshlets.back().triangleCount * 3;
+    };
+
+    for (size_t t = 0; t < indices.size(); t += 3) {
+        const uint32_t a = indices[t + 0];
+        const uint32_t b = indices[t + 1];
+        const uint32_t c = indices[t + 2];
+
+        // 縮退した三角形で同じ頂点を2回数えないようにする
+        uint32_t newVertices = 0;
+        if (localIndex[a] == kUnusedVertex) newVertices++;
+        if (b != a && localIndex[b] == kUnusedVertex) newVertices++;
+        if (c != a && c != b && localIndex[c] == kUnusedVertex) newVertices++;
+        if (current.vertexCount + newVertices > Meshlet::kMaxVertices ||
+            current.triangleCount == Meshlet::kMaxTriangles) {
+            finish();
+        }
+
+        const uint32_t corners[3] = { a, b, c };
+        for (int k = 0; k < 3; k++) {
+            uint32_t vertex = corners[k];
+            if (localIndex[vertex] == kUnusedVertex) {
+                localIndex[vertex] = static_cast<uint8_t>(current.vertexCount);
+                meshletVertices.push_back(vertex);
+                current.vertexCount++;
+            }
+            meshletTriangles[t + k] = localIndex[vertex];
+        }
+        current.triangleCount++;
+    }
+    if (current.triangleCount > 0) {
+        finish();
+    }
+
+    mesh.meshlets         = std::move(meshlets);
+    mesh.meshletVertices  = std::move(meshletVertices);
+    mesh.meshletTriangles = std::move(meshletTriangles);
+
+    mesh.meshletBounds.clear();
+    mesh.meshletBounds.reserve(mesh.meshlets.size());
+    for (const Meshlet& meshlet : mesh.meshlets) {
+        mesh.meshletBounds.push_back(ComputeBounds(mesh, meshlet));
+    }
+    return true;
+}
+
+// 境界球と法線錐の計算
+MeshletBounds MeshletBuilder::ComputeBounds(
+    const MeshAsset& mesh, const Meshlet& meshlet) {
+    MeshletBounds bounds = {};
+    bounds.coneCutoff    = 1.0f;
+
+    std::vector<XMFLOAT3> positions(meshlet.vertexCount);
+    for (uint32_t i = 0; i < meshlet.vertexCount; i++) {
+        uint32_t vertex = mesh.meshletVertices[meshlet.vertexOffset + i];
+        positions[i]    = mesh.vertices[vertex].position;
+    }
+    if (positions.empty()) {
+        return bounds;
+    }
+    ComputeBoundingSphere(positions, bounds.center, bounds.radius);
+    bounds.coneApex = bounds.center;
+
+    // 三角形の表の向き（時計回りが表，左手系）と代表点
+    std::vector<XMFLOAT3> normals;
+    std::vector<XMFLOAT3> corners;
+    normals.reserve(meshlet.triangleCount);
+    corners.reserve(meshlet.triangleCount);
+    XMFLOAT3 axis(0.0f, 0.0f, 0.0f);
+    for (uint32_t t = 0; t < meshlet.triangleCount; t++) {
+        const uint8_t* local =
+            &mesh.meshletTriangles[meshlet.triangleOffset + t * 3];
+        const XMFLOAT3& p0 = positions[local[0]];
+        const XMFLOAT3& p1 = positions[local[1]];
+        const XMFLOAT3& p2 = positions[local[2]];
+
+        XMFLOAT3 normal = Cross(Subtract(p1, p0), Subtract(p2, p0));
+        float length    = Length(normal);
+        if (!(length > 0.0f)) {
+            continue;  // 縮退した三角形は向きを持たない
+        }
+        normal = Scale(normal, 1.0f / length);
+        normals.push_back(normal);
+        corners.push_back(p0);
+        axis.x += normal.x;
+        axis.y += normal.y;
+        axis.z += normal.z;
+    }
+
+    float axisLength = Length(axis);
+    if (normals.empty() || !(axisLength > 0.0f)) {
+        return bounds;
+    }
+    axis = Scale(axis, 1.0f / axisLength);
+
+    // 軸から最も離れた法線が広がり角を決める
+    float minDot = 1.0f;
+    for (const XMFLOAT3& normal : normals) {
+        minDot = std::min(minDot, Dot(normal, axis));
+    }
+    if (minDot <= kMinConeDot) {
+        return bounds;  // 向きがばらばらで，どこから見ても表が残る
+    }
+
+    // 全ての三角形の平面の裏側に入るまで，中心から軸の逆方向へ頂点を下げる
+    float maxT = 0.0f;
+    for (size_t i = 0; i < normals.size(); i++) {
+        float distance = Dot(Subtract(bounds.center, corners[i]), normals[i]);
+        maxT           = std::max(maxT, distance / Dot(normals[i], axis));
+    }
+
+    bounds.coneApex   = Subtract(bounds.center, Scale(axis, maxT));
+    bounds.coneAxis   = axis;
+    bounds.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+    return bounds;
+}
@@ -0,0 +1,782 @@
+#include "Engine/Resource/MipGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <immintrin.h>
+
+#include "Engine/Core/CpuFeatures.h"
+#include "Engine/Core/JobSystem.h"
+
+// MSVCは/arch無しでもAVX2の組み込み関数を使えるが，
+// GCCとClangは関数ごとに使う命令セットを指定する
+#if defined(_MSC_VER) && !defined(__clang__)
+#define MIP_TARGET_AVX2
+#else
+#define MIP_TARGET_AVX2 __attribute__((target("avx2,f16c")))
+#endif
+
+namespace /* anonymous */ {
+//===========================================================================
+// フィルタの重み
+//===========================================================================
+
+/// @brief 1軸の縮小の重み
+/// 縮小先のi番目は，t = 0, 1, ...の順に
+/// indices[t * size + i]の縮小元にweights[t * size + i]を掛けて足す
+/// 縮小先の並びを連続させて，8つの縮小先の重みをまとめて読めるようにする
+struct FilterTaps {
+    std::vector<int32_t> indices;  // 縮小元の位置
+    std::vector<float> weights;    // 重み，使わないタップは0
+    uint32_t size     = 0;         // 縮小先の数
+    uint32_t tapCount = 0;         // 縮小先1つあたりのタップ数
+};
+
+/// @brief 縮小先ごとの(位置, 重み)の並びを，重みの和が1になるように詰める
+FilterTaps PackTaps(
+    const std::vector<std::vector<std::pair<int32_t, double>>>& perDst) {
+    FilterTaps taps;
+    taps.size = static_cast<uint32_t>(perDst.size());
+    for (const auto& list : perDst) {
+        taps.tapCount =
+            std::max(taps.tapCount, static_cast<uint32_t>(list.size()));
+    }
+
+    const size_t total = size_t{ taps.size } * taps.tapCount;
+    taps.indices.assign(total, 0);
+    taps.weights.assign(total, 0.0f);
+    for (uint32_t i = 0; i < taps.size; i++) {
+        const auto& list = perDst[i];
+
+        double sum = 0.0;
+        for (const auto& tap : list) {
+            sum += tap.second;
+        }
+
+        // 足りないタップは重み0で最初の縮小元を指す
+        for (uint32_t t = 0; t < taps.tapCount; t++) {
+            const size_t at   = size_t{ t } * taps.size + i;
+            const bool inList = t < list.size();
+            taps.indices[at]  = inList ? list[t].first : list[0].first;
+            taps.weights[at] =
+                inList ? static_cast<float>(list[t].second / sum) : 0.0f;
+        }
+    }
+    return taps;
+}
+
+/// @brief 縮小先のピクセルが覆う範囲と，縮小元の各ピクセルの重なりから
+/// ボックスフィルタの重みを作る
+FilterTaps ComputeBoxTaps(uint32_t srcSize, uint32_t dstSize) {
+    const double scale = static_cast<double>(srcSize) / dstSize;
+
+    std::vector<std::vector<std::pair<int32_t, double>>> perDst(dstSize);
+    for (uint32_t i = 0; i < dstSize; i++) {
+        double begin = i * scale;
+        double end   = (i + 1) * scale;
+        uint32_t j0  = static_cast<uint32_t>(begin);
+        uint32_t j1  = std::min(static_cast<uint32_t>(std::ceil(end)), srcSize);
+
+        for (uint32_t j = j0; j < j1; j++) {
+            double overlap = std::min(end, j + 1.0) - std::max(begin, 1.0 * j);
+            if (overlap > 0.0) {
+                perDst[i].emplace_back(static_cast<int32_t>(j), overlap);
+            }
+        }
+    }
+    return PackTaps(perDst);
+}
+
+/// @brief 0次の第1種変形ベッセル関数
+double BesselI0(double x) {
+    double sum  = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 64 && term > sum * 1e-12; k++) {
+        const double t = x / (2.0 * k);
+        term *= t * t;
+        sum += term;
+    }
+    return sum;
+}
+
+/// @brief Kaiser窓を掛けたsincの重みを作る
+/// 縮小先のピクセル単位でkKaiserWidthの半径を見て，範囲外は繰り返す
+FilterTaps ComputeKaiserTaps(uint32_t srcSize, uint32_t dstSize) {
+    constexpr double kPi    = 3.14159265358979323846;
+    const double width      = MipGenerator::kKaiserWidth;
+    const double alpha      = MipGenerator::kKaiserAlpha;
+    const double scale      = static_cast<double>(srcSize) / dstSize;
+    const double radius     = width * scale;  // 縮小元のピクセル単位
+    const double normalizer = 1.0 / BesselI0(alpha);
+
+    std::vector<std::vector<std::pair<int32_t, double>>> perDst(dstSize);
+    for (uint32_t i = 0; i < dstSize; i++) {
+        // 縮小元の中心が(center - radius, center + radius)に入るもの
+        const double center = (i + 0.5) * scale;
+        const int64_t j0 =
+            static_cast<int64_t>(std::floor(center - radius - 0.5)) + 1;
+        const int64_t j1 =
+            static_cast<int64_t>(std::ceil(center + radius - 0.5));
+
+        for (int64_t j = j0; j < j1; j++) {
+            const double x = (j + 0.5 - center) / scale;
+            const double r = x / width;
+            if (r * r >= 1.0) {
+                continue;
+            }
+
+            const double sinc =
+                x == 0.0 ? 1.0 : std::sin(kPi * x) / (kPi * x);
+            const double window =
+                BesselI0(alpha * std::sqrt(1.0 - r * r)) * normalizer;
+
+            // 範囲外は反対側から繰り返す
+            int64_t wrapped = j % srcSize;
+            if (wrapped < 0) {
+                wrapped += srcSize;
+            }
+            perDst[i].emplace_back(
+                static_cast<int32_t>(wrapped), sinc * window);
+        }
+    }
+    return PackTaps(perDst);
+}
+
+/// @brief フィルタの重みを作る，大きさが変わらない軸はそのまま写す
+FilterTaps ComputeTaps(MipFilter filter, uint32_t srcSize, uint32_t dstSize) {
+    if (srcSize == dstSize) {
+        std::vector<std::vector<std::pair<int32_t, double>>> perDst(dstSize);
+        for (uint32_t i = 0; i < dstSize; i++) {
+            perDst[i].emplace_back(static_cast<int32_t>(i), 1.0);
+        }
+        return PackTaps(perDst);
+    }
+    return filter == MipFilter::Kaiser ? ComputeKaiserTaps(srcSize, dstSize)
+                                       : ComputeBoxTaps(srcSize, dstSize);
+}
+
+//===========================================================================
+// 色の変換
+//===========================================================================
+
+/// @brief sRGBと線形の変換表
+/// 線形からsRGBへの変換は，floatのビットの上位で区間を引いて下限を求め，
+/// 次の値に丸める境界と1回だけ比べる
+/// 区間の幅は境界の間隔より狭いので，結果は境界を順に探した場合と一致する
+struct ColorTables {
+    /// @brief 区間の最小値（2^-13），これより小さい値は全て0になる
+    static constexpr int32_t kBucketBias = (127 - 13) << 8;
+
+    /// @brief 区間の数（指数13個 x 仮数の上位8ビット）
+    static constexpr int32_t kBucketCount = 13 << 8;
+
+    /// @brief 区間を引くときに捨てるビット数
+    static constexpr int kBucketShift = 15;
+
+    float decode[512];                 // [0, 256)はsRGB，[256, 512)は線形
+    float thresholds[257];             // [k]はk以上に丸める最小の線形な値
+    int32_t bucketBase[kBucketCount];  // 区間の最小値を変換した値
+};
+
+/// @brief sRGBから線形
+double SrgbToLinear(double c) {
+    return c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+}
+
+/// @brief 変換表を作る
+ColorTables BuildColorTables() {
+    ColorTables tables{};
+    for (int k = 0; k < 256; k++) {
+        tables.decode[k]       = static_cast<float>(SrgbToLinear(k / 255.0));
+        tables.decode[256 + k] = static_cast<float>(k / 255.0);
+    }
+
+    tables.thresholds[0] = -std::numeric_limits<float>::infinity();
+    for (int k = 1; k < 256; k++) {
+        tables.thresholds[k] =
+            static_cast<float>(SrgbToLinear((k - 0.5) / 255.0));
+    }
+    tables.thresholds[256] = std::numeric_limits<float>::infinity();
+
+    int32_t base = 0;
+    for (int32_t b = 0; b < ColorTables::kBucketCount; b++) {
+        const uint32_t bucket = b + ColorTables::kBucketBias;
+        const uint32_t bits   = bucket << ColorTables::kBucketShift;
+        float lower;
+        std::memcpy(&lower, &bits, sizeof(lower));
+        while (lower >= tables.thresholds[base + 1]) {
+            base++;
+        }
+        tables.bucketBase[b] = base;
+    }
+    return tables;
+}
+
+/// @brief 変換表（最初に使うときに作る）
+const ColorTables& GetColorTables() {
+    static const ColorTables tables = BuildColorTables();
+    return tables;
+}
+
+/// @brief [0, 1]に収める，NaNは0にする
+float Saturate(float x) {
+    x = x > 0.0f ? x : 0.0f;
+    return x < 1.0f ? x : 1.0f;
+}
+
+/// @brief 線形な値をsRGBの8ビットに丸める
+int32_t EncodeSrgb(const ColorTables& tables, float x) {
+    x = Saturate(x);
+
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    int32_t bucket = static_cast<int32_t>(bits >> ColorTables::kBucketShift) -
+                     ColorTables::kBucketBias;
+    bucket = std::clamp(bucket, 0, ColorTables::kBucketCount - 1);
+
+    const int32_t base = tables.bucketBase[bucket];
+    return base + (x >= tables.thresholds[base + 1] ? 1 : 0);
+}
+
+/// @brief 線形な値を8ビットに丸める
+int32_t QuantizeUnorm8(float x) {
+    return static_cast<int32_t>(Saturate(x) * 255.0f + 0.5f);
+}
+
+/// @brief 半精度からfloat
+float HalfToFloat(uint16_t half) {
+    const uint32_t sign     = static_cast<uint32_t>(half & 0x8000) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1F;
+    const uint32_t mantissa = half & 0x3FF;
+
+    uint32_t bits;
+    if (exponent == 0) {
+        // 0と非正規化数
+        float value = std::ldexp(static_cast<float>(mantissa), -24);
+        std::memcpy(&bits, &value, sizeof(bits));
+        bits |= sign;
+    } else if (exponent == 0x1F) {
+        // 無限大とNaN（NaNはquietにする）
+        bits = sign | 0x7F800000 | (mantissa << 13) |
+               (mantissa != 0 ? 0x00400000 : 0);
+    } else {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+/// @brief floatから半精度（最近接偶数丸め）
+uint16_t FloatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint32_t sign = (bits >> 16) & 0x8000;
+    bits &= 0x7FFFFFFF;
+
+    uint32_t half;
+    if (bits >= 0x7F800000) {
+        // 無限大とNaN（NaNはquietにする）
+        half = bits > 0x7F800000 ? 0x7E00 | ((bits >> 13) & 0x3FF) : 0x7C00;
+    } else if (bits >= 0x477FF000) {
+        // 半精度の最大値を超えるものは無限大
+        half = 0x7C00;
+    } else if (bits < 0x38800000) {
+        // 非正規化数は0.5を足して仮数の位置を合わせ，丸めをFPUに任せる
+        float magic;
+        std::memcpy(&magic, &bits, sizeof(magic));
+        magic += 0.5f;
+        std::memcpy(&half, &magic, sizeof(half));
+        half -= 0x3F000000;
+    } else {
+        // 正規化数は指数を付け替え，捨てる13ビットで丸める
+        const uint32_t odd = (bits >> 13) & 1;
+        bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFF + odd;
+        half = bits >> 13;
+    }
+    return static_cast<uint16_t>(half | sign);
+}
+
+//===========================================================================
+// スカラーの処理
+// どの関数も[begin, end)の範囲を処理し，AVX2の版は端数をこちらに任せる
+//===========================================================================
+
+/// @brief 1段の縮小で共通の情報
+struct LevelContext {
+    const ColorTables* pTables = nullptr;
+    MipFormat format           = MipFormat::RGBA8;
+    uint32_t channels          = 4;
+    int32_t decodeOffsets[4]   = {};     // RGBA8の変換表の位置
+    bool isSRGB                = false;  // RGBA8のみ
+    bool isNormalMap           = false;  // RGBA8のみ
+};
+
+/// @brief 縮小元の1行の[begin, end)番目の値をfloatの線形な値にする
+void LoadScalar(const LevelContext& context, const uint8_t* pSrc,
+    uint32_t begin, uint32_t end, float* pOut) {
+    switch (context.format) {
+    case MipFormat::RGBA8:
+        for (uint32_t i = begin; i < end; i++) {
+            pOut[i] = context.pTables
+                          ->decode[pSrc[i] + context.decodeOffsets[i & 3]];
+        }
+        break;
+    case MipFormat::RGBA16F: {
+        const uint16_t* pHalf = reinterpret_cast<const uint16_t*>(pSrc);
+        for (uint32_t i = begin; i < end; i++) {
+            pOut[i] = HalfToFloat(pHalf[i]);
+        }
+        break;
+    }
+    case MipFormat::R32F:
+        std::memcpy(pOut + begin, reinterpret_cast<const float*>(pSrc) + begin,
+            (end - begin) * sizeof(float));
+        break;
+    }
+}
+
+/// @brief 横に縮小し，縮小先の[begin, end)番目のピクセルを作る
+void FilterScalar(const float* pIn, uint32_t channels, const FilterTaps& taps,
+    uint32_t begin, uint32_t end, float* pOut) {
+    for (uint32_t x = begin; x < end; x++) {
+        for (uint32_t c = 0; c < channels; c++) {
+            float sum = 0.0f;
+            for (uint32_t t = 0; t < taps.tapCount; t++) {
+                const size_t at = size_t{ t } * taps.size + x;
+                sum = sum + taps.weights[at] *
+                                pIn[taps.indices[at] * channels + c];
+            }
+            pOut[x * channels + c] = sum;
+        }
+    }
+}
+
+/// @brief 横に縮小した行を縦に重み付けして足し，[begin, end)番目の値を作る
+void AccumulateScalar(const float* const* pRows, const float* pWeights,
+    uint32_t rowCount, uint32_t begin, uint32_t end, float* pOut) {
+    for (uint32_t i = begin; i < end; i++) {
+        float sum = 0.0f;
+        for (uint32_t t = 0; t < rowCount; t++) {
+            sum = sum + pWeights[t] * pRows[t][i];
+        }
+        pOut[i] = sum;
+    }
+}
+
+/// @brief 法線を長さ1に戻す（[0, 1]に詰めたXYZ，アルファはそのまま）
+void RenormalizeScalar(float* pTexel) {
+    const float x   = pTexel[0] * 2.0f - 1.0f;
+    const float y   = pTexel[1] * 2.0f - 1.0f;
+    const float z   = pTexel[2] * 2.0f - 1.0f;
+    const float len = std::sqrt(x * x + y * y + z * z);
+
+    const float scale[3] = { x, y, z };
+    for (int c = 0; c < 3; c++) {
+        const float n = len > 0.0f ? scale[c] / len : scale[c];
+        pTexel[c]     = n * 0.5f + 0.5f;
+    }
+}
+
+/// @brief 縮小先の[begin, end)番目のピクセルを書き込む
+void StoreScalar(const LevelContext& context, const float* pIn,
+    uint32_t begin, uint32_t end, uint8_t* pDst) {
+    switch (context.format) {
+    case MipFormat::RGBA8:
+        for (uint32_t x = begin; x < end; x++) {
+            float texel[4];
+            std::memcpy(texel, pIn + x * 4, sizeof(texel));
+            if (context.isNormalMap) {
+                RenormalizeScalar(texel);
+            }
+
+            // アルファはsRGBでも線形
+            for (uint32_t c = 0; c < 4; c++) {
+                pDst[x * 4 + c] = static_cast<uint8_t>(
+                    context.isSRGB && c < 3
+                        ? EncodeSrgb(*context.pTables, texel[c])
+                        : QuantizeUnorm8(texel[c]));
+            }
+        }
+        break;
+    case MipFormat::RGBA16F: {
+        uint16_t* pHalf = reinterpret_cast<uint16_t*>(pDst);
+        for (uint32_t i = begin * 4; i < end * 4; i++) {
+            pHalf[i] = FloatToHalf(pIn[i]);
+        }
+        break;
+    }
+    case MipFormat::R32F:
+        std::memcpy(reinterpret_cast<float*>(pDst) + begin, pIn + begin,
+            (end - begin) * sizeof(float));
+        break;
+    }
+}
+
+//===========================================================================
+// AVX2の処理
+// スカラーと同じ順番で掛けて足す（FMAは使わない）ので，結果は一致する
+//===========================================================================
+
+/// @brief 縮小元の1行をfloatの線形な値にする（8つずつ）
+MIP_TARGET_AVX2 void LoadAvx2(const LevelContext& context,
+    const uint8_t* pSrc, uint32_t begin, uint32_t end, float* pOut) {
+    uint32_t i = begin;
+    switch (context.format) {
+    case MipFormat::RGBA8: {
+        // 8ビットの値を変換表の位置にして引く
+        const int32_t* o     = context.decodeOffsets;
+        const __m256i offset = _mm256_setr_epi32(
+            o[0], o[1], o[2], o[3], o[0], o[1], o[2], o[3]);
+        for (; i + 8 <= end; i += 8) {
+            const __m128i bytes = _mm_loadl_epi64(
+                reinterpret_cast<const __m128i*>(pSrc + i));
+            const __m256i index =
+                _mm256_add_epi32(_mm256_cvtepu8_epi32(bytes), offset);
+            _mm256_storeu_ps(pOut + i,
+                _mm256_i32gather_ps(context.pTables->decode, index, 4));
+        }
+        break;
+    }
+    case MipFormat::RGBA16F: {
+        const uint16_t* pHalf = reinterpret_cast<const uint16_t*>(pSrc);
+        for (; i + 8 <= end; i += 8) {
+            const __m128i half = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(pHalf + i));
+            _mm256_storeu_ps(pOut + i, _mm256_cvtph_ps(half));
+        }
+        break;
+    }
+    case MipFormat::R32F:
+        break;
+    }
+    LoadScalar(context, pSrc, i, end, pOut);
+}
+
+/// @brief 横に縮小する（RGBAは2ピクセルずつ，Rは8ピクセルずつ）
+MIP_TARGET_AVX2 void FilterAvx2(const float* pIn, uint32_t channels,
+    const FilterTaps& taps, uint32_t begin, uint32_t end, float* pOut) {
+    uint32_t x = begin;
+    if (channels == 4) {
+        // 2ピクセル分の重みを下位と上位の4レーンに広げる
+        const __m256i spread = _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+        for (; x + 2 <= end; x += 2) {
+            __m256 sum = _mm256_setzero_ps();
+            for (uint32_t t = 0; t < taps.tapCount; t++) {
+                const size_t at      = size_t{ t } * taps.size + x;
+                const int32_t* pIdx  = &taps.indices[at];
+                const __m128i weight = _mm_loadl_epi64(
+                    reinterpret_cast<const __m128i*>(&taps.weights[at]));
+                const __m256 w = _mm256_permutevar8x32_ps(
+                    _mm256_castps128_ps256(_mm_castsi128_ps(weight)), spread);
+                const __m256 v = _mm256_insertf128_ps(
+                    _mm256_castps128_ps256(_mm_loadu_ps(pIn + pIdx[0] * 4)),
+                    _mm_loadu_ps(pIn + pIdx[1] * 4), 1);
+                sum = _mm256_add_ps(sum, _mm256_mul_ps(w, v));
+            }
+            _mm256_storeu_ps(pOut + x * 4, sum);
+        }
+    } else if (channels == 1) {
+        for (; x + 8 <= end; x += 8) {
+            __m256 sum = _mm256_setzero_ps();
+            for (uint32_t t = 0; t < taps.tapCount; t++) {
+                const size_t at     = size_t{ t } * taps.size + x;
+                const __m256i index = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(&taps.indices[at]));
+                const __m256 w = _mm256_loadu_ps(&taps.weights[at]);
+                const __m256 v = _mm256_i32gather_ps(pIn, index, 4);
+                sum            = _mm256_add_ps(sum, _mm256_mul_ps(w, v));
+            }
+            _mm256_storeu_ps(pOut + x, sum);
+        }
+    }
+    FilterScalar(pIn, channels, taps, x, end, pOut);
+}
+
+/// @brief 縦に重み付けして足す（8つずつ）
+MIP_TARGET_AVX2 void AccumulateAvx2(const float* const* pRows,
+    const float* pWeights, uint32_t rowCount, uint32_t begin, uint32_t end,
+    float* pOut) {
+    uint32_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 sum = _mm256_setzero_ps();
+        for (uint32_t t = 0; t < rowCount; t++) {
+            const __m256 w = _mm256_set1_ps(pWeights[t]);
+            sum = _mm256_add_ps(
+                sum, _mm256_mul_ps(w, _mm256_loadu_ps(pRows[t] + i)));
+        }
+        _mm256_storeu_ps(pOut + i, sum);
+    }
+    AccumulateScalar(pRows, pWeights, rowCount, i, end, pOut);
+}
+
+/// @brief [0, 1]に収める，NaNは0にする
+MIP_TARGET_AVX2 __m256 SaturateAvx2(__m256 v) {
+    return _mm256_min_ps(
+        _mm256_max_ps(v, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+}
+
+/// @brief 2ピクセル分の法線を長さ1に戻す
+MIP_TARGET_AVX2 __m256 RenormalizeAvx2(__m256 texels) {
+    const __m256 one  = _mm256_set1_ps(1.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 n =
+        _mm256_sub_ps(_mm256_mul_ps(texels, _mm256_set1_ps(2.0f)), one);
+
+    // スカラーと同じくx*x + y*yにz*zを足す
+    const __m256 sq  = _mm256_mul_ps(n, n);
+    const __m256 sum = _mm256_add_ps(
+        _mm256_add_ps(_mm256_permute_ps(sq, 0x00), _mm256_permute_ps(sq, 0x55)),
+        _mm256_permute_ps(sq, 0xAA));
+    const __m256 len = _mm256_sqrt_ps(sum);
+
+    const __m256 positive =
+        _mm256_cmp_ps(len, _mm256_setzero_ps(), _CMP_GT_OQ);
+    const __m256 unit =
+        _mm256_blendv_ps(n, _mm256_div_ps(n, len), positive);
+    const __m256 packed = _mm256_add_ps(_mm256_mul_ps(unit, half), half);
+    return _mm256_blend_ps(packed, texels, 0x88);
+}
+
+/// @brief 線形な値をsRGBの8ビットに丸める
+MIP_TARGET_AVX2 __m256i EncodeSrgbAvx2(const ColorTables& tables, __m256 v) {
+    const __m256 x = SaturateAvx2(v);
+
+    __m256i bucket = _mm256_sub_epi32(
+        _mm256_srli_epi32(_mm256_castps_si256(x), ColorTables::kBucketShift),
+        _mm256_set1_epi32(ColorTables::kBucketBias));
+    bucket = _mm256_max_epi32(bucket, _mm256_setzero_si256());
+    bucket = _mm256_min_epi32(
+        bucket, _mm256_set1_epi32(ColorTables::kBucketCount - 1));
+
+    const __m256i base = _mm256_i32gather_epi32(tables.bucketBase, bucket, 4);
+    const __m256 threshold =
+        _mm256_i32gather_ps(tables.thresholds + 1, base, 4);
+
+    // 比較の結果は-1なので引く
+    const __m256 ge = _mm256_cmp_ps(x, threshold, _CMP_GE_OQ);
+    return _mm256_sub_epi32(base, _mm256_castps_si256(ge));
+}
+
+/// @brief 縮小先のピクセルを書き込む（RGBA8は2ピクセルずつ）
+MIP_TARGET_AVX2 void StoreAvx2(const LevelContext& context, const float* pIn,
+    uint32_t begin, uint32_t end, uint8_t* pDst) {
+    uint32_t x = begin;
+    switch (context.format) {
+    case MipFormat::RGBA8: {
+        const __m256 scale = _mm256_set1_ps(255.0f);
+        const __m256 half  = _mm256_set1_ps(0.5f);
+        for (; x + 2 <= end; x += 2) {
+            __m256 v = _mm256_loadu_ps(pIn + x * 4);
+            if (context.isNormalMap) {
+                v = RenormalizeAvx2(v);
+            }
+
+            __m256i q = _mm256_cvttps_epi32(
+                _mm256_add_ps(_mm256_mul_ps(SaturateAvx2(v), scale), half));
+            if (context.isSRGB) {
+                // アルファはsRGBでも線形
+                q = _mm256_blend_epi32(
+                    EncodeSrgbAvx2(*context.pTables, v), q, 0x88);
+            }
+
+            const __m128i words = _mm_packus_epi32(
+                _mm256_castsi256_si128(q), _mm256_extracti128_si256(q, 1));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(pDst + x * 4),
+                _mm_packus_epi16(words, words));
+        }
+        break;
+    }
+    case MipFormat::RGBA16F: {
+        uint16_t* pHalf = reinterpret_cast<uint16_t*>(pDst);
+        for (; x + 2 <= end; x += 2) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pHalf + x * 4),
+                _mm256_cvtps_ph(
+                    _mm256_loadu_ps(pIn + x * 4), _MM_FROUND_TO_NEAREST_INT));
+        }
+        break;
+    }
+    case MipFormat::R32F:
+        break;
+    }
+    StoreScalar(context, pIn, x, end, pDst);
+}
+
+//===========================================================================
+// 行の縮小
+//===========================================================================
+
+/// @brief 行の処理の組（スカラーかAVX2か）
+struct RowKernels {
+    void (*load)(const LevelContext&, const uint8_t*, uint32_t, uint32_t,
+        float*);
+    void (*filter)(const float*, uint32_t, const FilterTaps&, uint32_t,
+        uint32_t, float*);
+    void (*accumulate)(const float* const*, const float*, uint32_t, uint32_t,
+        uint32_t, float*);
+    void (*store)(const LevelContext&, const float*, uint32_t, uint32_t,
+        uint8_t*);
+};
+
+constexpr RowKernels kScalarKernels = {
+    LoadScalar, FilterScalar, AccumulateScalar, StoreScalar
+};
+constexpr RowKernels kAvx2Kernels = {
+    LoadAvx2, FilterAvx2, AccumulateAvx2, StoreAvx2
+};
+
+/// @brief 縮小先の[rowBegin, rowEnd)行を作る
+/// 使う縮小元の行を一度ずつ横に縮小してから，縦に重み付けして足す
+void DownsampleRows(const LevelContext& context, const RowKernels& kernels,
+    const uint8_t* pSrc, const MipLevel& src, uint8_t* pDst,
+    const MipLevel& dst, const FilterTaps& tapsX, const FilterTaps& tapsY,
+    uint32_t rowBegin, uint32_t rowEnd) {
+    const uint32_t channels = context.channels;
+    const uint32_t srcCount = src.width * channels;
+    const uint32_t dstCount = dst.width * channels;
+
+    // 使う縮小元の行（繰り返しで離れた行も含む）
+    std::vector<int32_t> srcRows;
+    for (uint32_t t = 0; t < tapsY.tapCount; t++) {
+        const int32_t* pIdx = &tapsY.indices[size_t{ t } * tapsY.size];
+        srcRows.insert(srcRows.end(), pIdx + rowBegin, pIdx + rowEnd);
+    }
+    std::sort(srcRows.begin(), srcRows.end());
+    srcRows.erase(std::unique(srcRows.begin(), srcRows.end()), srcRows.end());
+
+    // 横に縮小した行
+    std::vector<float> loaded(srcCount);
+    std::vector<float> filtered(srcRows.size() * dstCount);
+    for (size_t k = 0; k < srcRows.size(); k++) {
+        kernels.load(
+            context, pSrc + srcRows[k] * src.rowPitch, 0, srcCount,
+            loaded.data());
+        kernels.filter(loaded.data(), channels, tapsX, 0, dst.width,
+            &filtered[k * dstCount]);
+    }
+
+    // 縦に重み付けして足し，書き込む
+    std::vector<const float*> rows(tapsY.tapCount);
+    std::vector<float> weights(tapsY.tapCount);
+    std::vector<float> result(dstCount);
+    for (uint32_t y = rowBegin; y < rowEnd; y++) {
+        for (uint32_t t = 0; t < tapsY.tapCount; t++) {
+            const size_t at = size_t{ t } * tapsY.size + y;
+            const size_t k =
+                std::lower_bound(srcRows.begin(), srcRows.end(),
+                    tapsY.indices[at]) -
+                srcRows.begin();
+            rows[t]    = &filtered[k * dstCount];
+            weights[t] = tapsY.weights[at];
+        }
+        kernels.accumulate(rows.data(), weights.data(), tapsY.tapCount, 0,
+            dstCount, result.data());
+        kernels.store(
+            context, result.data(), 0, dst.width, pDst + y * dst.rowPitch);
+    }
+}
+}  // namespace
+
+// 1ピクセルのバイト数
+uint32_t MipGenerator::GetBytesPerPixel(MipFormat format) {
+    switch (format) {
+    case MipFormat::RGBA8:
+        return 4;
+    case MipFormat::RGBA16F:
+        return 8;
+    case MipFormat::R32F:
+        return 4;
+    }
+    return 0;
+}
+
+// 1ピクセルのチャンネル数
+uint32_t MipGenerator::GetChannelCount(MipFormat format) {
+    return format == MipFormat::R32F ? 1 : 4;
+}
+
+// AVX2の経路を使えるか
+bool MipGenerator::IsAvx2Supported() {
+    return CpuFeatures::HasAvx2() && CpuFeatures::HasF16C();
+}
+
+// 1x1までの段数
+uint32_t MipGenerator::ComputeMipCount(uint32_t width, uint32_t height) {
+    uint32_t count = 1;
+    while (width > 1 || height > 1) {
+        width  = std::max(width / 2, 1u);
+        height = std::max(height / 2, 1u);
+        count++;
+    }
+    return count;
+}
+
+// 全ての段の領域を確保
+bool MipGenerator::Allocate(uint32_t width, uint32_t height,
+    uint32_t mipCount, MipFormat format, MipChain& outChain) {
+    outChain = MipChain{};
+    if (width == 0 || height == 0) {
+        return false;
+    }
+
+    const uint32_t maxCount = ComputeMipCount(width, height);
+
+    mipCount = mipCount == 0 ? maxCount : std::min(mipCount, maxCount);
+
+    // 段の位置を決めてからまとめて確保する
+    size_t offset = 0;
+    outChain.format = format;
+    outChain.levels.resize(mipCount);
+    for (MipLevel& level : outChain.levels) {
+        level.width    = width;
+        level.height   = height;
+        level.offset   = offset;
+        level.rowPitch = size_t{ width } * GetBytesPerPixel(format);
+        offset += level.rowPitch * height;
+
+        width  = std::max(width / 2, 1u);
+        height = std::max(height / 2, 1u);
+    }
+    outChain.pixels.resize(offset);
+    return true;
+}
+
+// 先頭の段から残りの段を作る
+void MipGenerator::Generate(
+    MipChain& chain, const MipOptions& options, JobSystem* pJobSystem) {
+    // sRGBと法線マップはRGBA8のみ
+    const bool isRGBA8 = chain.format == MipFormat::RGBA8;
+
+    LevelContext context;
+    context.pTables     = &GetColorTables();
+    context.format      = chain.format;
+    context.channels    = GetChannelCount(chain.format);
+    context.isSRGB      = isRGBA8 && options.isSRGB;
+    context.isNormalMap = isRGBA8 && options.isNormalMap;
+    for (int c = 0; c < 4; c++) {
+        context.decodeOffsets[c] = context.isSRGB && c < 3 ? 0 : 256;
+    }
+
+    const RowKernels& kernels = options.useAvx2 && IsAvx2Supported()
+                                    ? kAvx2Kernels
+                                    : kScalarKernels;
+
+    // 前の段から次の段を作るので，段の間は順番に処理する
+    for (uint32_t i = 1; i < chain.GetMipCount(); i++) {
+        const MipLevel& src = chain.levels[i - 1];
+        const MipLevel& dst = chain.levels[i];
+        const uint8_t* pSrc = chain.GetData(i - 1);
+        uint8_t* pDst       = chain.GetData(i);
+
+        FilterTaps tapsX = ComputeTaps(options.filter, src.width, dst.width);
+        FilterTaps tapsY = ComputeTaps(options.filter, src.height, dst.height);
+        ParallelFor(pJobSystem, dst.height, kGrainRows,
+            [&](uint32_t begin, uint32_t end) {
+                DownsampleRows(context, kernels, pSrc, src, pDst, dst, tapsX,
+                    tapsY, begin, end);
+            });
+    }
+}
@@ -2,15 +2,21 @@
 
 #include "Engine/Core/DescriptorPool.h"
 #include "Engine/Core/GraphicsDevice.h"
+#include "Engine/Core/Hash.h"
+#include "Engine/Core/MappedFile.h"
 #include "Engine/Model/ModelAsset.h"
 #include "Engine/Resource/AssetPath.h"
+#include "Engine/Resource/DerivedDataCache.h"
 #include "Engine/Resource/GLBImporter.h"
 #include "Engine/Resource/TextureManager.h"
 
-bool ModelLoader::Init(
-    GraphicsDevice& graphicsDevice, TextureManager& textureManager) {
+bool ModelLoader::Init(GraphicsDevice& graphicsDevice,
+    TextureManager& textureManager, DerivedDataCache* pCache,
+    JobSystem* pJobSystem) {
     m_pGraphicsDevice = &graphicsDevice;
     m_pTextureManager = &textureManager;
+    m_pCache          = pCache;
+    m_pJobSystem      = pJobSystem;
 
     return true;
 }
@@ -18,6 +24,8 @@ bool ModelLoader::Init(
 void ModelLoader::Term() {
     m_pGraphicsDevice = nullptr;
     m_pTextureManager = nullptr;
+    m_pCache          = nullptr;
+    m_pJobSystem      = nullptr;
 }
 
 std::unique_ptr<Model> ModelLoader::LoadModel(
@@ -27,14 +35,98 @@ std::unique_ptr<Model> ModelLoader::LoadModel(
         return nullptr;
     }
 
-    // GLBの読み込み
-    ModelAsset modelAsset;
-    if (!GLBImporter::LoadFromFile(path, modelAsset)) {
+    // CPU側の読み込み
+    ModelSource source;
+    if (!LoadSource(path, source)) {
+        return nullptr;
+    }
+
+    // batchは記録時にアップロードヒープへコピーするので，その後は破棄してよい
+    return CreateModel(source, batch);
+}
+
+// モデルのCPU側の読み込み
+bool ModelLoader::LoadSource(
+    const std::filesystem::path& path, ModelSource& outSource) {
+    outSource = ModelSource{};
+
+    // 変換済みモデルはマッピングと検証だけで済む
+    if (IsCookedPath(path)) {
+        outSource.pCooked = std::make_unique<CookedModelFile>();
+        return outSource.pCooked->Open(path);
+    }
+
+    // キャッシュにあればassimpとデコードを省く
+    uint64_t key = 0;
+    bool useCache = m_pCache != nullptr && m_pCache->IsEnabled() &&
+                    ComputeCacheKey(path, key);
+    if (useCache) {
+        std::filesystem::path entryPath;
+        if (m_pCache->Find(key, entryPath)) {
+            outSource.pCooked = std::make_unique<CookedModelFile>();
+            if (outSource.pCooked->Open(entryPath)) {
+                return true;
+            }
+
+            // 壊れたエントリは消して作り直す
+            OutputDebugStringW(L"Discarding corrupt cache entry.\n");
+            outSource.pCooked.reset();
+            m_pCache->Remove(key);
+        }
+    }
+
+    // GLBの読み込みと画像のデコード
+    if (!LoadAsset(path, outSource.asset, outSource.images, nullptr,
+            m_pJobSystem)) {
+        return false;
+    }
+
+    // 次回のために書き込む，失敗しても読み込み自体は成功している
+    if (useCache) {
+        m_pCache->Store(key, [&](const std::filesystem::path& entryPath) {
+            return WriteCookedModel(
+                entryPath, outSource.asset, outSource.images);
+        });
+    }
+    return true;
+}
+
+// 読み込み結果からGPUリソース作成
+std::unique_ptr<Model> ModelLoader::CreateModel(
+    ModelSource& source, DirectX::ResourceUploadBatch& batch) {
+    if (source.pCooked != nullptr) {
+        return CreateModel(source.pCooked->GetView(), batch);
+    }
+    return CreateModel(source.asset, source.images, batch);
+}
+
+// モデルのCPU側の読み込み
+bool ModelLoader::LoadAsset(const std::filesystem::path& path,
+    ModelAsset& outAsset, std::vector<DirectX::ScratchImage>& outImages,
+    MeshImportStats* pOutStats, JobSystem* pJobSystem) {
+    // GLBの読み込みとメッシュの最適化
+    if (!GLBImporter::LoadFromFile(path, outAsset, pOutStats, pJobSystem)) {
+        return false;
+    }
+
+    // 画像のデコードとミップチェーン生成
+    TextureManager::DecodeModelImages(outAsset, outImages, pJobSystem);
+
+    return true;
+}
+
+// モデルのGPUリソース作成
+std::unique_ptr<Model> ModelLoader::CreateModel(ModelAsset& modelAsset,
+    const std::vector<DirectX::ScratchImage>& images,
+    DirectX::ResourceUploadBatch& batch) {
+    // 初期化チェック
+    if (!m_pGraphicsDevice || !m_pTextureManager) {
         return nullptr;
     }
 
     // テクスチャ生成
-    m_pTextureManager->BuildTexturesFromModelAsset(modelAsset, batch);
+    m_pTextureManager->BuildTexturesFromDecodedImages(
+        modelAsset, images, batch);
 
     // モデルのGPUリソース生成
     auto model = std::make_unique<Model>();
@@ -45,3 +137,136 @@ std::unique_ptr<Model> ModelLoader::LoadModel(
 
     return model;
 }
+
+// 変換済みモデルからGPUリソース作成
+std::unique_ptr<Model> ModelLoader::CreateModel(
+    const CookedModelView& view, DirectX::ResourceUploadBatch& batch) {
+    // 初期化チェック
+    if (!m_pGraphicsDevice || !m_pTextureManager) {
+        return nullptr;
+    }
+
+    // テクスチャ生成，サブリソースはマッピングを直接指す
+    std::vector<TextureHandle> textureHandles;
+    std::vector<D3D12_SUBRESOURCE_DATA> subresources;
+    for (uint32_t i = 0; i < view.GetTextureCount(); i++) {
+        const cooked::TextureRecord& texture = view.GetTexture(i);
+        auto records                         = view.GetSubresources(i);
+        if (records.empty()) {
+            // デコードに失敗した画像は無効ハンドルのまま
+            textureHandles.push_back(TextureHandle{});
+            continue;
+        }
+
+        DirectX::TexMetadata metadata = {};
+        metadata.width     = texture.width;
+        metadata.height    = texture.height;
+        metadata.depth     = 1;
+        metadata.arraySize = 1;
+        metadata.mipLevels = texture.mipLevels;
+        metadata.format    = static_cast<DXGI_FORMAT>(texture.format);
+        metadata.dimension = DirectX::TEX_DIMENSION_TEXTURE2D;
+
+        subresources.clear();
+        for (const auto& record : records) {
+            D3D12_SUBRESOURCE_DATA data = {};
+            data.pData      = view.GetData(record.dataOffset);
+            data.RowPitch   = static_cast<LONG_PTR>(record.rowPitch);
+            data.SlicePitch = static_cast<LONG_PTR>(record.slicePitch);
+            subresources.push_back(data);
+        }
+
+        uint32_t index = m_pTextureManager->CreateFromSubresources(metadata,
+            subresources.data(), static_cast<UINT>(subresources.size()),
+            texture.isSRGB != 0, batch);
+        textureHandles.push_back(TextureHandle{ index });
+    }
+
+    // マテリアルのテクスチャハンドルを解決
+    std::vector<MaterialAsset> materials = view.GetMaterials();
+    TextureManager::ResolveMaterialTextures(materials, textureHandles);
+
+    // メッシュはマッピングを直接指す参照のまま転送する
+    std::vector<MeshView> meshes;
+    meshes.reserve(view.GetMeshCount());
+    for (uint32_t i = 0; i < view.GetMeshCount(); i++) {
+        meshes.push_back(view.GetMesh(i));
+    }
+
+    // モデルのGPUリソース生成
+    auto model = std::make_unique<Model>();
+    if (!model->Init(
+            *m_pGraphicsDevice, m_pTextureManager, batch, meshes, materials)) {
+        return nullptr;
+    }
+
+    return model;
+}
+
+// 変換済みモデルのパスかどうか
+bool ModelLoader::IsCookedPath(const std::filesystem::path& path) {
+    return path.extension() == L".mdl";
+}
+
+// GLBを変換済みモデルとして書き出す
+bool ModelLoader::CookModel(const std::filesystem::path& srcPath,
+    const std::filesystem::path& dstPath, MeshImportStats* pOutStats,
+    JobSystem* pJobSystem) {
+    // GLBの読み込みと画像のデコード・ミップ生成
+    ModelAsset modelAsset;
+    std::vector<DirectX::ScratchImage> images;
+    if (!LoadAsset(srcPath, modelAsset, images, pOutStats, pJobSystem)) {
+        return false;
+    }
+
+    return WriteCookedModel(dstPath, modelAsset, images);
+}
+
+// キャッシュのキー
+bool ModelLoader::ComputeCacheKey(
+    const std::filesystem::path& path, uint64_t& outKey) {
+    // 更新時刻ではなく内容から作り，コピーや再エクスポートでも正しく判定する
+    MappedFile file;
+    if (!file.Open(path)) {
+        return false;
+    }
+
+    uint64_t key = hash::Fnv1a64(file.GetData(), file.GetSize());
+    key          = hash::Fnv1a64Value(GLBImporter::kImportFlags, key);
+    key          = hash::Fnv1a64Value(GLBImporter::kVersion, key);
+    key          = hash::Fnv1a64Value(cooked::kVersion, key);
+    outKey       = key;
+    return true;
+}
+
+// 読み込み済みのデータを変換済みモデルとして書き出す
+bool ModelLoader::WriteCookedModel(const std::filesystem::path& path,
+    const ModelAsset& modelAsset,
+    const std::vector<DirectX::ScratchImage>& images) {
+    // ミップチェーンを書き出し用の参照に変換
+    std::vector<CookedTextureSource> textures(images.size());
+    for (size_t i = 0; i < images.size(); i++) {
+        if (images[i].GetImageCount() == 0) {
+            // デコードに失敗した画像はサブリソースなしで書き出す
+            continue;
+        }
+
+        const DirectX::TexMetadata& metadata = images[i].GetMetadata();
+        CookedTextureSource& texture         = textures[i];
+        texture.width     = static_cast<uint32_t>(metadata.width);
+        texture.height    = static_cast<uint32_t>(metadata.height);
+        texture.format    = static_cast<uint32_t>(metadata.format);
+        texture.mipLevels = static_cast<uint32_t>(metadata.mipLevels);
+        texture.isSRGB    = modelAsset.images[i].isSRGB;
+        for (size_t mip = 0; mip < metadata.mipLevels; mip++) {
+            const DirectX::Image* pImage = images[i].GetImage(mip, 0, 0);
+            if (pImage == nullptr) {
+                return false;
+            }
+            texture.subresources.push_back(
+                { pImage->pixels, pImage->rowPitch, pImage->slicePitch });
+        }
+    }
+
+    return CookedModelWriter::Write(path, modelAsset, textures);
+}
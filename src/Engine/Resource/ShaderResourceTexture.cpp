@@ -1,7 +1,10 @@
 ﻿#include "Engine/Resource/ShaderResourceTexture.h"
 
+#include <cstring>
+
 #include "Engine/Core/DescriptorPool.h"
 #include "Engine/Core/DxDebug.h"
+#include "Engine/Resource/ImageDecoder.h"
 
 ShaderResourceTexture::ShaderResourceTexture() : m_pPoolSRV(nullptr) {}
 
@@ -15,6 +18,44 @@ bool ShaderResourceTexture::InitFromImage(ID3D12Device* pDevice,
         return false;
     }
 
+    // 画像データの読み込みとミップチェーン生成
+    DirectX::ScratchImage mipChain;
+    if (!DecodeImage(image, mipChain)) {
+        return false;
+    }
+
+    return InitFromDecodedImage(
+        pDevice, pPoolSRV, mipChain, image.isSRGB, batch);
+}
+
+bool ShaderResourceTexture::InitFromDecodedImage(ID3D12Device* pDevice,
+    DescriptorPool* pPoolSRV, const DirectX::ScratchImage& mipChain,
+    bool isSRGB, DirectX::ResourceUploadBatch& batch) {
+    // 引数チェック
+    if (!pDevice || mipChain.GetImageCount() == 0) {
+        return false;
+    }
+
+    // すべてのmip，配列スライスをアップロード
+    const DirectX::TexMetadata& mipMeta = mipChain.GetMetadata();
+    std::vector<D3D12_SUBRESOURCE_DATA> subresources;
+    DirectX::PrepareUpload(pDevice, mipChain.GetImages(),
+        mipChain.GetImageCount(), mipMeta, subresources);
+
+    return InitFromSubresources(pDevice, pPoolSRV, mipMeta,
+        subresources.data(), static_cast<UINT>(subresources.size()), isSRGB,
+        batch);
+}
+
+bool ShaderResourceTexture::InitFromSubresources(ID3D12Device* pDevice,
+    DescriptorPool* pPoolSRV, const DirectX::TexMetadata& metadata,
+    const D3D12_SUBRESOURCE_DATA* pSubresources, UINT subresourceCount,
+    bool isSRGB, DirectX::ResourceUploadBatch& batch) {
+    // 引数チェック
+    if (!pDevice || !pPoolSRV || !pSubresources || subresourceCount == 0) {
+        return false;
+    }
+
     // 既存リソースの破棄
     Term();
 
@@ -22,44 +63,22 @@ bool ShaderResourceTexture::InitFromImage(ID3D12Device* pDevice,
 
     // TextureResourceの作成
     {
-        // 画像データの読み込み
-        DirectX::ScratchImage srcImage;
-        CHECK_HR(pDevice, DirectX::LoadFromWICMemory(image.imageData.data(),
-                              image.imageData.size(), DirectX::WIC_FLAGS_NONE,
-                              nullptr, srcImage));
-
-        // ミップチェーン生成
-        DirectX::ScratchImage mipChain;
-        const DirectX::TexMetadata& srcMeta = srcImage.GetMetadata();
-
-        auto hr = DirectX::GenerateMipMaps(srcImage.GetImages(),
-            srcImage.GetImageCount(), srcMeta,
-            DirectX::TEX_FILTER_DEFAULT | DirectX::TEX_FILTER_WRAP, 0,
-            mipChain);
-        if (FAILED(hr)) {
-            mipChain = std::move(srcImage);
-        }
-
-        const DirectX::TexMetadata& mipMeta = mipChain.GetMetadata();
-
         // TextureResourceの初期化
-        bool result = m_texture.InitAsTexture2D(pDevice, mipMeta.width,
-            mipMeta.height, mipMeta.format, mipMeta.mipLevels,
-            D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_COPY_DEST);
+        bool result = m_texture.InitAsTexture2D(pDevice,
+            static_cast<UINT>(metadata.width),
+            static_cast<UINT>(metadata.height), metadata.format,
+            static_cast<UINT>(metadata.mipLevels), D3D12_RESOURCE_FLAG_NONE,
+            D3D12_RESOURCE_STATE_COPY_DEST);
         if (!result) {
             return false;
         }
 
-        // すべてのmip，配列スライスをアップロード
-        std::vector<D3D12_SUBRESOURCE_DATA> subresources;
-        DirectX::PrepareUpload(pDevice, mipChain.GetImages(),
-            mipChain.GetImageCount(), mipMeta, subresources);
-
         // テクスチャのアップロード
-        batch.Upload(m_texture.GetResource(), 0, subresources.data(),
-            static_cast<UINT>(subresources.size()));
+        batch.Upload(
+            m_texture.GetResource(), 0, pSubresources, subresourceCount);
 
         // PIXEL_SHADER_RESOURCEへ遷移
+        // コピーキューのbatchではCOMMONになり，描画時に暗黙に昇格する
         batch.Transition(m_texture.GetResource(),
             D3D12_RESOURCE_STATE_COPY_DEST,
             D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
@@ -80,7 +99,7 @@ bool ShaderResourceTexture::InitFromImage(ID3D12Device* pDevice,
             D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
 
         // フォーマットの決定
-        if (image.isSRGB) {
+        if (isSRGB) {
             srvDesc.Format = DirectX::MakeSRGB(texDesc.Format);
         } else {
             srvDesc.Format = texDesc.Format;
@@ -95,6 +114,49 @@ bool ShaderResourceTexture::InitFromImage(ID3D12Device* pDevice,
     return true;
 }
 
+// 画像のデコードとミップチェーン生成
+bool ShaderResourceTexture::DecodeImage(const ImageAsset& image,
+    DirectX::ScratchImage& outMipChain, JobSystem* pJobSystem) {
+    // 引数チェック
+    if (!image.IsValid()) {
+        return false;
+    }
+
+    // 画像データの読み込みとミップチェーン生成
+    // ぼけにくいKaiserで縮小し，色は線形にしてから，法線は長さを戻して作る
+    MipOptions options;
+    options.filter      = MipFilter::Kaiser;
+    options.isSRGB      = image.isSRGB;
+    options.isNormalMap = image.isNormalMap;
+
+    MipChain mipChain;
+    if (!ImageDecoder::Decode(image.imageData.data(), image.imageData.size(),
+            options, mipChain, pJobSystem)) {
+        OutputDebugStringW(L"Error: Failed to decode image.\n");
+        return false;
+    }
+
+    // アップロードに使うScratchImageへ移す
+    const MipLevel& top = mipChain.levels[0];
+    auto hr = outMipChain.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM, top.width,
+        top.height, 1, mipChain.GetMipCount());
+    if (FAILED(hr)) {
+        dxdebug::OutputHr(hr, L"Initialize2D", __FILE__, __LINE__);
+        return false;
+    }
+    for (uint32_t i = 0; i < mipChain.GetMipCount(); i++) {
+        const MipLevel& level      = mipChain.levels[i];
+        const DirectX::Image* pDst = outMipChain.GetImage(i, 0, 0);
+        const uint8_t* pSrc        = mipChain.GetData(i);
+        for (uint32_t y = 0; y < level.height; y++) {
+            std::memcpy(pDst->pixels + y * pDst->rowPitch,
+                pSrc + y * level.rowPitch, level.rowPitch);
+        }
+    }
+
+    return true;
+}
+
 bool ShaderResourceTexture::InitSolidColorRGBA8(ID3D12Device* pDevice,
     DescriptorPool* pPoolSRV, uint8_t r, uint8_t g, uint8_t b, uint8_t a,
     DirectX::ResourceUploadBatch& batch) {
@@ -0,0 +1,368 @@
+#include "Engine/Resource/TangentGenerator.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+#include "Engine/Core/Hash.h"
+#include "Engine/Core/JobSystem.h"
+
+namespace /* anonymous */ {
+using DirectX::XMFLOAT2;
+using DirectX::XMFLOAT3;
+
+XMFLOAT3 Add(const XMFLOAT3& a, const XMFLOAT3& b) {
+    return XMFLOAT3(a.x + b.x, a.y + b.y, a.z + b.z);
+}
+
+XMFLOAT3 Subtract(const XMFLOAT3& a, const XMFLOAT3& b) {
+    return XMFLOAT3(a.x - b.x, a.y - b.y, a.z - b.z);
+}
+
+XMFLOAT3 Scale(const XMFLOAT3& a, float s) {
+    return XMFLOAT3(a.x * s, a.y * s, a.z * s);
+}
+
+XMFLOAT3 Cross(const XMFLOAT3& a, const XMFLOAT3& b) {
+    return XMFLOAT3(
+        a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+}
+
+float Dot(const XMFLOAT3& a, const XMFLOAT3& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+/// @brief 正規化する，長さが0ならfalseを返してaは変えない
+bool Normalize(XMFLOAT3& a) {
+    float length = std::sqrt(Dot(a, a));
+    if (!(length > FLT_MIN)) {
+        return false;
+    }
+    a = Scale(a, 1.0f / length);
+    return true;
+}
+
+/// @brief nに垂直な成分だけを残す
+XMFLOAT3 Project(const XMFLOAT3& a, const XMFLOAT3& n) {
+    return Subtract(a, Scale(n, Dot(n, a)));
+}
+
+/// @brief 2つの単位ベクトルのなす角
+float Angle(const XMFLOAT3& a, const XMFLOAT3& b) {
+    return std::acos(std::clamp(Dot(a, b), -1.0f, 1.0f));
+}
+
+/// @brief nに垂直な任意の単位ベクトル（UVから接線が決まらない頂点用）
+XMFLOAT3 AnyPerpendicular(const XMFLOAT3& n) {
+    // nと最も平行でない軸から作る
+    XMFLOAT3 axis = std::fabs(n.x) < 0.9f ? XMFLOAT3(1.0f, 0.0f, 0.0f)
+                                          : XMFLOAT3(0.0f, 1.0f, 0.0f);
+    XMFLOAT3 t    = Project(axis, n);
+    Normalize(t);
+    return t;
+}
+
+/// @brief 頂点ごとに，同じ位置で最初に出てくる頂点の番号を求める
+std::vector<uint32_t> WeldPositions(
+    const std::vector<StandardVertex>& vertices) {
+    const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+
+    auto hashPosition = [&](uint32_t v) {
+        return static_cast<size_t>(
+            hash::Fnv1a64(&vertices[v].position, sizeof(XMFLOAT3)));
+    };
+    auto equalPosition = [&](uint32_t a, uint32_t b) {
+        return std::memcmp(&vertices[a].position, &vertices[b].position,
+                   sizeof(XMFLOAT3)) == 0;
+    };
+    std::unordered_map<uint32_t, uint32_t, decltype(hashPosition),
+        decltype(equalPosition)>
+        firstVertex(vertexCount, hashPosition, equalPosition);
+
+    std::vector<uint32_t> weld(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; v++) {
+        weld[v] = firstVertex.try_emplace(v, v).first->second;
+    }
+    return weld;
+}
+
+/// @brief 頂点ごとに，位置・法線・UVが同じで最初に出てくる頂点の番号を求める
+/// MikkTSpaceと同じく，この単位で接線を平均する
+std::vector<uint32_t> WeldTangentSpace(
+    const std::vector<StandardVertex>& vertices) {
+    const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+
+    // 位置と法線は続いて並んでいる
+    constexpr size_t kPositionNormalSize = sizeof(XMFLOAT3) * 2;
+
+    auto hashVertex = [&](uint32_t v) {
+        const StandardVertex& vertex = vertices[v];
+        uint64_t key = hash::Fnv1a64(&vertex.position, kPositionNormalSize);
+        key          = hash::Fnv1a64(&vertex.texcoord, sizeof(XMFLOAT2), key);
+        return static_cast<size_t>(key);
+    };
+    auto equalVertex = [&](uint32_t a, uint32_t b) {
+        const StandardVertex& va = vertices[a];
+        const StandardVertex& vb = vertices[b];
+        return std::memcmp(&va.position, &vb.position, kPositionNormalSize) ==
+                   0 &&
+               std::memcmp(&va.texcoord, &vb.texcoord, sizeof(XMFLOAT2)) == 0;
+    };
+    std::unordered_map<uint32_t, uint32_t, decltype(hashVertex),
+        decltype(equalVertex)>
+        firstVertex(vertexCount, hashVertex, equalVertex);
+
+    std::vector<uint32_t> weld(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; v++) {
+        weld[v] = firstVertex.try_emplace(v, v).first->second;
+    }
+    return weld;
+}
+}  // namespace
+
+//=============================================================================
+// モデル全体
+//=============================================================================
+void TangentGenerator::Generate(std::vector<MeshAsset>& meshes,
+    const std::vector<Target>& targets, JobSystem* pJobSystem,
+    Stats* pOutStats) {
+    using Clock = std::chrono::steady_clock;
+    auto start  = Clock::now();
+
+    // メッシュごとに並列に処理し，メッシュの中も三角形ごとに分ける
+    // 入れ子のParallelForは待つ間も他のジョブを実行するので詰まらない
+    const uint32_t meshCount = static_cast<uint32_t>(
+        std::min(meshes.size(), targets.size()));
+    std::vector<uint32_t> splitCounts(meshCount, 0);
+    ParallelFor(pJobSystem, meshCount, 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++) {
+            if (targets[i].normals) {
+                GenerateNormals(meshes[i], pJobSystem);
+            }
+            if (targets[i].tangents) {
+                splitCounts[i] = GenerateTangents(meshes[i], pJobSystem);
+            }
+        }
+    });
+
+    if (pOutStats == nullptr) {
+        return;
+    }
+    Stats stats;
+    for (uint32_t i = 0; i < meshCount; i++) {
+        if (!targets[i].normals && !targets[i].tangents) {
+            continue;
+        }
+        stats.normalMeshCount += targets[i].normals ? 1 : 0;
+        stats.tangentMeshCount += targets[i].tangents ? 1 : 0;
+        stats.splitVertexCount += splitCounts[i];
+        stats.triangleCount += meshes[i].indices.size() / 3;
+    }
+    stats.generateTimeMs =
+        std::chrono::duration<double, std::milli>(Clock::now() - start)
+            .count();
+    *pOutStats = stats;
+}
+
+//=============================================================================
+// 法線
+//=============================================================================
+void TangentGenerator::GenerateNormals(
+    MeshAsset& mesh, JobSystem* pJobSystem) {
+    // インポート中の形式でのみ扱う
+    if (mesh.HasCompactVertices() || mesh.HasShortIndices()) {
+        return;
+    }
+
+    std::vector<StandardVertex>& vertices = mesh.vertices;
+    const std::vector<uint32_t>& indices  = mesh.indices;
+    const uint32_t vertexCount   = static_cast<uint32_t>(vertices.size());
+    const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+
+    // 三角形の角ごとに，角の角度で重み付けした面法線を求める
+    // 角度で重み付けすると，三角形の分割の仕方に結果が左右されない
+    std::vector<XMFLOAT3> cornerNormals(size_t{ triangleCount } * 3);
+    ParallelFor(pJobSystem, triangleCount, kGrainSize,
+        [&](uint32_t begin, uint32_t end) {
+            for (uint32_t t = begin; t < end; t++) {
+                const size_t base = size_t{ t } * 3;
+                XMFLOAT3 p[3];
+                for (int k = 0; k < 3; k++) {
+                    p[k] = vertices[indices[base + k]].position;
+                }
+
+                XMFLOAT3 normal =
+                    Cross(Subtract(p[1], p[0]), Subtract(p[2], p[0]));
+                if (!Normalize(normal)) {
+                    // 縮退した三角形は向きを持たない
+                    for (int k = 0; k < 3; k++) {
+                        cornerNormals[base + k] = XMFLOAT3(0.0f, 0.0f, 0.0f);
+                    }
+                    continue;
+                }
+                for (int k = 0; k < 3; k++) {
+                    XMFLOAT3 e0 = Subtract(p[(k + 1) % 3], p[k]);
+                    XMFLOAT3 e1 = Subtract(p[(k + 2) % 3], p[k]);
+                    float angle = 0.0f;
+                    if (Normalize(e0) && Normalize(e1)) {
+                        angle = Angle(e0, e1);
+                    }
+                    cornerNormals[base + k] = Scale(normal, angle);
+                }
+            }
+        });
+
+    // 同じ位置の頂点で足し合わせる（シームの両側で同じ法線になる）
+    std::vector<uint32_t> weld = WeldPositions(vertices);
+    std::vector<XMFLOAT3> sums(vertexCount, XMFLOAT3(0.0f, 0.0f, 0.0f));
+    for (size_t i = 0; i < cornerNormals.size(); i++) {
+        uint32_t v = weld[indices[i]];
+        sums[v]    = Add(sums[v], cornerNormals[i]);
+    }
+
+    ParallelFor(pJobSystem, vertexCount, kGrainSize,
+        [&](uint32_t begin, uint32_t end) {
+            for (uint32_t v = begin; v < end; v++) {
+                XMFLOAT3 normal = sums[weld[v]];
+                if (!Normalize(normal)) {
+                    normal = XMFLOAT3(0.0f, 1.0f, 0.0f);
+                }
+                vertices[v].normal = normal;
+            }
+        });
+}
+
+//=============================================================================
+// 接線
+//=============================================================================
+uint32_t TangentGenerator::GenerateTangents(
+    MeshAsset& mesh, JobSystem* pJobSystem) {
+    // インポート中の形式でのみ扱う
+    if (mesh.HasCompactVertices() || mesh.HasShortIndices()) {
+        return 0;
+    }
+
+    std::vector<StandardVertex>& vertices = mesh.vertices;
+    std::vector<uint32_t>& indices        = mesh.indices;
+    const uint32_t vertexCount   = static_cast<uint32_t>(vertices.size());
+    const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+
+    // 三角形の角ごとに，UVのu方向の勾配（dP/du）を頂点の法線に垂直な面へ
+    // 射影し，射影した2辺のなす角で重み付けする（MikkTSpaceと同じ）
+    // 符号はdP/dvが(N×T)と同じ向きなら+1，UVが裏返っていれば-1
+    // UVの面積が0の三角形は接線を決められないので寄与しない（符号0）
+    std::vector<XMFLOAT3> cornerTangents(size_t{ triangleCount } * 3);
+    std::vector<int8_t> cornerSigns(size_t{ triangleCount } * 3, 0);
+    ParallelFor(pJobSystem, triangleCount, kGrainSize,
+        [&](uint32_t begin, uint32_t end) {
+            for (uint32_t t = begin; t < end; t++) {
+                const size_t base        = size_t{ t } * 3;
+                const StandardVertex& v0 = vertices[indices[base + 0]];
+                const StandardVertex& v1 = vertices[indices[base + 1]];
+                const StandardVertex& v2 = vertices[indices[base + 2]];
+
+                XMFLOAT3 d1 = Subtract(v1.position, v0.position);
+                XMFLOAT3 d2 = Subtract(v2.position, v0.position);
+                float s1    = v1.texcoord.x - v0.texcoord.x;
+                float t1    = v1.texcoord.y - v0.texcoord.y;
+                float s2    = v2.texcoord.x - v0.texcoord.x;
+                float t2    = v2.texcoord.y - v0.texcoord.y;
+
+                float area = s1 * t2 - s2 * t1;
+                if (!(std::fabs(area) > FLT_MIN)) {
+                    continue;
+                }
+                float r    = 1.0f / area;
+                XMFLOAT3 u = Scale(Subtract(Scale(d1, t2), Scale(d2, t1)), r);
+                XMFLOAT3 w = Scale(Subtract(Scale(d2, s1), Scale(d1, s2)), r);
+
+                const StandardVertex* corners[3] = { &v0, &v1, &v2 };
+                for (int k = 0; k < 3; k++) {
+                    const XMFLOAT3& n = corners[k]->normal;
+                    XMFLOAT3 tangent  = Project(u, n);
+                    if (!Normalize(tangent)) {
+                        continue;
+                    }
+
+                    const XMFLOAT3& p = corners[k]->position;
+                    XMFLOAT3 e0 =
+                        Project(Subtract(corners[(k + 1) % 3]->position, p), n);
+                    XMFLOAT3 e1 =
+                        Project(Subtract(corners[(k + 2) % 3]->position, p), n);
+                    float angle = 0.0f;
+                    if (Normalize(e0) && Normalize(e1)) {
+                        angle = Angle(e0, e1);
+                    }
+
+                    cornerTangents[base + k] = Scale(tangent, angle);
+                    cornerSigns[base + k] =
+                        Dot(Cross(n, tangent), w) < 0.0f ? -1 : 1;
+                }
+            }
+        });
+
+    // 位置・法線・UVが同じ頂点で，符号ごとに足し合わせる
+    // masks[v]はvの角の符号（bit0が+1，bit1が-1）
+    std::vector<uint32_t> weld = WeldTangentSpace(vertices);
+    std::vector<XMFLOAT3> sums(
+        size_t{ vertexCount } * 2, XMFLOAT3(0.0f, 0.0f, 0.0f));
+    std::vector<uint8_t> masks(vertexCount, 0);
+    std::vector<uint8_t> weldMasks(vertexCount, 0);
+    for (size_t i = 0; i < cornerSigns.size(); i++) {
+        if (cornerSigns[i] == 0) {
+            continue;
+        }
+        uint32_t v    = indices[i];
+        uint32_t side = cornerSigns[i] < 0 ? 1 : 0;
+        size_t slot   = size_t{ weld[v] } * 2 + side;
+        sums[slot]    = Add(sums[slot], cornerTangents[i]);
+
+        masks[v] |= 1 << side;
+        weldMasks[weld[v]] |= 1 << side;
+    }
+
+    // 両方の符号で使われる頂点は複製し，-1の角を複製先へ付け替える
+    std::vector<uint32_t> splitVertices(vertexCount, UINT32_MAX);
+    for (uint32_t v = 0; v < vertexCount; v++) {
+        if (masks[v] == 3) {
+            splitVertices[v] = static_cast<uint32_t>(vertices.size());
+            vertices.push_back(vertices[v]);
+            weld.push_back(weld[v]);
+            masks[v] = 1;
+            masks.push_back(2);
+        }
+    }
+    const uint32_t splitCount =
+        static_cast<uint32_t>(vertices.size()) - vertexCount;
+    if (splitCount > 0) {
+        for (size_t i = 0; i < cornerSigns.size(); i++) {
+            uint32_t split = splitVertices[indices[i]];
+            if (cornerSigns[i] < 0 && split != UINT32_MAX) {
+                indices[i] = split;
+            }
+        }
+    }
+
+    // 平均して書き込む，角が寄与しない頂点は同じ頂点の符号を使う
+    ParallelFor(pJobSystem, static_cast<uint32_t>(vertices.size()),
+        kGrainSize, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t v = begin; v < end; v++) {
+                uint8_t mask  = masks[v] != 0 ? masks[v] : weldMasks[weld[v]];
+                uint32_t side = (mask & 1) == 0 && (mask & 2) != 0 ? 1 : 0;
+                StandardVertex& vertex = vertices[v];
+
+                XMFLOAT3 tangent = Project(sums[size_t{ weld[v] } * 2 + side],
+                    vertex.normal);
+                if (!Normalize(tangent)) {
+                    tangent = AnyPerpendicular(vertex.normal);
+                }
+                vertex.tangent = DirectX::XMFLOAT4(
+                    tangent.x, tangent.y, tangent.z, side == 0 ? 1.0f : -1.0f);
+            }
+        });
+
+    return splitCount;
+}
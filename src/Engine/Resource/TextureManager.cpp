@@ -1,6 +1,8 @@
 #include "Engine/Resource/TextureManager.h"
 
 #include "Engine/Core/EngineConfig.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Resource/ImageDecoder.h"
 
 TextureManager::TextureManager()
     : m_pDevice(nullptr), m_pPoolAssetSRV(nullptr) {}
@@ -50,7 +52,23 @@ void TextureManager::BuildTexturesFromModelAsset(
         return;
     }
 
-    // マテリアルを操作してsRGBフラグを設定
+    // 画像のデコードとテクスチャ生成
+    std::vector<DirectX::ScratchImage> images;
+    DecodeModelImages(modelAsset, images);
+    BuildTexturesFromDecodedImages(modelAsset, images, batch);
+}
+
+// ModelAssetの画像のデコード
+void TextureManager::DecodeModelImages(ModelAsset& modelAsset,
+    std::vector<DirectX::ScratchImage>& outImages, JobSystem* pJobSystem) {
+    outImages.clear();
+
+    // 引数チェック
+    if (!modelAsset.IsValid()) {
+        return;
+    }
+
+    // マテリアルを操作してsRGBと法線マップのフラグを設定
     for (const auto& material : modelAsset.materials) {
         // baseColorとemissiveはsRGBフラグを有効化する
         if (material.baseColorLocalTextureIndex >= 0) {
@@ -60,18 +78,62 @@ void TextureManager::BuildTexturesFromModelAsset(
         if (material.emissiveLocalTextureIndex >= 0) {
             modelAsset.images[material.emissiveLocalTextureIndex].isSRGB = true;
         }
+        // 法線マップはミップの段ごとに長さを1に戻す
+        if (material.normalLocalTextureIndex >= 0) {
+            modelAsset.images[material.normalLocalTextureIndex].isNormalMap =
+                true;
+        }
+    }
+
+    // ImageAsset配列を画像ごとに並列にデコード
+    // 大きな画像のミップ生成は画像の中でも行ごとに分ける
+    const std::vector<ImageAsset>& images = modelAsset.images;
+    outImages.resize(images.size());
+    ParallelFor(pJobSystem, static_cast<uint32_t>(images.size()), 1,
+        [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                // フォーマットチェック
+                // GLBの埋め込み画像想定で，png, jpgを対象にする
+                if (!ImageDecoder::IsSupportedFormat(images[i].format)) {
+                    OutputDebugStringW(L"Error: texture format invalid");
+                    continue;
+                }
+
+                if (!ShaderResourceTexture::DecodeImage(
+                        images[i], outImages[i], pJobSystem)) {
+                    outImages[i].Release();
+                }
+            }
+        });
+}
+
+// デコード済みの画像からテクスチャを構築
+void TextureManager::BuildTexturesFromDecodedImages(ModelAsset& modelAsset,
+    const std::vector<DirectX::ScratchImage>& images,
+    DirectX::ResourceUploadBatch& batch) {
+    // 引数チェック
+    if (!modelAsset.IsValid() || images.size() != modelAsset.images.size()) {
+        return;
     }
 
-    // ImageAsset配列からテクスチャを生成
+    // デコード済みの画像からテクスチャを生成
     std::vector<TextureHandle> textureHandles;
-    for (const auto& image : modelAsset.images) {
-        uint32_t index = CreateFromImageAsset(image, batch);
+    for (size_t i = 0; i < images.size(); i++) {
+        uint32_t index = CreateFromDecodedImage(
+            images[i], modelAsset.images[i].isSRGB, batch);
         TextureHandle textureHandle{ index };
         textureHandles.push_back(textureHandle);
     }
 
     // マテリアルのテクスチャハンドルを解決
-    for (auto& material : modelAsset.materials) {
+    ResolveMaterialTextures(modelAsset.materials, textureHandles);
+}
+
+// マテリアルのテクスチャハンドルを解決
+void TextureManager::ResolveMaterialTextures(
+    std::vector<MaterialAsset>& materials,
+    const std::vector<TextureHandle>& textureHandles) {
+    for (auto& material : materials) {
         auto Resolve = [&](int localIndex, TextureHandle& outHandle) {
             if (localIndex >= 0 &&
                 static_cast<size_t>(localIndex) < textureHandles.size()) {
@@ -100,8 +162,7 @@ uint32_t TextureManager::CreateFromImageAsset(
     // TextureResourceを生成
     // フォーマットチェック
     // GLBの埋め込み画像想定で，png, jpgを対象にする
-    if (image.format != "png" && image.format != "jpg" &&
-        image.format != "jpeg") {
+    if (!ImageDecoder::IsSupportedFormat(image.format)) {
         OutputDebugStringW(L"Error: texture format invalid");
         return UINT32_MAX;
     }
@@ -119,6 +180,47 @@ uint32_t TextureManager::CreateFromImageAsset(
     return handle;
 }
 
+// デコード済みの画像からテクスチャを生成
+uint32_t TextureManager::CreateFromDecodedImage(
+    const DirectX::ScratchImage& mipChain, bool isSRGB,
+    DirectX::ResourceUploadBatch& batch) {
+    // 引数チェック（デコードに失敗した画像は空）
+    if (mipChain.GetImageCount() == 0) {
+        return UINT32_MAX;
+    }
+
+    ShaderResourceTexture shaderResourceTexture;
+    if (!shaderResourceTexture.InitFromDecodedImage(
+            m_pDevice, m_pPoolAssetSRV.get(), mipChain, isSRGB, batch)) {
+        return UINT32_MAX;
+    }
+
+    // 配列に追加
+    uint32_t handle = static_cast<uint32_t>(m_textures.size());
+    m_textures.push_back(std::move(shaderResourceTexture));
+
+    return handle;
+}
+
+// サブリソースのデータからテクスチャを生成
+uint32_t TextureManager::CreateFromSubresources(
+    const DirectX::TexMetadata& metadata,
+    const D3D12_SUBRESOURCE_DATA* pSubresources, UINT subresourceCount,
+    bool isSRGB, DirectX::ResourceUploadBatch& batch) {
+    ShaderResourceTexture shaderResourceTexture;
+    if (!shaderResourceTexture.InitFromSubresources(m_pDevice,
+            m_pPoolAssetSRV.get(), metadata, pSubresources, subresourceCount,
+            isSRGB, batch)) {
+        return UINT32_MAX;
+    }
+
+    // 配列に追加
+    uint32_t handle = static_cast<uint32_t>(m_textures.size());
+    m_textures.push_back(std::move(shaderResourceTexture));
+
+    return handle;
+}
+
 // 単色テクスチャの生成
 bool TextureManager::CreateSolidColorTexture(
     DirectX::ResourceUploadBatch& batch, uint8_t r, uint8_t g, uint8_t b,
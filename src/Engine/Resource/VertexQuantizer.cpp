@@ -0,0 +1,322 @@
+#include "Engine/Resource/VertexQuantizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace /* anonymous */ {
+constexpr float kUnorm16Max = 65535.0f;
+constexpr float kSnorm16Max = 32767.0f;
+constexpr float kRadToDeg   = 57.29577951f;
+
+/// @brief 白とみなす頂点カラーの誤差（8bitの1段階）
+constexpr float kWhiteTolerance = 1.0f / 255.0f;
+
+/// @brief 0～1をUNORM16にする
+uint16_t ToUnorm16(float value) {
+    float clamped = std::clamp(value, 0.0f, 1.0f);
+    return static_cast<uint16_t>(std::lround(clamped * kUnorm16Max));
+}
+
+/// @brief 最小値と範囲で正規化してUNORM16にする
+uint16_t Quantize(float value, float offset, float scale) {
+    if (scale <= 0.0f) {
+        return 0;
+    }
+    return ToUnorm16((value - offset) / scale);
+}
+
+/// @brief Quantizeの逆，GPUのUNORMの変換と同じく65535で割る
+float Dequantize(uint16_t value, float offset, float scale) {
+    return offset + (static_cast<float>(value) / kUnorm16Max) * scale;
+}
+
+/// @brief SNORM16を-1～1に戻す，GPUと同じく-32768は-1にする
+float FromSnorm16(int16_t value) {
+    return std::max(static_cast<float>(value) / kSnorm16Max, -1.0f);
+}
+
+/// @brief 0を正として扱う符号
+float SignNotZero(float value) { return value >= 0.0f ? 1.0f : -1.0f; }
+
+/// @brief 八面体写像（丸め前の-1～1の2成分）
+void ToOctahedral(const DirectX::XMFLOAT3& d, float& outU, float& outV) {
+    float l1 = std::abs(d.x) + std::abs(d.y) + std::abs(d.z);
+    if (!(l1 > 0.0f)) {
+        outU = 0.0f;
+        outV = 0.0f;
+        return;
+    }
+    float u = d.x / l1;
+    float v = d.y / l1;
+    if (d.z < 0.0f) {
+        // 下半分は対角線で折り返す
+        float foldedU = (1.0f - std::abs(v)) * SignNotZero(u);
+        float foldedV = (1.0f - std::abs(u)) * SignNotZero(v);
+        u             = foldedU;
+        v             = foldedV;
+    }
+    outU = u;
+    outV = v;
+}
+
+float Dot(const DirectX::XMFLOAT3& a, const DirectX::XMFLOAT3& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+float Length(const DirectX::XMFLOAT3& v) { return std::sqrt(Dot(v, v)); }
+
+/// @brief 成分ごとの差の絶対値の最大値
+float MaxDifference(const DirectX::XMFLOAT3& a, const DirectX::XMFLOAT3& b) {
+    return std::max(
+        { std::abs(a.x - b.x), std::abs(a.y - b.y), std::abs(a.z - b.z) });
+}
+float MaxDifference(const DirectX::XMFLOAT2& a, const DirectX::XMFLOAT2& b) {
+    return std::max(std::abs(a.x - b.x), std::abs(a.y - b.y));
+}
+
+/// @brief 接線の方向だけを取り出す
+DirectX::XMFLOAT3 TangentDirection(const StandardVertex& v) {
+    return DirectX::XMFLOAT3(v.tangent.x, v.tangent.y, v.tangent.z);
+}
+
+/// @brief 2つの方向の間の角度（度），どちらかが長さ0なら0
+/// 小さい角度はacosでは精度が出ないので，外積の長さと内積から求める
+float AngleBetween(const DirectX::XMFLOAT3& a, const DirectX::XMFLOAT3& b) {
+    if (!(Length(a) > 0.0f) || !(Length(b) > 0.0f)) {
+        return 0.0f;
+    }
+    DirectX::XMFLOAT3 cross(
+        a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+    return std::atan2(Length(cross), Dot(a, b)) * kRadToDeg;
+}
+
+/// @brief 頂点カラーが白か
+bool IsWhite(const DirectX::XMFLOAT4& color) {
+    return std::abs(color.x - 1.0f) <= kWhiteTolerance &&
+           std::abs(color.y - 1.0f) <= kWhiteTolerance &&
+           std::abs(color.z - 1.0f) <= kWhiteTolerance &&
+           std::abs(color.w - 1.0f) <= kWhiteTolerance;
+}
+
+/// @brief 誤差の最大値の更新
+void UpdateMax(VertexQuantizer::ErrorStats& inOut,
+    const VertexQuantizer::ErrorStats& error) {
+    inOut.position = std::max(inOut.position, error.position);
+    inOut.normal   = std::max(inOut.normal, error.normal);
+    inOut.tangent  = std::max(inOut.tangent, error.tangent);
+    inOut.texcoord = std::max(inOut.texcoord, error.texcoord);
+}
+
+/// @brief 位置・法線・接線・UVが全て有限か
+bool IsFinite(const StandardVertex& v) {
+    const float values[] = { v.position.x, v.position.y, v.position.z,
+        v.normal.x, v.normal.y, v.normal.z, v.tangent.x, v.tangent.y,
+        v.tangent.z, v.tangent.w, v.texcoord.x, v.texcoord.y };
+    return std::all_of(std::begin(values), std::end(values),
+        [](float value) { return std::isfinite(value); });
+}
+}  // namespace
+
+// モデル全体の圧縮
+void VertexQuantizer::CompressVertices(
+    std::vector<MeshAsset>& meshes, Stats* pOutStats) {
+    Stats stats;
+    for (MeshAsset& mesh : meshes) {
+        const uint64_t vertexCount = mesh.GetVertexCount();
+        stats.vertexCount += vertexCount;
+        stats.bytesBefore += vertexCount * sizeof(StandardVertex);
+
+        ErrorStats error;
+        if (!mesh.HasCompactVertices() && !Compress(mesh, &error)) {
+            stats.standardMeshCount++;
+            stats.bytesAfter += vertexCount * sizeof(StandardVertex);
+            continue;
+        }
+
+        stats.compactMeshCount++;
+        stats.bytesAfter += vertexCount * sizeof(CompactVertex);
+        UpdateMax(stats.maxError, error);
+    }
+
+    if (pOutStats != nullptr) {
+        *pOutStats = stats;
+    }
+}
+
+// メッシュの圧縮
+bool VertexQuantizer::Compress(MeshAsset& mesh, ErrorStats* pOutError) {
+    const std::vector<StandardVertex>& vertices = mesh.vertices;
+    if (vertices.empty()) {
+        return false;
+    }
+
+    // 圧縮すると失われる情報を持つメッシュは対象外
+    for (const StandardVertex& vertex : vertices) {
+        if (!IsWhite(vertex.color) || !IsFinite(vertex)) {
+            return false;
+        }
+    }
+
+    // UVは丸めの誤差が範囲に比例するので，広すぎる場合は対象外
+    VertexQuantization quantization = ComputeQuantization(vertices);
+    float texcoordStep =
+        std::max(quantization.texcoordScale.x, quantization.texcoordScale.y) /
+        kUnorm16Max;
+    if (texcoordStep * 0.5f > kMaxTexcoordError) {
+        return false;
+    }
+
+    // 変換して誤差を測る
+    std::vector<CompactVertex> compactVertices(vertices.size());
+    ErrorStats error;
+    for (size_t i = 0; i < vertices.size(); i++) {
+        const StandardVertex& source = vertices[i];
+        compactVertices[i]           = Encode(source, quantization);
+
+        StandardVertex decoded = Decode(compactVertices[i], quantization);
+        ErrorStats vertexError;
+        vertexError.position = MaxDifference(decoded.position, source.position);
+        vertexError.normal   = AngleBetween(decoded.normal, source.normal);
+        vertexError.tangent =
+            AngleBetween(TangentDirection(decoded), TangentDirection(source));
+        vertexError.texcoord = MaxDifference(decoded.texcoord, source.texcoord);
+        UpdateMax(error, vertexError);
+    }
+
+    mesh.compactVertices = std::move(compactVertices);
+    mesh.quantization    = quantization;
+    mesh.vertices.clear();
+    mesh.vertices.shrink_to_fit();
+    if (pOutError != nullptr) {
+        *pOutError = error;
+    }
+    return true;
+}
+
+// 復元に使う値の計算
+VertexQuantization VertexQuantizer::ComputeQuantization(
+    const std::vector<StandardVertex>& vertices) {
+    VertexQuantization quantization;
+    if (vertices.empty()) {
+        return quantization;
+    }
+
+    DirectX::XMFLOAT3 minPosition = vertices[0].position;
+    DirectX::XMFLOAT3 maxPosition = vertices[0].position;
+    DirectX::XMFLOAT2 minTexcoord = vertices[0].texcoord;
+    DirectX::XMFLOAT2 maxTexcoord = vertices[0].texcoord;
+    for (const StandardVertex& vertex : vertices) {
+        minPosition.x = std::min(minPosition.x, vertex.position.x);
+        minPosition.y = std::min(minPosition.y, vertex.position.y);
+        minPosition.z = std::min(minPosition.z, vertex.position.z);
+        maxPosition.x = std::max(maxPosition.x, vertex.position.x);
+        maxPosition.y = std::max(maxPosition.y, vertex.position.y);
+        maxPosition.z = std::max(maxPosition.z, vertex.position.z);
+        minTexcoord.x = std::min(minTexcoord.x, vertex.texcoord.x);
+        minTexcoord.y = std::min(minTexcoord.y, vertex.texcoord.y);
+        maxTexcoord.x = std::max(maxTexcoord.x, vertex.texcoord.x);
+        maxTexcoord.y = std::max(maxTexcoord.y, vertex.texcoord.y);
+    }
+
+    quantization.positionOffset = minPosition;
+    quantization.positionScale  = DirectX::XMFLOAT3(
+        maxPosition.x - minPosition.x, maxPosition.y - minPosition.y,
+        maxPosition.z - minPosition.z);
+    quantization.texcoordOffset = minTexcoord;
+    quantization.texcoordScale  = DirectX::XMFLOAT2(
+        maxTexcoord.x - minTexcoord.x, maxTexcoord.y - minTexcoord.y);
+    return quantization;
+}
+
+// 1頂点の圧縮
+CompactVertex VertexQuantizer::Encode(
+    const StandardVertex& vertex, const VertexQuantization& quantization) {
+    const VertexQuantization& q = quantization;
+
+    CompactVertex result;
+    result.position[0] = Quantize(
+        vertex.position.x, q.positionOffset.x, q.positionScale.x);
+    result.position[1] = Quantize(
+        vertex.position.y, q.positionOffset.y, q.positionScale.y);
+    result.position[2] = Quantize(
+        vertex.position.z, q.positionOffset.z, q.positionScale.z);
+
+    // 接空間の向き（-1か+1）を使っていないwに入れる
+    result.position[3] = vertex.tangent.w < 0.0f ? 0 : 0xFFFF;
+
+    EncodeOctahedral(vertex.normal, &result.normalTangent[0]);
+    EncodeOctahedral(TangentDirection(vertex), &result.normalTangent[2]);
+
+    result.texcoord[0] = Quantize(
+        vertex.texcoord.x, q.texcoordOffset.x, q.texcoordScale.x);
+    result.texcoord[1] = Quantize(
+        vertex.texcoord.y, q.texcoordOffset.y, q.texcoordScale.y);
+    return result;
+}
+
+// 1頂点の復元
+StandardVertex VertexQuantizer::Decode(
+    const CompactVertex& vertex, const VertexQuantization& quantization) {
+    const VertexQuantization& q = quantization;
+
+    StandardVertex result;
+    result.position = DirectX::XMFLOAT3(
+        Dequantize(vertex.position[0], q.positionOffset.x, q.positionScale.x),
+        Dequantize(vertex.position[1], q.positionOffset.y, q.positionScale.y),
+        Dequantize(vertex.position[2], q.positionOffset.z, q.positionScale.z));
+
+    // wは0か1なので-1か+1に戻す
+    DirectX::XMFLOAT3 tangent = DecodeOctahedral(&vertex.normalTangent[2]);
+    float sign                = vertex.position[3] / kUnorm16Max * 2.0f - 1.0f;
+
+    result.normal  = DecodeOctahedral(&vertex.normalTangent[0]);
+    result.tangent = DirectX::XMFLOAT4(tangent.x, tangent.y, tangent.z, sign);
+    result.color   = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
+
+    result.texcoord = DirectX::XMFLOAT2(
+        Dequantize(vertex.texcoord[0], q.texcoordOffset.x, q.texcoordScale.x),
+        Dequantize(vertex.texcoord[1], q.texcoordOffset.y, q.texcoordScale.y));
+    return result;
+}
+
+// 八面体写像での符号化
+void VertexQuantizer::EncodeOctahedral(
+    const DirectX::XMFLOAT3& direction, int16_t outEncoded[2]) {
+    float u = 0.0f;
+    float v = 0.0f;
+    ToOctahedral(direction, u, v);
+
+    // 切り捨てと切り上げの組み合わせから，復元後の角度が最小のものを選ぶ
+    float baseU   = std::floor(std::clamp(u, -1.0f, 1.0f) * kSnorm16Max);
+    float baseV   = std::floor(std::clamp(v, -1.0f, 1.0f) * kSnorm16Max);
+    float bestDot = -2.0f;
+    for (int i = 0; i < 4; i++) {
+        float candidateU = std::min(baseU + (i & 1), kSnorm16Max);
+        float candidateV = std::min(baseV + (i >> 1), kSnorm16Max);
+
+        int16_t candidate[2] = { static_cast<int16_t>(candidateU),
+            static_cast<int16_t>(candidateV) };
+
+        float dot = Dot(DecodeOctahedral(candidate), direction);
+        if (dot > bestDot) {
+            bestDot       = dot;
+            outEncoded[0] = candidate[0];
+            outEncoded[1] = candidate[1];
+        }
+    }
+}
+
+// 八面体写像からの復元
+DirectX::XMFLOAT3 VertexQuantizer::DecodeOctahedral(const int16_t encoded[2]) {
+    float u = FromSnorm16(encoded[0]);
+    float v = FromSnorm16(encoded[1]);
+    DirectX::XMFLOAT3 d(u, v, 1.0f - std::abs(u) - std::abs(v));
+
+    // 下半分は折り返しを戻す（TestVS.hlslと同じ式）
+    float t = std::max(-d.z, 0.0f);
+    d.x += d.x >= 0.0f ? -t : t;
+    d.y += d.y >= 0.0f ? -t : t;
+
+    float length = Length(d);
+    return DirectX::XMFLOAT3(d.x / length, d.y / length, d.z / length);
+}
@@ -2,16 +2,18 @@
 
 #include <algorithm>
 #include <cassert>
+#include <span>
 
-#include "Engine/Core/GraphicsDevice.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Render/RenderStats.h"
+#include "Engine/Scene/TransformBatch.h"
 
 Scene::Scene()  = default;
 Scene::~Scene() = default;
 
-void Scene::Init(GraphicsDevice& graphicsDevice) {
-    m_pDevice           = graphicsDevice.GetDevice();
-    m_pPoolCBV          = graphicsDevice.CbvSrvUavPool();
-    m_currentFrameIndex = 0;
+void Scene::Init() {
+    // 上限まで確保しておき，Spawn時の列の再確保を避ける
+    m_gameObjectMap.Reserve(config::kMaxObjects);
 }
 
 // シーンにモデルを追加する
@@ -23,42 +25,167 @@ engine::ModelHandle Scene::RegisterModel(std::unique_ptr<Model> pModel) {
     return handle;
 }
 
+// 中身が空のモデルのスロットを確保する
+engine::ModelHandle Scene::ReserveModel() {
+    return m_modelMap.Insert(nullptr);
+}
+
+// 確保済みのスロットにモデルを設定する
+bool Scene::ResolveModel(
+    engine::ModelHandle handle, std::unique_ptr<Model> pModel) {
+    auto* pSlot = m_modelMap.Get(handle);
+    if (pSlot == nullptr) {
+        return false;
+    }
+    assert(*pSlot == nullptr && "Model slot is already resolved.");
+    *pSlot = std::move(pModel);
+    return true;
+}
+
+// シーンからモデルを外す
+std::unique_ptr<Model> Scene::UnregisterModel(engine::ModelHandle handle) {
+    auto pModel = m_modelMap.Erase(handle);
+    return pModel ? std::move(*pModel) : nullptr;
+}
+
 // アップロードヒープの削除
 void Scene::DiscardModelUploads() {
     for (auto& model : m_modelMap) {
-        model->DiscardUpload();
+        // 非同期ロード中のスロットは空
+        if (model) {
+            model->DiscardUpload();
+        }
     }
 }
 
 // シーン内にオブジェクトを作成する
 engine::ObjectHandle Scene::SpawnObject(engine::ModelHandle model) {
-    // オブジェクトの作成
-    auto pObj = std::make_unique<GameObject>(model);
-
-    // transformGPUの初期化
-    for (int i = 0; i < config::kFrameCount; i++) {
-        pObj->GetTransformGPU(i).Init(
-            m_pDevice, m_pPoolCBV, pObj->GetTransform().CalcWorldMatrix());
-    }
-
     // ゲームオブジェクトをシーンに追加
-    engine::ObjectHandle handle = m_gameObjectMap.Insert(std::move(pObj));
+    // GPU側のリソースは持たないので，列に値を書き込むだけで確保は発生しない
+    Transform transform;
+    DirectX::XMFLOAT4X4 world;
+    DirectX::XMFLOAT4X4 worldInv;
+    DirectX::XMStoreFloat4x4(&world, transform.CalcWorldMatrix());
+    DirectX::XMStoreFloat4x4(&worldInv, transform.CalcInverseWorldMatrix());
+    engine::ObjectHandle handle = m_gameObjectMap.Insert(
+        transform, model, transform.GetVersion(), world, worldInv);
+
+    // 親子関係のノードをルートとして追加
+    m_sceneGraph.AddNode(handle.index);
 
     return handle;
 }
 
 // ゲームオブジェクトの削除
 void Scene::DespawnObject(engine::ObjectHandle handle) {
-    auto obj = m_gameObjectMap.Erase(handle);
-    if (obj.has_value()) {
-        m_retireQueue.Retire(std::move(obj.value()), m_currentFrameIndex);
-
-        // Despawn時のm_currentFrameIndexは「前回BeginFrameで設定された値」
-        // = このオブジェクトが最後に描画されたフレームスロット。
-        // queue[k]のクリアは必ずfence[k]待機の直後に行われるため、
-        // GPUがそのスロットの最終描画を終えてから破棄されることが保証される。
-        // ※この正しさはBeginFrameでのフェンス待機→クリアの順序に依存する。
-        // TODO:将来的にはフェンス値タグ方式への移行が望ましい。
+    if (!m_gameObjectMap.Contains(handle)) return;
+
+    // 子孫を先に削除する
+    uint32_t child = m_sceneGraph.GetFirstChild(handle.index);
+    while (child != SceneGraph::kNone) {
+        uint32_t next = m_sceneGraph.GetNextSibling(child);
+        DespawnObject(m_gameObjectMap.GetHandle(
+            m_gameObjectMap.GetSlotDataIndex(child)));
+        child = next;
+    }
+    m_sceneGraph.RemoveNode(handle.index);
+
+    // GPUが参照するのはフレームごとのアップロード領域に書き込んだ行列なので，
+    // 描画中のフレームがあってもすぐに削除できる
+    m_gameObjectMap.Erase(handle);
+}
+
+// 親オブジェクトの設定
+bool Scene::SetParent(engine::ObjectHandle child, engine::ObjectHandle parent) {
+    if (!m_gameObjectMap.Contains(child)) return false;
+
+    uint32_t parentNode = SceneGraph::kNone;
+    if (parent.IsValid()) {
+        if (!m_gameObjectMap.Contains(parent)) return false;
+        parentNode = parent.index;
+    }
+    return m_sceneGraph.SetParent(child.index, parentNode);
+}
+
+// 親オブジェクトの取得
+engine::ObjectHandle Scene::GetParent(engine::ObjectHandle handle) {
+    if (!m_gameObjectMap.Contains(handle)) return {};
+
+    uint32_t parentNode = m_sceneGraph.GetParent(handle.index);
+    if (parentNode == SceneGraph::kNone) return {};
+    return m_gameObjectMap.GetHandle(
+        m_gameObjectMap.GetSlotDataIndex(parentNode));
+}
+
+// ワールド行列の計算
+void Scene::UpdateWorldMatrices(JobSystem& jobSystem, RenderStats& stats) {
+    // 付け替えで順序が崩れていれば並べ直す
+    m_sceneGraph.Sort();
+    const auto& order       = m_sceneGraph.GetOrder();
+    const auto& orderParent = m_sceneGraph.GetOrderParent();
+
+    auto& transforms = m_gameObjectMap.GetColumn<Column_Transform>();
+    auto& versions   = m_gameObjectMap.GetColumn<Column_Version>();
+    auto& worlds     = m_gameObjectMap.GetColumn<Column_World>();
+    auto& worldInvs  = m_gameObjectMap.GetColumn<Column_WorldInv>();
+
+    m_orderDataIndex.resize(order.size());
+    m_orderChanged.resize(order.size());
+    m_changedIndices.clear();
+    m_composePositions.clear();
+
+    // 1. 再計算が必要なオブジェクトを集める
+    // 親は必ず子より前にあるので，親の変更フラグは確定済み
+    for (uint32_t pos = 0; pos < order.size(); pos++) {
+        uint32_t i            = m_gameObjectMap.GetSlotDataIndex(order[pos]);
+        uint32_t parentPos    = orderParent[pos];
+        m_orderDataIndex[pos] = i;
+
+        // 自身の姿勢・親・親のワールド行列のいずれかが変わっていれば再計算する
+        uint32_t version = transforms[i].GetVersion();
+        bool changed     = version != versions[i];
+        changed |= m_sceneGraph.ConsumeReparented(order[pos]);
+        changed |= parentPos != SceneGraph::kNone && m_orderChanged[parentPos];
+        m_orderChanged[pos] = changed;
+        if (!changed) continue;
+
+        m_changedIndices.push_back(i);
+        if (parentPos != SceneGraph::kNone) {
+            m_composePositions.push_back(pos);
+        }
+        versions[i] = version;
+    }
+
+    // 変更がなかったものは行列の計算を省略する
+    const uint32_t changedCount =
+        static_cast<uint32_t>(m_changedIndices.size());
+    stats.transformsUpdated = changedCount;
+    stats.transformsSkipped = m_gameObjectMap.Size() - changedCount;
+
+    // 2. ローカルのワールド行列と逆行列をまとめて計算する
+    // 逆行列は汎用の逆行列計算を使わず，TRSの成分から組み立てる
+    // 各要素は独立しているので，変更リストを分割してワーカーで並列に計算する
+    std::span<const uint32_t> changed(m_changedIndices);
+    jobSystem.ParallelFor(static_cast<uint32_t>(changed.size()),
+        config::kObjectsPerJob, [&](uint32_t begin, uint32_t end) {
+            TransformBatch::CalcWorldAndInverse(transforms,
+                changed.subspan(begin, end - begin), worlds, worldInvs);
+        });
+
+    // 3. 親を持つものは並び順に親のワールド行列を掛ける
+    // 親の結果に依存するので，この段はメインスレッドで順に処理する
+    for (uint32_t pos : m_composePositions) {
+        uint32_t i      = m_orderDataIndex[pos];
+        uint32_t parent = m_orderDataIndex[orderParent[pos]];
+
+        // 行ベクトル規約なので，ローカル→親の順に掛ける
+        // 逆行列は (L * P)^-1 = P^-1 * L^-1
+        DirectX::XMMATRIX world    = DirectX::XMLoadFloat4x4(&worlds[i]);
+        DirectX::XMMATRIX worldInv = DirectX::XMLoadFloat4x4(&worldInvs[i]);
+        world *= DirectX::XMLoadFloat4x4(&worlds[parent]);
+        worldInv = DirectX::XMLoadFloat4x4(&worldInvs[parent]) * worldInv;
+        DirectX::XMStoreFloat4x4(&worlds[i], world);
+        DirectX::XMStoreFloat4x4(&worldInvs[i], worldInv);
     }
 }
 
@@ -88,30 +215,30 @@ void Scene::DespawnLight(engine::LightHandle handle) {
 }
 
 void Scene::Term() {
-    // 遅延解放キューのクリア
-    m_retireQueue.ClearAll();
-
     // スロットマップの破棄
     // デバイスとディスクリプタプールが破棄される前に，
-    // GPUリソースを持つオブジェクトを全て破棄する
+    // GPUリソースを持つモデルを全て破棄する
     m_gameObjectMap.Clear();
+    m_sceneGraph.Clear();
     m_lightMap.Clear();
     m_modelMap.Clear();
+}
 
-    m_pDevice  = nullptr;
-    m_pPoolCBV = nullptr;
+/// ハンドルに対応するゲームオブジェクトの姿勢の取得
+/// 変更はTransformの変更カウンタで検出するので，ここではダーティビットを立てない
+Transform* Scene::GetTransform(engine::ObjectHandle handle) {
+    return m_gameObjectMap.Get<Column_Transform>(handle);
 }
 
-/// 遅延解放キューのクリア
-void Scene::BeginFrame(uint32_t frameIndex) {
-    m_currentFrameIndex = frameIndex;
-    m_retireQueue.Clear(frameIndex);
+/// ハンドルに対応するゲームオブジェクトのワールド行列の取得
+const DirectX::XMFLOAT4X4* Scene::GetWorldMatrix(engine::ObjectHandle handle) {
+    return m_gameObjectMap.Get<Column_World>(handle);
 }
 
-/// ハンドルに対応するゲームオブジェクトの取得
-GameObject* Scene::GetObject(engine::ObjectHandle handle) {
-    auto* pObj = m_gameObjectMap.Get(handle);
-    return pObj ? pObj->get() : nullptr;
+/// ハンドルに対応するゲームオブジェクトのモデルハンドルの取得
+engine::ModelHandle Scene::GetModelHandle(engine::ObjectHandle handle) {
+    auto* pModel = m_gameObjectMap.Get<Column_Model>(handle);
+    return pModel ? *pModel : engine::ModelHandle{};
 }
 
 /// ハンドルに対応するモデルの取得
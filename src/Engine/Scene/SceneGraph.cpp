@@ -0,0 +1,151 @@
+#include "Engine/Scene/SceneGraph.h"
+
+#include <cassert>
+
+// ノードをルートとして追加する
+void SceneGraph::AddNode(uint32_t id) {
+    if (id >= m_nodes.size()) {
+        m_nodes.resize(id + 1);
+    }
+    assert(!m_nodes[id].alive && "Node is already registered.");
+
+    m_nodes[id]       = Node{};
+    m_nodes[id].alive = true;
+
+    // ルートは末尾に加えても順序の条件を崩さない
+    m_nodes[id].position = static_cast<uint32_t>(m_order.size());
+    m_order.push_back(id);
+    m_orderParent.push_back(kNone);
+}
+
+// ノードを削除する
+void SceneGraph::RemoveNode(uint32_t id) {
+    if (!Contains(id)) return;
+
+    // 残っている子はルートにする
+    uint32_t child = m_nodes[id].firstChild;
+    while (child != kNone) {
+        uint32_t next              = m_nodes[child].nextSibling;
+        m_nodes[child].parent      = kNone;
+        m_nodes[child].prevSibling = kNone;
+        m_nodes[child].nextSibling = kNone;
+        m_nodes[child].reparented  = true;
+        child                      = next;
+    }
+    m_nodes[id].firstChild = kNone;
+
+    Unlink(id);
+    m_nodes[id].alive = false;
+
+    // 並びの穴は次のSortで詰める
+    m_needsSort = true;
+}
+
+// 親を付け替える
+bool SceneGraph::SetParent(uint32_t child, uint32_t parent) {
+    if (!Contains(child)) return false;
+    if (parent != kNone && !Contains(parent)) return false;
+    if (m_nodes[child].parent == parent) return true;
+
+    // 新しい親の祖先に子自身が含まれていれば循環になる
+    for (uint32_t p = parent; p != kNone; p = m_nodes[p].parent) {
+        if (p == child) return false;
+    }
+
+    Unlink(child);
+    if (parent != kNone) {
+        Link(child, parent);
+    }
+    m_nodes[child].reparented = true;
+
+    // 親が既に子より前にあれば，子孫も含めて順序の条件は崩れない
+    // その場合は親の並び位置だけ差し替え，並べ直しは行わない
+    if (!m_needsSort) {
+        uint32_t childPos = m_nodes[child].position;
+        if (parent == kNone) {
+            m_orderParent[childPos] = kNone;
+        } else if (m_nodes[parent].position < childPos) {
+            m_orderParent[childPos] = m_nodes[parent].position;
+        } else {
+            m_needsSort = true;
+        }
+    }
+    return true;
+}
+
+// 全ノードを削除する
+void SceneGraph::Clear() {
+    m_nodes.clear();
+    m_order.clear();
+    m_orderParent.clear();
+    m_needsSort = false;
+}
+
+// 幅優先で並べ直す
+void SceneGraph::Sort() {
+    if (!m_needsSort) return;
+
+    // これまでの並びの順にルートを取り出し，ルートの相対順序は保つ
+    // 削除後に同じIDが再登録された場合は古い位置の要素を読み飛ばす
+    std::vector<uint32_t> order;
+    order.reserve(m_order.size());
+    for (uint32_t pos = 0; pos < m_order.size(); pos++) {
+        const Node& node = m_nodes[m_order[pos]];
+        if (node.alive && node.position == pos && node.parent == kNone) {
+            order.push_back(m_order[pos]);
+        }
+    }
+
+    // 幅優先で子を後ろに積む．orderそのものをキューとして使う
+    for (uint32_t head = 0; head < order.size(); head++) {
+        uint32_t id = order[head];
+        for (uint32_t c = m_nodes[id].firstChild; c != kNone;
+            c = m_nodes[c].nextSibling) {
+            order.push_back(c);
+        }
+    }
+
+    // 並び位置と親の並び位置を更新
+    m_order = std::move(order);
+    m_orderParent.resize(m_order.size());
+    for (uint32_t pos = 0; pos < m_order.size(); pos++) {
+        m_nodes[m_order[pos]].position = pos;
+    }
+    for (uint32_t pos = 0; pos < m_order.size(); pos++) {
+        uint32_t parent    = m_nodes[m_order[pos]].parent;
+        m_orderParent[pos] = parent == kNone ? kNone : m_nodes[parent].position;
+    }
+
+    m_needsSort = false;
+}
+
+// 親の子リストから外す
+void SceneGraph::Unlink(uint32_t id) {
+    Node& node = m_nodes[id];
+    if (node.parent == kNone) return;
+
+    if (node.prevSibling != kNone) {
+        m_nodes[node.prevSibling].nextSibling = node.nextSibling;
+    } else {
+        m_nodes[node.parent].firstChild = node.nextSibling;
+    }
+    if (node.nextSibling != kNone) {
+        m_nodes[node.nextSibling].prevSibling = node.prevSibling;
+    }
+
+    node.parent      = kNone;
+    node.prevSibling = kNone;
+    node.nextSibling = kNone;
+}
+
+// 親の子リストの先頭に加える
+void SceneGraph::Link(uint32_t id, uint32_t parent) {
+    Node& node       = m_nodes[id];
+    node.parent      = parent;
+    node.prevSibling = kNone;
+    node.nextSibling = m_nodes[parent].firstChild;
+    if (node.nextSibling != kNone) {
+        m_nodes[node.nextSibling].prevSibling = id;
+    }
+    m_nodes[parent].firstChild = id;
+}
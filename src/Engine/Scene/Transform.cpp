@@ -1,6 +1,7 @@
 #include "Engine/Scene/Transform.h"
 
 #include <cassert>
+#include <cmath>
 
 using namespace DirectX;
 
@@ -11,6 +12,15 @@ Transform::Transform()
 
 Transform::~Transform() {}
 
+// 代入
+Transform& Transform::operator=(const Transform& other) {
+    m_position    = other.m_position;
+    m_orientation = other.m_orientation;
+    m_scale       = other.m_scale;
+    m_version++;
+    return *this;
+}
+
 XMMATRIX Transform::CalcWorldMatrix() const {
     // スケーリング
     XMMATRIX scaleMatrix = XMMatrixScaling(m_scale.x, m_scale.y, m_scale.z);
@@ -29,6 +39,62 @@ XMMATRIX Transform::CalcWorldMatrix() const {
     return worldMatrix;
 }
 
+namespace /* anonymous */ {
+/// @brief 回転行列とスケール・平行移動から逆行列を組み立てる
+/// (S * R * T)^-1 = T^-1 * R^T * S^-1
+XMMATRIX MakeInverseTRS(const XMMATRIX& rotation, const XMFLOAT3& scale,
+    const XMFLOAT3& position) {
+    // スケールが0に近い場合は逆行列が不安定になるため単位行列を返す
+    constexpr float kMinScale = Transform::kMinInvertibleScale;
+    if (std::fabs(scale.x) < kMinScale || std::fabs(scale.y) < kMinScale ||
+        std::fabs(scale.z) < kMinScale) {
+        return XMMatrixIdentity();
+    }
+
+    // R^T * S^-1：回転の転置の各列をスケールの逆数で割る
+    XMMATRIX inverse = XMMatrixTranspose(rotation);
+    if (scale.x == scale.y && scale.y == scale.z) {
+        // 一様スケールの場合は全体を1回のスカラー倍で済ませる
+        XMVECTOR invScale = XMVectorReplicate(1.0f / scale.x);
+        inverse.r[0]      = XMVectorMultiply(inverse.r[0], invScale);
+        inverse.r[1]      = XMVectorMultiply(inverse.r[1], invScale);
+        inverse.r[2]      = XMVectorMultiply(inverse.r[2], invScale);
+    } else {
+        XMVECTOR invScale = XMVectorReciprocal(
+            XMVectorSet(scale.x, scale.y, scale.z, 1.0f));
+        inverse.r[0] = XMVectorMultiply(inverse.r[0], invScale);
+        inverse.r[1] = XMVectorMultiply(inverse.r[1], invScale);
+        inverse.r[2] = XMVectorMultiply(inverse.r[2], invScale);
+    }
+
+    // T^-1：平行移動を打ち消す -t を回転・スケールの逆変換で写す
+    XMVECTOR translation =
+        XMVector3TransformNormal(XMLoadFloat3(&position), inverse);
+    inverse.r[3] = XMVectorSetW(XMVectorNegate(translation), 1.0f);
+
+    return inverse;
+}
+}  // namespace
+
+XMMATRIX Transform::CalcInverseWorldMatrix() const {
+    XMMATRIX rotationMatrix =
+        XMMatrixRotationQuaternion(XMLoadFloat4(&m_orientation));
+    return MakeInverseTRS(rotationMatrix, m_scale, m_position);
+}
+
+void Transform::CalcWorldAndInverse(XMMATRIX& world, XMMATRIX& inverse) const {
+    XMMATRIX rotationMatrix =
+        XMMatrixRotationQuaternion(XMLoadFloat4(&m_orientation));
+
+    // S * R * T：回転行列の各行をスケールし，平行移動を4行目に置く
+    world.r[0] = XMVectorScale(rotationMatrix.r[0], m_scale.x);
+    world.r[1] = XMVectorScale(rotationMatrix.r[1], m_scale.y);
+    world.r[2] = XMVectorScale(rotationMatrix.r[2], m_scale.z);
+    world.r[3] = XMVectorSet(m_position.x, m_position.y, m_position.z, 1.0f);
+
+    inverse = MakeInverseTRS(rotationMatrix, m_scale, m_position);
+}
+
 // オイラー角で姿勢を設定する
 void Transform::SetRotation(float pitch, float yaw, float roll) {
     // ラジアンに変換
@@ -39,6 +105,7 @@ void Transform::SetRotation(float pitch, float yaw, float roll) {
     // クォータニオンを計算
     XMVECTOR quaternion = XMQuaternionRotationRollPitchYaw(pitch, yaw, roll);
     XMStoreFloat4(&m_orientation, quaternion);
+    m_version++;
 }
 
 // ワールド座標系での回転操作
@@ -52,6 +119,7 @@ void Transform::RotateWorld(const XMFLOAT3& axis, float angleDeg) {
     XMVECTOR orientation =
         XMQuaternionMultiply(XMLoadFloat4(&m_orientation), rotationQuat);
     XMStoreFloat4(&m_orientation, XMQuaternionNormalize(orientation));
+    m_version++;
 }
 
 // ローカル座標系での回転操作
@@ -65,6 +133,7 @@ void Transform::RotateLocal(const XMFLOAT3& axis, float angleDeg) {
     XMVECTOR orientation =
         XMQuaternionMultiply(rotationQuat, XMLoadFloat4(&m_orientation));
     XMStoreFloat4(&m_orientation, XMQuaternionNormalize(orientation));
+    m_version++;
 }
 
 // 指定した座標の方向を向く
@@ -119,6 +188,7 @@ void Transform::LookTo(const XMFLOAT3& direction, const XMFLOAT3& upHint) {
 
     // 回転の適用
     XMStoreFloat4(&m_orientation, XMQuaternionNormalize(q));
+    m_version++;
 }
 
 XMFLOAT3 Transform::GetForward() const {
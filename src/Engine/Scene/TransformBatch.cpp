@@ -0,0 +1,317 @@
+#include "Engine/Scene/TransformBatch.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+#include "Engine/Core/CpuFeatures.h"
+#include "Engine/Scene/Transform.h"
+
+#if defined(_XM_SSE_INTRINSICS_)
+#include <immintrin.h>
+#endif
+
+// MSVCは/arch無しでもAVX2の組み込み関数を使えるが，
+// GCCとClangは関数ごとに使う命令セットを指定する
+// AVX2の版はRunBatchesAvx2の中に全て展開して，AVX2を有効にした関数だけで
+// __m256を扱う（展開前の関数についての-Wpsabiの警告は実際には当たらない）
+#if defined(_MSC_VER) && !defined(__clang__)
+#define BATCH_TARGET_AVX2
+#else
+#define BATCH_TARGET_AVX2 __attribute__((target("avx2"), flatten))
+#if !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+#endif
+
+using namespace DirectX;
+
+namespace /* anonymous */ {
+
+// 入力成分の並び：位置xyz，クォータニオンxyzw，スケールxyz
+constexpr size_t kInputCount  = 10;
+constexpr size_t kMatrixCount = 16;
+constexpr size_t kMaxWidth    = 8;
+
+//==============================================================
+// レーン演算
+// 同じ計算式をスカラー・SSE・AVX2で共有するため，演算を型ごとにまとめる
+//==============================================================
+
+/// @brief スカラー（1レーン）
+struct ScalarOps {
+    using V                       = float;
+    using M                       = bool;
+    static constexpr size_t Width = 1;
+
+    static V Load(const float* p) { return *p; }
+    static void Store(float* p, V v) { *p = v; }
+    static V Set1(float f) { return f; }
+    static V Add(V a, V b) { return a + b; }
+    static V Sub(V a, V b) { return a - b; }
+    static V Mul(V a, V b) { return a * b; }
+    static V Div(V a, V b) { return a / b; }
+    static V Abs(V a) { return std::fabs(a); }
+    static M Less(V a, V b) { return a < b; }
+    static M Or(M a, M b) { return a || b; }
+    static V Select(M m, V ifTrue, V ifFalse) { return m ? ifTrue : ifFalse; }
+};
+
+#if defined(_XM_SSE_INTRINSICS_)
+/// @brief SSE（4レーン）
+struct SseOps {
+    using V                       = __m128;
+    using M                       = __m128;
+    static constexpr size_t Width = 4;
+
+    static V Load(const float* p) { return _mm_load_ps(p); }
+    static void Store(float* p, V v) { _mm_store_ps(p, v); }
+    static V Set1(float f) { return _mm_set1_ps(f); }
+    static V Add(V a, V b) { return _mm_add_ps(a, b); }
+    static V Sub(V a, V b) { return _mm_sub_ps(a, b); }
+    static V Mul(V a, V b) { return _mm_mul_ps(a, b); }
+    static V Div(V a, V b) { return _mm_div_ps(a, b); }
+    static V Abs(V a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static M Less(V a, V b) { return _mm_cmplt_ps(a, b); }
+    static M Or(M a, M b) { return _mm_or_ps(a, b); }
+    static V Select(M m, V ifTrue, V ifFalse) {
+        return _mm_or_ps(_mm_and_ps(m, ifTrue), _mm_andnot_ps(m, ifFalse));
+    }
+};
+#endif
+
+#if defined(_XM_SSE_INTRINSICS_)
+/// @brief AVX2（8レーン），IsAvx2Supportedがtrueのときだけ使う
+struct AvxOps {
+    using V                       = __m256;
+    using M                       = __m256;
+    static constexpr size_t Width = 8;
+
+    BATCH_TARGET_AVX2 static V Load(const float* p) {
+        return _mm256_load_ps(p);
+    }
+    BATCH_TARGET_AVX2 static void Store(float* p, V v) {
+        _mm256_store_ps(p, v);
+    }
+    BATCH_TARGET_AVX2 static V Set1(float f) { return _mm256_set1_ps(f); }
+    BATCH_TARGET_AVX2 static V Add(V a, V b) { return _mm256_add_ps(a, b); }
+    BATCH_TARGET_AVX2 static V Sub(V a, V b) { return _mm256_sub_ps(a, b); }
+    BATCH_TARGET_AVX2 static V Mul(V a, V b) { return _mm256_mul_ps(a, b); }
+    BATCH_TARGET_AVX2 static V Div(V a, V b) { return _mm256_div_ps(a, b); }
+    BATCH_TARGET_AVX2 static V Abs(V a) {
+        return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a);
+    }
+    BATCH_TARGET_AVX2 static M Less(V a, V b) {
+        return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+    }
+    BATCH_TARGET_AVX2 static M Or(M a, M b) { return _mm256_or_ps(a, b); }
+    BATCH_TARGET_AVX2 static V Select(M m, V ifTrue, V ifFalse) {
+        return _mm256_blendv_ps(ifFalse, ifTrue, m);
+    }
+};
+#endif
+
+/// @brief Widthレーン分のTRSからワールド行列と逆行列を計算する
+/// 入出力は成分ごとにレーンを並べた配列（in[成分][レーン]）
+template <typename Ops>
+void ComputeLanes(float (*in)[kMaxWidth], float (*outWorld)[kMaxWidth],
+    float (*outInverse)[kMaxWidth]) {
+    using V = typename Ops::V;
+
+    V tx = Ops::Load(in[0]), ty = Ops::Load(in[1]), tz = Ops::Load(in[2]);
+    V qx = Ops::Load(in[3]), qy = Ops::Load(in[4]), qz = Ops::Load(in[5]);
+    V qw = Ops::Load(in[6]);
+    V sx = Ops::Load(in[7]), sy = Ops::Load(in[8]), sz = Ops::Load(in[9]);
+
+    const V zero = Ops::Set1(0.0f);
+    const V one  = Ops::Set1(1.0f);
+    const V two  = Ops::Set1(2.0f);
+
+    // クォータニオンから回転行列（XMMatrixRotationQuaternionと同じ並び）
+    V x2 = Ops::Mul(qx, two), y2 = Ops::Mul(qy, two), z2 = Ops::Mul(qz, two);
+    V xx = Ops::Mul(qx, x2), yy = Ops::Mul(qy, y2), zz = Ops::Mul(qz, z2);
+    V xy = Ops::Mul(qx, y2), xz = Ops::Mul(qx, z2), yz = Ops::Mul(qy, z2);
+    V wx = Ops::Mul(qw, x2), wy = Ops::Mul(qw, y2), wz = Ops::Mul(qw, z2);
+
+    V r[3][3];
+    r[0][0] = Ops::Sub(one, Ops::Add(yy, zz));
+    r[0][1] = Ops::Add(xy, wz);
+    r[0][2] = Ops::Sub(xz, wy);
+    r[1][0] = Ops::Sub(xy, wz);
+    r[1][1] = Ops::Sub(one, Ops::Add(xx, zz));
+    r[1][2] = Ops::Add(yz, wx);
+    r[2][0] = Ops::Add(xz, wy);
+    r[2][1] = Ops::Sub(yz, wx);
+    r[2][2] = Ops::Sub(one, Ops::Add(xx, yy));
+
+    // ワールド行列 S * R * T：回転行列の各行をスケールし，4行目に平行移動
+    const V s[3] = { sx, sy, sz };
+    const V t[3] = { tx, ty, tz };
+    for (int row = 0; row < 3; row++) {
+        for (int col = 0; col < 3; col++) {
+            Ops::Store(outWorld[row * 4 + col], Ops::Mul(r[row][col], s[row]));
+        }
+        Ops::Store(outWorld[row * 4 + 3], zero);
+        Ops::Store(outWorld[12 + row], t[row]);
+    }
+    Ops::Store(outWorld[15], one);
+
+    // 逆行列 T^-1 * R^T * S^-1
+    // スケールが0に近いレーンは単位行列にする
+    const V minScale = Ops::Set1(Transform::kMinInvertibleScale);
+    auto degenerate  = Ops::Or(Ops::Less(Ops::Abs(sx), minScale),
+        Ops::Or(Ops::Less(Ops::Abs(sy), minScale),
+            Ops::Less(Ops::Abs(sz), minScale)));
+
+    const V invS[3] = { Ops::Div(one, sx), Ops::Div(one, sy),
+        Ops::Div(one, sz) };
+    for (int col = 0; col < 3; col++) {
+        // 3x3部分：inv[row][col] = R[col][row] / s[col]
+        for (int row = 0; row < 3; row++) {
+            V m = Ops::Mul(r[col][row], invS[col]);
+            Ops::Store(outInverse[row * 4 + col],
+                Ops::Select(degenerate, row == col ? one : zero, m));
+        }
+
+        // 平行移動：-(t・R[col]) / s[col]
+        V dot = Ops::Mul(tx, r[col][0]);
+        dot   = Ops::Add(dot, Ops::Mul(ty, r[col][1]));
+        dot   = Ops::Add(dot, Ops::Mul(tz, r[col][2]));
+        V m   = Ops::Sub(zero, Ops::Mul(dot, invS[col]));
+        Ops::Store(outInverse[12 + col], Ops::Select(degenerate, zero, m));
+        Ops::Store(outInverse[col * 4 + 3], zero);
+    }
+    Ops::Store(outInverse[15], one);
+}
+
+/// @brief [begin, end)のうちWidthで割り切れる分をOpsで処理し，処理済みの位置を返す
+/// @param load load(i, float* components)でi番目の入力10成分を書き込む
+/// @param store store(i, world, inverse)でi番目の結果を受け取る
+template <typename Ops, typename Load, typename Store>
+size_t RunBatches(size_t begin, size_t end, const Load& load,
+    const Store& store) {
+    constexpr size_t W = Ops::Width;
+
+    alignas(32) float in[kInputCount][kMaxWidth];
+    alignas(32) float world[kMatrixCount][kMaxWidth];
+    alignas(32) float inverse[kMatrixCount][kMaxWidth];
+
+    size_t i = begin;
+    for (; i + W <= end; i += W) {
+        // 入力を成分ごとに並べ替える
+        for (size_t lane = 0; lane < W; lane++) {
+            float components[kInputCount];
+            load(i + lane, components);
+            for (size_t c = 0; c < kInputCount; c++) {
+                in[c][lane] = components[c];
+            }
+        }
+
+        ComputeLanes<Ops>(in, world, inverse);
+
+        // レーンごとの行列に戻して書き出す
+        for (size_t lane = 0; lane < W; lane++) {
+            XMFLOAT4X4 w, inv;
+            for (size_t c = 0; c < kMatrixCount; c++) {
+                w.m[c / 4][c % 4]   = world[c][lane];
+                inv.m[c / 4][c % 4] = inverse[c][lane];
+            }
+            store(i + lane, w, inv);
+        }
+    }
+    return i;
+}
+
+#if defined(_XM_SSE_INTRINSICS_)
+/// @brief AVX2で処理する，計算と入出力の並べ替えを全てこの関数に展開する
+template <typename Load, typename Store>
+BATCH_TARGET_AVX2 size_t RunBatchesAvx2(size_t begin, size_t end,
+    const Load& load, const Store& store) {
+    return RunBatches<AvxOps>(begin, end, load, store);
+}
+#endif
+
+/// @brief 使える最も広いSIMD幅から順に処理し，端数をスカラーで処理する
+template <typename Load, typename Store>
+void Dispatch(size_t count, TransformBatch::SimdLevel simdLevel,
+    const Load& load, const Store& store) {
+    using SimdLevel = TransformBatch::SimdLevel;
+
+    size_t done = 0;
+#if defined(_XM_SSE_INTRINSICS_)
+    if (simdLevel == SimdLevel::Avx2 && TransformBatch::IsAvx2Supported()) {
+        done = RunBatchesAvx2(done, count, load, store);
+    }
+    if (simdLevel != SimdLevel::Scalar) {
+        done = RunBatches<SseOps>(done, count, load, store);
+    }
+#endif
+    RunBatches<ScalarOps>(done, count, load, store);
+}
+
+}  // namespace
+
+// AVX2の経路を使えるか
+bool TransformBatch::IsAvx2Supported() { return CpuFeatures::HasAvx2(); }
+
+// 位置・回転・スケールの列から計算する
+void TransformBatch::CalcWorldAndInverse(std::span<const XMFLOAT3> positions,
+    std::span<const XMFLOAT4> orientations, std::span<const XMFLOAT3> scales,
+    std::span<XMFLOAT4X4> outWorlds, std::span<XMFLOAT4X4> outInverses,
+    SimdLevel simdLevel) {
+    const size_t count = positions.size();
+    assert(orientations.size() == count && scales.size() == count &&
+           outWorlds.size() >= count && outInverses.size() >= count &&
+           "Span sizes do not match.");
+
+    Dispatch(
+        count, simdLevel,
+        [&](size_t i, float* c) {
+            c[0] = positions[i].x;
+            c[1] = positions[i].y;
+            c[2] = positions[i].z;
+            c[3] = orientations[i].x;
+            c[4] = orientations[i].y;
+            c[5] = orientations[i].z;
+            c[6] = orientations[i].w;
+            c[7] = scales[i].x;
+            c[8] = scales[i].y;
+            c[9] = scales[i].z;
+        },
+        [&](size_t i, const XMFLOAT4X4& world, const XMFLOAT4X4& inverse) {
+            outWorlds[i]   = world;
+            outInverses[i] = inverse;
+        });
+}
+
+// 指定した要素だけを計算する
+void TransformBatch::CalcWorldAndInverse(std::span<const Transform> transforms,
+    std::span<const uint32_t> indices, std::span<XMFLOAT4X4> outWorlds,
+    std::span<XMFLOAT4X4> outInverses) {
+    assert(outWorlds.size() >= transforms.size() &&
+           outInverses.size() >= transforms.size() &&
+           "Output spans are too small.");
+
+    Dispatch(
+        indices.size(), SimdLevel::Avx2,
+        [&](size_t i, float* c) {
+            const Transform& transform = transforms[indices[i]];
+            XMFLOAT3 position          = transform.GetPosition();
+            XMFLOAT4 orientation       = transform.GetOrientation();
+            XMFLOAT3 scale             = transform.GetScale();
+            c[0]                       = position.x;
+            c[1]                       = position.y;
+            c[2]                       = position.z;
+            c[3]                       = orientation.x;
+            c[4]                       = orientation.y;
+            c[5]                       = orientation.z;
+            c[6]                       = orientation.w;
+            c[7]                       = scale.x;
+            c[8]                       = scale.y;
+            c[9]                       = scale.z;
+        },
+        [&](size_t i, const XMFLOAT4X4& world, const XMFLOAT4X4& inverse) {
+            outWorlds[indices[i]]   = world;
+            outInverses[indices[i]] = inverse;
+        });
+}
@@ -5,7 +5,6 @@
 #include "Engine/Engine.h"
 #include "Engine/Resource/AssetLoadScope.h"
 #include "Engine/Resource/AssetPath.h"
-#include "Engine/Scene/GameObject.h"
 #include "Engine/Scene/Scene.h"
 #include "Game/CameraController.h"
 
@@ -27,19 +26,19 @@ void Game::Init(Engine* pEngine) {
 
     m_pEngine->GetScene().GetCamera().SetExposure(2.8f, 1.0f / 30.0f, 800.0f);
 
-    // モデルのロード
-    auto loader = m_pEngine->CreateAssetLoadScope();
+    // モデルの非同期ロード
+    // ハンドルはすぐに返るので，転送の完了前でもオブジェクトを作成できる
     std::filesystem::path path;
     AssetPath().GetAssetPath(L"model/TextureSphere.glb", path);
-    m_earthModel = loader.LoadModel(path);
+    m_earthModel = m_pEngine->LoadModelAsync(path);
     AssetPath().GetAssetPath(L"model/lowpoly_apple.glb", path);
-    m_appleModel = loader.LoadModel(path);
+    m_appleModel = m_pEngine->LoadModelAsync(path);
     AssetPath().GetAssetPath(L"model/Katana.glb", path);
-    m_katanaModel = loader.LoadModel(path);
+    m_katanaModel = m_pEngine->LoadModelAsync(path);
     AssetPath().GetAssetPath(L"model/Plane.glb", path);
-    m_planeModel = loader.LoadModel(path);
+    m_planeModel = m_pEngine->LoadModelAsync(path);
     AssetPath().GetAssetPath(L"model/NormalTangentTest.glb", path);
-    m_normalTestModel = loader.LoadModel(path);
+    m_normalTestModel = m_pEngine->LoadModelAsync(path);
 
     // ライトの作成
 
@@ -92,6 +91,7 @@ void Game::Init(Engine* pEngine) {
     /*
     {
         // IESプロファイルのロード
+        auto loader = m_pEngine->CreateAssetLoadScope();
         std::optional<uint32_t> iesIndex;
         AssetPath().GetAssetPath(L"ies/TopPost.IES", path);
         iesIndex = loader.LoadIESProfile(path);
@@ -141,9 +141,8 @@ void Game::Tick(float deltaTime) {
         if (!m_appleObject.IsValid()) {
             m_appleObject = m_pEngine->GetScene().SpawnObject(m_appleModel);
             m_pEngine->GetScene()
-                .GetObject(m_appleObject)
-                ->GetTransform()
-                .SetScale({ 3.0f, 3.0f, 3.0f });
+                .GetTransform(m_appleObject)
+                ->SetScale({ 3.0f, 3.0f, 3.0f });
         } else {
             m_pEngine->GetScene().DespawnObject(m_appleObject);
             m_appleObject = {};
@@ -163,9 +162,8 @@ void Game::Tick(float deltaTime) {
         if (!m_planeObject.IsValid()) {
             m_planeObject = m_pEngine->GetScene().SpawnObject(m_planeModel);
             m_pEngine->GetScene()
-                .GetObject(m_planeObject)
-                ->GetTransform()
-                .SetPosition({ 0.0f, -1.0f, 0.0f });
+                .GetTransform(m_planeObject)
+                ->SetPosition({ 0.0f, -1.0f, 0.0f });
         } else {
             m_pEngine->GetScene().DespawnObject(m_planeObject);
             m_planeObject = {};
@@ -0,0 +1,232 @@
+/// @file   main.cpp
+/// @brief  モデル変換ツールのエントリーポイント
+/// GLBを読み込み，ミップ生成済みの変換済みモデル（.mdl）として書き出す
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cwchar>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Resource/CookedModelFile.h"
+#include "Engine/Resource/ModelLoader.h"
+
+namespace /* anonymous */ {
+/// @brief 使い方の表示
+void PrintUsage() {
+    std::wprintf(
+        L"Usage: ModelCooker <input.glb> [output.mdl] [--bench <count>]\n"
+        L"  output.mdl  省略時は入力と同じ場所に拡張子を変えて書き出す\n"
+        L"  --bench     GLB（逐次・並列）と変換済みモデルの読み込みを比べる\n");
+}
+
+/// @brief 法線と接線の生成・最適化・16bit化・LOD・メッシュレット・
+/// 頂点の圧縮の結果を表示する
+void PrintMeshStats(const MeshImportStats& importStats) {
+    const TangentGenerator::Stats& tangents = importStats.tangents;
+    std::wprintf(L"tangents: normals %u, tangents %u meshes "
+                 L"(%u split vertices), %.1f ms (%.2f M triangles/s)\n",
+        tangents.normalMeshCount, tangents.tangentMeshCount,
+        tangents.splitVertexCount, tangents.generateTimeMs,
+        tangents.GetTrianglesPerSecond() / 1e6);
+
+    std::wprintf(L"mesh  vertices (before -> after)  ACMR (before -> after)"
+                 L"  ATVR (before -> after)\n");
+    for (size_t i = 0; i < importStats.meshes.size(); i++) {
+        const MeshOptimizer::Stats& stats = importStats.meshes[i];
+        std::wprintf(L"%4zu  %8u -> %-8u          %6.3f -> %-6.3f"
+                     L"          %6.3f -> %-6.3f\n",
+            i, stats.vertexCountBefore, stats.vertexCountAfter,
+            stats.before.acmr, stats.after.acmr, stats.before.atvr,
+            stats.after.atvr);
+    }
+
+    const MeshOptimizer::IndexStats& indices = importStats.indices;
+    std::wprintf(L"meshes %u -> %u (%u split, %u with 16-bit indices)\n",
+        indices.meshCountBefore, indices.meshCountAfter,
+        indices.splitMeshCount, indices.shortMeshCount);
+    std::wprintf(L"index bytes %llu -> %llu, vertex bytes %llu -> %llu, "
+                 L"saved %lld bytes\n",
+        static_cast<unsigned long long>(indices.indexBytesBefore),
+        static_cast<unsigned long long>(indices.indexBytesAfter),
+        static_cast<unsigned long long>(indices.vertexBytesBefore),
+        static_cast<unsigned long long>(indices.vertexBytesAfter),
+        static_cast<long long>(indices.GetSavedBytes()));
+
+    // LODごとの三角形数と，簡略化の処理速度
+    const MeshSimplifier::Stats& lods = importStats.lods;
+    std::wprintf(L"lods: %u meshes, %.1f ms (%.2f M triangles/s)\n",
+        lods.meshCount, lods.simplifyTimeMs,
+        lods.GetTrianglesPerSecond() / 1e6);
+    for (uint32_t i = 0; i < MeshSimplifier::kMaxLods; i++) {
+        if (lods.lodMeshCount[i] == 0) {
+            break;
+        }
+        std::wprintf(L"  LOD%u  %10llu triangles (%u meshes)\n", i,
+            static_cast<unsigned long long>(lods.triangleCount[i]),
+            lods.lodMeshCount[i]);
+    }
+
+    const MeshletBuilder::Stats& meshlets = importStats.meshlets;
+    std::wprintf(L"meshlets: %u (%.1f triangles, %.1f vertices each, "
+                 L"%u with normal cone)\n",
+        meshlets.meshletCount, meshlets.GetTrianglesPerMeshlet(),
+        meshlets.GetVerticesPerMeshlet(), meshlets.coneMeshletCount);
+
+    const VertexQuantizer::Stats& vertices = importStats.vertices;
+    std::wprintf(L"vertex format: %u compact, %u standard, "
+                 L"%.1f -> %.1f bytes/vertex\n",
+        vertices.compactMeshCount, vertices.standardMeshCount,
+        vertices.GetBytesPerVertexBefore(), vertices.GetBytesPerVertexAfter());
+    std::wprintf(L"max error: position %g, normal %.4f deg, "
+                 L"tangent %.4f deg, texcoord %g\n",
+        vertices.maxError.position, vertices.maxError.normal,
+        vertices.maxError.tangent, vertices.maxError.texcoord);
+}
+
+/// @brief 変換済みモデルのデータを全て読む
+/// マッピングはページを触るまで読み込まれないので，転送と同じく全体に触れる
+uint64_t TouchCookedData(const CookedModelView& view) {
+    auto Touch = [](const uint8_t* pData, uint64_t size) {
+        uint64_t sum = 0;
+        for (uint64_t i = 0; i < size; i++) {
+            sum += pData[i];
+        }
+        return sum;
+    };
+
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < view.GetMeshCount(); i++) {
+        MeshView mesh = view.GetMesh(i);
+        sum += Touch(static_cast<const uint8_t*>(mesh.pVertices),
+            uint64_t{ mesh.vertexCount } * mesh.GetVertexStride());
+        sum += Touch(static_cast<const uint8_t*>(mesh.pIndices),
+            uint64_t{ mesh.indexCount } * mesh.GetIndexSize());
+        sum += Touch(reinterpret_cast<const uint8_t*>(mesh.pMeshlets),
+            uint64_t{ mesh.meshletCount } * sizeof(Meshlet));
+        sum += Touch(reinterpret_cast<const uint8_t*>(mesh.pMeshletBounds),
+            uint64_t{ mesh.meshletCount } * sizeof(MeshletBounds));
+    }
+    for (uint32_t i = 0; i < view.GetTextureCount(); i++) {
+        for (const auto& record : view.GetSubresources(i)) {
+            sum += Touch(view.GetData(record.dataOffset), record.slicePitch);
+        }
+    }
+    return sum;
+}
+
+/// @brief 読み込み時間の計測
+/// @param count 繰り返し回数
+/// @param jobSystem GLBの並列の読み込みに使うジョブシステム
+int RunBenchmark(const std::filesystem::path& srcPath,
+    const std::filesystem::path& dstPath, int count, JobSystem& jobSystem) {
+    using Clock = std::chrono::steady_clock;
+    auto ToMs   = [](Clock::duration d) {
+        return std::chrono::duration<double, std::milli>(d).count();
+    };
+
+    // GLBの解析と画像のデコード・ミップ生成
+    // 法線と接線の生成・画像のデコードを逐次と並列で比べる
+    JobSystem* jobSystems[2] = { nullptr, &jobSystem };
+    double glbMs[2]          = {};
+    double tangentMs[2]      = {};
+    for (int j = 0; j < 2; j++) {
+        for (int i = 0; i < count; i++) {
+            auto start = Clock::now();
+            ModelAsset modelAsset;
+            std::vector<DirectX::ScratchImage> images;
+            MeshImportStats stats;
+            if (!ModelLoader::LoadAsset(
+                    srcPath, modelAsset, images, &stats, jobSystems[j])) {
+                std::fwprintf(
+                    stderr, L"Failed to load %ls\n", srcPath.c_str());
+                return 1;
+            }
+            glbMs[j] += ToMs(Clock::now() - start);
+            tangentMs[j] += stats.tangents.generateTimeMs;
+        }
+    }
+
+    // マッピングと検証，データへのアクセス
+    double cookedMs = 0.0;
+    uint64_t sum    = 0;
+    for (int i = 0; i < count; i++) {
+        auto start = Clock::now();
+        CookedModelFile file;
+        if (!file.Open(dstPath)) {
+            std::fwprintf(stderr, L"Failed to open %ls\n", dstPath.c_str());
+            return 1;
+        }
+        sum += TouchCookedData(file.GetView());
+        cookedMs += ToMs(Clock::now() - start);
+    }
+
+    std::wprintf(L"GLB    : %.3f ms (tangents %.3f ms), 1 thread\n",
+        glbMs[0] / count, tangentMs[0] / count);
+    std::wprintf(L"GLB    : %.3f ms (tangents %.3f ms), %u threads\n",
+        glbMs[1] / count, tangentMs[1] / count,
+        jobSystem.GetWorkerCount() + 1);
+    std::wprintf(L"Cooked : %.3f ms (checksum %llu)\n", cookedMs / count,
+        static_cast<unsigned long long>(sum));
+    return 0;
+}
+}  // namespace
+
+// エントリーポイント
+int wmain(int argc, wchar_t** argv) {
+    // 引数の解析
+    std::filesystem::path srcPath;
+    std::filesystem::path dstPath;
+    int benchCount = 0;
+    for (int i = 1; i < argc; i++) {
+        if (std::wcscmp(argv[i], L"--bench") == 0 && i + 1 < argc) {
+            benchCount = (std::max)(1, _wtoi(argv[++i]));
+        } else if (srcPath.empty()) {
+            srcPath = argv[i];
+        } else if (dstPath.empty()) {
+            dstPath = argv[i];
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+    if (srcPath.empty()) {
+        PrintUsage();
+        return 1;
+    }
+    if (dstPath.empty()) {
+        dstPath = srcPath;
+        dstPath.replace_extension(L".mdl");
+    }
+
+    // 法線と接線の生成と画像のデコードを並列に行う
+    JobSystem jobSystem;
+    if (!jobSystem.Init()) {
+        std::fwprintf(stderr, L"Failed to initialize JobSystem\n");
+        return 1;
+    }
+
+    int result = 0;
+    MeshImportStats importStats;
+    if (ModelLoader::CookModel(srcPath, dstPath, &importStats, &jobSystem)) {
+        std::wprintf(L"%ls -> %ls (%llu bytes)\n", srcPath.c_str(),
+            dstPath.c_str(),
+            static_cast<unsigned long long>(
+                std::filesystem::file_size(dstPath)));
+        PrintMeshStats(importStats);
+        if (benchCount > 0) {
+            result =
+                RunBenchmark(srcPath, dstPath, benchCount, jobSystem);
+        }
+    } else {
+        std::fwprintf(stderr, L"Failed to cook %ls\n", srcPath.c_str());
+        result = 1;
+    }
+
+    jobSystem.Term();
+    return result;
+}
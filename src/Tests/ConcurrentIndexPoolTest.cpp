@@ -0,0 +1,269 @@
+/// @file   ConcurrentIndexPoolTest.cpp
+/// @brief  ConcurrentIndexPoolの複数スレッドでの確保・解放と，競合時の速度
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "Engine/Core/ConcurrentIndexPool.h"
+#include "Engine/Core/FreeRangeAllocator.h"
+#include "Tests/TestFramework.h"
+
+namespace /* anonymous */ {
+
+/// @brief 試すスレッド数
+constexpr uint32_t kThreadCounts[] = { 1, 2, 4, 8, 16 };
+
+constexpr uint32_t kCapacity = 4096;
+
+/// @brief threadCount個のスレッドで同時にfuncを呼び，全て終わるまで待つ
+/// 全てのスレッドが揃ってから一斉に始める
+template <typename Func>
+void RunThreads(uint32_t threadCount, Func func) {
+    std::atomic<uint32_t> ready{ 0 };
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < threadCount; t++) {
+        threads.emplace_back([&, t] {
+            ready.fetch_add(1);
+            while (ready.load() < threadCount) {
+                std::this_thread::yield();
+            }
+            func(t);
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+/// @brief 確保中のインデックスの記録（二重に確保されたら数える）
+class OwnerTable {
+public:
+    explicit OwnerTable(uint32_t capacity) : m_owned(capacity) {}
+
+    void Acquire(uint32_t index) {
+        if (m_owned[index].exchange(1) != 0) {
+            m_duplicates.fetch_add(1);
+        }
+    }
+    void Release(uint32_t index) { m_owned[index].store(0); }
+
+    uint32_t GetDuplicateCount() const { return m_duplicates.load(); }
+
+private:
+    std::vector<std::atomic<uint8_t>> m_owned;
+    std::atomic<uint32_t> m_duplicates{ 0 };
+};
+
+/// @brief 空きが全て戻っていれば，全体を1つの範囲として確保できる
+bool IsFullyFree(ConcurrentIndexPool& pool) {
+    uint32_t first = pool.AllocateRange(pool.GetCapacity());
+    if (first != 0) {
+        return false;
+    }
+    pool.FreeRange(0, pool.GetCapacity());
+    return true;
+}
+
+}  // namespace
+
+//==============================================================
+// テスト
+//==============================================================
+
+// 1〜16スレッドで確保・解放と範囲の確保を混ぜても，同じインデックスを
+// 二重に渡さず，スレッドの終了後には全ての空きが戻る
+TEST_CASE(ConcurrentIndexPool_StressNoDuplicates) {
+    constexpr uint32_t kIterations = 20000;
+    constexpr uint32_t kMaxHeld    = 40;  // キャッシュより少し多く持つ
+
+    for (uint32_t threadCount : kThreadCounts) {
+        ConcurrentIndexPool pool;
+        pool.Reset(kCapacity);
+        OwnerTable owners(kCapacity);
+        std::atomic<uint32_t> failures{ 0 };
+
+        RunThreads(threadCount, [&](uint32_t t) {
+            std::mt19937 rng(t + 1);
+            std::vector<uint32_t> held;
+            for (uint32_t i = 0; i < kIterations; i++) {
+                if (held.size() < kMaxHeld && (rng() % 3) != 0) {
+                    uint32_t index = pool.Allocate();
+                    if (index == ConcurrentIndexPool::kInvalidIndex) {
+                        failures.fetch_add(1);
+                        continue;
+                    }
+                    owners.Acquire(index);
+                    held.push_back(index);
+                } else if (!held.empty()) {
+                    size_t k = rng() % held.size();
+                    std::swap(held[k], held.back());
+                    owners.Release(held.back());
+                    pool.Free(held.back());
+                    held.pop_back();
+                }
+
+                // 最初のスレッドは時々範囲も確保する
+                if (t == 0 && i % 256 == 0) {
+                    uint32_t count = 1 + rng() % 32;
+                    uint32_t first = pool.AllocateRange(count);
+                    if (first == ConcurrentIndexPool::kInvalidIndex) {
+                        continue;
+                    }
+                    for (uint32_t k = first; k < first + count; k++) {
+                        owners.Acquire(k);
+                    }
+                    for (uint32_t k = first; k < first + count; k++) {
+                        owners.Release(k);
+                    }
+                    pool.FreeRange(first, count);
+                }
+            }
+            for (uint32_t index : held) {
+                owners.Release(index);
+                pool.Free(index);
+            }
+        });
+
+        // 容量は十分にあるので，確保に失敗することはない
+        std::printf("  %2u threads: %u duplicates, %u failures\n",
+            threadCount, owners.GetDuplicateCount(), failures.load());
+        CHECK(owners.GetDuplicateCount() == 0);
+        CHECK(failures.load() == 0);
+        CHECK(IsFullyFree(pool));
+    }
+}
+
+// 生きているスレッドのキャッシュに残った空きも，範囲の確保で回収する
+TEST_CASE(ConcurrentIndexPool_ReclaimsIdleCaches) {
+    constexpr uint32_t kThreads = 8;
+
+    ConcurrentIndexPool pool;
+    pool.Reset(kCapacity);
+
+    std::atomic<uint32_t> parked{ 0 };
+    std::atomic<bool> finish{ false };
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreads; t++) {
+        threads.emplace_back([&] {
+            // 確保してから解放すると，空きがこのスレッドのキャッシュに残る
+            std::vector<uint32_t> held;
+            for (int i = 0; i < 60; i++) {
+                held.push_back(pool.Allocate());
+            }
+            for (uint32_t index : held) {
+                pool.Free(index);
+            }
+            parked.fetch_add(1);
+            while (!finish.load()) {
+                std::this_thread::yield();
+            }
+        });
+    }
+    while (parked.load() < kThreads) {
+        std::this_thread::yield();
+    }
+
+    // スレッドは止まっているので，キャッシュを取り出して全て戻せる
+    CHECK(IsFullyFree(pool));
+
+    // 回収した後も，各スレッドのキャッシュはそのまま使える
+    finish.store(true);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    RunThreads(kThreads, [&](uint32_t) {
+        for (int i = 0; i < 100; i++) {
+            pool.Free(pool.Allocate());
+        }
+    });
+    CHECK(IsFullyFree(pool));
+}
+
+// 使い切ったときは無効値を返し，解放すれば再び確保できる
+TEST_CASE(ConcurrentIndexPool_Exhaustion) {
+    constexpr uint32_t kSmall = 100;
+
+    ConcurrentIndexPool pool;
+    pool.Reset(kSmall);
+
+    std::vector<uint32_t> held;
+    for (uint32_t i = 0; i < kSmall; i++) {
+        held.push_back(pool.Allocate());
+    }
+    CHECK(pool.Allocate() == ConcurrentIndexPool::kInvalidIndex);
+    CHECK(pool.AllocateRange(1) == ConcurrentIndexPool::kInvalidIndex);
+
+    std::sort(held.begin(), held.end());
+    bool allDistinct = std::adjacent_find(held.begin(), held.end()) ==
+                       held.end();
+    CHECK(allDistinct && held.back() < kSmall);
+
+    // 範囲外の解放は無視する
+    pool.Free(kSmall);
+    pool.FreeRange(kSmall - 1, 2);
+    for (uint32_t index : held) {
+        pool.Free(index);
+    }
+    CHECK(IsFullyFree(pool));
+}
+
+//==============================================================
+// 計測
+//==============================================================
+
+// スレッド数ごとの確保・解放の速度
+// 全体を1つのmutexで守ったFreeRangeAllocatorと比べる
+BENCHMARK_CASE(ConcurrentIndexPool_Contention) {
+    constexpr uint32_t kOps  = 200000;  // スレッドあたりの確保・解放の組
+    constexpr uint32_t kHeld = 16;      // 同時に持つ数
+
+    std::printf(
+        "  hardware threads: %u\n", std::thread::hardware_concurrency());
+    std::printf("  threads  pool ops/ms  locked ops/ms\n");
+
+    for (uint32_t threadCount : kThreadCounts) {
+        ConcurrentIndexPool pool;
+        pool.Reset(kCapacity);
+        Stopwatch poolWatch;
+        RunThreads(threadCount, [&](uint32_t) {
+            uint32_t held[kHeld];
+            for (uint32_t i = 0; i < kOps; i += kHeld) {
+                for (uint32_t& index : held) {
+                    index = pool.Allocate();
+                }
+                for (uint32_t index : held) {
+                    pool.Free(index);
+                }
+            }
+        });
+        const double poolMs = poolWatch.GetElapsedMs();
+
+        std::mutex mutex;
+        FreeRangeAllocator ranges;
+        ranges.Reset(kCapacity);
+        Stopwatch lockedWatch;
+        RunThreads(threadCount, [&](uint32_t) {
+            uint32_t held[kHeld];
+            for (uint32_t i = 0; i < kOps; i += kHeld) {
+                for (uint32_t& index : held) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    index = ranges.Allocate(1);
+                }
+                for (uint32_t index : held) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    ranges.Free(index, 1);
+                }
+            }
+        });
+        const double lockedMs = lockedWatch.GetElapsedMs();
+
+        const double totalOps = double(kOps) * threadCount;
+        std::printf("  %7u  %11.0f  %13.0f\n", threadCount,
+            totalOps / poolMs, totalOps / lockedMs);
+    }
+}
@@ -0,0 +1,155 @@
+/// @file   DeferredReleaseQueueTest.cpp
+/// @brief  DeferredReleaseQueueがフェンス値の順に，完了後にだけ破棄するかの検証
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Engine/Core/DeferredReleaseQueue.h"
+#include "Engine/Core/JobSystem.h"
+#include "Tests/TestFramework.h"
+
+namespace /* anonymous */ {
+
+/// @brief 破棄の記録
+/// GPUが完了したフェンス値を持ち，それより先のものが破棄されたら数える
+struct ReleaseLog {
+    std::atomic<uint64_t> completed{ 0 };  // 完了したことにするフェンス値
+    std::atomic<uint32_t> early{ 0 };      // 完了前に破棄された数
+    std::mutex mutex;
+    std::vector<uint64_t> order;           // 破棄されたフェンス値の順
+
+    size_t GetCount() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return order.size();
+    }
+};
+
+/// @brief 破棄されたときにReleaseLogへ記録するオブジェクト
+/// ムーブ元は記録しない
+class Tracked {
+public:
+    Tracked(ReleaseLog& log, uint64_t fenceValue)
+        : m_pLog(&log), m_fenceValue(fenceValue) {}
+    Tracked(Tracked&& other) noexcept
+        : m_pLog(std::exchange(other.m_pLog, nullptr)),
+          m_fenceValue(other.m_fenceValue) {}
+    Tracked& operator=(Tracked&&) = delete;
+
+    ~Tracked() {
+        if (m_pLog == nullptr) return;
+        if (m_fenceValue > m_pLog->completed.load()) {
+            m_pLog->early.fetch_add(1);
+        }
+        std::lock_guard<std::mutex> lock(m_pLog->mutex);
+        m_pLog->order.push_back(m_fenceValue);
+    }
+
+private:
+    ReleaseLog* m_pLog;
+    uint64_t m_fenceValue;
+};
+
+/// @brief GPUがフェンス値に到達したことにして回収する
+void Complete(DeferredReleaseQueue& queue, ReleaseLog& log,
+    uint64_t fenceValue, JobSystem* pJobSystem = nullptr) {
+    log.completed.store(fenceValue);
+    queue.Collect(fenceValue, pJobSystem);
+}
+
+}  // namespace
+
+//==============================================================
+// テスト
+//==============================================================
+
+// 預けた順に関係なく，完了したフェンス値以下のものだけを値の順に破棄する
+TEST_CASE(DeferredReleaseQueue_ReleasesInFenceOrder) {
+    ReleaseLog log;
+    {
+        DeferredReleaseQueue queue;
+        const uint64_t fences[] = { 3, 1, 4, 1, 5, 2, 6, 2, 0 };
+        for (uint64_t fence : fences) {
+            queue.Retire(Tracked(log, fence), fence);
+        }
+        // 型は問わない
+        queue.Retire(std::make_unique<Tracked>(log, 4), 4);
+        CHECK(queue.GetPendingCount() == 10);
+
+        Complete(queue, log, 0);
+        CHECK(log.GetCount() == 1 && queue.GetPendingCount() == 9);
+
+        Complete(queue, log, 2);
+        CHECK(log.GetCount() == 5 && queue.GetPendingCount() == 5);
+
+        // 同じ値で呼んでも何も起きない
+        Complete(queue, log, 2);
+        CHECK(log.GetCount() == 5);
+
+        Complete(queue, log, 4);
+        CHECK(log.GetCount() == 8 && queue.GetPendingCount() == 2);
+        CHECK(std::is_sorted(log.order.begin(), log.order.end()));
+
+        // 残りはキューの破棄時に全て破棄する
+        log.completed.store(UINT64_MAX);
+    }
+    CHECK(log.GetCount() == 10);
+    CHECK(log.early.load() == 0);
+}
+
+// 複数スレッドから預け，ワーカースレッドで破棄しても完了前には破棄しない
+TEST_CASE(DeferredReleaseQueue_ConcurrentRetireWithJobSystem) {
+    constexpr uint32_t kThreads   = 4;
+    constexpr uint32_t kPerThread = 1000;
+    constexpr uint64_t kFences    = 50;
+
+    JobSystem jobSystem;
+    CHECK(jobSystem.Init(3));
+    ReleaseLog log;
+    DeferredReleaseQueue queue;
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreads; t++) {
+        threads.emplace_back([&] {
+            for (uint32_t i = 0; i < kPerThread; i++) {
+                uint64_t fence = 1 + i % kFences;
+                queue.Retire(Tracked(log, fence), fence);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    CHECK(queue.GetPendingCount() == kThreads * kPerThread);
+
+    // 半分まで完了させる，ワーカーでの破棄は後から追いつく
+    for (uint64_t fence = 0; fence <= kFences / 2; fence++) {
+        Complete(queue, log, fence, &jobSystem);
+    }
+    CHECK(queue.GetPendingCount() == kThreads * kPerThread / 2);
+
+    // GPUの完了を待ってから全て破棄する
+    log.completed.store(UINT64_MAX);
+    queue.ReleaseAll();
+    CHECK(queue.GetPendingCount() == 0);
+    CHECK(log.GetCount() == kThreads * kPerThread);
+    CHECK(log.early.load() == 0);
+
+    // ReleaseAllの後も同じジョブシステムで使い続けられる
+    log.completed.store(0);
+    for (uint32_t i = 0; i < 100; i++) {
+        queue.Retire(Tracked(log, 100), 100);
+    }
+    Complete(queue, log, 99, &jobSystem);
+    CHECK(queue.GetPendingCount() == 100);
+    Complete(queue, log, 100, &jobSystem);
+    queue.ReleaseAll();
+    CHECK(log.GetCount() == kThreads * kPerThread + 100);
+    CHECK(log.early.load() == 0);
+    jobSystem.Term();
+}
@@ -0,0 +1,340 @@
+/// @file   DrawListTest.cpp
+/// @brief  DrawListのソートキー・基数ソート・バインドの省略の検証
+
+#include <d3d12.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Engine/Render/DrawList.h"
+#include "Tests/TestFramework.h"
+
+namespace /* anonymous */ {
+
+constexpr DrawList::RootSlots kSlots = { 0, 1, 2, 3, 4 };
+
+/// @brief コマンドリストの代わりに，現在バインドされている値を覚えておく
+/// 描画のたびに，その時点の状態をパケットと突き合わせられるようにする
+struct MockCommandList {
+    ID3D12PipelineState* pPSO                = nullptr;
+    D3D12_GPU_VIRTUAL_ADDRESS rootCBV[5]     = {};
+    D3D12_GPU_VIRTUAL_ADDRESS rootSRV[5]     = {};
+    D3D12_GPU_DESCRIPTOR_HANDLE rootTable[5] = {};
+    const void* pRootConstants[5]            = {};
+    D3D12_VERTEX_BUFFER_VIEW vbv             = {};
+    D3D12_INDEX_BUFFER_VIEW ibv              = {};
+
+    uint32_t setCount = 0;  // Draw以外の呼び出し回数
+    std::vector<uint32_t> drawnStartIndices;  // 描画した順のstartIndex
+
+    // 描画のたびに突き合わせるパケット（startIndexで引く）
+    std::vector<DrawPacket>* pPackets = nullptr;
+    uint32_t mismatchCount            = 0;  // 状態が合わなかった描画の数
+
+    void SetPipelineState(ID3D12PipelineState* p) {
+        pPSO = p;
+        setCount++;
+    }
+    void SetGraphicsRootConstantBufferView(
+        UINT slot, D3D12_GPU_VIRTUAL_ADDRESS address) {
+        rootCBV[slot] = address;
+        setCount++;
+    }
+    void SetGraphicsRootShaderResourceView(
+        UINT slot, D3D12_GPU_VIRTUAL_ADDRESS address) {
+        rootSRV[slot] = address;
+        setCount++;
+    }
+    void SetGraphicsRootDescriptorTable(
+        UINT slot, D3D12_GPU_DESCRIPTOR_HANDLE handle) {
+        rootTable[slot] = handle;
+        setCount++;
+    }
+    void SetGraphicsRoot32BitConstants(
+        UINT slot, UINT, const void* pData, UINT) {
+        pRootConstants[slot] = pData;
+        setCount++;
+    }
+    void IASetVertexBuffers(UINT, UINT, const D3D12_VERTEX_BUFFER_VIEW* p) {
+        vbv = *p;
+        setCount++;
+    }
+    void IASetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW* p) {
+        ibv = *p;
+        setCount++;
+    }
+    void DrawIndexedInstanced(UINT, UINT, UINT startIndex, INT, UINT) {
+        drawnStartIndices.push_back(startIndex);
+        if (pPackets && !Matches((*pPackets)[startIndex])) {
+            mismatchCount++;
+        }
+    }
+
+    /// @brief 現在の状態でパケットを正しく描画できるか
+    bool Matches(const DrawPacket& packet) const {
+        bool ok = pPSO == packet.pPSO &&
+                  rootCBV[kSlots.materialCB] == packet.materialCB &&
+                  rootTable[kSlots.textureTable].ptr ==
+                      packet.textureTable.ptr &&
+                  vbv.BufferLocation == packet.vbv.BufferLocation &&
+                  vbv.SizeInBytes == packet.vbv.SizeInBytes &&
+                  vbv.StrideInBytes == packet.vbv.StrideInBytes &&
+                  ibv.BufferLocation == packet.ibv.BufferLocation &&
+                  ibv.SizeInBytes == packet.ibv.SizeInBytes &&
+                  ibv.Format == packet.ibv.Format;
+        if (packet.instanceData != 0) {
+            ok = ok && rootSRV[kSlots.instanceData] == packet.instanceData;
+        } else {
+            ok = ok && rootCBV[kSlots.transformCB] == packet.transformCB;
+        }
+        if (packet.pMeshConstants != nullptr) {
+            ok = ok &&
+                 pRootConstants[kSlots.meshConstants] == packet.pMeshConstants;
+        }
+        return ok;
+    }
+};
+
+/// @brief 比較にだけ使うパイプラインステート（参照はしない）
+ID3D12PipelineState* FakePSO(uint32_t index) {
+    return reinterpret_cast<ID3D12PipelineState*>(
+        static_cast<uintptr_t>(0x1000 * (index + 1)));
+}
+
+/// @brief 描画順の確認用に，startIndexに追加順の番号を入れたパケット
+DrawPacket MakePacket(uint32_t index, uint64_t sortKey) {
+    DrawPacket packet        = {};
+    packet.sortKey           = sortKey;
+    packet.startIndex        = index;
+    packet.indexCount        = 3;
+    packet.instanceCount     = 1;
+    packet.vbv.SizeInBytes   = 1024;
+    packet.vbv.StrideInBytes = 32;
+    packet.ibv.SizeInBytes   = 256;
+    packet.ibv.Format        = DXGI_FORMAT_R16_UINT;
+    return packet;
+}
+
+/// @brief Sortした順（startIndexの列）
+std::vector<uint32_t> RecordOrder(const DrawList& drawList) {
+    MockCommandList cmdList;
+    DrawListStats stats;
+    drawList.Record(&cmdList, kSlots, stats);
+    return cmdList.drawnStartIndices;
+}
+
+}  // namespace
+
+//==============================================================
+// テスト
+//==============================================================
+
+// ソートキーのビット配置と，各フィールドの切り詰め
+TEST_CASE(DrawList_SortKeyLayout) {
+    // 最上位にパイプライン，最下位に深度
+    CHECK(DrawList::MakeSortKey(1, 0, 0, 0.0f) == 1ull << 60);
+    CHECK(DrawList::MakeSortKey(0, 1, 0, 0.0f) == 1ull << 36);
+    CHECK(DrawList::MakeSortKey(0, 0, 1, 0.0f) == 1ull << 16);
+    CHECK(DrawList::MakeSortKey(0, 0, 0, 1.0f) == 0xFFFFull);
+    CHECK(DrawList::MakeSortKey(15, 0xFFFFFF, 0xFFFFF, 1.0f) == ~0ull);
+
+    // 幅を超えた上位ビットは隣のフィールドに漏れない
+    CHECK(DrawList::MakeSortKey(0x12, 0, 0, 0.0f) ==
+          DrawList::MakeSortKey(0x2, 0, 0, 0.0f));
+    CHECK(DrawList::MakeSortKey(0, 0x1000001, 0, 0.0f) ==
+          DrawList::MakeSortKey(0, 1, 0, 0.0f));
+    CHECK(DrawList::MakeSortKey(0, 0, 0x100003, 0.0f) ==
+          DrawList::MakeSortKey(0, 0, 3, 0.0f));
+
+    // 深度は0～1に丸め，手前ほど小さい
+    CHECK(DrawList::MakeSortKey(0, 0, 0, -1.0f) == 0);
+    CHECK(DrawList::MakeSortKey(0, 0, 0, 2.0f) == 0xFFFFull);
+    CHECK(DrawList::MakeSortKey(0, 0, 0, 0.25f) <
+          DrawList::MakeSortKey(0, 0, 0, 0.5f));
+
+    // 上位のフィールドが優先される
+    CHECK(DrawList::MakeSortKey(0, 5, 0xFFFFF, 1.0f) <
+          DrawList::MakeSortKey(0, 6, 0, 0.0f));
+    CHECK(DrawList::MakeSortKey(0, 0xFFFFFF, 0, 0.0f) <
+          DrawList::MakeSortKey(1, 0, 0, 0.0f));
+}
+
+// 基数ソートの結果がstd::stable_sortと同じ（同じキーは追加順のまま）
+TEST_CASE(DrawList_RadixSortMatchesStableSort) {
+    std::mt19937_64 rng(5);
+    for (uint32_t count : { 0u, 1u, 2u, 255u, 256u, 257u, 10000u }) {
+        DrawList drawList;
+        std::vector<std::pair<uint64_t, uint32_t>> expected;
+        for (uint32_t i = 0; i < count; i++) {
+            // 全ビットの乱数と，重複の多いキーを混ぜる
+            uint64_t key = (i % 2 == 0) ? rng()
+                                        : DrawList::MakeSortKey(rng() % 3,
+                                              rng() % 4, rng() % 5, 0.5f);
+            drawList.Add(MakePacket(i, key));
+            expected.push_back({ key, i });
+        }
+        std::stable_sort(expected.begin(), expected.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        drawList.Sort();
+        std::vector<uint32_t> order = RecordOrder(drawList);
+        CHECK(order.size() == count);
+        bool same = order.size() == count;
+        for (uint32_t i = 0; same && i < count; i++) {
+            same = order[i] == expected[i].second;
+        }
+        CHECK(same);
+    }
+
+    // 全て同じキーなら追加順のまま（全桁を飛ばす経路）
+    DrawList drawList;
+    for (uint32_t i = 0; i < 100; i++) {
+        drawList.Add(MakePacket(i, 0x1234));
+    }
+    drawList.Sort();
+    std::vector<uint32_t> order = RecordOrder(drawList);
+    CHECK(std::is_sorted(order.begin(), order.end()) && order.size() == 100);
+}
+
+// 同じ値のバインドを省略し，どの描画でも必要な値がバインドされている
+TEST_CASE(DrawList_ElidesRedundantBinds) {
+    const uint32_t meshConstants[4] = {};
+
+    // 同じパイプライン・マテリアル・メッシュの4個と，インスタンス描画
+    std::vector<DrawPacket> packets;
+    for (uint32_t i = 0; i < 6; i++) {
+        DrawPacket packet         = MakePacket(i, i);
+        packet.pPSO               = FakePSO(0);
+        packet.materialCB         = 0x1000;
+        packet.textureTable.ptr   = 0x2000;
+        packet.vbv.BufferLocation = 0x3000;
+        packet.ibv.BufferLocation = 0x4000;
+        packet.transformCB        = 0x5000 + 256 * i;
+        packets.push_back(packet);
+    }
+    // 4,5はインスタンス描画で，同じ列を指す
+    packets[4].instanceData = 0x6000;
+    packets[5].instanceData = 0x6000;
+    // 5だけ別のマテリアルとメッシュ定数
+    packets[5].materialCB        = 0x1100;
+    packets[5].pMeshConstants    = meshConstants;
+    packets[5].meshConstantCount = 4;
+
+    DrawList drawList;
+    for (const DrawPacket& packet : packets) {
+        drawList.Add(packet);
+    }
+    drawList.Sort();
+
+    MockCommandList cmdList;
+    cmdList.pPackets = &packets;
+    DrawListStats stats;
+    drawList.Record(&cmdList, kSlots, stats);
+
+    CHECK(cmdList.mismatchCount == 0);
+    CHECK(stats.drawCalls == 6);
+    // 1回目：PSO・ワールド行列・マテリアル・テーブル・VB・IBの6個
+    // 2～4回目：ワールド行列だけ（他の5個は省略）
+    // 5回目：インスタンスの列だけ
+    // 6回目：マテリアルとメッシュ定数（インスタンスの列は同じなので省略）
+    CHECK(stats.bindsIssued == 6 + 3 + 1 + 2);
+    CHECK(stats.bindsElided == 0 + 3 * 5 + 5 + 5);
+    CHECK(cmdList.setCount == stats.bindsIssued);
+}
+
+// 乱数で作った1万個のパケットでも，省略した結果の状態が常に正しい
+TEST_CASE(DrawList_ElisionKeepsStateCorrect) {
+    constexpr uint32_t kCount = 10000;
+    const uint32_t meshConstants[4][4] = {};
+    std::mt19937 rng(11);
+
+    std::vector<DrawPacket> packets;
+    for (uint32_t i = 0; i < kCount; i++) {
+        const uint32_t pipeline = rng() % 3;
+        const uint32_t material = rng() % 40;
+        const uint32_t mesh     = rng() % 12;
+        const float depth       = (rng() % 1000) / 1000.0f;
+
+        DrawPacket packet = MakePacket(i,
+            DrawList::MakeSortKey(pipeline, material, mesh, depth));
+        packet.pPSO               = FakePSO(pipeline);
+        packet.materialCB         = 0x10000 + 256 * material;
+        packet.textureTable.ptr   = 0x20000 + 32 * material;
+        packet.vbv.BufferLocation = 0x30000 + 4096 * mesh;
+        packet.ibv.BufferLocation = 0x40000 + 4096 * mesh;
+        packet.ibv.Format =
+            mesh % 2 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+        if (i % 4 == 0) {
+            packet.instanceData  = 0x50000 + 256 * mesh;
+            packet.instanceCount = 8;
+        } else {
+            packet.transformCB = 0x60000 + 256 * i;
+        }
+        if (mesh % 3 == 0) {
+            packet.pMeshConstants    = meshConstants[mesh % 4];
+            packet.meshConstantCount = 4;
+        }
+        packets.push_back(packet);
+    }
+
+    DrawList drawList;
+    for (const DrawPacket& packet : packets) {
+        drawList.Add(packet);
+    }
+    drawList.Sort();
+
+    MockCommandList cmdList;
+    cmdList.pPackets = &packets;
+    DrawListStats stats;
+    drawList.Record(&cmdList, kSlots, stats);
+
+    std::printf("  %u draws: %u binds issued, %u elided\n", stats.drawCalls,
+        stats.bindsIssued, stats.bindsElided);
+    CHECK(cmdList.mismatchCount == 0);
+    CHECK(stats.drawCalls == kCount);
+    CHECK(cmdList.setCount == stats.bindsIssued);
+    // PSOは3回，マテリアルは高々3*40回しか切り替わらない
+    CHECK(stats.bindsElided > stats.bindsIssued);
+}
+
+//==============================================================
+// 計測
+//==============================================================
+
+// 1万個のパケットの基数ソートとstd::sortの比較
+BENCHMARK_CASE(DrawList_Sort10k) {
+    constexpr uint32_t kCount = 10000;
+    constexpr int kRepeat     = 200;
+    std::mt19937 rng(12);
+
+    DrawList drawList;
+    std::vector<uint64_t> keys;
+    for (uint32_t i = 0; i < kCount; i++) {
+        uint64_t key = DrawList::MakeSortKey(rng() % 4, rng() % 500,
+            rng() % 2000, (rng() % 1000) / 1000.0f);
+        drawList.Add(MakePacket(i, key));
+        keys.push_back(key);
+    }
+
+    double radixMs = 1e30;
+    double stdMs   = 1e30;
+    for (int repeat = 0; repeat < kRepeat; repeat++) {
+        Stopwatch radixWatch;
+        drawList.Sort();
+        radixMs = std::min(radixMs, radixWatch.GetElapsedMs());
+
+        std::vector<std::pair<uint64_t, uint32_t>> entries;
+        entries.reserve(kCount);
+        for (uint32_t i = 0; i < kCount; i++) {
+            entries.push_back({ keys[i], i });
+        }
+        Stopwatch stdWatch;
+        std::sort(entries.begin(), entries.end());
+        stdMs = std::min(stdMs, stdWatch.GetElapsedMs());
+    }
+    std::printf("  %u packets: radix %.1f us, std::sort %.1f us\n", kCount,
+        radixMs * 1000.0, stdMs * 1000.0);
+}
@@ -0,0 +1,259 @@
+/// @file   FrustumCullerTest.cpp
+/// @brief  FrustumCullerの平面・AABB判定と，1万オブジェクトの処理時間
+
+#include <DirectXCollision.h>
+#include <DirectXMath.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "Engine/Render/FrustumCuller.h"
+#include "Tests/TestFramework.h"
+
+using namespace DirectX;
+
+namespace /* anonymous */ {
+
+constexpr float kNear = 1.0f;
+constexpr float kFar  = 100.0f;
+
+/// @brief 原点から+Zを向く，画角90度・縦横比1のビュー射影行列
+XMMATRIX MakeViewProjection() {
+    XMMATRIX view = XMMatrixLookToLH(XMVectorZero(),
+        XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f),
+        XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+    XMMATRIX proj = XMMatrixPerspectiveFovLH(XM_PIDIV2, 1.0f, kNear, kFar);
+    return XMMatrixMultiply(view, proj);
+}
+
+bool NearlyEqual(float a, float b, float tolerance = 1e-5f) {
+    return std::fabs(a - b) <= tolerance;
+}
+
+/// @brief 8頂点をワールド空間に写したAABBと平面の距離の最小値（倍精度）
+/// 正なら全ての平面の内側，負ならどれかの平面の外側
+double ReferenceDistance(const FrustumCuller& culler,
+    const BoundingBox& bounds, const XMMATRIX& world) {
+    double minCorner[3] = { 1e30, 1e30, 1e30 };
+    double maxCorner[3] = { -1e30, -1e30, -1e30 };
+    for (int corner = 0; corner < 8; corner++) {
+        XMFLOAT3 local = {
+            bounds.Center.x + ((corner & 1) ? 1 : -1) * bounds.Extents.x,
+            bounds.Center.y + ((corner & 2) ? 1 : -1) * bounds.Extents.y,
+            bounds.Center.z + ((corner & 4) ? 1 : -1) * bounds.Extents.z,
+        };
+        XMFLOAT3 p;
+        XMStoreFloat3(&p, XMVector3Transform(XMLoadFloat3(&local), world));
+        const double v[3] = { p.x, p.y, p.z };
+        for (int k = 0; k < 3; k++) {
+            minCorner[k] = std::min(minCorner[k], v[k]);
+            maxCorner[k] = std::max(maxCorner[k], v[k]);
+        }
+    }
+
+    // 法線方向に最も進んだ頂点（p-vertex）の符号付き距離
+    double minDistance = 1e30;
+    for (uint32_t i = 0; i < FrustumCuller::kPlaneCount; i++) {
+        const XMFLOAT4& plane = culler.GetPlane(i);
+        const double n[3]     = { plane.x, plane.y, plane.z };
+        double distance       = plane.w;
+        for (int k = 0; k < 3; k++) {
+            distance += n[k] * (n[k] >= 0.0 ? maxCorner[k] : minCorner[k]);
+        }
+        minDistance = std::min(minDistance, distance);
+    }
+    return minDistance;
+}
+
+/// @brief 乱数で置いたオブジェクトのワールド行列
+std::vector<XMMATRIX> MakeRandomWorlds(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-150.0f, 150.0f);
+    std::uniform_real_distribution<float> angle(-XM_PI, XM_PI);
+    std::uniform_real_distribution<float> scale(0.2f, 8.0f);
+
+    std::vector<XMMATRIX> worlds;
+    worlds.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        XMMATRIX s = XMMatrixScaling(scale(rng), scale(rng), scale(rng));
+        XMVECTOR q = XMQuaternionRotationRollPitchYaw(
+            angle(rng), angle(rng), angle(rng));
+        XMMATRIX r = XMMatrixRotationQuaternion(q);
+        XMMATRIX t =
+            XMMatrixTranslation(position(rng), position(rng), position(rng));
+        worlds.push_back(s * r * t);
+    }
+    return worlds;
+}
+
+}  // namespace
+
+//==============================================================
+// テスト
+//==============================================================
+
+// ビュー射影行列から内向きの正規化された6平面を取り出す
+TEST_CASE(FrustumCuller_ExtractsPlanes) {
+    FrustumCuller culler;
+    culler.SetViewProjection(MakeViewProjection());
+
+    // 画角90度なので左右上下の平面は45度傾く
+    const float h             = std::sqrt(0.5f);
+    const XMFLOAT4 expected[] = {
+        { h, 0.0f, h, 0.0f },          // 左
+        { -h, 0.0f, h, 0.0f },         // 右
+        { 0.0f, h, h, 0.0f },          // 下
+        { 0.0f, -h, h, 0.0f },         // 上
+        { 0.0f, 0.0f, 1.0f, -kNear },  // 手前
+        { 0.0f, 0.0f, -1.0f, kFar },   // 奥
+    };
+    for (uint32_t i = 0; i < FrustumCuller::kPlaneCount; i++) {
+        const XMFLOAT4& plane = culler.GetPlane(i);
+        CHECK(NearlyEqual(plane.x, expected[i].x));
+        CHECK(NearlyEqual(plane.y, expected[i].y));
+        CHECK(NearlyEqual(plane.z, expected[i].z));
+        CHECK(NearlyEqual(plane.w, expected[i].w, 1e-3f));
+    }
+}
+
+// 内側・外側・平面をまたぐAABBの判定
+TEST_CASE(FrustumCuller_ClassifiesBoxes) {
+    FrustumCuller culler;
+    culler.SetViewProjection(MakeViewProjection());
+
+    const BoundingBox unit({ 0.0f, 0.0f, 0.0f }, { 0.5f, 0.5f, 0.5f });
+    struct Case {
+        XMFLOAT3 position;
+        bool visible;
+    };
+    const Case cases[] = {
+        { { 0.0f, 0.0f, 10.0f }, true },     // 正面
+        { { 0.0f, 0.0f, -10.0f }, false },   // 背後
+        { { 0.0f, 0.0f, 0.8f }, true },      // 手前の平面をまたぐ
+        { { 0.0f, 0.0f, 0.2f }, false },     // 手前の平面より手前
+        { { 0.0f, 0.0f, 100.3f }, true },    // 奥の平面をまたぐ
+        { { 0.0f, 0.0f, 101.0f }, false },   // 奥の平面より奥
+        { { -10.5f, 0.0f, 10.0f }, true },   // 左の平面をまたぐ
+        { { -12.0f, 0.0f, 10.0f }, false },  // 左の外
+        { { 0.0f, 12.0f, 10.0f }, false },   // 上の外
+        { { 0.0f, -10.6f, 10.0f }, true },   // 下の平面をまたぐ
+        { { 12.0f, 12.0f, 10.0f }, false },  // 右上の外
+    };
+
+    std::vector<uint32_t> expected;
+    for (const Case& c : cases) {
+        uint32_t index = culler.Add(unit,
+            XMMatrixTranslation(c.position.x, c.position.y, c.position.z));
+        if (c.visible) {
+            expected.push_back(index);
+        }
+    }
+    CHECK(culler.Size() == std::size(cases));
+    CHECK(culler.Cull() == expected);
+
+    // 回転とスケールで広がったAABBも判定に含める
+    // 左の外にある細長い箱を45度回すと，視錐台に入る
+    culler.Clear();
+    const BoundingBox thin({ 0.0f, 0.0f, 0.0f }, { 4.0f, 0.1f, 0.1f });
+    culler.Add(thin, XMMatrixTranslation(-15.0f, 0.0f, 10.0f));
+    culler.Add(thin, XMMatrixRotationY(XM_PIDIV4) *
+                         XMMatrixTranslation(-15.0f, 0.0f, 12.0f));
+    const std::vector<uint32_t>& visible = culler.Cull();
+    CHECK(visible.size() == 1 && visible[0] == 1);
+}
+
+// 4の倍数でない登録数でも，詰め物の番号を結果に含めない
+TEST_CASE(FrustumCuller_IgnoresPadding) {
+    FrustumCuller culler;
+    culler.SetViewProjection(MakeViewProjection());
+    CHECK(culler.Cull().empty());
+
+    const BoundingBox unit({ 0.0f, 0.0f, 0.0f }, { 0.5f, 0.5f, 0.5f });
+    for (uint32_t count = 1; count <= 9; count++) {
+        culler.Clear();
+        for (uint32_t i = 0; i < count; i++) {
+            culler.Add(unit, XMMatrixTranslation(0.0f, 0.0f, 5.0f + i));
+        }
+        const std::vector<uint32_t>& visible = culler.Cull();
+        CHECK(visible.size() == count);
+        for (uint32_t i = 0; i < visible.size(); i++) {
+            CHECK(visible[i] == i);
+        }
+    }
+}
+
+// 8頂点から作ったAABBの倍精度の判定と一致する（境界付近は除く）
+TEST_CASE(FrustumCuller_MatchesReference) {
+    constexpr size_t kCount   = 10000;
+    constexpr double kEpsilon = 1e-3;
+
+    FrustumCuller culler;
+    culler.SetViewProjection(MakeViewProjection());
+    const BoundingBox bounds({ 0.2f, -0.1f, 0.3f }, { 1.0f, 0.5f, 2.0f });
+    const std::vector<XMMATRIX> worlds = MakeRandomWorlds(kCount, 7);
+    for (const XMMATRIX& world : worlds) {
+        culler.Add(bounds, world);
+    }
+    const std::vector<uint32_t>& visible = culler.Cull();
+    std::vector<bool> isVisible(kCount, false);
+    for (uint32_t index : visible) {
+        isVisible[index] = true;
+    }
+
+    uint32_t mismatches  = 0;
+    uint32_t insideCount = 0;
+    for (size_t i = 0; i < kCount; i++) {
+        const double distance = ReferenceDistance(culler, bounds, worlds[i]);
+        if (distance > kEpsilon) {
+            insideCount++;
+            mismatches += isVisible[i] ? 0 : 1;
+        } else if (distance < -kEpsilon) {
+            mismatches += isVisible[i] ? 1 : 0;
+        }
+    }
+    std::printf("  %zu visible of %zu (reference %u)\n", visible.size(),
+        kCount, insideCount);
+    CHECK(insideCount > 0 && insideCount < kCount);
+    CHECK(mismatches == 0);
+    CHECK(std::is_sorted(visible.begin(), visible.end()));
+}
+
+//==============================================================
+// 計測
+//==============================================================
+
+// 1万オブジェクトの登録と判定にかかる時間
+BENCHMARK_CASE(FrustumCuller_Cull10k) {
+    constexpr size_t kCount = 10000;
+    constexpr int kRepeat   = 200;
+
+    const BoundingBox bounds({ 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f });
+    const std::vector<XMMATRIX> worlds = MakeRandomWorlds(kCount, 8);
+    const XMMATRIX viewProj            = MakeViewProjection();
+
+    FrustumCuller culler;
+    double bestAddMs  = 1e30;
+    double bestCullMs = 1e30;
+    size_t visible    = 0;
+    for (int repeat = 0; repeat < kRepeat; repeat++) {
+        Stopwatch addWatch;
+        culler.Clear();
+        culler.SetViewProjection(viewProj);
+        for (const XMMATRIX& world : worlds) {
+            culler.Add(bounds, world);
+        }
+        bestAddMs = std::min(bestAddMs, addWatch.GetElapsedMs());
+
+        Stopwatch cullWatch;
+        visible    = culler.Cull().size();
+        bestCullMs = std::min(bestCullMs, cullWatch.GetElapsedMs());
+    }
+    std::printf("  %zu objects, %zu visible: add %.1f us, cull %.1f us "
+                "(%.1f M objects/s)\n",
+        kCount, visible, bestAddMs * 1000.0, bestCullMs * 1000.0,
+        kCount / bestCullMs / 1000.0);
+}
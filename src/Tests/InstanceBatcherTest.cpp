@@ -0,0 +1,200 @@
+/// @file   InstanceBatcherTest.cpp
+/// @brief  InstanceBatcherのグループ分けとワールド行列の詰め込みの検証
+
+#include <DirectXMath.h>
+
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Render/InstanceBatcher.h"
+#include "Engine/Shader/ShaderConstants.h"
+#include "Tests/TestFramework.h"
+
+using namespace DirectX;
+
+namespace /* anonymous */ {
+
+using Group = InstanceBatcher::Group;
+
+/// @brief 成分ごとに異なる値を持つ行列の列（転置を見分けられるようにする）
+std::vector<XMFLOAT4X4> MakeMatrices(size_t count, float base) {
+    std::vector<XMFLOAT4X4> matrices(count);
+    for (size_t i = 0; i < count; i++) {
+        for (int k = 0; k < 16; k++) {
+            matrices[i].m[k / 4][k % 4] = base + i * 16.0f + k;
+        }
+    }
+    return matrices;
+}
+
+/// @brief 書き込まれた定数が元の行列と一致するか
+/// worldは転置，worldInverseはそのまま
+bool IsPacked(const shader::TransformConstants& tc, const XMFLOAT4X4& world,
+    const XMFLOAT4X4& inverse) {
+    for (int row = 0; row < 4; row++) {
+        for (int col = 0; col < 4; col++) {
+            if (tc.world.m[row][col] != world.m[col][row] ||
+                tc.worldInverse.m[row][col] != inverse.m[row][col]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/// @brief 全てのグループの範囲が重ならず，全ての要素をちょうど1回覆うか
+bool CoversEveryEntry(const InstanceBatcher& batcher) {
+    const size_t entryCount = batcher.GetEntries().size();
+    std::vector<int> covered(entryCount, 0);
+    uint32_t nextInstance = 0;
+    for (const Group& group : batcher.GetGroups()) {
+        for (uint32_t i = 0; i < group.entryCount; i++) {
+            covered[group.firstEntry + i]++;
+        }
+        // インスタンスバッファの位置はグループの順に連続する
+        if (group.firstInstance != InstanceBatcher::kNotInstanced) {
+            if (group.firstInstance != nextInstance) {
+                return false;
+            }
+            nextInstance += group.entryCount;
+        }
+    }
+    for (int c : covered) {
+        if (c != 1) {
+            return false;
+        }
+    }
+    return nextInstance == batcher.GetInstanceCount();
+}
+
+}  // namespace
+
+//==============================================================
+// テスト
+//==============================================================
+
+// 同じキーをまとめ，少ないグループは要素ごとに描画する
+TEST_CASE(InstanceBatcher_GroupsByKey) {
+    const uint64_t keys[] = { 5, 1, 5, 5, 2, 1, 9, 5, 2, 3 };
+    const size_t count    = std::size(keys);
+    const std::vector<XMFLOAT4X4> worlds   = MakeMatrices(count, 0.0f);
+    const std::vector<XMFLOAT4X4> inverses = MakeMatrices(count, 1000.0f);
+
+    InstanceBatcher batcher;
+    for (uint32_t i = 0; i < count; i++) {
+        batcher.Add(keys[i], 100 + i, i);
+    }
+    std::vector<shader::TransformConstants> out(count);
+    batcher.Build(2, worlds, inverses, out.data(), uint32_t(count));
+
+    // キー順に並び，同じキーの中は追加順
+    const uint32_t expectedItems[] = { 101, 105, 104, 108, 109, 100, 102, 103,
+        107, 106 };
+    const std::vector<InstanceBatcher::Entry>& entries = batcher.GetEntries();
+    for (size_t i = 0; i < count; i++) {
+        CHECK(entries[i].itemIndex == expectedItems[i]);
+    }
+
+    // キー1(2個)・2(2個)・5(4個)はインスタンス描画，3と9は単体
+    const std::vector<Group>& groups = batcher.GetGroups();
+    CHECK(groups.size() == 5);
+    CHECK(groups[0].firstEntry == 0 && groups[0].entryCount == 2 &&
+          groups[0].firstInstance == 0);
+    CHECK(groups[1].firstEntry == 2 && groups[1].entryCount == 2 &&
+          groups[1].firstInstance == 2);
+    CHECK(groups[2].firstEntry == 4 && groups[2].entryCount == 1 &&
+          groups[2].firstInstance == InstanceBatcher::kNotInstanced);
+    CHECK(groups[3].firstEntry == 5 && groups[3].entryCount == 4 &&
+          groups[3].firstInstance == 4);
+    CHECK(groups[4].firstEntry == 9 && groups[4].entryCount == 1 &&
+          groups[4].firstInstance == InstanceBatcher::kNotInstanced);
+    CHECK(batcher.GetInstanceCount() == 8);
+    CHECK(CoversEveryEntry(batcher));
+
+    // インスタンスの位置には，その要素の行列が書き込まれる
+    for (const Group& group : groups) {
+        if (group.firstInstance == InstanceBatcher::kNotInstanced) {
+            continue;
+        }
+        for (uint32_t i = 0; i < group.entryCount; i++) {
+            uint32_t data = entries[group.firstEntry + i].dataIndex;
+            CHECK(IsPacked(out[group.firstInstance + i], worlds[data],
+                inverses[data]));
+        }
+    }
+}
+
+// 容量に収まらないグループや書き込み先がない場合は要素ごとに描画する
+TEST_CASE(InstanceBatcher_FallsBackWhenFull) {
+    const uint64_t keys[] = { 5, 1, 5, 5, 2, 1, 9, 5, 2, 3 };
+    const size_t count    = std::size(keys);
+    const std::vector<XMFLOAT4X4> worlds   = MakeMatrices(count, 0.0f);
+    const std::vector<XMFLOAT4X4> inverses = MakeMatrices(count, 1000.0f);
+
+    InstanceBatcher batcher;
+    for (uint32_t i = 0; i < count; i++) {
+        batcher.Add(keys[i], i, i);
+    }
+
+    // 容量6：キー1と2で4個使い，キー5の4個は入らない
+    std::vector<shader::TransformConstants> out(6);
+    batcher.Build(2, worlds, inverses, out.data(), 6);
+    CHECK(batcher.GetInstanceCount() == 4);
+    CHECK(batcher.GetGroups().size() == 2 + 1 + 4 + 1);
+    CHECK(CoversEveryEntry(batcher));
+
+    // 書き込み先がなければ全て単体
+    batcher.Build(2, worlds, inverses, nullptr, 0);
+    CHECK(batcher.GetInstanceCount() == 0);
+    CHECK(batcher.GetGroups().size() == count);
+    CHECK(CoversEveryEntry(batcher));
+
+    // minInstancesを大きくすれば全て単体
+    batcher.Build(5, worlds, inverses, out.data(), 6);
+    CHECK(batcher.GetInstanceCount() == 0);
+    CHECK(batcher.GetGroups().size() == count);
+
+    // Clearの後は空
+    batcher.Clear();
+    batcher.Build(2, worlds, inverses, out.data(), 6);
+    CHECK(batcher.GetGroups().empty() && batcher.GetEntries().empty());
+}
+
+// 並列に書き込んでも逐次と同じ結果になる
+TEST_CASE(InstanceBatcher_ParallelPackingMatchesSerial) {
+    constexpr uint32_t kCount = 5000;
+    const std::vector<XMFLOAT4X4> worlds   = MakeMatrices(kCount, 0.0f);
+    const std::vector<XMFLOAT4X4> inverses = MakeMatrices(kCount, 1e5f);
+
+    std::mt19937 rng(3);
+    InstanceBatcher serial, parallel;
+    for (uint32_t i = 0; i < kCount; i++) {
+        uint64_t key  = rng() % 1500;  // 平均3個強，単体と混ざる
+        uint32_t data = rng() % kCount;
+        serial.Add(key, i, data);
+        parallel.Add(key, i, data);
+    }
+
+    JobSystem jobSystem;
+    CHECK(jobSystem.Init(3));
+    std::vector<shader::TransformConstants> serialOut(kCount);
+    std::vector<shader::TransformConstants> parallelOut(kCount);
+    serial.Build(4, worlds, inverses, serialOut.data(), kCount);
+    parallel.Build(4, worlds, inverses, parallelOut.data(), kCount,
+        &jobSystem);
+    jobSystem.Term();
+
+    const uint32_t instanceCount = serial.GetInstanceCount();
+    std::printf("  %u entries, %zu draws, %u instanced\n", kCount,
+        serial.GetGroups().size(), instanceCount);
+    CHECK(instanceCount > 0);
+    CHECK(parallel.GetInstanceCount() == instanceCount);
+    CHECK(parallel.GetGroups().size() == serial.GetGroups().size());
+    CHECK(std::memcmp(serialOut.data(), parallelOut.data(),
+              instanceCount * sizeof(shader::TransformConstants)) == 0);
+    CHECK(CoversEveryEntry(parallel));
+}
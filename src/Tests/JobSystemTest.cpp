@@ -0,0 +1,120 @@
+/// @file   JobSystemTest.cpp
+/// @brief  JobSystem::ParallelForの分担とスレッド数ごとの速度
+
+#include <DirectXMath.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <vector>
+
+#include "Engine/Core/EngineConfig.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Scene/Transform.h"
+#include "Tests/TestFramework.h"
+
+using namespace DirectX;
+
+namespace /* anonymous */ {
+
+/// @brief 計測するスレッド数（呼び出し元を含む）
+constexpr uint32_t kThreadCounts[] = { 1, 2, 4, 8, 16 };
+
+/// @brief ライトを分割するときの1ジョブあたりの数（以前の並列化と同じ）
+constexpr uint32_t kLightsPerJob = 16;
+
+/// @brief count個のワールド行列と逆行列をgrainSizeずつ並列に計算する
+/// @return 1回あたりの最短時間（マイクロ秒）
+double MeasureParallelFor(JobSystem& jobSystem, uint32_t count,
+    uint32_t grainSize, int repeat) {
+    std::vector<Transform> transforms(count);
+    for (uint32_t i = 0; i < count; i++) {
+        transforms[i].SetPosition({ float(i), 0.0f, 1.0f });
+        transforms[i].SetRotation(float(i % 360), 30.0f, 0.0f);
+    }
+    std::vector<XMFLOAT4X4> worlds(count), inverses(count);
+
+    double bestMs = 1e30;
+    for (int r = 0; r < repeat; r++) {
+        Stopwatch stopwatch;
+        jobSystem.ParallelFor(count, grainSize, [&](uint32_t b, uint32_t e) {
+            for (uint32_t i = b; i < e; i++) {
+                XMMATRIX world, inverse;
+                transforms[i].CalcWorldAndInverse(world, inverse);
+                XMStoreFloat4x4(&worlds[i], world);
+                XMStoreFloat4x4(&inverses[i], inverse);
+            }
+        });
+        bestMs = std::min(bestMs, stopwatch.GetElapsedMs());
+    }
+    return bestMs * 1000.0;
+}
+
+}  // namespace
+
+//==============================================================
+// テスト
+//==============================================================
+
+// 全ての要素をちょうど1回ずつ処理する（入れ子のParallelForを含む）
+TEST_CASE(JobSystem_ParallelForCoversEachIndexOnce) {
+    JobSystem jobSystem;
+    CHECK(jobSystem.Init(3));
+
+    constexpr uint32_t kOuter = 37;
+    constexpr uint32_t kInner = 1000;
+    std::vector<std::atomic<uint32_t>> visits(kOuter * kInner);
+    jobSystem.ParallelFor(kOuter, 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t outer = begin; outer < end; outer++) {
+            jobSystem.ParallelFor(kInner, 64, [&](uint32_t b, uint32_t e) {
+                for (uint32_t i = b; i < e; i++) {
+                    visits[outer * kInner + i].fetch_add(1);
+                }
+            });
+        }
+    });
+
+    uint32_t wrong = 0;
+    for (const std::atomic<uint32_t>& visit : visits) {
+        wrong += visit.load() != 1 ? 1 : 0;
+    }
+    CHECK(wrong == 0);
+    jobSystem.Term();
+}
+
+//==============================================================
+// 計測
+//==============================================================
+
+// スレッド数ごとの所要時間
+// オブジェクト数（kMaxObjects）と，ライト数（kMaxLights）の小さな処理を比べる
+BENCHMARK_CASE(JobSystem_Scaling) {
+    std::printf(
+        "  hardware threads: %u\n", std::thread::hardware_concurrency());
+    std::printf("  threads  objects us  speedup  lights us  speedup\n");
+
+    double objectsBase = 0.0;
+    double lightsBase  = 0.0;
+    for (uint32_t threads : kThreadCounts) {
+        JobSystem jobSystem;
+        if (threads > 1) {
+            jobSystem.Init(threads - 1);
+        }
+
+        const double objectsUs = MeasureParallelFor(jobSystem,
+            config::kMaxObjects, config::kObjectsPerJob, 200);
+        const double lightsUs  = MeasureParallelFor(
+            jobSystem, config::kMaxLights, kLightsPerJob, 2000);
+        if (threads == 1) {
+            objectsBase = objectsUs;
+            lightsBase  = lightsUs;
+        }
+        std::printf("  %7u  %10.1f  %6.2fx  %9.2f  %6.2fx\n", threads,
+            objectsUs, objectsBase / objectsUs, lightsUs,
+            lightsBase / lightsUs);
+
+        if (threads > 1) {
+            jobSystem.Term();
+        }
+    }
+}
@@ -0,0 +1,136 @@
+/// @file   LinearUploadAllocatorTest.cpp
+/// @brief  LinearUploadAllocatorのアライメント・追加ページ・作り直しの検証
+/// WARPデバイスで実際のアップロードヒープを作って確認する
+
+#include <d3d12.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "Engine/Graphics/LinearUploadAllocator.h"
+#include "Tests/TestDevice.h"
+#include "Tests/TestFramework.h"
+
+namespace /* anonymous */ {
+
+constexpr size_t kPageAlignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+
+size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/// @brief CPU側・GPU側のアドレスが両方ともalignmentに揃っているか
+bool IsAligned(const UploadAllocation& allocation, size_t alignment) {
+    return reinterpret_cast<uintptr_t>(allocation.pCPU) % alignment == 0 &&
+           allocation.gpuAddress % alignment == 0;
+}
+
+}  // namespace
+
+//==============================================================
+// テスト
+//==============================================================
+
+// 容量はページ単位に切り上げ，割り当ては指定したアライメントに揃う
+TEST_CASE(LinearUploadAllocator_AlignsAllocations) {
+    ID3D12Device* pDevice = GetWarpDevice();
+    CHECK(pDevice != nullptr);
+    if (pDevice == nullptr) return;
+
+    LinearUploadAllocator allocator;
+    CHECK(!allocator.Init(pDevice, 0));
+    CHECK(allocator.Init(pDevice, 1000));
+    CHECK(allocator.GetCapacity() == kPageAlignment);
+
+    // 既定は定数バッファのアライメント（256）
+    UploadAllocation a = allocator.Allocate(100);
+    UploadAllocation b = allocator.Allocate(16, 16);
+    UploadAllocation c = allocator.Allocate(128);
+    UploadAllocation d = allocator.Allocate(1, 4096);
+    CHECK(a.IsValid() && b.IsValid() && c.IsValid() && d.IsValid());
+    CHECK(IsAligned(a, 256) && IsAligned(b, 16) && IsAligned(c, 256) &&
+          IsAligned(d, 4096));
+    CHECK(b.gpuAddress == a.gpuAddress + 112);
+    CHECK(c.gpuAddress == a.gpuAddress + 256);
+    CHECK(d.gpuAddress == a.gpuAddress + 4096);
+    // CPU側とGPU側のオフセットは同じ
+    CHECK(static_cast<uint8_t*>(c.pCPU) - static_cast<uint8_t*>(a.pCPU) ==
+          256);
+
+    // 詰め物を含めた使用量
+    CHECK(allocator.GetUsedBytes() == 4097);
+    CHECK(allocator.GetOverflowPageCount() == 0);
+
+    // 大きさ0は無効
+    CHECK(!allocator.Allocate(0).IsValid());
+
+    // Pushは書き込んだ値を読み戻せる（マップしたままのメモリ）
+    struct Data {
+        float v[4];
+    };
+    const Data data         = { { 1.0f, 2.0f, 3.0f, 4.0f } };
+    UploadAllocation pushed = allocator.Push(data);
+    CHECK(pushed.IsValid() && IsAligned(pushed, 256));
+    CHECK(std::memcmp(pushed.pCPU, &data, sizeof(data)) == 0);
+
+    // Resetで先頭に戻る
+    allocator.Reset();
+    CHECK(allocator.GetUsedBytes() == 0);
+    CHECK(allocator.Allocate(64).gpuAddress == a.gpuAddress);
+}
+
+// 容量を超えたら追加ページで割り当てを続け，Resetで1.5倍に作り直す
+TEST_CASE(LinearUploadAllocator_OverflowAndRegrow) {
+    ID3D12Device* pDevice = GetWarpDevice();
+    CHECK(pDevice != nullptr);
+    if (pDevice == nullptr) return;
+
+    LinearUploadAllocator allocator;
+    CHECK(allocator.Init(pDevice, kPageAlignment));
+
+    // 1ページ分（256個）の後の割り当ては追加ページに入る
+    std::vector<UploadAllocation> allocations;
+    for (int i = 0; i < 300; i++) {
+        UploadAllocation allocation = allocator.Allocate(256);
+        CHECK(allocation.IsValid() && IsAligned(allocation, 256));
+        // 書き込めること（前の割り当てを上書きしないこと）
+        std::memset(allocation.pCPU, i & 0xFF, 256);
+        allocations.push_back(allocation);
+    }
+    CHECK(allocator.GetOverflowPageCount() == 1);
+    for (int i = 0; i < 300; i++) {
+        const uint8_t* p = static_cast<const uint8_t*>(allocations[i].pCPU);
+        CHECK(p[0] == (i & 0xFF) && p[255] == (i & 0xFF));
+    }
+
+    // ページより大きな割り当ては，その大きさの追加ページになる
+    UploadAllocation big = allocator.Allocate(200000);
+    CHECK(big.IsValid() && IsAligned(big, 256));
+    CHECK(allocator.GetOverflowPageCount() == 2);
+    std::memset(big.pCPU, 0xAB, 200000);
+
+    // 使い切れなかったページの末尾も使用量に含める
+    const size_t used = allocator.GetUsedBytes();
+    CHECK(used == kPageAlignment + kPageAlignment + 200000);
+
+    // 使用量の1.5倍（ページ単位に切り上げ）で作り直す
+    allocator.Reset();
+    CHECK(allocator.GetOverflowPageCount() == 0);
+    CHECK(allocator.GetCapacity() == AlignUp(used + used / 2, kPageAlignment));
+
+    // 同じ負荷なら追加ページは作られない
+    for (int i = 0; i < 300; i++) {
+        CHECK(allocator.Allocate(256).IsValid());
+    }
+    CHECK(allocator.Allocate(200000).IsValid());
+    CHECK(allocator.GetOverflowPageCount() == 0);
+
+    // 追加ページがなければResetしても容量は変わらない
+    const size_t capacity = allocator.GetCapacity();
+    allocator.Reset();
+    CHECK(allocator.GetCapacity() == capacity);
+
+    allocator.Term();
+    CHECK(allocator.GetCapacity() == 0);
+}
@@ -0,0 +1,186 @@
+/// @file   MeshOptimizerTest.cpp
+/// @brief  MeshOptimizerのインデックスの範囲確認と16bit化の検証
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Engine/Model/ModelAsset.h"
+#include "Engine/Resource/MeshOptimizer.h"
+#include "Tests/TestFramework.h"
+
+namespace /* anonymous */ {
+
+using Triangle = std::array<std::array<float, 3>, 3>;
+
+/// @brief (n+1)x(n+1)頂点の格子（頂点は三角形の間で共有する）
+MeshAsset MakeGrid(uint32_t n, uint32_t materialID) {
+    MeshAsset mesh;
+    mesh.materialID = materialID;
+    for (uint32_t y = 0; y <= n; y++) {
+        for (uint32_t x = 0; x <= n; x++) {
+            StandardVertex vertex{};
+            vertex.position = { float(x), float(y), 0.0f };
+            vertex.normal   = { 0.0f, 0.0f, -1.0f };
+            mesh.vertices.push_back(vertex);
+        }
+    }
+    for (uint32_t y = 0; y < n; y++) {
+        for (uint32_t x = 0; x < n; x++) {
+            uint32_t a = y * (n + 1) + x;
+            uint32_t c = a + n + 1;
+            mesh.indices.insert(mesh.indices.end(), { a, c, a + 1 });
+            mesh.indices.insert(mesh.indices.end(), { a + 1, c, c + 1 });
+        }
+    }
+    return mesh;
+}
+
+/// @brief 三角形ごとの頂点座標の一覧（回転をそろえて並べ替えたもの）
+/// 分割しても形状が変わらないことを比べるのに使う
+std::vector<Triangle> GetTriangles(const std::vector<MeshAsset>& meshes) {
+    std::vector<Triangle> triangles;
+    for (const MeshAsset& mesh : meshes) {
+        const uint32_t count = mesh.GetIndexCount();
+        for (uint32_t i = 0; i + 2 < count; i += 3) {
+            Triangle triangle;
+            for (uint32_t k = 0; k < 3; k++) {
+                uint32_t index = mesh.HasShortIndices() ? mesh.indices16[i + k]
+                                                        : mesh.indices[i + k];
+                const DirectX::XMFLOAT3& p = mesh.vertices[index].position;
+                triangle[k]                = { p.x, p.y, p.z };
+            }
+            std::rotate(triangle.begin(),
+                std::min_element(triangle.begin(), triangle.end()),
+                triangle.end());
+            triangles.push_back(triangle);
+        }
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+}  // namespace
+
+//==============================================================
+// テスト
+//==============================================================
+
+// 全てのインデックスが頂点数未満のときだけtrue
+TEST_CASE(MeshOptimizer_ValidateIndexRange) {
+    CHECK(MeshOptimizer::ValidateIndexRange({}, 0));
+    CHECK(MeshOptimizer::ValidateIndexRange({ 0, 1, 2 }, 3));
+    CHECK(!MeshOptimizer::ValidateIndexRange({ 0, 1, 3 }, 3));
+    CHECK(!MeshOptimizer::ValidateIndexRange({ 0 }, 0));
+    CHECK(!MeshOptimizer::ValidateIndexRange({ 0, 1, UINT32_MAX }, 3));
+}
+
+// 16bitにできないメッシュは変更しない
+TEST_CASE(MeshOptimizer_CompactIndices) {
+    MeshAsset mesh = MakeGrid(4, 0);
+    const std::vector<uint32_t> original = mesh.indices;
+    CHECK(MeshOptimizer::CompactIndices(mesh));
+    CHECK(mesh.HasShortIndices() && mesh.indices.empty());
+    CHECK(std::equal(original.begin(), original.end(),
+        mesh.indices16.begin(), mesh.indices16.end()));
+    // 変換済みなら何もしない
+    CHECK(MeshOptimizer::CompactIndices(mesh));
+
+    // 範囲外のインデックス
+    MeshAsset broken = MakeGrid(4, 0);
+    broken.indices.back() = static_cast<uint32_t>(broken.vertices.size());
+    CHECK(!MeshOptimizer::CompactIndices(broken));
+    CHECK(!broken.HasShortIndices() && broken.indices.size() == 96);
+
+    // 頂点数が上限を超える（256x256の格子は66049頂点）
+    MeshAsset large = MakeGrid(256, 0);
+    CHECK(large.vertices.size() > MeshOptimizer::kMaxShortIndexVertices);
+    CHECK(!MeshOptimizer::CompactIndices(large));
+    CHECK(!large.HasShortIndices());
+
+    MeshAsset empty;
+    CHECK(!MeshOptimizer::CompactIndices(empty));
+}
+
+// 大きなメッシュは分割して16bitにし，形状とマテリアルは変わらない
+TEST_CASE(MeshOptimizer_ConvertToShortIndicesSplits) {
+    std::vector<MeshAsset> meshes;
+    meshes.push_back(MakeGrid(16, 1));
+    meshes.push_back(MakeGrid(400, 2));  // 160801頂点
+    meshes.push_back(MakeGrid(32, 3));
+    const std::vector<Triangle> before = GetTriangles(meshes);
+
+    MeshOptimizer::IndexStats stats;
+    MeshOptimizer::ConvertToShortIndices(meshes, &stats);
+
+    CHECK(stats.meshCountBefore == 3);
+    CHECK(stats.splitMeshCount == 1);
+    CHECK(stats.meshCountAfter == meshes.size());
+    CHECK(stats.meshCountAfter >= 5);
+    CHECK(stats.shortMeshCount == stats.meshCountAfter);
+    CHECK(GetTriangles(meshes) == before);
+
+    // 分割したメッシュは元の位置に並び，元のマテリアルを持つ
+    CHECK(meshes.front().materialID == 1 && meshes.back().materialID == 3);
+    for (size_t i = 1; i + 1 < meshes.size(); i++) {
+        CHECK(meshes[i].materialID == 2);
+    }
+
+    for (const MeshAsset& mesh : meshes) {
+        CHECK(mesh.HasShortIndices());
+        CHECK(mesh.vertices.size() <= MeshOptimizer::kMaxShortIndexVertices);
+    }
+
+    // 分割したメッシュのAABBは，そのメッシュの頂点だけを覆う
+    uint32_t outside = 0;
+    for (size_t i = 1; i + 1 < meshes.size(); i++) {
+        const DirectX::BoundingBox& bounds = meshes[i].bounds;
+        for (const StandardVertex& vertex : meshes[i].vertices) {
+            DirectX::XMVECTOR p = DirectX::XMLoadFloat3(&vertex.position);
+            outside += bounds.Contains(p) == DirectX::DISJOINT ? 1 : 0;
+        }
+        CHECK(bounds.Extents.y < 400.0f * 0.5f);
+    }
+    CHECK(outside == 0);
+
+    // 境界の頂点が増えても，インデックスが半分になる分の方が大きい
+    CHECK(stats.vertexBytesAfter > stats.vertexBytesBefore);
+    CHECK(stats.indexBytesAfter * 2 == stats.indexBytesBefore);
+    CHECK(stats.GetSavedBytes() > 0);
+    std::printf("  index %.1f KB -> %.1f KB, vertex %.1f KB -> %.1f KB, "
+                "saved %.1f KB (%.1f%%)\n",
+        stats.indexBytesBefore / 1024.0, stats.indexBytesAfter / 1024.0,
+        stats.vertexBytesBefore / 1024.0, stats.vertexBytesAfter / 1024.0,
+        stats.GetSavedBytes() / 1024.0,
+        100.0 * stats.GetSavedBytes() /
+            (stats.indexBytesBefore + stats.vertexBytesBefore));
+}
+
+// 分割で複製する頂点の方が大きくつくメッシュは32bitのまま残す
+TEST_CASE(MeshOptimizer_ConvertToShortIndicesKeepsWide) {
+    // 全体に散らばった頂点をつなぐ三角形は，どこで区切っても
+    // ほとんどの頂点を複製することになる
+    constexpr uint32_t kVertexCount = 70000;
+    MeshAsset mesh;
+    mesh.vertices.resize(kVertexCount);
+    for (uint32_t v = 0; v < kVertexCount; v++) {
+        mesh.vertices[v].position = { float(v), 0.0f, 0.0f };
+    }
+    std::mt19937 rng(5);
+    for (uint32_t i = 0; i < kVertexCount * 3; i++) {
+        mesh.indices.push_back(rng() % kVertexCount);
+    }
+
+    std::vector<MeshAsset> meshes;
+    meshes.push_back(mesh);
+    MeshOptimizer::IndexStats stats;
+    MeshOptimizer::ConvertToShortIndices(meshes, &stats);
+
+    CHECK(meshes.size() == 1 && stats.splitMeshCount == 0);
+    CHECK(stats.shortMeshCount == 0 && !meshes[0].HasShortIndices());
+    CHECK(meshes[0].indices == mesh.indices);
+    CHECK(stats.GetSavedBytes() == 0);
+}
@@ -0,0 +1,312 @@
+/// @file   MeshletBuilderTest.cpp
+/// @brief  MeshletBuilderが作るメッシュレットと境界・法線錐の正しさの検証
+
+#include <DirectXMath.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Engine/Model/Meshlet.h"
+#include "Engine/Model/ModelAsset.h"
+#include "Engine/Render/FrustumCuller.h"
+#include "Engine/Render/MeshletCuller.h"
+#include "Engine/Resource/MeshOptimizer.h"
+#include "Engine/Resource/MeshletBuilder.h"
+#include "Tests/TestFramework.h"
+
+using DirectX::XMFLOAT3;
+
+namespace /* anonymous */ {
+
+XMFLOAT3 Subtract(const XMFLOAT3& a, const XMFLOAT3& b) {
+    return XMFLOAT3(a.x - b.x, a.y - b.y, a.z - b.z);
+}
+
+float Dot(const XMFLOAT3& a, const XMFLOAT3& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+XMFLOAT3 Cross(const XMFLOAT3& a, const XMFLOAT3& b) {
+    return XMFLOAT3(
+        a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+}
+
+XMFLOAT3 Normalize(const XMFLOAT3& v) {
+    float length = std::sqrt(Dot(v, v));
+    return XMFLOAT3(v.x / length, v.y / length, v.z / length);
+}
+
+/// @brief 表が外を向いた凸凹のある球（時計回りが表，左手系）
+MeshAsset MakeSphere(uint32_t rings, uint32_t segments, uint32_t seed) {
+    constexpr float kPi = 3.14159265f;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> bump(0.995f, 1.005f);
+
+    MeshAsset mesh;
+    for (uint32_t r = 0; r <= rings; r++) {
+        float theta = kPi * r / rings;
+        for (uint32_t s = 0; s <= segments; s++) {
+            float phi    = 2.0f * kPi * s / segments;
+            float radius = 5.0f * bump(rng);
+            StandardVertex vertex{};
+            float ring   = radius * std::sin(theta);
+            vertex.position = { ring * std::cos(phi), radius * std::cos(theta),
+                ring * std::sin(phi) };
+            vertex.normal   = Normalize(vertex.position);
+            mesh.vertices.push_back(vertex);
+        }
+    }
+    for (uint32_t r = 0; r < rings; r++) {
+        for (uint32_t s = 0; s < segments; s++) {
+            uint32_t a = r * (segments + 1) + s;
+            uint32_t b = a + segments + 1;
+            mesh.indices.insert(mesh.indices.end(), { a, a + 1, b });
+            mesh.indices.insert(mesh.indices.end(), { a + 1, b + 1, b });
+        }
+    }
+    return mesh;
+}
+
+/// @brief 視点から見て三角形が裏向きかどうか（面上の視点も裏とみなす）
+bool IsBackFacing(const XMFLOAT3& p0, const XMFLOAT3& p1, const XMFLOAT3& p2,
+    const XMFLOAT3& eye) {
+    XMFLOAT3 normal = Cross(Subtract(p1, p0), Subtract(p2, p0));
+    float scale     = std::sqrt(Dot(normal, normal)) *
+                  std::sqrt(Dot(Subtract(eye, p0), Subtract(eye, p0)));
+    return Dot(normal, Subtract(eye, p0)) <= scale * 1e-5f;
+}
+
+/// @brief メッシュの構造の検証
+/// メッシュレットは元のインデックスの並びを先頭から隙間なく区切り，
+/// ローカル番号を頂点番号に戻すと元のインデックスになる
+void CheckMeshlets(
+    const MeshAsset& mesh, const std::vector<uint32_t>& indices) {
+    CHECK(mesh.meshletBounds.size() == mesh.meshlets.size());
+    CHECK(mesh.meshletTriangles.size() == indices.size());
+
+    uint32_t nextTriangle = 0;
+    uint32_t nextVertex   = 0;
+    uint32_t mismatches   = 0;
+    for (const Meshlet& meshlet : mesh.meshlets) {
+        CHECK(meshlet.triangleOffset == nextTriangle);
+        CHECK(meshlet.vertexOffset == nextVertex);
+        CHECK(meshlet.triangleCount > 0);
+        CHECK(meshlet.vertexCount <= Meshlet::kMaxVertices);
+        CHECK(meshlet.triangleCount <= Meshlet::kMaxTriangles);
+        nextTriangle += meshlet.triangleCount * 3;
+        nextVertex += meshlet.vertexCount;
+
+        for (uint32_t i = 0; i < meshlet.triangleCount * 3; i++) {
+            uint8_t local = mesh.meshletTriangles[meshlet.triangleOffset + i];
+            if (local >= meshlet.vertexCount ||
+                mesh.meshletVertices[meshlet.vertexOffset + local] !=
+                    indices[meshlet.triangleOffset + i]) {
+                mismatches++;
+            }
+        }
+
+        // メッシュレット内で同じ頂点を2回持たない
+        std::vector<uint32_t> vertices(
+            mesh.meshletVertices.begin() + meshlet.vertexOffset,
+            mesh.meshletVertices.begin() + meshlet.vertexOffset +
+                meshlet.vertexCount);
+        std::sort(vertices.begin(), vertices.end());
+        CHECK(std::adjacent_find(vertices.begin(), vertices.end()) ==
+              vertices.end());
+    }
+    CHECK(nextTriangle == indices.size());
+    CHECK(nextVertex == mesh.meshletVertices.size());
+    CHECK(mismatches == 0);
+}
+
+}  // namespace
+
+//==============================================================
+// テスト
+//==============================================================
+
+// 球のメッシュレットは元のインデックスを再現し，上限を守る
+// 16bitのインデックスからでも同じメッシュレットになる
+TEST_CASE(MeshletBuilder_ReconstructsIndices) {
+    MeshAsset mesh = MakeSphere(64, 512, 1);
+    const std::vector<uint32_t> indices = mesh.indices;
+    CHECK(MeshletBuilder::Build(mesh));
+    CheckMeshlets(mesh, indices);
+
+    MeshAsset shortMesh = MakeSphere(64, 512, 1);
+    CHECK(MeshOptimizer::CompactIndices(shortMesh));
+    CHECK(MeshletBuilder::Build(shortMesh));
+    CHECK(shortMesh.meshletVertices == mesh.meshletVertices);
+    CHECK(shortMesh.meshletTriangles == mesh.meshletTriangles);
+
+    std::printf("  %zu meshlets, %.1f triangles/meshlet\n",
+        mesh.meshlets.size(),
+        double(indices.size() / 3) / double(mesh.meshlets.size()));
+}
+
+// 頂点数と三角形数のどちらの上限でも区切る
+TEST_CASE(MeshletBuilder_Limits) {
+    // 頂点を共有しない三角形は頂点数の上限で区切る（21個で63頂点）
+    MeshAsset scattered;
+    scattered.vertices.resize(3000);
+    for (uint32_t v = 0; v < 3000; v++) {
+        scattered.vertices[v].position = { float(v), float(v % 7), 0.0f };
+        scattered.indices.push_back(v);
+    }
+    std::vector<uint32_t> indices = scattered.indices;
+    CHECK(MeshletBuilder::Build(scattered));
+    CheckMeshlets(scattered, indices);
+    CHECK(scattered.meshlets.front().triangleCount == 21);
+
+    // 同じ3頂点の三角形と縮退した三角形は三角形数の上限で区切る
+    MeshAsset shared;
+    shared.vertices.resize(3);
+    shared.vertices[1].position = { 0.0f, 1.0f, 0.0f };
+    shared.vertices[2].position = { 1.0f, 0.0f, 0.0f };
+    for (uint32_t t = 0; t < 1000; t++) {
+        if (t % 5 == 0) {
+            shared.indices.insert(shared.indices.end(), { 1, 1, 2 });
+        } else {
+            shared.indices.insert(shared.indices.end(), { 0, 1, 2 });
+        }
+    }
+    indices = shared.indices;
+    CHECK(MeshletBuilder::Build(shared));
+    CheckMeshlets(shared, indices);
+    CHECK(shared.meshlets.front().triangleCount == Meshlet::kMaxTriangles);
+    CHECK(shared.meshlets.front().vertexCount == 3);
+
+    // 範囲外のインデックスがあれば作らない
+    MeshAsset broken = MakeSphere(4, 8, 2);
+    broken.indices.back() = static_cast<uint32_t>(broken.vertices.size());
+    CHECK(!MeshletBuilder::Build(broken));
+}
+
+// 境界球は全ての頂点を含み，法線錐の中の視点からは全ての三角形が裏向き
+TEST_CASE(MeshletBuilder_BoundsAndCones) {
+    MeshAsset mesh = MakeSphere(64, 512, 3);
+    CHECK(MeshletBuilder::Build(mesh));
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    uint32_t outside      = 0;
+    uint32_t coneMeshlets = 0;
+    uint32_t frontFacing  = 0;
+    for (size_t m = 0; m < mesh.meshlets.size(); m++) {
+        const Meshlet& meshlet      = mesh.meshlets[m];
+        const MeshletBounds& bounds = mesh.meshletBounds[m];
+
+        for (uint32_t i = 0; i < meshlet.vertexCount; i++) {
+            uint32_t vertex = mesh.meshletVertices[meshlet.vertexOffset + i];
+            XMFLOAT3 offset =
+                Subtract(mesh.vertices[vertex].position, bounds.center);
+            if (std::sqrt(Dot(offset, offset)) > bounds.radius * 1.0001f) {
+                outside++;
+            }
+        }
+
+        if (bounds.coneCutoff >= 1.0f) continue;
+        coneMeshlets++;
+
+        // 軸との角度のcosがcutoff以上の方向に，頂点から離れた視点を作る
+        // （MeshletCullerが裏向きと判定する範囲）
+        const XMFLOAT3& axis = bounds.coneAxis;
+        XMFLOAT3 helper      = std::abs(axis.x) < 0.9f
+                                   ? XMFLOAT3(1.0f, 0.0f, 0.0f)
+                                   : XMFLOAT3(0.0f, 1.0f, 0.0f);
+        XMFLOAT3 side        = Normalize(Cross(axis, helper));
+        XMFLOAT3 up          = Cross(axis, side);
+        for (int sample = 0; sample < 64; sample++) {
+            float cosAngle = bounds.coneCutoff +
+                             (1.0f - bounds.coneCutoff) * unit(rng);
+            float sinAngle = std::sqrt(1.0f - cosAngle * cosAngle);
+            float phi      = 6.2831853f * unit(rng);
+            float distance = 0.01f + 200.0f * unit(rng) * unit(rng);
+            XMFLOAT3 direction(
+                axis.x * cosAngle +
+                    (side.x * std::cos(phi) + up.x * std::sin(phi)) * sinAngle,
+                axis.y * cosAngle +
+                    (side.y * std::cos(phi) + up.y * std::sin(phi)) * sinAngle,
+                axis.z * cosAngle +
+                    (side.z * std::cos(phi) + up.z * std::sin(phi)) * sinAngle);
+            XMFLOAT3 eye(bounds.coneApex.x - direction.x * distance,
+                bounds.coneApex.y - direction.y * distance,
+                bounds.coneApex.z - direction.z * distance);
+
+            for (uint32_t t = 0; t < meshlet.triangleCount; t++) {
+                const uint32_t* corner =
+                    &mesh.indices[meshlet.triangleOffset + t * 3];
+                if (!IsBackFacing(mesh.vertices[corner[0]].position,
+                        mesh.vertices[corner[1]].position,
+                        mesh.vertices[corner[2]].position, eye)) {
+                    frontFacing++;
+                }
+            }
+        }
+    }
+    std::printf("  %u / %zu meshlets have a cone\n", coneMeshlets,
+        mesh.meshlets.size());
+    CHECK(outside == 0);
+    CHECK(coneMeshlets * 2 > mesh.meshlets.size());
+    CHECK(frontFacing == 0);
+}
+
+// 法線錐の判定は片面のマテリアルだけ，両面では視錐台の判定だけにする
+TEST_CASE(MeshletCuller_SkipsConeForDoubleSided) {
+    using namespace DirectX;
+
+    MeshAsset mesh = MakeSphere(64, 512, 4);
+    CHECK(MeshletBuilder::Build(mesh));
+    const uint32_t count = static_cast<uint32_t>(mesh.meshlets.size());
+
+    // 球全体が視錐台に入る位置から見る
+    const XMFLOAT3 eye(0.0f, 2.0f, -30.0f);
+    XMMATRIX view = XMMatrixLookAtLH(XMLoadFloat3(&eye), XMVectorZero(),
+        XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+    XMMATRIX projection =
+        XMMatrixPerspectiveFovLH(XM_PIDIV4, 1.0f, 0.1f, 100.0f);
+    FrustumCuller frustum;
+    frustum.SetViewProjection(XMMatrixMultiply(view, projection));
+
+    MeshletCuller culler;
+    culler.SetView(frustum, eye);
+    const XMMATRIX world = XMMatrixIdentity();
+
+    std::vector<MeshletCuller::IndexRange> ranges = culler.Cull(
+        mesh.meshlets.data(), mesh.meshletBounds.data(), count, world, world,
+        false);
+    CHECK(culler.GetStats().meshletsCulled == 0);
+    CHECK(ranges.size() == 1 && ranges[0].startIndex == 0 &&
+          ranges[0].indexCount == mesh.indices.size());
+
+    // 片面では奥側の一部を省き，省いたメッシュレットは全て裏向き
+    culler.ResetStats();
+    ranges = culler.Cull(mesh.meshlets.data(), mesh.meshletBounds.data(),
+        count, world, world, true);
+    const MeshletCuller::Stats& stats = culler.GetStats();
+    std::printf("  single-sided: %u / %u meshlets culled\n",
+        stats.meshletsCulled, stats.meshletsTested);
+    CHECK(stats.meshletsCulled * 10 > count);
+
+    std::vector<bool> drawn(mesh.indices.size() / 3, false);
+    for (const MeshletCuller::IndexRange& range : ranges) {
+        for (uint32_t i = 0; i < range.indexCount; i += 3) {
+            drawn[(range.startIndex + i) / 3] = true;
+        }
+    }
+    uint32_t frontFacingCulled = 0;
+    for (size_t t = 0; t < drawn.size(); t++) {
+        const uint32_t* corner = &mesh.indices[t * 3];
+        if (!drawn[t] && !IsBackFacing(mesh.vertices[corner[0]].position,
+                             mesh.vertices[corner[1]].position,
+                             mesh.vertices[corner[2]].position, eye)) {
+            frontFacingCulled++;
+        }
+    }
+    CHECK(frontFacingCulled == 0);
+}
@@ -0,0 +1,467 @@
+/// @file   MipGeneratorTest.cpp
+/// @brief  MipGeneratorのAVX2とスカラーの一致，倍精度の参照との誤差と処理速度
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Resource/MipGenerator.h"
+#include "Tests/TestFramework.h"
+
+namespace /* anonymous */ {
+
+using Taps = std::vector<std::pair<uint32_t, double>>;
+
+constexpr double kPi = 3.14159265358979323846;
+
+/// @brief 試す先頭の段の大きさ（奇数・1ピクセル幅の辺を含む）
+constexpr uint32_t kSizes[][2] = {
+    { 8, 8 }, { 7, 5 }, { 1, 9 }, { 13, 1 }, { 33, 17 }, { 64, 3 },
+    { 255, 129 }, { 2, 2 }, { 3, 1 },
+};
+
+constexpr MipFormat kFormats[] = {
+    MipFormat::RGBA8, MipFormat::RGBA16F, MipFormat::R32F
+};
+
+/// @brief 半精度の値をfloatにする（非正規化数を含む，無限大とNaNは使わない）
+float HalfToFloat(uint16_t half) {
+    const float sign     = (half & 0x8000) ? -1.0f : 1.0f;
+    const int exponent   = (half >> 10) & 0x1F;
+    const float mantissa = float(half & 0x3FF);
+    if (exponent == 0) {
+        return sign * std::ldexp(mantissa, -24);
+    }
+    return sign * std::ldexp(1024.0f + mantissa, exponent - 25);
+}
+
+double SrgbToLinear(double c) {
+    return c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+}
+
+/// @brief 線形の値をsRGBの8bitにする（四捨五入）
+int LinearToSrgb8(double x) {
+    x = std::clamp(x, 0.0, 1.0);
+    double s =
+        x <= 0.0031308 ? x * 12.92 : 1.055 * std::pow(x, 1 / 2.4) - 0.055;
+    return static_cast<int>(std::floor(s * 255.0 + 0.5));
+}
+
+/// @brief 0次の第1種変形ベッセル関数
+double BesselI0(double x) {
+    double sum  = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 100; k++) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+/// @brief 縮小先のiが使う縮小元の番号と重み（和は1）
+/// MipGeneratorの説明の定義から，速さを考えずに作り直したもの
+Taps ReferenceTaps(MipFilter filter, uint32_t srcSize, uint32_t dstSize,
+    uint32_t i) {
+    Taps taps;
+    const double scale = double(srcSize) / dstSize;
+    if (srcSize == dstSize) {
+        taps.emplace_back(i, 1.0);
+    } else if (filter == MipFilter::Box) {
+        // 縮小先のピクセルと重なる面積
+        for (uint32_t j = 0; j < srcSize; j++) {
+            double overlap = std::min((i + 1) * scale, j + 1.0) -
+                             std::max(i * scale, double(j));
+            if (overlap > 0.0) {
+                taps.emplace_back(j, overlap);
+            }
+        }
+    } else {
+        // 縮小先の単位で半径kKaiserWidthの窓を掛けたsinc，範囲外は繰り返す
+        const double width  = MipGenerator::kKaiserWidth;
+        const double alpha  = MipGenerator::kKaiserAlpha;
+        const double center = (i + 0.5) * scale;
+        const int first     = int(std::floor(center - width * scale)) - 2;
+        const int last      = int(std::ceil(center + width * scale)) + 2;
+        for (int j = first; j <= last; j++) {
+            double x = (j + 0.5 - center) / scale;
+            double r = x / width;
+            if (r * r >= 1.0) continue;
+            double sinc   = x == 0.0 ? 1.0 : std::sin(kPi * x) / (kPi * x);
+            double window = BesselI0(alpha * std::sqrt(1.0 - r * r)) /
+                            BesselI0(alpha);
+            int wrapped   = ((j % int(srcSize)) + int(srcSize)) % int(srcSize);
+            taps.emplace_back(uint32_t(wrapped), sinc * window);
+        }
+    }
+
+    double sum = 0.0;
+    for (const auto& tap : taps) {
+        sum += tap.second;
+    }
+    for (auto& tap : taps) {
+        tap.second /= sum;
+    }
+    return taps;
+}
+
+/// @brief 先頭の段を乱数で埋める
+/// 半精度は[-8, 8)程度の値，R32Fは[-2, 8)の値にする
+void FillRandom(MipChain& chain, std::mt19937& rng) {
+    const size_t bytes = chain.GetSlicePitch(0);
+    uint8_t* pData     = chain.GetData(0);
+    if (chain.format == MipFormat::RGBA8) {
+        for (size_t i = 0; i < bytes; i++) {
+            pData[i] = static_cast<uint8_t>(rng());
+        }
+    } else if (chain.format == MipFormat::RGBA16F) {
+        uint16_t* pHalf = reinterpret_cast<uint16_t*>(pData);
+        for (size_t i = 0; i < bytes / 2; i++) {
+            uint16_t exponent = static_cast<uint16_t>(8 + rng() % 10);
+            pHalf[i] = static_cast<uint16_t>(
+                (rng() & 0x8000) | (exponent << 10) | (rng() & 0x3FF));
+        }
+    } else {
+        std::uniform_real_distribution<float> value(-2.0f, 8.0f);
+        float* pFloat = reinterpret_cast<float*>(pData);
+        for (size_t i = 0; i < bytes / 4; i++) {
+            pFloat[i] = value(rng);
+        }
+    }
+}
+
+/// @brief 段のチャンネルの値（RGBA8は0～1，sRGBのRGBは線形にする）
+double GetValue(const MipChain& chain, uint32_t level, size_t index,
+    bool isSRGB) {
+    const uint8_t* pData = chain.GetData(level);
+    if (chain.format == MipFormat::RGBA8) {
+        double value = pData[index] / 255.0;
+        return (isSRGB && (index & 3) != 3) ? SrgbToLinear(value) : value;
+    }
+    if (chain.format == MipFormat::RGBA16F) {
+        return HalfToFloat(reinterpret_cast<const uint16_t*>(pData)[index]);
+    }
+    return reinterpret_cast<const float*>(pData)[index];
+}
+
+/// @brief 2段目を先頭の段から倍精度で作り直して比べる
+/// @return 許容値に対する最大の誤差の比（1以下なら許容範囲）
+/// RGBA8は1LSB，RGBA16Fは相対2^-10，R32Fは相対1e-5を許容値とする
+double CompareWithReference(const MipChain& chain, const MipOptions& options) {
+    const MipLevel& src     = chain.levels[0];
+    const MipLevel& dst     = chain.levels[1];
+    const uint32_t channels = MipGenerator::GetChannelCount(chain.format);
+    const bool isRGBA8      = chain.format == MipFormat::RGBA8;
+
+    double worst = 0.0;
+    for (uint32_t y = 0; y < dst.height; y++) {
+        Taps tapsY = ReferenceTaps(options.filter, src.height, dst.height, y);
+        for (uint32_t x = 0; x < dst.width; x++) {
+            Taps tapsX =
+                ReferenceTaps(options.filter, src.width, dst.width, x);
+
+            double value[4] = {};
+            for (const auto& ty : tapsY) {
+                for (const auto& tx : tapsX) {
+                    size_t texel = size_t(ty.first) * src.width + tx.first;
+                    for (uint32_t c = 0; c < channels; c++) {
+                        value[c] += ty.second * tx.second *
+                                    GetValue(chain, 0, texel * channels + c,
+                                        options.isSRGB);
+                    }
+                }
+            }
+
+            const size_t texel = size_t(y) * dst.width + x;
+            if (!isRGBA8) {
+                const double tolerance =
+                    chain.format == MipFormat::R32F ? 1e-5 : 1.0 / 1024.0;
+                for (uint32_t c = 0; c < channels; c++) {
+                    double got =
+                        GetValue(chain, 1, texel * channels + c, false);
+                    double error = std::abs(got - value[c]) /
+                                   std::max(1.0, std::abs(value[c]));
+                    worst = std::max(worst, error / tolerance);
+                }
+                continue;
+            }
+
+            if (options.isNormalMap) {
+                double n[3];
+                double length = 0.0;
+                for (int c = 0; c < 3; c++) {
+                    n[c] = value[c] * 2.0 - 1.0;
+                    length += n[c] * n[c];
+                }
+                length = std::sqrt(length);
+                for (int c = 0; c < 3; c++) {
+                    double unit = length > 0.0 ? n[c] / length : n[c];
+                    value[c]    = unit * 0.5 + 0.5;
+                }
+            }
+            for (uint32_t c = 0; c < 4; c++) {
+                double unorm = std::clamp(value[c], 0.0, 1.0) * 255.0;
+                int expected = (options.isSRGB && c < 3)
+                                   ? LinearToSrgb8(value[c])
+                                   : int(std::floor(unorm + 0.5));
+                int got      = chain.GetData(1)[texel * 4 + c];
+                worst   = std::max(worst, double(std::abs(expected - got)));
+            }
+        }
+    }
+    return worst;
+}
+
+/// @brief 指定した形式で試す設定の一覧（sRGBと法線マップはRGBA8だけ）
+std::vector<MipOptions> GetOptions(MipFormat format) {
+    std::vector<MipOptions> list;
+    for (MipFilter filter : { MipFilter::Box, MipFilter::Kaiser }) {
+        for (int flags = 0; flags < 4; flags++) {
+            MipOptions options;
+            options.filter      = filter;
+            options.isSRGB      = (flags & 1) != 0;
+            options.isNormalMap = (flags & 2) != 0;
+            if (format != MipFormat::RGBA8 && flags != 0) continue;
+            list.push_back(options);
+        }
+    }
+    return list;
+}
+
+const char* GetFormatName(MipFormat format) {
+    switch (format) {
+    case MipFormat::RGBA8:
+        return "RGBA8";
+    case MipFormat::RGBA16F:
+        return "RGBA16F";
+    default:
+        return "R32F";
+    }
+}
+
+}  // namespace
+
+//==============================================================
+// テスト
+//==============================================================
+
+// 段数と大きさ（半分にして切り捨て，1未満にはしない）
+TEST_CASE(MipGenerator_Allocate) {
+    CHECK(MipGenerator::ComputeMipCount(1, 1) == 1);
+    CHECK(MipGenerator::ComputeMipCount(7, 5) == 3);
+    CHECK(MipGenerator::ComputeMipCount(4096, 1) == 13);
+
+    MipChain chain;
+    CHECK(MipGenerator::Allocate(7, 5, 0, MipFormat::RGBA16F, chain));
+    CHECK(chain.GetMipCount() == 3);
+    CHECK(chain.levels[1].width == 3 && chain.levels[1].height == 2);
+    CHECK(chain.levels[2].width == 1 && chain.levels[2].height == 1);
+    CHECK(chain.levels[0].rowPitch == 7 * 8);
+    CHECK(chain.levels[2].offset + chain.GetSlicePitch(2) <=
+          chain.pixels.size());
+
+    CHECK(!MipGenerator::Allocate(0, 4, 0, MipFormat::RGBA8, chain));
+}
+
+// AVX2の有無と並列化の有無に関わらず，結果はビット単位で一致する
+TEST_CASE(MipGenerator_Avx2MatchesScalar) {
+    std::printf("  AVX2 supported: %s\n",
+        MipGenerator::IsAvx2Supported() ? "yes" : "no (scalar only)");
+
+    JobSystem jobSystem;
+    CHECK(jobSystem.Init(3));
+    std::mt19937 rng(7);
+
+    uint32_t mismatches = 0;
+    for (MipFormat format : kFormats) {
+        for (const MipOptions& base : GetOptions(format)) {
+            for (const auto& size : kSizes) {
+                MipChain scalar;
+                MipGenerator::Allocate(size[0], size[1], 0, format, scalar);
+                FillRandom(scalar, rng);
+                MipChain simd     = scalar;
+                MipChain parallel = scalar;
+
+                MipOptions options = base;
+                options.useAvx2    = false;
+                MipGenerator::Generate(scalar, options);
+                options.useAvx2 = true;
+                MipGenerator::Generate(simd, options);
+                MipGenerator::Generate(parallel, options, &jobSystem);
+
+                if (scalar.pixels != simd.pixels ||
+                    scalar.pixels != parallel.pixels) {
+                    mismatches++;
+                }
+            }
+        }
+    }
+    CHECK(mismatches == 0);
+    jobSystem.Term();
+}
+
+// 2段目が倍精度の参照の許容範囲に入る
+TEST_CASE(MipGenerator_MatchesReference) {
+    std::mt19937 rng(11);
+    for (MipFormat format : kFormats) {
+        double worst = 0.0;
+        for (const MipOptions& options : GetOptions(format)) {
+            for (const auto& size : kSizes) {
+                MipChain chain;
+                MipGenerator::Allocate(size[0], size[1], 0, format, chain);
+                if (chain.GetMipCount() < 2) continue;
+                FillRandom(chain, rng);
+                MipGenerator::Generate(chain, options);
+                worst = std::max(worst, CompareWithReference(chain, options));
+            }
+        }
+        std::printf("  %-8s worst error %.3f of tolerance\n",
+            GetFormatName(format), worst);
+        CHECK(worst <= 1.0);
+    }
+}
+
+// sRGBは線形にしてから平均し，法線マップは長さ1に戻す
+TEST_CASE(MipGenerator_SrgbAndNormalMaps) {
+    // 黒と白の市松模様は，sRGBなら線形の0.5（188），そうでなければ128
+    MipChain checker;
+    MipGenerator::Allocate(64, 64, 0, MipFormat::RGBA8, checker);
+    for (uint32_t y = 0; y < 64; y++) {
+        for (uint32_t x = 0; x < 64; x++) {
+            uint8_t* pTexel = checker.GetData(0) + (y * 64 + x) * 4;
+            uint8_t value   = ((x ^ y) & 1) ? 255 : 0;
+            std::memset(pTexel, value, 3);
+            pTexel[3] = 255;
+        }
+    }
+    MipChain linear = checker;
+    MipOptions options;
+    options.isSRGB = true;
+    MipGenerator::Generate(checker, options);
+    options.isSRGB = false;
+    MipGenerator::Generate(linear, options);
+    CHECK(checker.GetData(1)[0] == 188 && checker.GetData(1)[3] == 255);
+    CHECK(linear.GetData(1)[0] == 128);
+    CHECK(checker.GetData(checker.GetMipCount() - 1)[0] == 188);
+
+    // 向きが変わる法線を縮小すると短くなるが，指定すれば長さ1に戻す
+    MipChain normals;
+    MipGenerator::Allocate(128, 128, 0, MipFormat::RGBA8, normals);
+    for (uint32_t y = 0; y < 128; y++) {
+        for (uint32_t x = 0; x < 128; x++) {
+            double n[3] = { std::sin(x * 0.7) * 0.56, std::cos(y * 0.9) * 0.56,
+                0.6 };
+            double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            uint8_t* pTexel = normals.GetData(0) + (y * 128 + x) * 4;
+            for (int c = 0; c < 3; c++) {
+                pTexel[c] = static_cast<uint8_t>(
+                    std::lround((n[c] / length * 0.5 + 0.5) * 255.0));
+            }
+            pTexel[3] = 255;
+        }
+    }
+    for (bool isNormalMap : { false, true }) {
+        MipChain chain = normals;
+        options        = MipOptions{};
+        options.filter      = MipFilter::Kaiser;
+        options.isNormalMap = isNormalMap;
+        MipGenerator::Generate(chain, options);
+
+        double minLength = 2.0;
+        double maxLength = 0.0;
+        for (uint32_t level = 1; level < chain.GetMipCount(); level++) {
+            const MipLevel& mip = chain.levels[level];
+            for (size_t i = 0; i < size_t(mip.width) * mip.height; i++) {
+                const uint8_t* pTexel = chain.GetData(level) + i * 4;
+                double length         = 0.0;
+                for (int c = 0; c < 3; c++) {
+                    double v = pTexel[c] / 255.0 * 2.0 - 1.0;
+                    length += v * v;
+                }
+                minLength = std::min(minLength, std::sqrt(length));
+                maxLength = std::max(maxLength, std::sqrt(length));
+            }
+        }
+        std::printf("  normal map %s: length %.3f - %.3f\n",
+            isNormalMap ? "renormalized" : "plain", minLength, maxLength);
+        if (isNormalMap) {
+            CHECK(minLength > 0.99 && maxLength < 1.01);
+        } else {
+            CHECK(minLength < 0.9);
+        }
+    }
+}
+
+//==============================================================
+// 計測
+//==============================================================
+
+// 4096x4096から1x1までの処理速度（先頭の段のピクセル数で数える）
+// スカラーとAVX2を1スレッドで，AVX2はジョブシステムでも測る
+BENCHMARK_CASE(MipGenerator_Throughput) {
+    constexpr uint32_t kSize = 4096;
+    std::printf("  hardware threads: %u, AVX2: %s\n",
+        std::thread::hardware_concurrency(),
+        MipGenerator::IsAvx2Supported() ? "yes" : "no");
+    std::printf("  %-20s %8s %8s %9s  (MPixels/s)\n", "", "scalar", "avx2",
+        "parallel");
+
+    JobSystem jobSystem;
+    jobSystem.Init();
+    std::mt19937 rng(3);
+
+    struct Case {
+        const char* name;
+        MipFormat format;
+        MipFilter filter;
+        bool isSRGB;
+        bool isNormalMap;
+    };
+    const Case cases[] = {
+        { "RGBA8 box", MipFormat::RGBA8, MipFilter::Box, false, false },
+        { "RGBA8 sRGB box", MipFormat::RGBA8, MipFilter::Box, true, false },
+        { "RGBA8 sRGB kaiser", MipFormat::RGBA8, MipFilter::Kaiser, true,
+            false },
+        { "RGBA8 normal kaiser", MipFormat::RGBA8, MipFilter::Kaiser, false,
+            true },
+        { "RGBA16F box", MipFormat::RGBA16F, MipFilter::Box, false, false },
+        { "RGBA16F kaiser", MipFormat::RGBA16F, MipFilter::Kaiser, false,
+            false },
+        { "R32F box", MipFormat::R32F, MipFilter::Box, false, false },
+        { "R32F kaiser", MipFormat::R32F, MipFilter::Kaiser, false, false },
+    };
+
+    for (const Case& c : cases) {
+        MipChain chain;
+        MipGenerator::Allocate(kSize, kSize, 0, c.format, chain);
+        FillRandom(chain, rng);
+
+        // 3回のうち最短の時間で比べる
+        auto measure = [&](bool useAvx2, JobSystem* pJobSystem) {
+            MipOptions options;
+            options.filter      = c.filter;
+            options.isSRGB      = c.isSRGB;
+            options.isNormalMap = c.isNormalMap;
+            options.useAvx2     = useAvx2;
+            double bestMs       = 1e30;
+            for (int r = 0; r < 3; r++) {
+                Stopwatch stopwatch;
+                MipGenerator::Generate(chain, options, pJobSystem);
+                bestMs = std::min(bestMs, stopwatch.GetElapsedMs());
+            }
+            return double(kSize) * kSize / bestMs / 1000.0;
+        };
+        const double scalar   = measure(false, nullptr);
+        const double simd     = measure(true, nullptr);
+        const double parallel = measure(true, &jobSystem);
+        std::printf("  %-20s %8.1f %8.1f %9.1f\n", c.name, scalar, simd,
+            parallel);
+    }
+    jobSystem.Term();
+}
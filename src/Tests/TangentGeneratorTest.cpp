@@ -0,0 +1,315 @@
+/// @file   TangentGeneratorTest.cpp
+/// @brief  TangentGeneratorの法線・接線とassimpの後処理の結果の比較
+
+#include <DirectXMath.h>
+
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <assimp/Importer.hpp>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Model/ModelAsset.h"
+#include "Engine/Resource/TangentGenerator.h"
+#include "Tests/TestFramework.h"
+
+using DirectX::XMFLOAT3;
+
+namespace /* anonymous */ {
+
+/// @brief 以前GLBImporterがassimpに任せていた法線・接線の生成
+constexpr unsigned int kAssimpFlags =
+    aiProcess_GenSmoothNormals | aiProcess_CalcTangentSpace;
+
+constexpr double kRadToDeg = 57.29577951308232;
+
+float Dot(const XMFLOAT3& a, const XMFLOAT3& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+XMFLOAT3 Cross(const XMFLOAT3& a, const XMFLOAT3& b) {
+    return XMFLOAT3(
+        a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+}
+
+XMFLOAT3 ToFloat3(const aiVector3D& v) { return XMFLOAT3(v.x, v.y, v.z); }
+
+/// @brief 2つの単位ベクトルの間の角度（度）
+double AngleDegrees(const XMFLOAT3& a, const XMFLOAT3& b) {
+    return std::acos(std::clamp(Dot(a, b), -1.0f, 1.0f)) * kRadToDeg;
+}
+
+/// @brief 半径1のUV球（表が外向き，uの継ぎ目の頂点は複製する）
+/// 法線と接線は持たない
+MeshAsset MakeSphere(uint32_t n) {
+    constexpr float kPi = 3.14159265f;
+
+    MeshAsset mesh;
+    for (uint32_t y = 0; y <= n; y++) {
+        for (uint32_t x = 0; x <= n; x++) {
+            float theta = kPi * y / n;
+            float phi   = 2.0f * kPi * x / n;
+            StandardVertex vertex{};
+            vertex.position = { std::sin(theta) * std::cos(phi),
+                std::cos(theta), std::sin(theta) * std::sin(phi) };
+            // 継ぎ目と極の頂点は位置を完全に一致させる
+            if (x == n) {
+                vertex.position = { std::sin(theta), std::cos(theta), 0.0f };
+            }
+            if (y == 0 || y == n) {
+                vertex.position = { 0.0f, std::cos(theta), 0.0f };
+            }
+            vertex.texcoord = { float(x) / n, float(y) / n };
+            vertex.color    = { 1.0f, 1.0f, 1.0f, 1.0f };
+            mesh.vertices.push_back(vertex);
+        }
+    }
+    for (uint32_t y = 0; y < n; y++) {
+        for (uint32_t x = 0; x < n; x++) {
+            uint32_t a = y * (n + 1) + x;
+            uint32_t c = a + n + 1;
+            mesh.indices.insert(mesh.indices.end(), { a, a + 1, c });
+            mesh.indices.insert(mesh.indices.end(), { a + 1, c + 1, c });
+        }
+    }
+    return mesh;
+}
+
+/// @brief x = 0でuを折り返した平面（法線は上向きで与える）
+MeshAsset MakeMirroredPlane(uint32_t n) {
+    MeshAsset mesh;
+    for (uint32_t y = 0; y <= n; y++) {
+        for (uint32_t x = 0; x <= n; x++) {
+            float px = float(x) / n * 2.0f - 1.0f;
+            StandardVertex vertex{};
+            vertex.position = { px, 0.0f, float(y) / n };
+            vertex.normal   = { 0.0f, 1.0f, 0.0f };
+            vertex.texcoord = { std::abs(px), float(y) / n };
+            mesh.vertices.push_back(vertex);
+        }
+    }
+    for (uint32_t y = 0; y < n; y++) {
+        for (uint32_t x = 0; x < n; x++) {
+            uint32_t a = y * (n + 1) + x;
+            uint32_t c = a + n + 1;
+            mesh.indices.insert(mesh.indices.end(), { a, c, a + 1 });
+            mesh.indices.insert(mesh.indices.end(), { a + 1, c, c + 1 });
+        }
+    }
+    return mesh;
+}
+
+/// @brief メッシュをOBJ形式の文字列にする（法線は書かない）
+std::string ToObj(const MeshAsset& mesh) {
+    std::string obj;
+    char line[128];
+    for (const StandardVertex& vertex : mesh.vertices) {
+        std::snprintf(line, sizeof(line), "v %.9g %.9g %.9g\nvt %.9g %.9g\n",
+            vertex.position.x, vertex.position.y, vertex.position.z,
+            vertex.texcoord.x, vertex.texcoord.y);
+        obj += line;
+    }
+    for (size_t i = 0; i < mesh.indices.size(); i += 3) {
+        uint32_t a = mesh.indices[i + 0] + 1;
+        uint32_t b = mesh.indices[i + 1] + 1;
+        uint32_t c = mesh.indices[i + 2] + 1;
+        std::snprintf(line, sizeof(line), "f %u/%u %u/%u %u/%u\n", a, a, b, b,
+            c, c);
+        obj += line;
+    }
+    return obj;
+}
+
+/// @brief 三角形の角ごとの比較結果
+struct Comparison {
+    uint32_t cornerCount  = 0;    // 比べた角の数
+    uint32_t signMismatch = 0;    // wの符号がassimpの従法線と合わない数
+    double maxNormal      = 0.0;  // 法線の最大の差（度）
+    double maxTangent     = 0.0;  // 接線の最大の差（度）
+    double meanTangent    = 0.0;  // 接線の平均の差（度）
+};
+
+/// @brief TangentGeneratorとassimpで同じメッシュの法線・接線を求めて比べる
+/// assimpのOBJ読み込みは三角形の角ごとに頂点を作るので，角ごとに比べる
+/// @param source 位置とUVを持つメッシュ
+/// @param target TangentGeneratorで生成するもの
+/// @param minRadius y軸からこの距離より近い角は比べない（球の極）
+Comparison CompareWithAssimp(const MeshAsset& source,
+    TangentGenerator::Target target, float minRadius) {
+    Comparison result;
+
+    std::vector<MeshAsset> meshes = { source };
+    TangentGenerator::Generate(meshes, { target }, nullptr);
+    const MeshAsset& generated = meshes[0];
+
+    const std::string obj = ToObj(source);
+    Assimp::Importer importer;
+    const aiScene* pScene = importer.ReadFileFromMemory(
+        obj.data(), obj.size(), kAssimpFlags, "obj");
+    CHECK(pScene != nullptr && pScene->mNumMeshes == 1);
+    if (pScene == nullptr || pScene->mNumMeshes != 1) {
+        return result;
+    }
+    const aiMesh* pMesh = pScene->mMeshes[0];
+    CHECK(pMesh->mNumFaces * 3 == generated.indices.size());
+    CHECK(pMesh->HasNormals() && pMesh->HasTangentsAndBitangents());
+    if (pMesh->mNumFaces * 3 != generated.indices.size() ||
+        !pMesh->HasTangentsAndBitangents()) {
+        return result;
+    }
+
+    double tangentSum = 0.0;
+    for (uint32_t f = 0; f < pMesh->mNumFaces; f++) {
+        for (uint32_t k = 0; k < 3; k++) {
+            const uint32_t corner = pMesh->mFaces[f].mIndices[k];
+            const StandardVertex& vertex =
+                generated.vertices[generated.indices[f * 3 + k]];
+            const XMFLOAT3& p = vertex.position;
+            if (std::sqrt(p.x * p.x + p.z * p.z) < minRadius) {
+                continue;
+            }
+
+            XMFLOAT3 tangent(vertex.tangent.x, vertex.tangent.y,
+                vertex.tangent.z);
+            double normalError =
+                AngleDegrees(vertex.normal, ToFloat3(pMesh->mNormals[corner]));
+            double tangentError =
+                AngleDegrees(tangent, ToFloat3(pMesh->mTangents[corner]));
+
+            // wは(N×T)·Bの符号で，assimpの従法線と向きが合う
+            float handedness = Dot(Cross(vertex.normal, tangent),
+                ToFloat3(pMesh->mBitangents[corner]));
+            if ((handedness < 0.0f ? -1.0f : 1.0f) != vertex.tangent.w) {
+                result.signMismatch++;
+            }
+
+            result.cornerCount++;
+            result.maxNormal  = std::max(result.maxNormal, normalError);
+            result.maxTangent = std::max(result.maxTangent, tangentError);
+            tangentSum += tangentError;
+        }
+    }
+    if (result.cornerCount > 0) {
+        result.meanTangent = tangentSum / result.cornerCount;
+    }
+    return result;
+}
+
+}  // namespace
+
+//==============================================================
+// テスト
+//==============================================================
+
+// 球の法線と接線がassimpのGenSmoothNormals・CalcTangentSpaceとほぼ一致する
+// 差が出るのは，重み付けの違いとuの継ぎ目（assimpは継ぎ目をまたいで平均する）
+TEST_CASE(TangentGenerator_MatchesAssimpOnSphere) {
+    Comparison result =
+        CompareWithAssimp(MakeSphere(64), { true, true }, 0.1f);
+    std::printf("  %u corners: normal max %.3f deg, tangent max %.3f deg "
+                "mean %.4f deg, %u sign mismatches\n",
+        result.cornerCount, result.maxNormal, result.maxTangent,
+        result.meanTangent, result.signMismatch);
+    CHECK(result.cornerCount > 20000);
+    CHECK(result.maxNormal < 1.0);
+    CHECK(result.maxTangent < 5.0);
+    CHECK(result.meanTangent < 0.25);
+    CHECK(result.signMismatch == 0);
+}
+
+// UVを折り返した面でも，接線と符号がassimpと一致する
+// TangentGeneratorは境目の頂点を複製して，両側に別の符号を持たせる
+TEST_CASE(TangentGenerator_MatchesAssimpOnMirroredUVs) {
+    constexpr uint32_t kSize = 8;
+    MeshAsset plane = MakeMirroredPlane(kSize);
+
+    Comparison result = CompareWithAssimp(plane, { false, true }, 0.0f);
+    CHECK(result.cornerCount == kSize * kSize * 6);
+    CHECK(result.maxNormal < 1e-3);
+    CHECK(result.maxTangent < 0.05);
+    CHECK(result.signMismatch == 0);
+
+    const size_t vertexCount = plane.vertices.size();
+    uint32_t split = TangentGenerator::GenerateTangents(plane, nullptr);
+    CHECK(split == kSize + 1);
+    CHECK(plane.vertices.size() == vertexCount + split);
+}
+
+// 並列に処理しても逐次と同じ結果になる
+TEST_CASE(TangentGenerator_ParallelMatchesSerial) {
+    JobSystem jobSystem;
+    CHECK(jobSystem.Init(3));
+
+    // 三角形のまとまりが複数になる大きさ
+    std::vector<MeshAsset> serial = { MakeSphere(128), MakeMirroredPlane(64) };
+    std::vector<MeshAsset> parallel = serial;
+    const std::vector<TangentGenerator::Target> targets = {
+        { true, true }, { false, true }
+    };
+    TangentGenerator::Generate(serial, targets, nullptr);
+    TangentGenerator::Generate(parallel, targets, &jobSystem);
+
+    for (size_t m = 0; m < serial.size(); m++) {
+        const std::vector<StandardVertex>& a = serial[m].vertices;
+        const std::vector<StandardVertex>& b = parallel[m].vertices;
+        CHECK(a.size() == b.size());
+        CHECK(std::memcmp(a.data(), b.data(),
+                  std::min(a.size(), b.size()) * sizeof(StandardVertex)) == 0);
+        CHECK(serial[m].indices == parallel[m].indices);
+    }
+    jobSystem.Term();
+}
+
+//==============================================================
+// 計測
+//==============================================================
+
+// 大きなメッシュ群での法線・接線の生成時間
+// assimpの後処理（1スレッド）と，TangentGeneratorの逐次・並列を比べる
+BENCHMARK_CASE(TangentGenerator_VsAssimp) {
+    constexpr uint32_t kMeshCount = 8;
+    const MeshAsset sphere        = MakeSphere(512);
+    const std::string obj         = ToObj(sphere);
+
+    std::printf(
+        "  hardware threads: %u\n", std::thread::hardware_concurrency());
+
+    // assimpは読み込みと後処理を分けて測る
+    double assimpMs = 0.0;
+    for (uint32_t i = 0; i < kMeshCount; i++) {
+        Assimp::Importer importer;
+        if (importer.ReadFileFromMemory(obj.data(), obj.size(), 0, "obj") ==
+            nullptr) {
+            CHECK(false);
+            return;
+        }
+        Stopwatch stopwatch;
+        importer.ApplyPostProcessing(kAssimpFlags);
+        assimpMs += stopwatch.GetElapsedMs();
+    }
+    const double triangles = double(sphere.indices.size() / 3) * kMeshCount;
+    std::printf("  assimp:    %8.1f ms  %6.2f M tris/s\n", assimpMs,
+        triangles / assimpMs / 1000.0);
+
+    JobSystem jobSystem;
+    jobSystem.Init();
+    for (JobSystem* pJobSystem : { static_cast<JobSystem*>(nullptr),
+             &jobSystem }) {
+        std::vector<MeshAsset> meshes(kMeshCount, sphere);
+        std::vector<TangentGenerator::Target> targets(
+            kMeshCount, { true, true });
+        TangentGenerator::Stats stats;
+        TangentGenerator::Generate(meshes, targets, pJobSystem, &stats);
+        std::printf("  %-10s %8.1f ms  %6.2f M tris/s\n",
+            pJobSystem ? "parallel:" : "serial:", stats.generateTimeMs,
+            stats.GetTrianglesPerSecond() / 1e6);
+    }
+    jobSystem.Term();
+}
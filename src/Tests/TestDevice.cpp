@@ -0,0 +1,33 @@
+#include "Tests/TestDevice.h"
+
+#include <dxgi1_4.h>
+
+#include "Engine/Core/ComPtr.h"
+
+namespace /* anonymous */ {
+/// @brief WARPアダプタでデバイスを作る
+engine::ComPtr<ID3D12Device> CreateWarpDevice() {
+    engine::ComPtr<IDXGIFactory4> pFactory;
+    if (FAILED(CreateDXGIFactory1(IID_PPV_ARGS(&pFactory)))) {
+        return nullptr;
+    }
+
+    engine::ComPtr<IDXGIAdapter> pAdapter;
+    if (FAILED(pFactory->EnumWarpAdapter(IID_PPV_ARGS(&pAdapter)))) {
+        return nullptr;
+    }
+
+    engine::ComPtr<ID3D12Device> pDevice;
+    if (FAILED(D3D12CreateDevice(pAdapter.Get(), D3D_FEATURE_LEVEL_11_0,
+            IID_PPV_ARGS(&pDevice)))) {
+        return nullptr;
+    }
+    return pDevice;
+}
+}  // namespace
+
+// WARPデバイスの取得
+ID3D12Device* GetWarpDevice() {
+    static engine::ComPtr<ID3D12Device> pDevice = CreateWarpDevice();
+    return pDevice.Get();
+}
@@ -0,0 +1,36 @@
+#include "Tests/TestFramework.h"
+
+#include <cstdio>
+
+std::atomic<int> TestRegistry::s_failureCount{ 0 };
+
+// テストを登録する
+bool TestRegistry::Add(const char* name, TestCase::Func func,
+    bool isBenchmark) {
+    GetMutableCases().push_back({ name, func, isBenchmark });
+    return true;
+}
+
+// 登録済みのテストの一覧
+const std::vector<TestCase>& TestRegistry::GetCases() {
+    return GetMutableCases();
+}
+
+// 判定の失敗を記録する
+void TestRegistry::ReportFailure(const char* expression, const char* file,
+    int line) {
+    s_failureCount.fetch_add(1, std::memory_order_relaxed);
+    std::fprintf(stderr, "  FAILED: %s\n    at %s(%d)\n", expression, file,
+        line);
+}
+
+// 記録した失敗の数
+int TestRegistry::GetFailureCount() {
+    return s_failureCount.load(std::memory_order_relaxed);
+}
+
+// 静的初期化の順序に依存しないよう，関数内の静的変数に置く
+std::vector<TestCase>& TestRegistry::GetMutableCases() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
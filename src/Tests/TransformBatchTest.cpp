@@ -0,0 +1,238 @@
+/// @file   TransformBatchTest.cpp
+/// @brief  TransformBatchとTransform::CalcWorldAndInverseの比較
+
+#include <DirectXMath.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "Engine/Scene/Transform.h"
+#include "Engine/Scene/TransformBatch.h"
+#include "Tests/TestFramework.h"
+
+using namespace DirectX;
+
+namespace /* anonymous */ {
+
+using SimdLevel = TransformBatch::SimdLevel;
+
+constexpr SimdLevel kLevels[]       = { SimdLevel::Avx2, SimdLevel::Sse,
+          SimdLevel::Scalar };
+constexpr const char* kLevelNames[] = { "avx2", "sse", "scalar" };
+
+/// @brief 8でも4でも割り切れない数にして，端数の処理も通す
+constexpr size_t kObjectCount = 1003;
+
+/// @brief Transformとの差の許容値（ULP）
+constexpr float kMaxUlp = 8.0f;
+
+/// @brief TransformBatchに渡す入力の列と，同じ値を持つTransformの列
+struct Inputs {
+    std::vector<XMFLOAT3> positions;
+    std::vector<XMFLOAT4> orientations;
+    std::vector<XMFLOAT3> scales;
+    std::vector<Transform> transforms;
+};
+
+/// @brief 乱数でTRSを作る，スケールは非一様と一様を混ぜる
+Inputs MakeInputs(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+    std::uniform_real_distribution<float> scale(0.05f, 20.0f);
+
+    Inputs inputs;
+    inputs.transforms.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        Transform& transform = inputs.transforms[i];
+        transform.SetPosition({ position(rng), position(rng), position(rng) });
+        transform.SetRotation(angle(rng), angle(rng), angle(rng));
+        const float s = scale(rng);
+        transform.SetScale(
+            i % 3 == 0 ? XMFLOAT3{ s, s, s }
+                       : XMFLOAT3{ s, scale(rng), scale(rng) });
+
+        inputs.positions.push_back(transform.GetPosition());
+        inputs.orientations.push_back(transform.GetOrientation());
+        inputs.scales.push_back(transform.GetScale());
+    }
+    return inputs;
+}
+
+/// @brief 各要素の誤差を，その要素が取りうる大きさに対するULPで測る
+/// 0に近い要素は相対誤差が意味を持たないので，行列の大きさを下限にする
+/// @param magnitude 各要素の大きさの目安（[行][列]）
+float MaxUlpError(const XMFLOAT4X4& actual, const XMFLOAT4X4& expected,
+    const float (&magnitude)[4][4]) {
+    float maxUlp = 0.0f;
+    for (int row = 0; row < 4; row++) {
+        for (int col = 0; col < 4; col++) {
+            const float diff =
+                std::fabs(actual.m[row][col] - expected.m[row][col]);
+            const float scale = std::max(
+                std::fabs(expected.m[row][col]), magnitude[row][col]);
+            if (diff == 0.0f) {
+                continue;
+            }
+            maxUlp = std::max(maxUlp, diff / (scale * FLT_EPSILON));
+        }
+    }
+    return maxUlp;
+}
+
+/// @brief 指定した経路でまとめて計算する
+void CalcBatch(const Inputs& inputs, SimdLevel level,
+    std::vector<XMFLOAT4X4>& worlds, std::vector<XMFLOAT4X4>& inverses) {
+    worlds.assign(inputs.positions.size(), {});
+    inverses.assign(inputs.positions.size(), {});
+    TransformBatch::CalcWorldAndInverse(inputs.positions, inputs.orientations,
+        inputs.scales, worlds, inverses, level);
+}
+
+}  // namespace
+
+//==============================================================
+// テスト
+//==============================================================
+
+// AVX2・SSE・スカラーの結果がビット単位で一致する
+TEST_CASE(TransformBatch_LevelsAreBitExact) {
+    std::printf("  AVX2 %s\n",
+        TransformBatch::IsAvx2Supported() ? "supported" : "not supported");
+
+    const Inputs inputs = MakeInputs(kObjectCount, 1);
+    std::vector<XMFLOAT4X4> scalarWorlds, scalarInverses;
+    CalcBatch(inputs, SimdLevel::Scalar, scalarWorlds, scalarInverses);
+
+    for (size_t level = 0; level < 2; level++) {
+        std::vector<XMFLOAT4X4> worlds, inverses;
+        CalcBatch(inputs, kLevels[level], worlds, inverses);
+        CHECK(std::memcmp(worlds.data(), scalarWorlds.data(),
+                  worlds.size() * sizeof(XMFLOAT4X4)) == 0);
+        CHECK(std::memcmp(inverses.data(), scalarInverses.data(),
+                  inverses.size() * sizeof(XMFLOAT4X4)) == 0);
+    }
+}
+
+// Transform::CalcWorldAndInverseとの差が数ULPに収まる
+TEST_CASE(TransformBatch_MatchesTransform) {
+    const Inputs inputs = MakeInputs(kObjectCount, 2);
+    std::vector<XMFLOAT4X4> worlds, inverses;
+    CalcBatch(inputs, SimdLevel::Avx2, worlds, inverses);
+
+    float maxWorldUlp   = 0.0f;
+    float maxInverseUlp = 0.0f;
+    for (size_t i = 0; i < kObjectCount; i++) {
+        XMMATRIX world, inverse;
+        inputs.transforms[i].CalcWorldAndInverse(world, inverse);
+        XMFLOAT4X4 expectedWorld, expectedInverse;
+        XMStoreFloat4x4(&expectedWorld, world);
+        XMStoreFloat4x4(&expectedInverse, inverse);
+
+        // 回転行列の成分は1以下なので，3x3部分はスケール（の逆数）が目安
+        // 逆行列の平行移動は，位置の成分の和をスケールで割った値が目安
+        const XMFLOAT3& p            = inputs.positions[i];
+        const XMFLOAT3& s            = inputs.scales[i];
+        const float scale[3]         = { s.x, s.y, s.z };
+        const float invS[3]          = { 1.0f / s.x, 1.0f / s.y, 1.0f / s.z };
+        const float pSum = std::fabs(p.x) + std::fabs(p.y) + std::fabs(p.z);
+        float worldMagnitude[4][4]   = {};
+        float inverseMagnitude[4][4] = {};
+        for (int k = 0; k < 3; k++) {
+            for (int j = 0; j < 3; j++) {
+                worldMagnitude[k][j]   = std::fabs(scale[k]);
+                inverseMagnitude[j][k] = std::fabs(invS[k]);
+            }
+            inverseMagnitude[3][k] = pSum * std::fabs(invS[k]);
+        }
+
+        maxWorldUlp = std::max(maxWorldUlp,
+            MaxUlpError(worlds[i], expectedWorld, worldMagnitude));
+        maxInverseUlp = std::max(maxInverseUlp,
+            MaxUlpError(inverses[i], expectedInverse, inverseMagnitude));
+
+        // 平行移動はそのまま写すだけなので完全に一致する
+        CHECK(worlds[i]._41 == p.x && worlds[i]._42 == p.y &&
+              worlds[i]._43 == p.z && worlds[i]._44 == 1.0f);
+    }
+
+    std::printf("  max error: world %.2f ULP, inverse %.2f ULP\n",
+        maxWorldUlp, maxInverseUlp);
+    CHECK(maxWorldUlp <= kMaxUlp);
+    CHECK(maxInverseUlp <= kMaxUlp);
+}
+
+// スケールが0に近いものは，Transformと同じく逆行列を単位行列にする
+TEST_CASE(TransformBatch_DegenerateScaleGivesIdentity) {
+    Inputs inputs    = MakeInputs(16, 3);
+    inputs.scales[1] = { 0.0f, 1.0f, 1.0f };
+    inputs.scales[6] = { 1.0f, -1e-7f, 1.0f };
+    inputs.scales[9] = { 2.0f, 2.0f, 0.0f };
+
+    XMFLOAT4X4 identity;
+    XMStoreFloat4x4(&identity, XMMatrixIdentity());
+    for (SimdLevel level : kLevels) {
+        std::vector<XMFLOAT4X4> worlds, inverses;
+        CalcBatch(inputs, level, worlds, inverses);
+        for (size_t i : { 1, 6, 9 }) {
+            CHECK(std::memcmp(&inverses[i], &identity, sizeof(identity)) ==
+                  0);
+        }
+        // 同じバッチの他の要素には影響しない
+        CHECK(std::memcmp(&inverses[0], &identity, sizeof(identity)) != 0);
+        for (size_t i = 0; i < worlds.size(); i++) {
+            for (int k = 0; k < 16; k++) {
+                CHECK(std::isfinite(inverses[i].m[k / 4][k % 4]));
+            }
+        }
+    }
+}
+
+//==============================================================
+// 計測
+//==============================================================
+
+// 1ミリ秒あたりに処理できるオブジェクト数
+BENCHMARK_CASE(TransformBatch_Throughput) {
+    constexpr size_t kCount = 100000;
+    constexpr int kRepeat   = 20;
+    const Inputs inputs     = MakeInputs(kCount, 4);
+    std::vector<XMFLOAT4X4> worlds(kCount), inverses(kCount);
+
+    // 基準：Transformを1つずつ計算する
+    double bestMs = 1e30;
+    for (int repeat = 0; repeat < kRepeat; repeat++) {
+        Stopwatch stopwatch;
+        for (size_t i = 0; i < kCount; i++) {
+            XMMATRIX world, inverse;
+            inputs.transforms[i].CalcWorldAndInverse(world, inverse);
+            XMStoreFloat4x4(&worlds[i], world);
+            XMStoreFloat4x4(&inverses[i], inverse);
+        }
+        bestMs = std::min(bestMs, stopwatch.GetElapsedMs());
+    }
+    const double baseline = kCount / bestMs;
+    std::printf("  %-9s %10.0f objects/ms\n", "transform", baseline);
+
+    for (size_t level = 0; level < 3; level++) {
+        if (kLevels[level] == SimdLevel::Avx2 &&
+            !TransformBatch::IsAvx2Supported()) {
+            continue;
+        }
+        bestMs = 1e30;
+        for (int repeat = 0; repeat < kRepeat; repeat++) {
+            Stopwatch stopwatch;
+            TransformBatch::CalcWorldAndInverse(inputs.positions,
+                inputs.orientations, inputs.scales, worlds, inverses,
+                kLevels[level]);
+            bestMs = std::min(bestMs, stopwatch.GetElapsedMs());
+        }
+        std::printf("  %-9s %10.0f objects/ms (%.2fx)\n", kLevelNames[level],
+            kCount / bestMs, kCount / bestMs / baseline);
+    }
+}
@@ -0,0 +1,240 @@
+/// @file   VertexQuantizerTest.cpp
+/// @brief  VertexQuantizerの圧縮と復元の誤差の検証
+
+#include <DirectXMath.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Engine/Model/ModelAsset.h"
+#include "Engine/Resource/VertexQuantizer.h"
+#include "Tests/TestFramework.h"
+
+using DirectX::XMFLOAT3;
+
+namespace /* anonymous */ {
+
+constexpr double kRadToDeg = 57.29577951308232;
+
+/// @brief 2つの方向の間の角度（度，倍精度）
+double AngleDegrees(const XMFLOAT3& a, const XMFLOAT3& b) {
+    const double cx = double(a.y) * b.z - double(a.z) * b.y;
+    const double cy = double(a.z) * b.x - double(a.x) * b.z;
+    const double cz = double(a.x) * b.y - double(a.y) * b.x;
+    const double dot =
+        double(a.x) * b.x + double(a.y) * b.y + double(a.z) * b.z;
+    return std::atan2(std::sqrt(cx * cx + cy * cy + cz * cz), dot) *
+           kRadToDeg;
+}
+
+XMFLOAT3 Normalize(const XMFLOAT3& v) {
+    float length = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+    return XMFLOAT3(v.x / length, v.y / length, v.z / length);
+}
+
+/// @brief 接線の方向だけを取り出す
+XMFLOAT3 TangentDirection(const StandardVertex& vertex) {
+    return XMFLOAT3(vertex.tangent.x, vertex.tangent.y, vertex.tangent.z);
+}
+
+/// @brief 乱数で作った頂点（頂点カラーは白，接線は法線に垂直）
+std::vector<StandardVertex> MakeVertices(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    std::vector<StandardVertex> vertices;
+    while (vertices.size() < count) {
+        XMFLOAT3 n(unit(rng), unit(rng), unit(rng));
+        if (n.x * n.x + n.y * n.y + n.z * n.z < 1e-4f) continue;
+
+        StandardVertex vertex{};
+        vertex.position = { unit(rng) * 50.0f, unit(rng) * 3.0f + 10.0f,
+            unit(rng) };
+        vertex.normal   = Normalize(n);
+        XMFLOAT3 t      = Normalize(XMFLOAT3(
+            vertex.normal.z, 0.0f, -vertex.normal.x + 1e-3f));
+        float sign      = (vertices.size() & 1) ? 1.0f : -1.0f;
+        vertex.tangent  = { t.x, t.y, t.z, sign };
+        vertex.texcoord = { unit(rng) * 2.0f, unit(rng) + 0.5f };
+        vertex.color    = { 1.0f, 1.0f, 1.0f, 1.0f };
+        vertices.push_back(vertex);
+    }
+    return vertices;
+}
+
+}  // namespace
+
+//==============================================================
+// テスト
+//==============================================================
+
+// 八面体写像の往復で方向がほとんど変わらない
+TEST_CASE(VertexQuantizer_OctahedralRoundTrip) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    std::vector<XMFLOAT3> directions = {
+        { 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f },
+        { 0.0f, -1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f },
+        Normalize({ 1.0f, 1.0f, -1.0f }), Normalize({ -1.0f, -1.0f, -1.0f }),
+        Normalize({ 1.0f, -1.0f, 1e-7f }), Normalize({ 1e-7f, 1.0f, -1e-7f }),
+    };
+    while (directions.size() < 200000) {
+        XMFLOAT3 d(unit(rng), unit(rng), unit(rng));
+        if (d.x * d.x + d.y * d.y + d.z * d.z > 1e-4f) {
+            directions.push_back(Normalize(d));
+        }
+    }
+
+    double maxError = 0.0;
+    for (const XMFLOAT3& direction : directions) {
+        int16_t encoded[2];
+        VertexQuantizer::EncodeOctahedral(direction, encoded);
+        XMFLOAT3 decoded = VertexQuantizer::DecodeOctahedral(encoded);
+        maxError         = std::max(maxError, AngleDegrees(direction, decoded));
+
+        // 復元した方向は単位長
+        float length = std::sqrt(decoded.x * decoded.x +
+                                 decoded.y * decoded.y + decoded.z * decoded.z);
+        CHECK(std::abs(length - 1.0f) < 1e-5f);
+    }
+    std::printf("  octahedral: %zu directions, max error %.5f deg\n",
+        directions.size(), maxError);
+    CHECK(maxError < 0.01);
+
+    // 長さ0の方向は壊れた値にならない
+    int16_t zero[2];
+    VertexQuantizer::EncodeOctahedral({ 0.0f, 0.0f, 0.0f }, zero);
+    XMFLOAT3 decoded = VertexQuantizer::DecodeOctahedral(zero);
+    CHECK(std::isfinite(decoded.x) && std::isfinite(decoded.y) &&
+          std::isfinite(decoded.z));
+}
+
+// 位置とUVの誤差は量子化の半段階以内，接空間の向きと頂点カラーは保つ
+TEST_CASE(VertexQuantizer_EncodeDecodeRoundTrip) {
+    const std::vector<StandardVertex> vertices = MakeVertices(5000, 7);
+    const VertexQuantization q = VertexQuantizer::ComputeQuantization(vertices);
+
+    // 半段階に，float演算の丸めの分（値の大きさの数ulp）を足す
+    auto bound = [](float offset, float scale) {
+        return scale / 65535.0f * 0.5f +
+               (std::abs(offset) + scale) * 4.0f * FLT_EPSILON;
+    };
+    const float positionBound[3] = {
+        bound(q.positionOffset.x, q.positionScale.x),
+        bound(q.positionOffset.y, q.positionScale.y),
+        bound(q.positionOffset.z, q.positionScale.z),
+    };
+    const float texcoordBound[2] = {
+        bound(q.texcoordOffset.x, q.texcoordScale.x),
+        bound(q.texcoordOffset.y, q.texcoordScale.y),
+    };
+
+    uint32_t outOfBound = 0;
+    double maxNormal    = 0.0;
+    double maxTangent   = 0.0;
+    for (const StandardVertex& source : vertices) {
+        CompactVertex compact  = VertexQuantizer::Encode(source, q);
+        StandardVertex decoded = VertexQuantizer::Decode(compact, q);
+
+        const XMFLOAT3& p0 = source.position;
+        const XMFLOAT3& p1 = decoded.position;
+        const DirectX::XMFLOAT2& t0 = source.texcoord;
+        const DirectX::XMFLOAT2& t1 = decoded.texcoord;
+        if (std::abs(p1.x - p0.x) > positionBound[0] ||
+            std::abs(p1.y - p0.y) > positionBound[1] ||
+            std::abs(p1.z - p0.z) > positionBound[2] ||
+            std::abs(t1.x - t0.x) > texcoordBound[0] ||
+            std::abs(t1.y - t0.y) > texcoordBound[1]) {
+            outOfBound++;
+        }
+
+        maxNormal =
+            std::max(maxNormal, AngleDegrees(source.normal, decoded.normal));
+        maxTangent = std::max(maxTangent,
+            AngleDegrees(TangentDirection(source), TangentDirection(decoded)));
+
+        CHECK(decoded.tangent.w == source.tangent.w);
+        CHECK(decoded.color.x == 1.0f && decoded.color.w == 1.0f);
+    }
+    std::printf("  position step %.6f, normal %.5f deg, tangent %.5f deg\n",
+        q.positionScale.x / 65535.0f, maxNormal, maxTangent);
+    CHECK(outOfBound == 0);
+    CHECK(maxNormal < 0.01 && maxTangent < 0.01);
+}
+
+// Compressが返す誤差は実際の往復の誤差で，許容値を超えない
+TEST_CASE(VertexQuantizer_CompressReportsError) {
+    MeshAsset mesh;
+    mesh.vertices = MakeVertices(5000, 11);
+    const std::vector<StandardVertex> original = mesh.vertices;
+
+    VertexQuantizer::ErrorStats error;
+    CHECK(VertexQuantizer::Compress(mesh, &error));
+    CHECK(mesh.HasCompactVertices() && mesh.vertices.empty());
+    CHECK(mesh.GetVertexCount() == 5000);
+    CHECK(mesh.GetView().GetVertexStride() == sizeof(CompactVertex));
+
+    float maxPosition = 0.0f;
+    for (size_t i = 0; i < original.size(); i++) {
+        StandardVertex decoded = VertexQuantizer::Decode(
+            mesh.compactVertices[i], mesh.quantization);
+        maxPosition = std::max({ maxPosition,
+            std::abs(decoded.position.x - original[i].position.x),
+            std::abs(decoded.position.y - original[i].position.y),
+            std::abs(decoded.position.z - original[i].position.z) });
+    }
+    CHECK(error.position == maxPosition);
+    CHECK(error.texcoord <= VertexQuantizer::kMaxTexcoordError);
+    CHECK(error.normal < 0.01f && error.tangent < 0.01f);
+}
+
+// 情報が失われるメッシュは圧縮しない
+TEST_CASE(VertexQuantizer_RejectsLossyMeshes) {
+    const std::vector<StandardVertex> vertices = MakeVertices(1000, 13);
+
+    MeshAsset colored;
+    colored.vertices          = vertices;
+    colored.vertices[7].color = { 1.0f, 0.0f, 0.0f, 1.0f };
+
+    MeshAsset wide;
+    wide.vertices               = vertices;
+    wide.vertices[3].texcoord.x = 100.0f;
+
+    MeshAsset broken;
+    broken.vertices             = vertices;
+    broken.vertices[5].normal.y = NAN;
+
+    for (MeshAsset* pMesh : { &colored, &wide, &broken }) {
+        CHECK(!VertexQuantizer::Compress(*pMesh));
+        CHECK(!pMesh->HasCompactVertices());
+        CHECK(pMesh->vertices.size() == vertices.size());
+    }
+
+    // 平らなメッシュ（範囲0の軸）は圧縮でき，その軸の誤差は0
+    MeshAsset flat;
+    flat.vertices = vertices;
+    for (StandardVertex& vertex : flat.vertices) {
+        vertex.position.z = 2.0f;
+    }
+    CHECK(VertexQuantizer::Compress(flat));
+    StandardVertex decoded =
+        VertexQuantizer::Decode(flat.compactVertices[0], flat.quantization);
+    CHECK(decoded.position.z == 2.0f);
+
+    // モデル全体では圧縮できたメッシュだけが小さくなる
+    std::vector<MeshAsset> meshes(2);
+    meshes[0].vertices = vertices;
+    meshes[1]          = colored;
+    VertexQuantizer::Stats stats;
+    VertexQuantizer::CompressVertices(meshes, &stats);
+    std::printf("  %.1f -> %.1f bytes/vertex\n",
+        stats.GetBytesPerVertexBefore(), stats.GetBytesPerVertexAfter());
+    CHECK(stats.compactMeshCount == 1 && stats.standardMeshCount == 1);
+    CHECK(stats.bytesAfter ==
+          vertices.size() * (sizeof(CompactVertex) + sizeof(StandardVertex)));
+}
@@ -0,0 +1,61 @@
+/// @file   main.cpp
+/// @brief  エンジンの単体テストと計測のエントリーポイント
+/// GPUを使わない部分（一部はWARPデバイス）をコンソールで検証する
+
+#include <cstdio>
+#include <cstring>
+
+#include "Tests/TestFramework.h"
+
+namespace /* anonymous */ {
+/// @brief 使い方の表示
+void PrintUsage() {
+    std::printf(
+        "Usage: Tests [--bench] [filter]\n"
+        "  --bench  テストに加えて計測（ベンチマーク）も実行する\n"
+        "  filter   名前にこの文字列を含むものだけを実行する\n");
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    bool runBenchmarks = false;
+    const char* filter = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--bench") == 0) {
+            runBenchmarks = true;
+        } else if (std::strcmp(argv[i], "--help") == 0) {
+            PrintUsage();
+            return 0;
+        } else {
+            filter = argv[i];
+        }
+    }
+
+    int runCount    = 0;
+    int failedCount = 0;
+    for (const TestCase& testCase : TestRegistry::GetCases()) {
+        if (testCase.isBenchmark && !runBenchmarks) {
+            continue;
+        }
+        if (filter && !std::strstr(testCase.name, filter)) {
+            continue;
+        }
+
+        std::printf("[ RUN  ] %s\n", testCase.name);
+        std::fflush(stdout);
+        const int failuresBefore = TestRegistry::GetFailureCount();
+        Stopwatch stopwatch;
+        testCase.func();
+        const bool passed = TestRegistry::GetFailureCount() == failuresBefore;
+        std::printf("[ %s ] %s (%.1f ms)\n", passed ? " OK " : "FAIL",
+            testCase.name, stopwatch.GetElapsedMs());
+
+        runCount++;
+        if (!passed) {
+            failedCount++;
+        }
+    }
+
+    std::printf("%d run, %d failed\n", runCount, failedCount);
+    return failedCount == 0 ? 0 : 1;
+}